@@ -60,12 +60,12 @@ void DialogPortsConfig::SetupTable()
     QStringList         HeaderList;
 
     // Setup the headers for the table
-    HeaderList << CONFIGPORTDLG_HEADER_INDEX << CONFIGPORTDLG_HEADER_DYN_PORT_NAME << CONFIGPORTDLG_HEADER_SET_NUM_PORTS;
-    ui->TableWidget_DynPorts->setColumnCount(3);                                // Two Columns
+    HeaderList << CONFIGPORTDLG_HEADER_INDEX << CONFIGPORTDLG_HEADER_DYN_PORT_NAME << CONFIGPORTDLG_HEADER_SET_NUM_PORTS << CONFIGPORTDLG_HEADER_SHOW_AS_BUS;
+    ui->TableWidget_DynPorts->setColumnCount(4);                                // Four Columns
     ui->TableWidget_DynPorts->setHorizontalHeaderLabels(HeaderList);            // Header Names
     ui->TableWidget_DynPorts->horizontalHeader()->resizeSection(0, CONFIGPORTDLG_HEADER_0_WIDTH); // Header index 0 width
     ui->TableWidget_DynPorts->horizontalHeader()->resizeSection(1, CONFIGPORTDLG_HEADER_1_WIDTH);  // Header index 1 width
-    ui->TableWidget_DynPorts->horizontalHeader()->setStretchLastSection(true);  // Header Index 2 consumes remaining space
+    ui->TableWidget_DynPorts->horizontalHeader()->setStretchLastSection(true);  // Header Index 3 consumes remaining space
     ui->TableWidget_DynPorts->setSortingEnabled(false);                         // Disable Sorting
 
     // Set table headers to resize per their contents
@@ -96,12 +96,12 @@ void DialogPortsConfig::PopulatePortData()
             Value = QString("%1").arg(PortInfo->GetNumTotalInstances());
 
             // Add Port Data
-            AddPortDataEntry(x, Name, Value);
+            AddPortDataEntry(x, Name, Value, PortInfo->IsPortBus());
         }
     }
 }
 
-void DialogPortsConfig::AddPortDataEntry(int Index, QString& EnvName, QString& EnvValue)
+void DialogPortsConfig::AddPortDataEntry(int Index, QString& EnvName, QString& EnvValue, bool ShowAsBus)
 {
     QTableWidgetItem* pItem;
     int               rowIndex;
@@ -126,6 +126,12 @@ void DialogPortsConfig::AddPortDataEntry(int Index, QString& EnvName, QString& E
     pItem = new QTableWidgetItem(EnvValue);
     pItem->setFlags(Qt::ItemIsEnabled | Qt::ItemIsEditable);
     ui->TableWidget_DynPorts->setItem(rowIndex, 2, pItem);
+
+    // Add the Show as Bus checkbox to the table
+    pItem = new QTableWidgetItem();
+    pItem->setFlags(Qt::ItemIsEnabled | Qt::ItemIsUserCheckable);
+    pItem->setCheckState((ShowAsBus == true) ? Qt::Checked : Qt::Unchecked);
+    ui->TableWidget_DynPorts->setItem(rowIndex, 3, pItem);
 }
 
 void DialogPortsConfig::SavePortData()
@@ -135,6 +141,8 @@ void DialogPortsConfig::SavePortData()
     int               Index;
     QString           PortName;
     QString           PortValue;
+    bool              ShowAsBus;
+    bool              WasBus;
     PortInfoData*     PortInfo;
     QString           ControllingParam;
     QString           NumInstancesStr;
@@ -155,9 +163,16 @@ void DialogPortsConfig::SavePortData()
         pItem = ui->TableWidget_DynPorts->item(x, 2);  // Port Value
         PortValue = pItem->text();  // Ports will range from 0 to PORT_MAX_NUM_DYNAMIC_PORTS
 
-        // Get the Port Info
+        pItem = ui->TableWidget_DynPorts->item(x, 3);  // Show as Bus
+        ShowAsBus = (pItem->checkState() == Qt::Checked);
+
+        // Get the Port Info (A changed Show as Bus overrides the default Bus of a large Port)
         PortInfo = m_SelectedComponent->GetPortInfoDataArray().at(Index);
+        WasBus = PortInfo->IsPortBus();
         PortInfo->SetNumTotalInstances(PortValue.toInt());
+        if (ShowAsBus != WasBus) {
+            PortInfo->SetPortBus(ShowAsBus);
+        }
 
     }
 
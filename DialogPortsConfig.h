@@ -45,7 +45,7 @@ private:
     // Table Management
     void SetupTable();
     void PopulatePortData();
-    void AddPortDataEntry(int Index, QString& EnvName, QString& EnvValue);
+    void AddPortDataEntry(int Index, QString& EnvName, QString& EnvValue, bool ShowAsBus);
     // Save the Changes back to the Port
     void SavePortData();
 
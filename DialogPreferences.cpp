@@ -26,6 +26,12 @@ DialogPreferences::DialogPreferences(QWidget *parent) :
 {
     ui->setupUi(this);
     setWindowTitle("Preferences");
+
+    // The View Update Modes (The Item Data is the QGraphicsView::ViewportUpdateMode)
+    ui->ViewUpdateModeCombo->addItem("Minimal (Repaint Only Changed Areas)", QGraphicsView::MinimalViewportUpdate);
+    ui->ViewUpdateModeCombo->addItem("Smart (Qt Chooses the Repaint Area)", QGraphicsView::SmartViewportUpdate);
+    ui->ViewUpdateModeCombo->addItem("Bounding Rect (Repaint One Area Around Changes)", QGraphicsView::BoundingRectViewportUpdate);
+    ui->ViewUpdateModeCombo->addItem("Full (Repaint Everything)", QGraphicsView::FullViewportUpdate);
 }
 
 DialogPreferences::~DialogPreferences()
@@ -53,6 +59,59 @@ bool DialogPreferences::GetFlagReturnToSelectAfterTextPlaced()
     return ui->ReturnToSelectAfterText->isChecked();
 }
 
+void DialogPreferences::SetFlagCacheComponentRendering(bool flag)
+{
+    ui->CacheComponentRendering->setChecked(flag);
+}
+
+void DialogPreferences::SetViewUpdateMode(int Mode)
+{
+    int Index = ui->ViewUpdateModeCombo->findData(Mode);
+
+    // Unknown modes show the first entry
+    ui->ViewUpdateModeCombo->setCurrentIndex((Index >= 0) ? Index : 0);
+}
+
+void DialogPreferences::SetFlagOptimizeViewPainting(bool flag)
+{
+    ui->OptimizeViewPainting->setChecked(flag);
+}
+
+bool DialogPreferences::GetFlagCacheComponentRendering()
+{
+    return ui->CacheComponentRendering->isChecked();
+}
+
+int DialogPreferences::GetViewUpdateMode()
+{
+    return ui->ViewUpdateModeCombo->itemData(ui->ViewUpdateModeCombo->currentIndex()).toInt();
+}
+
+bool DialogPreferences::GetFlagOptimizeViewPainting()
+{
+    return ui->OptimizeViewPainting->isChecked();
+}
+
+void DialogPreferences::SetFlagAutoRouteNewWires(bool flag)
+{
+    ui->AutoRouteNewWires->setChecked(flag);
+}
+
+bool DialogPreferences::GetFlagAutoRouteNewWires()
+{
+    return ui->AutoRouteNewWires->isChecked();
+}
+
+void DialogPreferences::SetUndoMemoryBudget(qint64 Budget)
+{
+    ui->UndoMemoryBudgetSpin->setValue((int)(Budget / (1024 * 1024)));
+}
+
+qint64 DialogPreferences::GetUndoMemoryBudget()
+{
+    return (qint64)ui->UndoMemoryBudgetSpin->value() * 1024 * 1024;
+}
+
 void DialogPreferences::on_buttonBox_accepted()
 {
 }
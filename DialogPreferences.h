@@ -43,6 +43,23 @@ public:
     bool GetFlagReturnToSelectAfterWirePlaced();
     bool GetFlagReturnToSelectAfterTextPlaced();
 
+    // Rendering Preferences
+    void SetFlagCacheComponentRendering(bool flag);
+    void SetViewUpdateMode(int Mode);
+    void SetFlagOptimizeViewPainting(bool flag);
+
+    bool GetFlagCacheComponentRendering();
+    int  GetViewUpdateMode();
+    bool GetFlagOptimizeViewPainting();
+
+    // Wiring Preferences
+    void SetFlagAutoRouteNewWires(bool flag);
+    bool GetFlagAutoRouteNewWires();
+
+    // Undo Preferences (Budget in Bytes)
+    void SetUndoMemoryBudget(qint64 Budget);
+    qint64 GetUndoMemoryBudget();
+
 private slots:
     void on_buttonBox_accepted();
     void on_buttonBox_rejected();
@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#include "DialogTopologyGenerator.h"
+#include "ui_DialogTopologyGenerator.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+DialogTopologyGenerator::DialogTopologyGenerator(SSTInfoData* InfoData, QWidget* parent) :
+    QDialog(parent),
+    ui(new Ui::DialogTopologyGenerator)
+{
+    int x;
+
+    // Init Variables
+    m_SSTInfoData = InfoData;
+
+    // Build the UI
+    ui->setupUi(this);
+
+    // Set the title
+    setWindowTitle(TOPOLOGYDLG_DLGTITLE);
+
+    // Set the Ranges of the Spin Boxes
+    ui->ShapeParam1SpinBox->setRange(1, TOPOLOGYDLG_MAX_SHAPE_PARAM);
+    ui->ShapeParam2SpinBox->setRange(1, TOPOLOGYDLG_MAX_SHAPE_PARAM);
+    ui->ShapeParam3SpinBox->setRange(1, TOPOLOGYDLG_MAX_SHAPE_PARAM);
+    ui->EndpointsPerRouterSpinBox->setRange(0, TOPOLOGYDLG_MAX_ENDPOINTS_PER_ROUTER);
+
+    // Fill in the Topology Types (Combo Index == TopologyType)
+    for (x = 0; x < TopologyGenerator::TOPO_END; x++) {
+        ui->TopologyTypeCombo->addItem(TopologyGenerator::GetTopologyTypeName(TopologyGenerator::TopologyType(x)));
+    }
+
+    // Fill in the Components that can be chosen
+    PopulateComponentLists();
+
+    UpdateShapeParamLabels();
+    UpdateSummary();
+}
+
+DialogTopologyGenerator::~DialogTopologyGenerator()
+{
+    delete ui;
+}
+
+TopologyGenerator::TopologyType DialogTopologyGenerator::GetTopologyType()
+{
+    return TopologyGenerator::TopologyType(ui->TopologyTypeCombo->currentIndex());
+}
+
+int DialogTopologyGenerator::GetShapeParam1()
+{
+    return ui->ShapeParam1SpinBox->value();
+}
+
+int DialogTopologyGenerator::GetShapeParam2()
+{
+    return ui->ShapeParam2SpinBox->value();
+}
+
+int DialogTopologyGenerator::GetShapeParam3()
+{
+    return ui->ShapeParam3SpinBox->value();
+}
+
+int DialogTopologyGenerator::GetEndpointsPerRouter()
+{
+    // No Endpoint Component means no Endpoints
+    if (GetEndpointComponent() == NULL) {
+        return 0;
+    }
+    return ui->EndpointsPerRouterSpinBox->value();
+}
+
+SSTInfoDataComponent* DialogTopologyGenerator::GetRouterComponent()
+{
+    int Index = ui->RouterComponentCombo->currentIndex();
+
+    if ((Index < 0) || (Index >= m_ComponentList.count())) {
+        return NULL;
+    }
+    return m_ComponentList.at(Index);
+}
+
+QString DialogTopologyGenerator::GetRouterPortName()
+{
+    return ui->RouterPortCombo->currentText();
+}
+
+SSTInfoDataComponent* DialogTopologyGenerator::GetEndpointComponent()
+{
+    // NOTE: The first entry of the Endpoint Combo is "<None>"
+    int Index = ui->EndpointComponentCombo->currentIndex() - 1;
+
+    if ((Index < 0) || (Index >= m_ComponentList.count())) {
+        return NULL;
+    }
+    return m_ComponentList.at(Index);
+}
+
+QString DialogTopologyGenerator::GetEndpointPortName()
+{
+    return ui->EndpointPortCombo->currentText();
+}
+
+void DialogTopologyGenerator::PopulateComponentLists()
+{
+    int                   x;
+    int                   y;
+    SSTInfoDataElement*   Element;
+    SSTInfoDataComponent* Component;
+    QString               FullComponentName;
+
+    m_ComponentList.clear();
+    ui->EndpointComponentCombo->addItem(TOPOLOGYDLG_NO_ENDPOINT);
+
+    if (m_SSTInfoData == NULL) {
+        return;
+    }
+
+    // Add every Component (except the SST Startup Configuration) of every Element
+    for (x = 0; x < m_SSTInfoData->GetNumOfElements(); x++) {
+        Element = m_SSTInfoData->GetElement(x);
+        for (y = 0; y < Element->GetNumOfComponents(); y++) {
+            Component = Element->GetComponent(y);
+            if (Component->GetComponentType() != SSTInfoDataComponent::COMP_SSTSTARTUPCONFIGURATION) {
+                FullComponentName = Component->GetParentElementName() + "." + Component->GetComponentName();
+                m_ComponentList.append(Component);
+                ui->RouterComponentCombo->addItem(FullComponentName);
+                ui->EndpointComponentCombo->addItem(FullComponentName);
+            }
+        }
+    }
+}
+
+void DialogTopologyGenerator::PopulatePortList(QComboBox* PortCombo, SSTInfoDataComponent* Component, bool DynamicOnly)
+{
+    int     x;
+    QString PortName;
+
+    PortCombo->clear();
+    if (Component == NULL) {
+        return;
+    }
+
+    for (x = 0; x < Component->GetNumOfPorts(); x++) {
+        PortName = Component->GetPort(x)->GetPortName();
+
+        // Routers need a Dynamic Port (named with a %d or %(param)d) to hold all of their links
+        if ((DynamicOnly == false) || (PortName.contains("%d") == true) || (PortName.contains("%(") == true)) {
+            PortCombo->addItem(PortName);
+        }
+    }
+}
+
+void DialogTopologyGenerator::UpdateShapeParamLabels()
+{
+    QStringList ParamNames = TopologyGenerator::GetTopologyParamNames(GetTopologyType());
+
+    // Hide any Shape Parameters that the Topology does not use
+    ui->ShapeParam1Label->setText(ParamNames.at(0));
+    ui->ShapeParam2Label->setText(ParamNames.at(1));
+    ui->ShapeParam3Label->setText(ParamNames.at(2));
+    ui->ShapeParam3Label->setVisible(ParamNames.at(2).isEmpty() == false);
+    ui->ShapeParam3SpinBox->setVisible(ParamNames.at(2).isEmpty() == false);
+}
+
+void DialogTopologyGenerator::UpdateSummary()
+{
+    QString ErrorMsg;
+    bool    ValidFlag;
+
+    // Build the Topology (without any Graphic Items) to show the user what will be created
+    TopologyGenerator Generator(GetTopologyType(), GetShapeParam1(), GetShapeParam2(), GetShapeParam3(), GetEndpointsPerRouter());
+    ValidFlag = Generator.BuildTopology(ErrorMsg);
+
+    if (ValidFlag == true) {
+        ui->SummaryLabel->setText(QString("%1 Routers; %2 Endpoints; %3 Links").arg(Generator.GetNumRouters()).arg(Generator.GetNumEndpoints()).arg(Generator.GetNumLinks()));
+    } else {
+        ui->SummaryLabel->setText(ErrorMsg);
+    }
+
+    // Only allow the user to continue with a valid Topology and Router
+    ValidFlag &= (GetRouterComponent() != NULL) && (GetRouterPortName().isEmpty() == false);
+    ValidFlag &= (GetEndpointComponent() == NULL) || (GetEndpointPortName().isEmpty() == false);
+    ui->buttonBox->button(QDialogButtonBox::Ok)->setEnabled(ValidFlag);
+}
+
+void DialogTopologyGenerator::on_TopologyTypeCombo_currentIndexChanged(int Index)
+{
+    Q_UNUSED(Index)
+    UpdateShapeParamLabels();
+    UpdateSummary();
+}
+
+void DialogTopologyGenerator::on_RouterComponentCombo_currentIndexChanged(int Index)
+{
+    Q_UNUSED(Index)
+    PopulatePortList(ui->RouterPortCombo, GetRouterComponent(), true);
+    UpdateSummary();
+}
+
+void DialogTopologyGenerator::on_EndpointComponentCombo_currentIndexChanged(int Index)
+{
+    Q_UNUSED(Index)
+    PopulatePortList(ui->EndpointPortCombo, GetEndpointComponent(), false);
+    ui->EndpointsPerRouterSpinBox->setEnabled(GetEndpointComponent() != NULL);
+    UpdateSummary();
+}
+
+void DialogTopologyGenerator::on_ShapeParam1SpinBox_valueChanged(int Value)
+{
+    Q_UNUSED(Value)
+    UpdateSummary();
+}
+
+void DialogTopologyGenerator::on_ShapeParam2SpinBox_valueChanged(int Value)
+{
+    Q_UNUSED(Value)
+    UpdateSummary();
+}
+
+void DialogTopologyGenerator::on_ShapeParam3SpinBox_valueChanged(int Value)
+{
+    Q_UNUSED(Value)
+    UpdateSummary();
+}
+
+void DialogTopologyGenerator::on_EndpointsPerRouterSpinBox_valueChanged(int Value)
+{
+    Q_UNUSED(Value)
+    UpdateSummary();
+}
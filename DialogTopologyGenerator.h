@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DIALOGTOPOLOGYGENERATOR_H
+#define DIALOGTOPOLOGYGENERATOR_H
+
+#include "GlobalIncludes.h"
+
+#include "TopologyGenerator.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// The User Interface Form
+namespace Ui {
+    class DialogTopologyGenerator;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+class DialogTopologyGenerator : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DialogTopologyGenerator(SSTInfoData* InfoData, QWidget* parent = 0);
+    ~DialogTopologyGenerator();
+
+    // The Users Choices
+    TopologyGenerator::TopologyType GetTopologyType();
+    int GetShapeParam1();
+    int GetShapeParam2();
+    int GetShapeParam3();
+    int GetEndpointsPerRouter();
+
+    SSTInfoDataComponent* GetRouterComponent();
+    QString               GetRouterPortName();
+    SSTInfoDataComponent* GetEndpointComponent();   // NULL if no Endpoints are wanted
+    QString               GetEndpointPortName();
+
+private:
+    void PopulateComponentLists();
+    void PopulatePortList(QComboBox* PortCombo, SSTInfoDataComponent* Component, bool DynamicOnly);
+    void UpdateShapeParamLabels();
+    void UpdateSummary();
+
+private slots:
+    void on_TopologyTypeCombo_currentIndexChanged(int Index);
+    void on_RouterComponentCombo_currentIndexChanged(int Index);
+    void on_EndpointComponentCombo_currentIndexChanged(int Index);
+    void on_ShapeParam1SpinBox_valueChanged(int Value);
+    void on_ShapeParam2SpinBox_valueChanged(int Value);
+    void on_ShapeParam3SpinBox_valueChanged(int Value);
+    void on_EndpointsPerRouterSpinBox_valueChanged(int Value);
+
+private:
+    Ui::DialogTopologyGenerator*  ui;
+    SSTInfoData*                  m_SSTInfoData;
+    QList<SSTInfoDataComponent*>  m_ComponentList;   // Same order as the entries in the Component Combo Boxes
+};
+
+#endif // DIALOGTOPOLOGYGENERATOR_H
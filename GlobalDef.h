@@ -31,7 +31,8 @@
 #define NUMGRAPHICITEMTYPES                     GraphicItemBase::ITEMTYPE_END
 #define NUMCOMPONENTTYPES                       SSTInfoDataComponent::COMP_END
 #define SSTINFOXMLFILEFORMATVERSION             "1.0"                           /*** INCREMENT IF SSTINFO XML FORMAT CHANGES ***/
-#define SSTWORKBENCHPROJECTFILEFORMATVERSION    100                             /*** INCREMENT IF WORKBENCH PROJECT FILE STRUCTURE CHANGES ***/
+#define SSTWORKBENCHPROJECTFILEFORMATVERSION    104                             /*** INCREMENT IF WORKBENCH PROJECT FILE STRUCTURE CHANGES ***/
+#define SSTWORKBENCHPROJECTFILEPARAMSETSVERSION 104                             // First Project File Version that holds Parameter Sets
 #define SSTWORKBENCHPROJECTFILEMAGICNUMBER      0xCD4234DF
 #define PROJECTFILEEXTENSION                    ".swb"
 #define PROJECTFILEEXTENSIONFILTER              "*.swb"
@@ -43,6 +44,12 @@
 #define MOUSEMOVE_DELAYPIXELS                   5
 #define DEFAULT_PASTE_OFFSET                    20
 
+// Extra room added around items that grow the Scene Rect past its current size
+#define SCENE_GROW_MARGIN                       500
+
+// Cell Size of the Scene's Spatial Hash of Port Connection Points (Larger than a Port Ellipse)
+#define SCENE_PORT_HASH_CELL_SIZE               32
+
 // Zoom In and Out Limits
 #define ZOOM_IN_LIMIT                           500
 #define ZOOM_OUT_LIMIT                          25
@@ -60,8 +67,19 @@
 #define PERSISTVALUE_SSTINFOXMLFILEPATHNAME     "SSTInfoXMLDataFilePathName"
 #define PERSISTVALUE_PROJECTFILEPATHNAME        "ProjectDataFilePathName"
 #define PERSISTVALUE_PYTHONEXPORTFILEPATHNAME   "PythonExportFilePathName"
+#define PERSISTVALUE_IMAGEEXPORTFILEPATHNAME    "ImageExportFilePathName"
 #define PERSISTVALUE_PREF_RETURNTOSELAFTERWIRE  "ReturnToSelectAfterWire"
 #define PERSISTVALUE_PREF_RETURNTOSELAFTERTEXT  "ReturnToSelectAfterText"
+#define PERSISTVALUE_PREF_CACHECOMPONENTS       "CacheComponentRendering"
+#define PERSISTVALUE_PREF_VIEWUPDATEMODE        "ViewUpdateMode"
+#define PERSISTVALUE_PREF_OPTIMIZEVIEWPAINTING  "OptimizeViewPainting"
+#define PERSISTVALUE_PREF_AUTOROUTEWIRES        "AutoRouteNewWires"
+#define PERSISTVALUE_PREF_UNDOMEMORYBUDGET      "UndoMemoryBudget"
+
+// Rendering Preference Defaults
+#define RENDER_DEFAULT_CACHECOMPONENTS          true
+#define RENDER_DEFAULT_VIEWUPDATEMODE           QGraphicsView::SmartViewportUpdate
+#define RENDER_DEFAULT_OPTIMIZEVIEWPAINTING     true
 
 // DRAG & DROP NAME
 #define DRAGDROP_COMPONENTNAME                  "SSTWORKBENCH_COMPONENT"
@@ -84,6 +102,9 @@
 #define COMPONENT_PROPERTY_COMMENT              "Comment"
 #define COMPONENT_PROPERTY_RANK                 "Rank"
 #define COMPONENT_PROPERTY_WEIGHT               "Weight"
+#define COMPONENT_PROPERTY_PARAMSET             "Parameter Set"
+#define COMPONENT_PROPERTY_VALUE_REQUIRED       "REQUIRED"
+#define PROPERTIES_WINDOW_MIXED_VALUE           "<Multiple Values>"
 #define COMPONENT_DISPLAY_PREFIX_UNCAT          "[UNCAT] "
 #define COMPONENT_DISPLAY_PREFIX_PROCESSOR      "[PROC] "
 #define COMPONENT_DISPLAY_PREFIX_MEMORY         "[MEM] "
@@ -93,6 +114,26 @@
 #define COMPONENT_DISPLAY_PREFIX_ERROR          "[ERROR] + "
 #define COMPONENT_DISPLAY_MOVING_PORTS          "** MOVING PORTS (ESC to exit) **"
 
+// Graphic Item Group (Sub-Circuit Instance) Settings
+#define GROUP_KEY_ELEMENTNAME                   "SubCircuit"
+#define GROUP_WIDTH                             COMPONENT_WIDTH
+#define GROUP_LEFT_X                            COMPONENT_LEFT_X
+#define GROUP_RIGHT_X                           COMPONENT_RIGHT_X
+#define GROUP_TOP_Y                             COMPONENT_TOP_Y
+#define GROUP_PORTYOFFSET                       COMPONENT_PORTYOFFSET
+#define GROUP_EXPANDED_MARGIN                   20
+#define GROUP_EXPANDED_MAX_PIXMAP_SIZE          2048
+#define GROUP_ZVALUE                            0.0
+#define GROUP_FILL_COLOR                        QColor(230, 230, 250)
+#define GROUP_BOUNDARYPORT_SEPERATOR            ":"
+#define GROUP_DISPLAY_PREFIX                    "[SUB] "
+#define GROUP_PROPERTY_USERNAME                 "User Name"
+#define GROUP_PROPERTY_DEFINITION               "Sub-Circuit"
+#define GROUP_PROPERTY_INDEX                    "Index"
+#define GROUP_PROPERTY_NUMCOMPONENTS            "Number Of Components"
+#define GROUP_PROPERTY_NUMLINKS                 "Number Of Internal Links"
+#define GROUP_PROPERTY_COMMENT                  "Comment"
+
 // Graphic Item Port Settings
 #define PORT_LINE_LENGTH                        20
 #define PORT_LINE_START_EDGE_OFFSET             1   // Distance from edge of component to start drawing line (a Point)
@@ -118,22 +159,27 @@
 #define PORT_PROPERTY_CONTROLPARAM              "Component Controlling Parameter"
 #define PORT_TYPE_STATIC                        "Static"
 #define PORT_TYPE_DYNAMIC                       "Dynamic"
+#define PORT_TYPE_BUS                           "Dynamic Bus"
 #define PORT_DISCONNECT_MOVE_OFFSET             25
+#define PORT_BUS_LINE_WIDTH                     7
+#define PORT_BUS_RANGE_FORMAT                   "[%1..%2]"      // Replaces the %d of a Bus Port Name
+#define PORT_BUS_AUTO_THRESHOLD                 64              // Dynamic Ports growing past this many Instances are shown as a Bus by default
 
 // Port Config Dialog Settings
 #define CONFIGPORTDLG_DLGTITLE                  "Set Component Dynamic Ports"
 #define CONFIGPORTDLG_COMPONENTTITLE            "Setup Dynamic Ports for Component:\n"
-#define CONFIGPORTDLG_MAX_NUM_DYNAMIC_PORTS     100
+#define CONFIGPORTDLG_MAX_NUM_DYNAMIC_PORTS     4096
 #define CONFIGPORTDLG_HEADER_INDEX              "Index"
 #define CONFIGPORTDLG_HEADER_DYN_PORT_NAME      "Dynamic Port Name"
 #define CONFIGPORTDLG_HEADER_SET_NUM_PORTS      "Set Number of Ports"
+#define CONFIGPORTDLG_HEADER_SHOW_AS_BUS        "Show as Bus"
 #define CONFIGPORTDLG_HEADER_0_WIDTH            50
 #define CONFIGPORTDLG_HEADER_1_WIDTH            200
 
 // Parameter Config Dialog Settings
 #define CONFIGPARAMDLG_DLGTITLE                 "Set Component Dynamic Parameter"
 #define CONFIGPARAMDLG_COMPONENTTITLE           "Setup Dynamic Parameter"
-#define CONFIGPARAMDLG_MAX_NUM_DYNAMIC_PARAMS   100
+#define CONFIGPARAMDLG_MAX_NUM_DYNAMIC_PARAMS   4096
 #define CONFIGPARAMDLG_HEADER_DYN_PARAM_NAME     "Dynamic Parameter Name"
 #define CONFIGPARAMDLG_HEADER_SET_NUM_PARAMS    "Set Number of Parameters"
 #define CONFIGPARAMDLG_HEADER_0_WIDTH           200
@@ -141,6 +187,19 @@
 // Manage Modules Dialog Settings
 #define MANAGEMODULESDLG_DLGTITLE               "Manage Component Modules"
 
+// Topology Generator Dialog Settings
+#define TOPOLOGYDLG_DLGTITLE                    "Generate Network Topology"
+#define TOPOLOGYDLG_MAX_SHAPE_PARAM             256
+#define TOPOLOGYDLG_MAX_ENDPOINTS_PER_ROUTER    64
+#define TOPOLOGYDLG_NO_ENDPOINT                 "<None>"
+#define TOPOLOGY_MAX_COMPONENTS                 20000
+#define TOPOLOGY_LAYOUT_SPACING                 60
+#define TOPOLOGY_TYPESTR_MESH                   "Mesh"
+#define TOPOLOGY_TYPESTR_TORUS                  "Torus"
+#define TOPOLOGY_TYPESTR_FATTREE                "Fat-Tree"
+#define TOPOLOGY_TYPESTR_DRAGONFLY              "Dragonfly"
+#define TOPOLOGY_TYPESTR_UNDEFINED              "ERROR - UNDEFINED"
+
 // Port Info Data Settings
 #define PORTINFO_UNCONFIGURED                   "UNCONFIGURED - "
 
@@ -153,6 +212,37 @@
 #define SSTINFO_COMPONENTTYPESTR_SSTCONFIG      "SST Configuration"
 #define SSTINFO_COMPONENTTYPESTR_UNDEFINED      "ERROR - UNDEFINED"
 
+// Scene Image Export & Printing Settings
+#define IMAGEEXPORT_DLGTITLE                    "Export Image"
+#define IMAGEEXPORT_PNGFILEEXTENSION            ".png"
+#define IMAGEEXPORT_PDFFILEEXTENSION            ".pdf"
+#define IMAGEEXPORT_SVGFILEEXTENSION            ".svg"
+#define IMAGEEXPORT_PNGFILTER                   "PNG Image (*.png)"
+#define IMAGEEXPORT_PDFFILTER                   "PDF Document (*.pdf)"
+#define IMAGEEXPORT_SVGFILTER                   "SVG Image (*.svg)"
+#define IMAGEEXPORT_MARGIN                      20              // Scene units around the exported items
+#define IMAGEEXPORT_DEFAULTSCALEPERCENT         200
+#define IMAGEEXPORT_MINSCALEPERCENT             10
+#define IMAGEEXPORT_MAXSCALEPERCENT             2000
+#define IMAGEEXPORT_TILESIZE                    1024            // Pixels, width of each rendered tile and max height of a strip
+#define IMAGEEXPORT_STRIPMEMORYBUDGET           (32 * 1024 * 1024)
+#define IMAGEEXPORT_PNGMAXDIMENSION             1000000
+#define IMAGEEXPORT_PDFMAXPAGEPOINTS            14400.0         // Largest page the PDF format allows (200 inches)
+#define IMAGEEXPORT_DEFLATEBUFFERSIZE           65536
+#define PRINT_POINTSPERINCH                     72.0            // Full size printing maps one Scene unit to one point
+
+// Overview Minimap Settings
+#define MINIMAP_DOCKTITLE                       "Overview"
+#define MINIMAP_DEFAULT_WIDTH                   240
+#define MINIMAP_DEFAULT_HEIGHT                  180
+#define MINIMAP_MINIMUM_WIDTH                   80
+#define MINIMAP_MINIMUM_HEIGHT                  60
+#define MINIMAP_UPDATE_INTERVAL                 250     // Milliseconds between Thumbnail re-renders while the Scene is being edited
+#define MINIMAP_MAX_DIRTY_REGIONS               32      // More changed parts than this are re-rendered as their bounding rect
+#define MINIMAP_BACKGROUND_COLOR                Qt::white
+#define MINIMAP_OUTSIDE_COLOR                   Qt::lightGray
+#define MINIMAP_VIEWPORT_COLOR                  Qt::blue
+
 // Graphic Item Text Settings
 #define TEXT_ZVALUE                             1000.0
 #define TEXT_EMPTYTEXTSTRING                    "Empty Text"
@@ -161,6 +251,13 @@
 #define WIRE_SELECTED_ZVALUE                    100.0
 #define WIRE_DESELECTED_ZVALUE                  -100.0
 #define WIRE_PEN_WIDTH                          5
+#define WIRE_BUS_PEN_WIDTH                      9
+#define WIRE_BUNDLE_PEN_WIDTH                   13      // Pen of a Bundle of Wires between the same two Components
+#define WIRE_BUNDLE_MIN_WIRES                   2       // Fewest Wires that are drawn as a Bundle
+#define WIRE_BUNDLE_COLLAPSE_DELAY              300     // mSec after the last hover / selection before a Bundle collapses
+#define WIRE_BUNDLE_BADGE_FONT_SIZE             8
+#define WIRE_BUNDLE_BADGE_MARGIN                3
+#define WIRE_BUNDLE_BADGE_COLOR                 Qt::white
 #define WIRE_HANDLE_RECT                        -6, -6, 12, 12
 #define WIRE_HANDLE_START_CONNECTED             Qt::green
 #define WIRE_HANDLE_END_CONNECTED               Qt::green
@@ -172,5 +269,18 @@
 #define WIRE_STYLE_DESELECTED                   Qt::SolidLine
 #define WIRE_PROPERTY_COMMENT                   "Comment"
 #define WIRE_PROPERTY_NUMBER                    "Index"
+#define WIRE_REROUTE_FRAME_INTERVAL             16      // mSec between processing the queued Wire Reroutes (~60 Frames/Sec)
+#define WIRE_REROUTE_RATE_PERIOD                1000    // mSec between updates of the Wire Reroutes per second metric
+#define WIRE_ROUTER_CLEARANCE                   10      // Distance Routed Wires keep from Components and Groups
+#define WIRE_ROUTER_SEARCH_MARGIN               150     // Distance past its End Points that a Route may detour
+#define WIRE_ROUTER_BEND_COST                   30      // Extra length a Route will take to save a bend
+#define WIRE_ROUTER_MAX_EXPANSIONS              50000   // Route search limit before falling back to a 3 Segment Wire
+#define WIRE_ROUTER_INDEX_CELL_SIZE             128     // Cell Size of the Router's Spatial Hash of Obstacles
+#define WIRE_ROUTER_DEFAULT_AUTOROUTE           true
+
+// Undo Stack
+#define UNDO_DEFAULT_MEMORY_BUDGET              (64 * 1024 * 1024)  // Bytes the Undo Commands may hold
+#define UNDO_ITEM_MEMORY_ESTIMATE               4096                // Bytes held by a Command for each Item it keeps out of the Scene
+#define UNDO_ITEMID_DATAKEY                     0                   // QGraphicsItem::data() Key of the Id the Undo Commands know an Item by
 
 #endif // GLOBALDEF_H
@@ -29,7 +29,7 @@ class GraphicItemBase
 {
 public:
     // Enumeration for Identifying the item type (NOTE: ITEMTYPE_END MUST ALWAYS BE LAST)
-    enum ItemType { ITEMTYPE_UNDEFINED, ITEMTYPE_COMPONENT, ITEMTYPE_PORT, ITEMTYPE_TEXT, ITEMTYPE_WIRE, ITEMTYPE_WIREHANDLE, ITEMTYPE_WIRELINESEGMENT, ITEMTYPE_END };
+    enum ItemType { ITEMTYPE_UNDEFINED, ITEMTYPE_COMPONENT, ITEMTYPE_PORT, ITEMTYPE_TEXT, ITEMTYPE_WIRE, ITEMTYPE_WIREHANDLE, ITEMTYPE_WIRELINESEGMENT, ITEMTYPE_GROUP, ITEMTYPE_END };
 
     // Constructor / Destructor
     GraphicItemBase(const ItemType itemType);
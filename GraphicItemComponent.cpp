@@ -81,10 +81,6 @@ GraphicItemComponent::GraphicItemComponent(int ComponentIndex, SSTInfoDataCompon
         m_PortInfoDataArray.append(NewPortInfoData);
     }
 
-    // Create the Graphical Object for the Component Display Name
-    m_ComponentGraphicDisplayName = new QGraphicsSimpleTextItem(this);
-    m_ComponentGraphicDisplayTypeName = new QGraphicsSimpleTextItem(this);
-
     // Create the Initial Visual layout of the Component
     CreateInitiaLVisualLayoutOfComponent();
 
@@ -106,6 +102,7 @@ GraphicItemComponent::GraphicItemComponent(int ComponentIndex, SSTInfoDataCompon
         GetItemProperties()->AddProperty(COMPONENT_PROPERTY_COMMENT, "", "Comment on this Component", ItemProperty::READWRITE, false);
         GetItemProperties()->AddProperty(COMPONENT_PROPERTY_RANK, "", "Rank of Component (int)", ItemProperty::READWRITE, false);
         GetItemProperties()->AddProperty(COMPONENT_PROPERTY_WEIGHT, "", "Weight of Component (float)", ItemProperty::READWRITE, false);
+        GetItemProperties()->AddProperty(COMPONENT_PROPERTY_PARAMSET, "", "Name of the Parameter Set used by the Component", ItemProperty::READWRITE, false);
     } else {
         GetItemProperties()->AddProperty(COMPONENT_PROPERTY_COMPNAME, m_ComponentName, "Component Name", ItemProperty::READONLY, false);
 //      GetItemProperties()->AddProperty(COMPONENT_PROPERTY_INDEX, QString("%1").arg(m_ComponentIndex), "Component Index", ItemProperty::READONLY, false);
@@ -174,10 +171,6 @@ GraphicItemComponent::GraphicItemComponent(QDataStream& DataStreamIn, QMenu* Ite
         m_PortInfoDataArray.append(NewPortInfoData);
     }
 
-    // Create the Graphical Object for the Component Display Name
-    m_ComponentGraphicDisplayName = new QGraphicsSimpleTextItem(this);
-    m_ComponentGraphicDisplayTypeName = new QGraphicsSimpleTextItem(this);
-
     // Create and Update the Visual Layout of the Component
     CreateInitiaLVisualLayoutOfComponent();
     UpdateVisualLayoutOfComponent();
@@ -199,6 +192,10 @@ GraphicItemComponent::~GraphicItemComponent()
     int            count;
     PortInfoData*  PortInfoData;
 
+    // Clean up the Graphical Ports (They are not child items, so Qt will not delete them)
+    qDeleteAll(m_GraphicalPortArray);
+    m_GraphicalPortArray.clear();
+
     count = m_PortInfoDataArray.count();
     // Clean up the allocated Port Info Array
     for (x = 0; x < count; x++) {
@@ -288,10 +285,8 @@ void GraphicItemComponent::UpdateVisualLayoutOfComponent()
     int                            RightPhysicalSidePortSequence = 1;
     int                            NumGraphicalDynPorts;
     QVector<int>                   PhysicalPortSideSequenceArray;
-    QString                        FinalComponentDisplayName;
-    QGraphicsRectItem*             ModuleRectItem;
-    QGraphicsSimpleTextItem*       ModuleTextItem;
-    int                            ModuleCount;
+    QFont                          ModuleFont;
+    QStaticText                    ModuleText;
     QFontMetrics                   FontMetric(QGuiApplication::font());
     int                            ComponentTextHeight = FontMetric.height();
     int                            ModuleRectOffset = 5;
@@ -365,7 +360,7 @@ void GraphicItemComponent::UpdateVisualLayoutOfComponent()
             GraphicalPort = m_GraphicalPortArray.at(x);
             PortAssignedSide = GraphicalPort->GetAssignedComponentSide();
             PortSideSequence = GraphicalPort->GetAssignedComponentSideSequence();
-            NumGraphicalDynPorts = GraphicalPort->GetParentPortInfoData()->GetNumCreatedInstances();
+            NumGraphicalDynPorts = GraphicalPort->GetParentPortInfoData()->GetNumGraphicalPorts();
 
             if (PortAssignedSide == PortInfoData::SIDE_LEFT) {
                 if (PortSideSequence == LeftCurrentSequenceCount) {
@@ -428,48 +423,43 @@ void GraphicItemComponent::UpdateVisualLayoutOfComponent()
 
     ///////////////////////////////////////////
     // FORTH - ADD THE MODULES LOADED UNDER THE COMPONENT
-    // Blow away any created Module Objects
-    ModuleCount = m_ComponentModuleRectList.count();
-    for (x = 0; x < ModuleCount; x++) {
-        delete m_ComponentModuleRectList.at(0);
-        delete m_ComponentModuleTextList.at(0);
-        m_ComponentModuleRectList.removeAt(0);
-        m_ComponentModuleTextList.removeAt(0);
-    }
+    // Blow away any previous Module Layout
+    m_ComponentModuleRectList.clear();
+    m_ComponentModuleTextList.clear();
+    m_ComponentModuleFontList.clear();
+    m_ComponentModuleTextPosList.clear();
 
     // Set Module Rect Height the same as the height of the default application font,
     // And set the Initial Module Rect Y Position
     ModuleRectHeight = ComponentTextHeight;
     ModuleRectYPos = m_ComponentSideHeight;
 
-    // Now add the QGraphicsRectItem's for each Module,
-    // and put the Module name (QGraphicsSimpleTextItem) inside each Rect
+    // Now add the Rect for each Module, and put the Module name inside each Rect
+    // (Both are drawn by the Component in paint())
     for (x = 0; x < m_ComponentModuleNames.size(); x++) {
-        // Create the rect item and add it ot the list
-        ModuleRectItem = new QGraphicsRectItem(COMPONENT_LEFT_X + ModuleRectOffset, ModuleRectYPos, ModuleRectWidth, ModuleRectHeight, this);
-        m_ComponentModuleRectList.append(ModuleRectItem);
-
-        // Create the Text Item
-        ModuleTextItem = new QGraphicsSimpleTextItem(m_ComponentModuleNames.at(x), this);
-        m_ComponentModuleTextList.append(ModuleTextItem);
+        // Add the Module Rect to the list
+        m_ComponentModuleRectList.append(QRectF(COMPONENT_LEFT_X + ModuleRectOffset, ModuleRectYPos, ModuleRectWidth, ModuleRectHeight));
 
         // Figure out the width and heigth of the text and make it
         // fit inside the Module Rect (with a little spacing)
-        ModuleTextWidth = QFontMetrics(ModuleTextItem->font()).width(m_ComponentModuleNames.at(x));
-        ModuleTextHeight = QFontMetrics(ModuleTextItem->font()).height();
-        while (ModuleTextWidth > ModuleRectWidth - ModuleTextSpacer) {
-            int   PointSize = ModuleTextItem->font().pointSize();
-            QFont font = ModuleTextItem->font();
-            font.setPointSize(PointSize - 1);
-            ModuleTextItem->setFont(font);
-            ModuleTextWidth = QFontMetrics(ModuleTextItem->font()).width(m_ComponentModuleNames.at(x));
-            ModuleTextHeight = QFontMetrics(ModuleTextItem->font()).height();
+        ModuleFont = QGuiApplication::font();
+        ModuleTextWidth = QFontMetrics(ModuleFont).width(m_ComponentModuleNames.at(x));
+        ModuleTextHeight = QFontMetrics(ModuleFont).height();
+        while ((ModuleTextWidth > ModuleRectWidth - ModuleTextSpacer) && (ModuleFont.pointSize() > 1)) {
+            ModuleFont.setPointSize(ModuleFont.pointSize() - 1);
+            ModuleTextWidth = QFontMetrics(ModuleFont).width(m_ComponentModuleNames.at(x));
+            ModuleTextHeight = QFontMetrics(ModuleFont).height();
         }
 
+        // Lay out the Module Name once for its final font
+        SetStaticLabelText(ModuleText, m_ComponentModuleNames.at(x), ModuleFont);
+        m_ComponentModuleTextList.append(ModuleText);
+        m_ComponentModuleFontList.append(ModuleFont);
+
         // Set the Position of the text (NOTE: Text Height will always be the same or
         // a bit smaller than the Module Rect Height (depending upon the text length)
         ModuleTextYPos = ModuleRectYPos + ((ModuleRectHeight - ModuleTextHeight) / 2);
-        ModuleTextItem->setPos(COMPONENT_LEFT_X + ModuleRectOffset + ModuleTextSpacer, ModuleTextYPos);
+        m_ComponentModuleTextPosList.append(QPointF(COMPONENT_LEFT_X + ModuleRectOffset + ModuleTextSpacer, ModuleTextYPos));
 
         // Increment the Y Position for the Next Rect
         ModuleRectYPos += ModuleRectHeight;
@@ -479,25 +469,15 @@ void GraphicItemComponent::UpdateVisualLayoutOfComponent()
     // FIFTH - SETUP THE COMPONENT NAME
     // Set the text and position of the component name
 
-    // Check to see if We need to modify the Component name for Moving Ports
+    // Check to see if We need to add the Moving Ports line under the Component name
     if (m_MovingPortsMode == true) {
-        m_ComponentGraphicDisplayName->setBrush(Qt::red);
-        FinalComponentDisplayName = m_ComponentDisplayName + "\n" + COMPONENT_DISPLAY_MOVING_PORTS;
         ComponentTextYPos = COMPONENT_TOP_Y - (ComponentTextHeight * 2);
-
     } else {
-        m_ComponentGraphicDisplayName->setBrush(Qt::black);
-        FinalComponentDisplayName = m_ComponentDisplayName;
         ComponentTextYPos = COMPONENT_TOP_Y - ComponentTextHeight;
     }
 
-    // Set the Component Name on top of the Component Box
-    m_ComponentGraphicDisplayName->setText(FinalComponentDisplayName);
-    m_ComponentGraphicDisplayName->setPos(COMPONENT_LEFT_X, ComponentTextYPos);
-
-    // Set the Component Name Inside (at Top Left) of the Component Box
-    m_ComponentGraphicDisplayTypeName->setText(m_ComponentDisplayTypeName);
-    m_ComponentGraphicDisplayTypeName->setPos(COMPONENT_LEFT_X + COMPONENT_TYPENAME_OFFSET, COMPONENT_TOP_Y);
+    // Set the Component Name on top of the Component Box, and the Type Name inside it
+    UpdateComponentLabels(m_MovingPortsMode, ComponentTextYPos);
 
     // SIXTH - SET SIDE AND POSITION OF EACH GRAPHICAL PORT (STATIC AND DYNAMIC)
     // Look at all the ports in the GraphicalPortArray. Put the port
@@ -530,6 +510,15 @@ void GraphicItemComponent::UpdateVisualLayoutOfComponent()
             m_GraphicalPortArrayRightSide.append(GraphicalPort);
         }
     }
+
+    ///////////////////////////////////////////
+    // SEVENTH - SET THE RENDER CACHE ON ANY NEW MODULE ITEMS AND
+    // THROW AWAY THE CACHED IMAGE OF THE OLD LAYOUT
+    ApplyRenderCacheMode();
+    UpdatePortsGeometry();
+
+    // The size of the Component may have changed
+    emit ItemComponentGeometryChanged(this);
 }
 
 void GraphicItemComponent::DisconnectPortsFromAllWires()
@@ -545,6 +534,169 @@ int GraphicItemComponent::GetNumGraphicalPortsOnComponent()
     return m_GraphicalPortArray.count();
 }
 
+PortInfoData* GraphicItemComponent::FindPortInfoData(QString SSTInfoPortName)
+{
+    // Look at all the PortInfoData on this component for the matching SSTInfo Port Name
+    for (int x = 0; x < m_PortInfoDataArray.count(); x++) {
+        if (m_PortInfoDataArray.at(x)->GetSSTInfoPortName() == SSTInfoPortName) {
+            return m_PortInfoDataArray.at(x);
+        }
+    }
+    return NULL;
+}
+
+void GraphicItemComponent::SetDynamicPortNumInstances(PortInfoData* PortInfo, int NumInstances)
+{
+    QString       NumInstancesStr;
+    QString       ControllingParam;
+    ItemProperty* Property;
+
+    // Set the new Number of Instances and rebuild the Graphical Ports
+    PortInfo->SetNumTotalInstances(NumInstances);
+    UpdateVisualLayoutOfComponent();
+
+    // Sync the change to the Controlling Parameter of the Port (if one exists)
+    NumInstancesStr = QString("%1").arg(PortInfo->GetNumCreatedInstances());
+    ControllingParam = PortInfo->GetDynamicPortContollingParameterName();
+    if (ControllingParam.isEmpty() == false) {
+        Property = GetItemProperties()->GetProperty(ControllingParam);
+        if (Property != NULL) {
+            Property->SetValue(NumInstancesStr, false);
+            emit ItemComponentRefreshPropertiesWindowProperty(ControllingParam, NumInstancesStr);
+        }
+    }
+}
+
+QList<int> GraphicItemComponent::GetPortLayout()
+{
+    QList<int> PortLayout;
+
+    foreach (PortInfoData* PortInfo, m_PortInfoDataArray) {
+        PortLayout.append((int)PortInfo->GetAssignedComponentSide());
+        PortLayout.append(PortInfo->GetAssignedComponentSideSequence());
+    }
+    return PortLayout;
+}
+
+void GraphicItemComponent::SetPortLayout(const QList<int>& PortLayout)
+{
+    PortInfoData* PortInfo;
+    int           x;
+
+    // Put each Port back on its Side and in its Sequence, then lay out the Component again
+    for (x = 0; (x < m_PortInfoDataArray.count()) && (((x * 2) + 1) < PortLayout.count()); x++) {
+        PortInfo = m_PortInfoDataArray.at(x);
+        PortInfo->SetAssignedComponentSide((PortInfoData::ComponentSide)PortLayout.at(x * 2));
+        PortInfo->SetAssignedComponentSideSequence(PortLayout.at((x * 2) + 1));
+    }
+    UpdateVisualLayoutOfComponent();
+
+    emit ItemComponentSetProjectDirty();
+}
+
+QList<int> GraphicItemComponent::GetDynamicPortsState()
+{
+    QList<int> PortsState;
+
+    foreach (PortInfoData* PortInfo, m_PortInfoDataArray) {
+        PortsState.append(PortInfo->GetNumTotalInstances());
+        PortsState.append((PortInfo->IsPortBus() == true) ? 1 : 0);
+    }
+    return PortsState;
+}
+
+void GraphicItemComponent::SetDynamicPortsState(const QList<int>& PortsState)
+{
+    PortInfoData* PortInfo;
+    QString       NumInstancesStr;
+    QString       ControllingParam;
+    ItemProperty* Property;
+    int           x;
+
+    // Set the Instances of each Port and rebuild the Graphical Ports
+    for (x = 0; (x < m_PortInfoDataArray.count()) && (((x * 2) + 1) < PortsState.count()); x++) {
+        PortInfo = m_PortInfoDataArray.at(x);
+        PortInfo->SetNumTotalInstances(PortsState.at(x * 2));
+        PortInfo->SetPortBus(PortsState.at((x * 2) + 1) != 0);
+    }
+    UpdateVisualLayoutOfComponent();
+
+    // Sync the changes to the Controlling Parameters of the Ports (if they exist)
+    foreach (PortInfo, m_PortInfoDataArray) {
+        NumInstancesStr = QString("%1").arg(PortInfo->GetNumCreatedInstances());
+        ControllingParam = PortInfo->GetDynamicPortContollingParameterName();
+        if (ControllingParam.isEmpty() == false) {
+            Property = GetItemProperties()->GetProperty(ControllingParam);
+            if (Property != NULL) {
+                Property->SetValue(NumInstancesStr, false);
+                emit ItemComponentRefreshPropertiesWindowProperty(ControllingParam, NumInstancesStr);
+            }
+        }
+    }
+
+    emit ItemComponentSetProjectDirty();
+}
+
+QList<GraphicItemComponent::PortWireConnection> GraphicItemComponent::GetPortWireConnections()
+{
+    QList<PortWireConnection> ConnectionList;
+    PortWireConnection        Connection;
+    PortInfoData*             PortInfo;
+    GraphicItemPort*          Port;
+    int                       x;
+    int                       y;
+
+    for (x = 0; x < m_PortInfoDataArray.count(); x++) {
+        PortInfo = m_PortInfoDataArray.at(x);
+        for (y = 0; y < PortInfo->GetNumGraphicalPorts(); y++) {
+            Port = PortInfo->GetGraphicalPort(y);
+            if (Port->IsPortConnectedToWire() == true) {
+                Connection.PortInfoIndex = x;
+                Connection.PortInstance = y;
+                Connection.Wire = Port->GetPortConnectedWire();
+                Connection.StartPoint = (Connection.Wire->GetStartPointConnectedPort() == Port);
+                ConnectionList.append(Connection);
+            }
+        }
+    }
+    return ConnectionList;
+}
+
+void GraphicItemComponent::RestorePortWireConnections(const QList<PortWireConnection>& ConnectionList)
+{
+    PortInfoData*    PortInfo;
+    GraphicItemPort* Port;
+    QPointF          WirePoint;
+
+    foreach (const PortWireConnection& Connection, ConnectionList) {
+        // The Port must exist again, and be free
+        PortInfo = m_PortInfoDataArray.value(Connection.PortInfoIndex, NULL);
+        if ((PortInfo == NULL) || (Connection.PortInstance >= PortInfo->GetNumGraphicalPorts())) {
+            continue;
+        }
+        Port = PortInfo->GetGraphicalPort(Connection.PortInstance);
+        if (Port->IsPortConnectedToWire() == true) {
+            continue;
+        }
+
+        // Put the Wire End back on the Port, the Wire connects to the Port under its End Point
+        WirePoint = Connection.Wire->mapFromScene(Port->GetConnectionScenePoint());
+        if (Connection.StartPoint == true) {
+            Connection.Wire->UpdateStartPointPosition(WirePoint);
+        } else {
+            Connection.Wire->UpdateEndPointPosition(WirePoint);
+        }
+    }
+}
+
+void GraphicItemComponent::MoveToPosition(const QPointF& NewPos)
+{
+    // The Move Delay only applies to mouse drags
+    m_MoveDelayDistance = 0;
+    setPos(NewPos);
+    m_MoveDelayDistance = MOUSEMOVE_DELAYPIXELS;
+}
+
 bool GraphicItemComponent::ComponentContainsDynamicPorts()
 {
     // Look at all the PortInfoData on this component, if any of
@@ -571,25 +723,30 @@ bool GraphicItemComponent::AreAnyComponentPortsConnectedToWires()
 
 void GraphicItemComponent::SetComponentFillColor(const QColor& color)
 {
-    // Set The Components fill color
+    // Set The Components fill color (setBrush() also invalidates any cached image)
     m_ComponentFillColor = color;
     setBrush(m_ComponentFillColor);
 }
 
+void GraphicItemComponent::SetRenderCacheMode(QGraphicsItem::CacheMode Mode)
+{
+    m_RenderCacheMode = Mode;
+    ApplyRenderCacheMode();
+}
 
-void GraphicItemComponent::SetMovingPortsMode(bool Flag)
+void GraphicItemComponent::ApplyRenderCacheMode()
 {
-    GraphicItemPort* Port;
-    int              x;
+    // Cache the Component (Its Labels, Modules and Ports are all drawn by the Component).
+    // Qt throws away the cached image whenever an item calls update(), which setBrush(),
+    // setRect(), a layout change and selection changes all do.
+    setCacheMode(m_RenderCacheMode);
+}
 
-    // Set the Port Moving Flag
-    m_MovingPortsMode = Flag;
 
-    // Go through all ports and set them moveable
-    for (x = 0; x < m_GraphicalPortArray.count(); x++) {
-        Port = m_GraphicalPortArray.at(x);
-        Port->setFlag(QGraphicsItem::ItemIsMovable, Flag);
-    }
+void GraphicItemComponent::SetMovingPortsMode(bool Flag)
+{
+    // Set the Port Moving Flag (The Ports are dragged by mouseMoveEvent())
+    m_MovingPortsMode = Flag;
 
     // Update the component
     UpdateVisualLayoutOfComponent();
@@ -602,9 +759,8 @@ void GraphicItemComponent::AddModuleParameter(QString ParamName, QString Default
     GetItemProperties()->AddProperty(ParamName, DefaultValue, Desc);
 }
 
-void GraphicItemComponent::HandleItemPortModedPosition(GraphicItemPort* Port)
+void GraphicItemComponent::MovePortToPosition(GraphicItemPort* Port, const QPointF& NewPortPos)
 {
-    QPointF                     NewPortPos;
     qreal                       UpdatedXPos;
     qreal                       UpdatedYPos;
     QPointF                     InitialPos;
@@ -617,7 +773,6 @@ void GraphicItemComponent::HandleItemPortModedPosition(GraphicItemPort* Port)
     if (m_MovingPortsMode == true) {
 
         // Get the New Port Position, and initial updated locations
-        NewPortPos = Port->pos();
         UpdatedXPos = NewPortPos.x();
         UpdatedYPos = NewPortPos.y();
         InitialPos = Port->GetInitialPoint();
@@ -682,7 +837,11 @@ void GraphicItemComponent::HandleItemPortModedPosition(GraphicItemPort* Port)
         } else {
             // Redraw the port at the new position, but dont update the inital point
             Port->SetPortPosition(UpdatedXPos, UpdatedYPos, false);
+            UpdatePortsGeometry();
+            emit ItemComponentGeometryChanged(this);
         }
+
+        emit ItemComponentSetProjectDirty();
     }
 }
 
@@ -819,12 +978,8 @@ void GraphicItemComponent::CreateInitiaLVisualLayoutOfComponent()
     SetComponentBoxDimensions(m_NumPortsLeftSide, m_NumPortsRightSide);
 
     // Set the text and position of the component name
-    m_ComponentGraphicDisplayName->setText(m_ComponentDisplayName);
     ComponentTextYPos = COMPONENT_TOP_Y - QFontMetrics(QGuiApplication::font()).height();
-    m_ComponentGraphicDisplayName->setPos(COMPONENT_LEFT_X, ComponentTextYPos);
-
-    m_ComponentGraphicDisplayTypeName->setText(m_ComponentDisplayTypeName);
-    m_ComponentGraphicDisplayTypeName->setPos(COMPONENT_LEFT_X + COMPONENT_TYPENAME_OFFSET, COMPONENT_TOP_Y);
+    UpdateComponentLabels(false, ComponentTextYPos);
 
     // Now Create the Graphical Ports, assign them to a side and set their position
     for (x = 0; x < m_PortInfoDataArray.count(); x++) {
@@ -854,14 +1009,12 @@ void GraphicItemComponent::CreateInitiaLVisualLayoutOfComponent()
         // Create the port and append it to the port array
         NewPort = new GraphicItemPort(PortInfo, this);
         NewPort->SetPortPosition(AssignedXPos, AssignedYOffset);
-        connect(NewPort, SIGNAL(ItemPortSetProjectDirty()), this, SIGNAL(ItemComponentSetProjectDirty()));
-        connect(NewPort, SIGNAL(ItemPortMovedPosition(GraphicItemPort*)), this, SLOT(HandleItemPortModedPosition(GraphicItemPort*)));
 
         // Add this port to components Graphical Port Array
         m_GraphicalPortArray.append(NewPort);
 
         // Set the Port Info Starting Graphical Port
-        PortInfo->SetStartingGraphicalPort(NewPort);
+        PortInfo->AddGraphicalPort(NewPort);
 
         // Add the new Port to the left or right side array, and also set its index
         if (PortAssignedSide == PortInfoData::SIDE_LEFT) {
@@ -870,6 +1023,8 @@ void GraphicItemComponent::CreateInitiaLVisualLayoutOfComponent()
             m_GraphicalPortArrayRightSide.append(NewPort);
         }
     }
+
+    UpdatePortsGeometry();
 }
 
 void GraphicItemComponent::SetComponentBoxDimensions(int NumPortsLeftSide, int NumPortsRightSide)
@@ -897,169 +1052,121 @@ void GraphicItemComponent::SetComponentBoxDimensions(int NumPortsLeftSide, int N
 void GraphicItemComponent::ReconfigureAllGraphicalPorts()
 {
     int                            x;
-    GraphicItemPort*               StartGraphicalPort = NULL;
-    GraphicItemPort*               CurrentGraphicalPort = NULL;
-    GraphicItemPort*               NextGraphicalPort = NULL;
-    GraphicItemPort*               NewGraphicalPort = NULL;
+    int                            y;
+    GraphicItemPort*               GraphicalPort = NULL;
     PortInfoData*                  PortInfo;
     int                            TotalDynPorts;
-    int                            CreatedDynPorts;
-    bool                           PortConfiguredFlag;
-    int                            CurrentPortCount;
-
-    // Clear the Graphical Port Arrays and Num Ports on a side
-    m_GraphicalPortArray.clear();
+    int                            NumGraphicalDynPorts;
+    int                            TotalGraphicalPorts = 0;
 
     // NOTE: TotalInstances, and CreatedInstances of a dynamic port = 0 when unconfigured, however
-    //       there will always be 1 Graphic Port (StartGraphicalPort) created to provide a visual
+    //       there will always be 1 Graphic Port (The Starting Graphical Port) created to provide a visual
     //       represendation of the Unconfigured Dynamic Port.  When TotalInstances is set = 1,
-    //       We just used the pre-created Graphic Port (StartGraphicalPort) and mark it as configured.
+    //       We just used the pre-created Graphic Port and mark it as configured.
     //       When TotalInstances is set > 1, we will add new Graphic Ports as necessary to the system.
-    //       Each Graphic Port has a pointer (linked list) to its later peer Graphic Port.  If the
-    //       pointer is NULL, this will be the last Graphic Port in the linked list.
+    //       Each PortInfoData holds its Graphic Ports in an array in Instance order, so Ports are
+    //       only created or destroyed at the end of the array (the cost is the change in size).
     //       Created Instances reflects the temporary difference between what is currently created
     //       Graphic Ports and What the desired Total number of ports need to be (TotalInstances).
 
+    // Size the GraphicalPortArray once for all the ports
+    for (x = 0; x < m_PortInfoDataArray.count(); x++) {
+        PortInfo = m_PortInfoDataArray.at(x);
+
+        if (PortInfo->IsPortBus() == true) {
+            TotalGraphicalPorts += 1;
+        } else if (PortInfo->IsPortDynamic() == true) {
+            TotalGraphicalPorts += qMax(PortInfo->GetNumTotalInstances(), 1);
+        } else {
+            TotalGraphicalPorts += PortInfo->GetNumGraphicalPorts();
+        }
+    }
+
+    // Clear the Graphical Port Arrays and Num Ports on a side
+    m_GraphicalPortArray.clear();
+    m_GraphicalPortArray.reserve(TotalGraphicalPorts);
+
     // Now go through the PortInfoData Array.  For static ports, add its
     // associated Graphical Port to the GraphicalPortArray.  For Dynamic
     // Ports, See if we need to add or remove any Graphical Ports, then add
     // all the Graphical Ports to the GraphicalPortArray
     for (x = 0; x < m_PortInfoDataArray.count(); x++) {
         PortInfo = m_PortInfoDataArray.at(x);
-        StartGraphicalPort = PortInfo->GetStartingGraphicalPort();
 
         // Is the Port Dynamic
         if (PortInfo->IsPortDynamic() == false) {
 
             // This is a Static Port, Just add the existing Graphical Port to the GraphicalPortArray
-            m_GraphicalPortArray.append(StartGraphicalPort);
+            m_GraphicalPortArray.append(PortInfo->GetStartingGraphicalPort());
 
         } else {
             // This is a Dynamic Port
 
-            // Setup usable variables for the Total and Created number of port instances
+            // There is always at least 1 Graphical Port (Unconfigured when TotalDynPorts = 0)
+            // A Bus Port is a single Graphical Port that stands for all of the Instances
             TotalDynPorts = PortInfo->GetNumTotalInstances();
-            CreatedDynPorts = PortInfo->GetNumCreatedInstances();
-
-            // Check to see if we need to Add Graphical Ports
-            if (TotalDynPorts > CreatedDynPorts) {
-                // User has Increased the number of Dynamic Ports required, We need to make more ports
-                // Check for special case of a Dynamic Port Total Size of 1;
-                // If Total = 1, we dont need to do anything as a visible graphic port already exists
-                if (TotalDynPorts > 1) {
-                    // Find the last Graphical Port in the linked list of Graphical Ports
-                    NextGraphicalPort = StartGraphicalPort;  // The Starting Port
-                    CurrentGraphicalPort = StartGraphicalPort;
-                    while (NextGraphicalPort != NULL) {
-                        // Save the Pointer as the current port
-                        CurrentGraphicalPort = NextGraphicalPort;
-                        // Get the next port
-                        NextGraphicalPort = CurrentGraphicalPort->GetNextPeerDynamicPort();
-                    }
-
-                    // NOTE: At this point we Know TotalDynPorts must be > 1, But if CreatedDynPorts = 0, we need to
-                    //       1 less port (it does not reflect the StartGraphicalPort)
-                    if (CreatedDynPorts == 0) {
-                        CreatedDynPorts++;
-                    }
-                    while (TotalDynPorts > CreatedDynPorts) {
-                        // Now Add Ports; Starting from the end one
-                        // Create the port and append it to the port array
-                        NewGraphicalPort = new GraphicItemPort(PortInfo, this);
-                        // Set its position to 0, 0, and to the same side as the Last Dynamic Port
-                        NewGraphicalPort->SetPortPosition(0, 0);
-                        connect(NewGraphicalPort, SIGNAL(ItemPortSetProjectDirty()), this, SIGNAL(ItemComponentSetProjectDirty()));
-                        connect(NewGraphicalPort, SIGNAL(ItemPortMovedPosition(GraphicItemPort*)), this, SLOT(HandleItemPortModedPosition(GraphicItemPort*)));
-
-                        // Add the new port as a the next peer
-                        CurrentGraphicalPort->SetNextPeerDynamicPort(NewGraphicalPort);
-                        // Set the Current Port to point to the New Port and increment the number of Created Ports
-                        CurrentGraphicalPort = NewGraphicalPort;
-                        CreatedDynPorts++;
-                    }
-                }
+            if (PortInfo->IsPortBus() == true) {
+                NumGraphicalDynPorts = 1;
+            } else {
+                NumGraphicalDynPorts = qMax(TotalDynPorts, 1);
             }
 
-            // Check to see if we need to Remove Graphical Ports
-            if (TotalDynPorts < CreatedDynPorts) {
-                // User has Decreased the number of Dynamic Ports required, We need to remove some created ports
-
-                // Check for special case of a Dynamic Port Created Size of 1;
-                // If Created = 1, we dont need to do anything as a visible graphic port already exists
-                if (CreatedDynPorts >= 1) {
-                    // Start the Count
-                    CurrentPortCount = 0; // The StartGraphicalPort is always present Start the Count at 0
-
-                    // Find the last Graphical Port that we want to keep
-                    NextGraphicalPort = StartGraphicalPort;  // The Starting Port
-                    CurrentGraphicalPort = StartGraphicalPort;
-                    while ((NextGraphicalPort != NULL) &&  (CurrentPortCount != TotalDynPorts)) {
-                        CurrentPortCount++;
-
-                        // Save the Pointer as the current port
-                        CurrentGraphicalPort = NextGraphicalPort;
-                        // Get the next port
-                        NextGraphicalPort = CurrentGraphicalPort->GetNextPeerDynamicPort();
-                    }
-
-                    // Special Case if TotalDynPorts = 0
-                    if (TotalDynPorts == 0) {
-                        NextGraphicalPort = CurrentGraphicalPort->GetNextPeerDynamicPort();
-                    }
-
-                    // CurrentGraphicalPort is were we want to stop the Linked List
-                    CurrentGraphicalPort->SetNextPeerDynamicPort(NULL);
-
-                    // Delete any remaining ports starting at NextGraphicalPort
-                    while ((NextGraphicalPort != NULL)) {
-                        // Save the Pointer as the current port
-                        CurrentGraphicalPort = NextGraphicalPort;
+            // User has Increased the number of Dynamic Ports required, We need to make more ports
+            while (PortInfo->GetNumGraphicalPorts() < NumGraphicalDynPorts) {
+                // Create the port; Set its position to 0, 0 (It is placed by the layout)
+                GraphicalPort = new GraphicItemPort(PortInfo, this);
+                GraphicalPort->SetPortPosition(0, 0);
+                PortInfo->AddGraphicalPort(GraphicalPort);
+            }
 
-                        // Get the next port
-                        NextGraphicalPort = CurrentGraphicalPort->GetNextPeerDynamicPort();
+            // User has Decreased the number of Dynamic Ports required, We need to remove some created ports
+            while (PortInfo->GetNumGraphicalPorts() > NumGraphicalDynPorts) {
+                GraphicalPort = PortInfo->TakeLastGraphicalPort();
 
-                        // Disconnect any wires from this Port and move them based upon the Port side
-                        if (CurrentGraphicalPort->GetAssignedComponentSide() == PortInfoData::SIDE_LEFT) {
-                            CurrentGraphicalPort->DisconnectPortFromWire(-PORT_DISCONNECT_MOVE_OFFSET);
-                        } else {
-                            CurrentGraphicalPort->DisconnectPortFromWire(PORT_DISCONNECT_MOVE_OFFSET);
-                        }
+                // Disconnect any wires from this Port and move them based upon the Port side
+                if (GraphicalPort->GetAssignedComponentSide() == PortInfoData::SIDE_LEFT) {
+                    GraphicalPort->DisconnectPortFromWire(-PORT_DISCONNECT_MOVE_OFFSET);
+                } else {
+                    GraphicalPort->DisconnectPortFromWire(PORT_DISCONNECT_MOVE_OFFSET);
+                }
 
-                        // Delete the Graphical Port pointed to by CurrentGraphicalPort
-                        delete CurrentGraphicalPort;
-                    }
+                // Forget the Port if the user was working with it
+                if (m_SelectedPort == GraphicalPort) {
+                    m_SelectedPort = NULL;
+                }
+                if (m_PressedPort == GraphicalPort) {
+                    m_PressedPort = NULL;
                 }
+
+                // Delete the Graphical Port
+                delete GraphicalPort;
             }
 
             // At this Point, we now have a number of created instances that match our total instances
             // Set the NumCreatedInstances = NumTotalInstances
-            PortInfo->SetNumCreatedInstances(PortInfo->GetNumTotalInstances());
+            PortInfo->SetNumCreatedInstances(TotalDynPorts);
 
             // If the TotalNumberOfInstances is >= 1, then we need to mark this PortInfoData as configured
-            PortConfiguredFlag = (TotalDynPorts >= 1);
-            PortInfo->SetPortConfigured(PortConfiguredFlag);
-
-            // Walk the linked list of Graphic Ports that are associated with this
-            // dynamic port and add them to the GraphicalPortArray
-            NextGraphicalPort = StartGraphicalPort;
-            CurrentPortCount = 0; // The StartGraphicalPort is always present Start the Count at 0
+            PortInfo->SetPortConfigured(TotalDynPorts >= 1);
 
-            while (NextGraphicalPort != NULL) {
-                // Add this Graphical Port to the GraphicalPortArray
-                m_GraphicalPortArray.append(NextGraphicalPort);
+            // Add the Graphic Ports that are associated with this dynamic port to the GraphicalPortArray
+            for (y = 0; y < PortInfo->GetNumGraphicalPorts(); y++) {
+                GraphicalPort = PortInfo->GetGraphicalPort(y);
+                m_GraphicalPortArray.append(GraphicalPort);
 
                 // See if the Port is configured
-                if (PortInfo->GetNumCreatedInstances() > 0) {
+                if (TotalDynPorts > 0) {
                     // Mark the Graphical Port as configured and update its Count
-                    NextGraphicalPort->SetPortConfigured(true, CurrentPortCount);
+                    GraphicalPort->SetPortConfigured(true, y);
                 } else {
                     // Mark the Graphical Port as NOT configured
-                    NextGraphicalPort->SetPortConfigured(false, 0);
+                    GraphicalPort->SetPortConfigured(false, 0);
                 }
 
-                // Get the next port
-                NextGraphicalPort = NextGraphicalPort->GetNextPeerDynamicPort();
-                CurrentPortCount++;
+                // The width of the Bus may have changed, restyle any connected Wire
+                if (GraphicalPort->GetPortConnectedWire() != NULL) {
+                    GraphicalPort->GetPortConnectedWire()->UpdateWireLinePens();
+                }
             }
         }
     }
@@ -1078,6 +1185,14 @@ void GraphicItemComponent::CommonInit()
 
     // Flag setting Moving ports move = off
     m_MovingPortsMode = false;
+    m_ShowMovingPortsLabel = false;
+
+    // No Port is selected or being dragged
+    m_SelectedPort = NULL;
+    m_PressedPort = NULL;
+
+    // No Render Caching until the Scene asks for it
+    m_RenderCacheMode = QGraphicsItem::NoCache;
 }
 
 void GraphicItemComponent::CommonSetup()
@@ -1085,16 +1200,123 @@ void GraphicItemComponent::CommonSetup()
     // Set Graphic parameters for the Component
     setFlag(QGraphicsItem::ItemIsMovable);
     setFlag(QGraphicsItem::ItemIsSelectable);
+    setFlag(QGraphicsItem::ItemIsFocusable);  // Used to know when a selected Port loses its selection
     setFlag(QGraphicsItem::ItemSendsGeometryChanges);
+    setFlag(QGraphicsItem::ItemSendsScenePositionChanges);
+}
+
+void GraphicItemComponent::UpdatePortsGeometry()
+{
+    // The Ports are drawn by the Component, so they are part of its bounding rect and shape
+    prepareGeometryChange();
+    m_PortsBoundingRect = GraphicItemPort::GetPortsBoundingRect(m_GraphicalPortArray);
+    m_PortsShape = GraphicItemPort::GetPortsShape(m_GraphicalPortArray);
+    update();
+}
+
+void GraphicItemComponent::UpdateComponentLabels(bool MovingPortsFlag, qreal DisplayNameYPos)
+{
+    QFont LabelFont = QGuiApplication::font();
+
+    // Only text that changed is laid out again
+    SetStaticLabelText(m_DisplayNameStaticText, m_ComponentDisplayName, LabelFont);
+    SetStaticLabelText(m_DisplayTypeNameStaticText, m_ComponentDisplayTypeName, LabelFont);
+    SetStaticLabelText(m_MovingPortsStaticText, COMPONENT_DISPLAY_MOVING_PORTS, LabelFont);
+    m_ShowMovingPortsLabel = MovingPortsFlag;
+
+    m_DisplayNamePos = QPointF(COMPONENT_LEFT_X, DisplayNameYPos);
+    m_DisplayTypeNamePos = QPointF(COMPONENT_LEFT_X + COMPONENT_TYPENAME_OFFSET, COMPONENT_TOP_Y);
+
+    // The Display Name sits above the Component Box, so it is part of the bounding rect and shape
+    prepareGeometryChange();
+    m_LabelsBoundingRect = QRectF(m_DisplayNamePos, m_DisplayNameStaticText.size());
+    m_LabelsBoundingRect |= QRectF(m_DisplayTypeNamePos, m_DisplayTypeNameStaticText.size());
+    if (m_ShowMovingPortsLabel == true) {
+        m_LabelsBoundingRect |= QRectF(m_DisplayNamePos + QPointF(0, m_DisplayNameStaticText.size().height()), m_MovingPortsStaticText.size());
+    }
+    update();
+}
+
+void GraphicItemComponent::SetStaticLabelText(QStaticText& Label, const QString& Text, const QFont& Font)
+{
+    // Lay out the text once; QStaticText lays itself out again only if
+    // it is drawn with a different font or view scale than it was prepared for
+    if (Label.text() != Text) {
+        Label.setTextFormat(Qt::PlainText);
+        Label.setText(Text);
+        Label.prepare(QTransform(), Font);
+    }
+}
+
+void GraphicItemComponent::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    GraphicItemPort* Port;
+
+    // See if the user clicked on one of the Ports
+    if (event->button() == Qt::LeftButton) {
+        Port = GraphicItemPort::GetPortAtPoint(m_GraphicalPortArray, event->pos());
+        if (Port != NULL) {
+            // Select just the Port (The Scene has already shown its properties)
+            scene()->clearSelection();
+            m_SelectedPort = Port;
+            m_PressedPort = Port;
+            m_PressedPortStartPoint = Port->GetConnectionPoint();
+            m_PressedPortLayout = GetPortLayout();
+            setFocus(Qt::MouseFocusReason);
+            update();
+
+            // Keep the Component from being selected or moved
+            event->accept();
+            return;
+        }
+    }
+
+    // Clicked on the Component itself
+    if (m_SelectedPort != NULL) {
+        m_SelectedPort = NULL;
+        update();
+    }
+    QGraphicsItem::mousePressEvent(event);
+}
+
+void GraphicItemComponent::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
+{
+    // Dragging a Port only moves it when in Moving Ports Mode
+    if (m_PressedPort != NULL) {
+        if (m_MovingPortsMode == true) {
+            MovePortToPosition(m_PressedPort, m_PressedPortStartPoint + (event->pos() - event->buttonDownPos(Qt::LeftButton)));
+        }
+        return;
+    }
+    QGraphicsItem::mouseMoveEvent(event);
 }
 
 void GraphicItemComponent::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
 {
     // Reset the Delay Distance
     m_MoveDelayDistance = MOUSEMOVE_DELAYPIXELS;
+
+    // Finished with any Port being dragged, let the Scene make a reorder undoable
+    if (m_PressedPort != NULL) {
+        m_PressedPort = NULL;
+        if ((m_MovingPortsMode == true) && (GetPortLayout() != m_PressedPortLayout)) {
+            emit ItemComponentPortsReordered(this, m_PressedPortLayout);
+        }
+        return;
+    }
     QGraphicsItem::mouseReleaseEvent(event);
 }
 
+void GraphicItemComponent::focusOutEvent(QFocusEvent* event)
+{
+    // The user clicked somewhere else, the Port is no longer selected
+    if (m_SelectedPort != NULL) {
+        m_SelectedPort = NULL;
+        update();
+    }
+    QGraphicsItem::focusOutEvent(event);
+}
+
 void GraphicItemComponent::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
 {
     // Set this as the only item selected
@@ -1138,16 +1360,44 @@ QVariant GraphicItemComponent::itemChange(GraphicsItemChange change, const QVari
         }
     }
 
+    // The Component moved on the scene, have any connected wires follow the Ports
+    if (change == ItemScenePositionHasChanged && scene()) {
+        for (int x = 0; x < m_GraphicalPortArray.count(); x++) {
+            m_GraphicalPortArray.at(x)->UpdateConnectedWirePosition();
+        }
+    }
+
     // If the position has moved, then mark the Project as dirty
     if (change == QGraphicsItem::ItemPositionHasChanged) {
         emit ItemComponentSetProjectDirty();
+        emit ItemComponentGeometryChanged(this);
     }
 
     return QGraphicsItem::itemChange(change, value);
 }
 
+QRectF GraphicItemComponent::boundingRect() const
+{
+    return QGraphicsRectItem::boundingRect() | m_PortsBoundingRect | m_LabelsBoundingRect;
+}
+
+QPainterPath GraphicItemComponent::shape() const
+{
+    QPainterPath Path = QGraphicsRectItem::shape();
+
+    // Add the Port Ellipses so the Ports can be clicked on and found by the scene
+    Path.setFillRule(Qt::WindingFill);
+    Path.addPath(m_PortsShape);
+
+    // Clicking on the Labels also selects the Component
+    Path.addRect(m_LabelsBoundingRect);
+    return Path;
+}
+
 void GraphicItemComponent::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget /*=0*/)
 {
+    int x;
+
     Q_UNUSED(option)
     Q_UNUSED(widget)
 
@@ -1163,6 +1413,29 @@ void GraphicItemComponent::paint(QPainter* painter, const QStyleOptionGraphicsIt
         HighlightSelected(painter, option);
     }
 
+    // Draw the Modules loaded under the Component
+    for (x = 0; x < m_ComponentModuleRectList.count(); x++) {
+        painter->setPen(QPen());
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRect(m_ComponentModuleRectList.at(x));
+        painter->setPen(Qt::black);
+        painter->setFont(m_ComponentModuleFontList.at(x));
+        painter->drawStaticText(m_ComponentModuleTextPosList.at(x), m_ComponentModuleTextList.at(x));
+    }
+
+    // Draw the Component Labels (The name turns red when Moving Ports)
+    painter->setFont(QGuiApplication::font());
+    painter->setPen((m_ShowMovingPortsLabel == true) ? Qt::red : Qt::black);
+    painter->drawStaticText(m_DisplayNamePos, m_DisplayNameStaticText);
+    if (m_ShowMovingPortsLabel == true) {
+        painter->drawStaticText(m_DisplayNamePos + QPointF(0, m_DisplayNameStaticText.size().height()), m_MovingPortsStaticText);
+    }
+    painter->setPen(Qt::black);
+    painter->drawStaticText(m_DisplayTypeNamePos, m_DisplayTypeNameStaticText);
+
+    // Draw all the Ports of the Component
+    GraphicItemPort::PaintPorts(painter, m_GraphicalPortArray, m_SelectedPort);
+
     // Uncomment the following to draw the Default selection outline when item is selected
     //QGraphicsRectItem::paint(painter, option, widget);
 }
@@ -1193,6 +1466,7 @@ void GraphicItemComponent::PropertyChanged(QString& PropName, QString& NewPropVa
     int           x;
     int           NumPortInfo;
     PortInfoData* PortInfo;
+    ItemProperty* Property;
     bool          UpdateLayout = false;
 
     // A Property Changed, see if it was the User Defined Name
@@ -1211,8 +1485,9 @@ void GraphicItemComponent::PropertyChanged(QString& PropName, QString& NewPropVa
     for (x = 0; x < NumPortInfo; x++) {
         PortInfo = m_PortInfoDataArray.at(x);
         if (PortInfo->GetDynamicPortContollingParameterName() == PropName) {
-            // This parameter controls the number of graphicPorts tied to this PortInfo
-            PortInfo->SetNumTotalInstances(NewPropValue.toInt());
+            // This parameter controls the number of graphicPorts tied to this PortInfo (Use its pre-parsed value)
+            Property = GetItemProperties()->GetProperty(PropName);
+            PortInfo->SetNumTotalInstances((Property != NULL) ? Property->GetIntValue() : NewPropValue.toInt());
             UpdateLayout = true;
         }
     }
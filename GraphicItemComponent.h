@@ -36,6 +36,16 @@ public:
     enum { Type = UserType + ITEMTYPE_COMPONENT };
     int type() const {return Type;}
 
+    // A Wire End connected to a Graphical Port.  The Port is kept as its PortInfoData and Instance,
+    // so the Wire can be connected again after the Dynamic Ports have been rebuilt
+    struct PortWireConnection
+    {
+        int              PortInfoIndex;
+        int              PortInstance;
+        GraphicItemWire* Wire;
+        bool             StartPoint;
+    };
+
     // Constructor / Destructor
     GraphicItemComponent(int ComponentIndex, SSTInfoDataComponent* SSTInfoComponent, QMenu* ItemMenu, QColor& ComponentFillColor, const QPointF& startPos, QGraphicsItem* parent = 0);
     GraphicItemComponent(QDataStream& DataStreamIn, QMenu* ItemMenu, QGraphicsItem* parent = 0);  // Only used for serialization
@@ -72,9 +82,25 @@ public:
     bool AreAnyComponentPortsConnectedToWires();
     QList<PortInfoData*>& GetPortInfoDataArray() {return m_PortInfoDataArray;}
     QList<GraphicItemPort*>& GetGraphicalPortArray() {return m_GraphicalPortArray;}
+    PortInfoData* FindPortInfoData(QString SSTInfoPortName);
+    void SetDynamicPortNumInstances(PortInfoData* PortInfo, int NumInstances);
+
+    // Compact state of the Ports for Undo / Redo (Two values for each PortInfoData)
+    QList<int> GetPortLayout();             // Assigned Side & Side Sequence
+    void SetPortLayout(const QList<int>& PortLayout);
+    QList<int> GetDynamicPortsState();      // Total Instances & Bus Flag
+    void SetDynamicPortsState(const QList<int>& PortsState);
+    QList<PortWireConnection> GetPortWireConnections();
+    void RestorePortWireConnections(const QList<PortWireConnection>& ConnectionList);
+
+    // Place the Component exactly (Used by Undo / Redo)
+    void MoveToPosition(const QPointF& NewPos);
 
     void SetComponentFillColor(const QColor& color);
 
+    // Rendering Cache of the Component Box, Names, Modules and Ports
+    void SetRenderCacheMode(QGraphicsItem::CacheMode Mode);
+
     bool GetMovingPortsMode() {return m_MovingPortsMode;}
     void SetMovingPortsMode(bool Flag);
 
@@ -83,20 +109,27 @@ public:
     void        SetModulesList(QStringList ModulesList) {m_ComponentModuleNames = ModulesList;}
     void        AddModuleParameter(QString ParamName, QString DefaultValue, QString Desc);
 
+    // Called by the Ports (which do not have signals) when one of their properties changes
+    void SetProjectDirty() {emit ItemComponentSetProjectDirty();}
+
 signals:
     void ItemComponentSetProjectDirty();
     void ItemComponentRefreshPropertiesWindowProperty(QString, QString);
     void ItemComponentRefreshPropertiesWindow(ItemProperties*);
-
-private slots:
-    void HandleItemPortModedPosition(GraphicItemPort* Port);
+    void ItemComponentGeometryChanged(GraphicItemComponent*);
+    void ItemComponentPortsReordered(GraphicItemComponent*, QList<int>);
 
 private:
+    void MovePortToPosition(GraphicItemPort* Port, const QPointF& NewPortPos);
     void ReorderPortSequence(GraphicItemPort* CurrentPort, PortInfoData::ComponentSide CurrentSide, bool SwapSides, int CurrentSeq, int NewSeq);
     void CreateComponentDisplayName();
     void CreateInitiaLVisualLayoutOfComponent();
     void SetComponentBoxDimensions(int NumPortsLeftSide, int NumPortsRightSide);
     void ReconfigureAllGraphicalPorts();
+    void ApplyRenderCacheMode();
+    void UpdatePortsGeometry();
+    void UpdateComponentLabels(bool MovingPortsFlag, qreal DisplayNameYPos);
+    static void SetStaticLabelText(QStaticText& Label, const QString& Text, const QFont& Font);
 
     // Initialization
     void CommonInit();
@@ -104,11 +137,16 @@ private:
 
 private:
     // Mouse Handling
+    void mousePressEvent(QGraphicsSceneMouseEvent* event);
+    void mouseMoveEvent(QGraphicsSceneMouseEvent* event);
     void mouseReleaseEvent(QGraphicsSceneMouseEvent* event);
     void contextMenuEvent(QGraphicsSceneContextMenuEvent* event);
+    void focusOutEvent(QFocusEvent* event);
 
     // Something Changed on the Component
     QVariant itemChange(GraphicsItemChange change, const QVariant &value);
+    QRectF boundingRect() const;
+    QPainterPath shape() const;
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = 0);
     void HighlightSelected(QPainter* painter, const QStyleOptionGraphicsItem* option);
 
@@ -136,13 +174,27 @@ private:
     QList<GraphicItemPort*>             m_GraphicalPortArray;           // Array of all Graphical Ports
     QList<GraphicItemPort*>             m_GraphicalPortArrayLeftSide;   // Array of Graphical Ports on the Left Side
     QList<GraphicItemPort*>             m_GraphicalPortArrayRightSide;  // Array of Graphical Ports on the Right Side
+    QRectF                              m_PortsBoundingRect;            // Cached area covered by all the Ports
+    QPainterPath                        m_PortsShape;                   // Cached clickable area of all the Ports
+    GraphicItemPort*                    m_SelectedPort;
+    GraphicItemPort*                    m_PressedPort;
+    QPointF                             m_PressedPortStartPoint;
+    QList<int>                          m_PressedPortLayout;
 
     QStringList                         m_ComponentModuleNames;             // String Array of Module Names loaded by this Component
-    QList<QGraphicsRectItem*>           m_ComponentModuleRectList;
-    QList<QGraphicsSimpleTextItem*>     m_ComponentModuleTextList;
-
-    QGraphicsSimpleTextItem*            m_ComponentGraphicDisplayName;
-    QGraphicsSimpleTextItem*            m_ComponentGraphicDisplayTypeName;
+    QList<QRectF>                       m_ComponentModuleRectList;
+    QList<QStaticText>                  m_ComponentModuleTextList;
+    QList<QFont>                        m_ComponentModuleFontList;
+    QList<QPointF>                      m_ComponentModuleTextPosList;
+
+    // Labels are drawn by the Component from cached text layouts
+    QStaticText                         m_DisplayNameStaticText;
+    QStaticText                         m_DisplayTypeNameStaticText;
+    QStaticText                         m_MovingPortsStaticText;
+    QPointF                             m_DisplayNamePos;
+    QPointF                             m_DisplayTypeNamePos;
+    bool                                m_ShowMovingPortsLabel;
+    QRectF                              m_LabelsBoundingRect;               // Cached area covered by the Labels
 
     QMenu*                              m_ItemMenu;
 
@@ -154,6 +206,7 @@ private:
     qreal                               m_MoveDelayDistance;
 
     bool                                m_MovingPortsMode;
+    QGraphicsItem::CacheMode            m_RenderCacheMode;
 };
 
 #endif // GRAPHICITEMCOMPONENT_H
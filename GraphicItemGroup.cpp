@@ -0,0 +1,542 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#include "GraphicItemGroup.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+GraphicItemGroup::GraphicItemGroup(int GroupIndex, SubCircuitDefinition* Definition, QMenu* ItemMenu, const QPointF& startPos, QGraphicsItem* parent /*=0*/)
+    : QObject(), QGraphicsRectItem(parent), GraphicItemBase(GraphicItemBase::ITEMTYPE_GROUP)
+{
+    int                     x;
+    SubCircuitBoundaryPort* BoundaryPort;
+    PortInfoData*           NewPortInfoData;
+    int                     LeftSideSequence = 1;
+    int                     RightSideSequence = 1;
+
+    CommonInit();
+
+    // Save Data Constructor
+    m_Definition = Definition;
+    m_GroupIndex = GroupIndex;
+    m_ItemMenu = ItemMenu;
+    m_InstanceName = MakeValidInstanceName(m_Definition->GetDefinitionName() + "_" + QString("%1").arg(m_GroupIndex));
+
+    // Create a Port Info Data object for each of the Boundary Ports of the Sub-Circuit
+    for (x = 0; x < m_Definition->GetNumBoundaryPorts(); x++) {
+        BoundaryPort = m_Definition->GetBoundaryPort(x);
+
+        // Boundary ports are always static ports named after the internal port they export
+        SSTInfoDataPort BoundarySSTInfoPort(BoundaryPort->GetBoundaryPortName());
+        BoundarySSTInfoPort.SetPortDesc(QString("Boundary Port of Sub-Circuit %1").arg(m_Definition->GetDefinitionName()));
+
+        NewPortInfoData = new PortInfoData(&BoundarySSTInfoPort, BoundaryPort->GetAssignedSide());
+        if (BoundaryPort->GetAssignedSide() == PortInfoData::SIDE_LEFT) {
+            NewPortInfoData->SetAssignedComponentSideSequence(LeftSideSequence++);
+        } else {
+            NewPortInfoData->SetAssignedComponentSideSequence(RightSideSequence++);
+        }
+
+        // Start with the latency the internal port had when the Sub-Circuit was captured
+        NewPortInfoData->SetPortLatencyValue(0, BoundaryPort->GetInternalPortLatency());
+        m_PortInfoDataArray.append(NewPortInfoData);
+    }
+
+    // Build the Visuals of the Group
+    CreateGroupDisplayName();
+    CreateBoundaryPorts();
+    UpdateVisualLayoutOfGroup();
+
+    // Set the Group's Starting Position and Z height
+    setPos(startPos);
+    setZValue(GROUP_ZVALUE);
+
+    // Now set the Properties for this Group
+    GetItemProperties()->AddProperty(GROUP_PROPERTY_USERNAME, m_InstanceName, "Instance Name (Prefix of all Components in the Sub-Circuit)", ItemProperty::READWRITE, false);
+    GetItemProperties()->AddProperty(GROUP_PROPERTY_DEFINITION, m_Definition->GetDefinitionName(), "Name of the Sub-Circuit", ItemProperty::READONLY, false);
+    GetItemProperties()->AddProperty(GROUP_PROPERTY_INDEX, QString("%1").arg(m_GroupIndex), "Sub-Circuit Instance Index", ItemProperty::READONLY, false);
+    GetItemProperties()->AddProperty(GROUP_PROPERTY_NUMCOMPONENTS, QString("%1").arg(m_Definition->GetNumInternalComponents()), "Number of Components inside the Sub-Circuit", ItemProperty::READONLY, false);
+    GetItemProperties()->AddProperty(GROUP_PROPERTY_NUMLINKS, QString("%1").arg(m_Definition->GetNumInternalWires()), "Number of Links inside the Sub-Circuit", ItemProperty::READONLY, false);
+    GetItemProperties()->AddProperty(GROUP_PROPERTY_COMMENT, "", "Comment on this Sub-Circuit Instance", ItemProperty::READWRITE, false);
+
+    // Perform Common Setup
+    CommonSetup();
+}
+
+GraphicItemGroup::GraphicItemGroup(QDataStream& DataStreamIn, SubCircuitDefinition* Definition, QMenu* ItemMenu, QGraphicsItem* parent /*=0*/)
+    : QObject(), QGraphicsRectItem(parent), GraphicItemBase(GraphicItemBase::ITEMTYPE_GROUP)
+{
+    int             x;
+    QPointF         NewPos;
+    qreal           NewZValue;
+    qint32          NumPorts;
+    PortInfoData*   NewPortInfoData = NULL;
+
+    // NOTE: The Definition Name has already been read from the stream by the
+    //       scene in order to find the Definition that is passed in.
+
+    CommonInit();
+
+    m_Definition = Definition;
+    m_ItemMenu = ItemMenu;
+
+    // Serialization: Load General GraphicItem Data
+    DataStreamIn >> NewPos;
+    DataStreamIn >> NewZValue;
+
+    // Load In the Easy Stuff
+    DataStreamIn >> m_GroupIndex;
+    DataStreamIn >> m_InstanceName;
+    DataStreamIn >> m_ExpandedFlag;
+
+    // Load the Boundary Port Information
+    DataStreamIn >> NumPorts;
+    for (x = 0; x < NumPorts; x++) {
+        NewPortInfoData = new PortInfoData(DataStreamIn);
+        m_PortInfoDataArray.append(NewPortInfoData);
+    }
+
+    // Build the Visuals of the Group
+    CreateGroupDisplayName();
+    CreateBoundaryPorts();
+    UpdateVisualLayoutOfGroup();
+
+    // Set all the position info
+    setPos(NewPos);
+    setZValue(NewZValue);
+
+    // Load the Group Properties
+    GetItemProperties()->LoadData(DataStreamIn);
+
+    // Perform Common Setup
+    CommonSetup();
+}
+
+GraphicItemGroup::~GraphicItemGroup()
+{
+    // Clean up the Graphical Ports (They are not child items, so Qt will not delete them)
+    qDeleteAll(m_GraphicalPortArray);
+    m_GraphicalPortArray.clear();
+
+    // Clean up the allocated Port Info Array
+    qDeleteAll(m_PortInfoDataArray);
+    m_PortInfoDataArray.clear();
+}
+
+void GraphicItemGroup::SetGroupIndex(int NewIndex)
+{
+    m_GroupIndex = NewIndex;
+
+    // Set the appropriate properties (Changing the User Name will reset the Display Name)
+    GetItemProperties()->SetPropertyValue(GROUP_PROPERTY_INDEX, QString("%1").arg(m_GroupIndex));
+    GetItemProperties()->SetPropertyValue(GROUP_PROPERTY_USERNAME, m_Definition->GetDefinitionName() + "_" + QString("%1").arg(m_GroupIndex));
+}
+
+void GraphicItemGroup::SaveData(QDataStream& DataStreamOut)
+{
+    int x;
+
+    // Serialization: Save the Definition Name (MUST BE FIRST)
+    DataStreamOut << m_Definition->GetDefinitionName();
+
+    // Serialization: Save General GraphicItem Data
+    DataStreamOut << pos();
+    DataStreamOut << zValue();
+
+    // Save off the Easy Stuff
+    DataStreamOut << (qint32)m_GroupIndex;
+    DataStreamOut << m_InstanceName;
+    DataStreamOut << m_ExpandedFlag;
+
+    // Save the number of ports and then save all the ports
+    DataStreamOut << (qint32)m_PortInfoDataArray.count();
+    for (x = 0; x < m_PortInfoDataArray.count(); x++) {
+        m_PortInfoDataArray[x]->SaveData(DataStreamOut);
+    }
+
+    // Save the Group Properties
+    GetItemProperties()->SaveData(DataStreamOut);
+}
+
+void GraphicItemGroup::SetGroupExpanded(bool ExpandedFlag)
+{
+    m_ExpandedFlag = ExpandedFlag;
+
+    // Resize the Group and move the Boundary Ports (Connected wires will follow the ports)
+    UpdateVisualLayoutOfGroup();
+
+    emit ItemGroupSetProjectDirty();
+}
+
+SubCircuitBoundaryPort* GraphicItemGroup::GetBoundaryPortForGraphicalPort(GraphicItemPort* Port)
+{
+    int Index;
+
+    // The Graphical Ports are in the same order as the Definition's Boundary Ports
+    Index = m_GraphicalPortArray.indexOf(Port);
+    if ((Index >= 0) && (Index < m_Definition->GetNumBoundaryPorts())) {
+        return m_Definition->GetBoundaryPort(Index);
+    }
+    return NULL;
+}
+
+void GraphicItemGroup::DisconnectPortsFromAllWires()
+{
+    // For each port, call its disconnect from wire
+    for (int x = 0; x < m_GraphicalPortArray.count(); x++) {
+        m_GraphicalPortArray.at(x)->DisconnectPortFromWire();
+    }
+}
+
+void GraphicItemGroup::CreateGroupDisplayName()
+{
+    m_GroupDisplayName = GROUP_DISPLAY_PREFIX + m_InstanceName + " (" + m_Definition->GetDefinitionName() + ")";
+}
+
+void GraphicItemGroup::CreateBoundaryPorts()
+{
+    int              x;
+    GraphicItemPort* NewPort;
+
+    // Create one Graphical Port for each Boundary Port
+    for (x = 0; x < m_PortInfoDataArray.count(); x++) {
+        NewPort = new GraphicItemPort(m_PortInfoDataArray.at(x), this);
+        m_PortInfoDataArray.at(x)->AddGraphicalPort(NewPort);
+        m_GraphicalPortArray.append(NewPort);
+    }
+
+    // Create the Graphical Object for the Group Display Name
+    m_GroupGraphicDisplayName = new QGraphicsSimpleTextItem(this);
+}
+
+void GraphicItemGroup::UpdateVisualLayoutOfGroup()
+{
+    int              x;
+    int              NumPortsLeftSide = 0;
+    int              NumPortsRightSide = 0;
+    qreal            GroupWidth;
+    qreal            GroupHeight;
+    qreal            LeftPortSpacing;
+    qreal            RightPortSpacing;
+    qreal            TextHeight;
+    QRectF           InternalsBoundingRect;
+    GraphicItemPort* Port;
+
+    // Figure out how many ports are on each side
+    for (x = 0; x < m_PortInfoDataArray.count(); x++) {
+        if (m_PortInfoDataArray.at(x)->GetAssignedComponentSide() == PortInfoData::SIDE_LEFT) {
+            NumPortsLeftSide++;
+        } else {
+            NumPortsRightSide++;
+        }
+    }
+
+    // Collapsed size is based upon the number of ports (same as a component)
+    GroupWidth = GROUP_WIDTH;
+    GroupHeight = (qMax(NumPortsLeftSide, NumPortsRightSide) + 1) * GROUP_PORTYOFFSET;
+
+    // When Expanded, the Group grows to hold the rendered internals
+    if (m_ExpandedFlag == true) {
+        InternalsBoundingRect = m_Definition->GetInternalsBoundingRect();
+        GroupWidth = qMax(GroupWidth, InternalsBoundingRect.width() + (2 * GROUP_EXPANDED_MARGIN));
+        GroupHeight = qMax(GroupHeight, InternalsBoundingRect.height() + (2 * GROUP_EXPANDED_MARGIN));
+
+        // Center the internals inside the Group
+        m_InternalsRect = QRectF(-(InternalsBoundingRect.width() / 2), GROUP_TOP_Y + ((GroupHeight - InternalsBoundingRect.height()) / 2),
+                                 InternalsBoundingRect.width(), InternalsBoundingRect.height());
+    }
+
+    // Set the Box of the Group
+    setRect(-(GroupWidth / 2), GROUP_TOP_Y, GroupWidth, GroupHeight);
+
+    // Set the Display Name on top of the Group Box
+    TextHeight = QFontMetrics(m_GroupGraphicDisplayName->font()).height();
+    m_GroupGraphicDisplayName->setText(m_GroupDisplayName);
+    m_GroupGraphicDisplayName->setPos(-(GroupWidth / 2), GROUP_TOP_Y - TextHeight);
+
+    // Spread the ports evenly along each side
+    LeftPortSpacing = GroupHeight / (NumPortsLeftSide + 1);
+    RightPortSpacing = GroupHeight / (NumPortsRightSide + 1);
+    for (x = 0; x < m_GraphicalPortArray.count(); x++) {
+        Port = m_GraphicalPortArray.at(x);
+        if (Port->GetAssignedComponentSide() == PortInfoData::SIDE_LEFT) {
+            Port->SetPortPosition(-(GroupWidth / 2), GROUP_TOP_Y + (LeftPortSpacing * Port->GetAssignedComponentSideSequence()));
+        } else {
+            Port->SetPortPosition(GroupWidth / 2, GROUP_TOP_Y + (RightPortSpacing * Port->GetAssignedComponentSideSequence()));
+        }
+    }
+
+    UpdatePortsGeometry();
+
+    // The size of the Group may have changed (Expanded / Collapsed)
+    emit ItemGroupGeometryChanged(this);
+}
+
+void GraphicItemGroup::UpdatePortsGeometry()
+{
+    // The Ports are drawn by the Group, so they are part of its bounding rect and shape
+    prepareGeometryChange();
+    m_PortsBoundingRect = GraphicItemPort::GetPortsBoundingRect(m_GraphicalPortArray);
+    m_PortsShape = GraphicItemPort::GetPortsShape(m_GraphicalPortArray);
+    update();
+}
+
+void GraphicItemGroup::CommonInit()
+{
+    // Clear the Port Information Arrays
+    m_PortInfoDataArray.clear();
+    m_GraphicalPortArray.clear();
+
+    m_ExpandedFlag = false;
+    m_GroupGraphicDisplayName = NULL;
+    m_SelectedPort = NULL;
+    m_PressedPort = NULL;
+
+    // Set the Initial Position Move Delay
+    m_MoveDelayDistance = MOUSEMOVE_DELAYPIXELS;
+}
+
+void GraphicItemGroup::CommonSetup()
+{
+    // Set The Groups fill color
+    setBrush(GROUP_FILL_COLOR);
+
+    // Set Graphic parameters for the Group
+    setFlag(QGraphicsItem::ItemIsMovable);
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setFlag(QGraphicsItem::ItemIsFocusable);  // Used to know when a selected Port loses its selection
+    setFlag(QGraphicsItem::ItemSendsGeometryChanges);
+    setFlag(QGraphicsItem::ItemSendsScenePositionChanges);
+}
+
+void GraphicItemGroup::MoveToPosition(const QPointF& NewPos)
+{
+    // The Move Delay only applies to mouse drags
+    m_MoveDelayDistance = 0;
+    setPos(NewPos);
+    m_MoveDelayDistance = MOUSEMOVE_DELAYPIXELS;
+}
+
+void GraphicItemGroup::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    GraphicItemPort* Port;
+
+    // See if the user clicked on one of the Boundary Ports (See GraphicItemComponent::mousePressEvent())
+    if (event->button() == Qt::LeftButton) {
+        Port = GraphicItemPort::GetPortAtPoint(m_GraphicalPortArray, event->pos());
+        if (Port != NULL) {
+            scene()->clearSelection();
+            m_SelectedPort = Port;
+            m_PressedPort = Port;
+            setFocus(Qt::MouseFocusReason);
+            update();
+            event->accept();
+            return;
+        }
+    }
+
+    // Clicked on the Group itself
+    if (m_SelectedPort != NULL) {
+        m_SelectedPort = NULL;
+        update();
+    }
+    QGraphicsItem::mousePressEvent(event);
+}
+
+void GraphicItemGroup::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
+{
+    // Boundary Ports cannot be dragged, and dragging one does not move the Group
+    if (m_PressedPort != NULL) {
+        return;
+    }
+    QGraphicsItem::mouseMoveEvent(event);
+}
+
+void GraphicItemGroup::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
+{
+    // Reset the Delay Distance
+    m_MoveDelayDistance = MOUSEMOVE_DELAYPIXELS;
+
+    // A click on a Port does not select the Group
+    if (m_PressedPort != NULL) {
+        m_PressedPort = NULL;
+        return;
+    }
+    QGraphicsItem::mouseReleaseEvent(event);
+}
+
+void GraphicItemGroup::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event)
+{
+    // Double Click toggles between the Expanded and Collapsed views
+    SetGroupExpanded(!m_ExpandedFlag);
+    QGraphicsItem::mouseDoubleClickEvent(event);
+}
+
+void GraphicItemGroup::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
+{
+    // Set this as the only item selected
+    scene()->clearSelection();
+    setSelected(true);
+
+    // Execute the Menu
+    m_ItemMenu->exec(event->screenPos());  // Blocking Call
+    QGraphicsItem::contextMenuEvent(event);
+
+    // See GraphicItemComponent::contextMenuEvent() for why we ungrab the mouse
+    ungrabMouse();
+}
+
+void GraphicItemGroup::focusOutEvent(QFocusEvent* event)
+{
+    // The user clicked somewhere else, the Port is no longer selected
+    if (m_SelectedPort != NULL) {
+        m_SelectedPort = NULL;
+        update();
+    }
+    QGraphicsItem::focusOutEvent(event);
+}
+
+QVariant GraphicItemGroup::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+    QPointF NewPos;
+    QPointF OldPos;
+
+    // Check to see if the Item has moved enough
+    if (change == QGraphicsItem::ItemPositionChange) {
+        NewPos = value.toPointF();
+        OldPos = pos();
+        if ((OldPos - NewPos).manhattanLength() < m_MoveDelayDistance) {
+            // The mouse has not moved enough, keep the old position
+            return QVariant(OldPos);
+        } else {
+            // Clear the delay distance until the mouse is released
+            m_MoveDelayDistance = 0;
+        }
+    }
+
+    // The Group moved on the scene, have any connected wires follow the Boundary Ports
+    if (change == ItemScenePositionHasChanged && scene()) {
+        for (int x = 0; x < m_GraphicalPortArray.count(); x++) {
+            m_GraphicalPortArray.at(x)->UpdateConnectedWirePosition();
+        }
+    }
+
+    // If the position has moved, then mark the Project as dirty
+    if (change == QGraphicsItem::ItemPositionHasChanged) {
+        emit ItemGroupSetProjectDirty();
+        emit ItemGroupGeometryChanged(this);
+    }
+
+    return QGraphicsItem::itemChange(change, value);
+}
+
+QRectF GraphicItemGroup::boundingRect() const
+{
+    return QGraphicsRectItem::boundingRect() | m_PortsBoundingRect;
+}
+
+QPainterPath GraphicItemGroup::shape() const
+{
+    QPainterPath Path = QGraphicsRectItem::shape();
+
+    // Add the Port Ellipses so the Ports can be clicked on and found by the scene
+    Path.setFillRule(Qt::WindingFill);
+    Path.addPath(m_PortsShape);
+    return Path;
+}
+
+void GraphicItemGroup::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget /*=0*/)
+{
+    Q_UNUSED(option)
+    Q_UNUSED(widget)
+
+    // Draw the Group Box (Double line to distinguish it from a Component)
+    painter->setPen(QPen(Qt::black, 0, Qt::SolidLine));
+    painter->setBrush(brush());
+    painter->drawRect(rect());
+    painter->drawRect(rect().adjusted(3, 3, -3, -3));
+
+    // When Expanded, draw the internals of the Sub-Circuit
+    if (m_ExpandedFlag == true) {
+        m_Definition->RenderInternals(painter, m_InternalsRect);
+    }
+
+    if (isSelected() == true) {
+        painter->setPen(QPen(Qt::black, 2, Qt::DashLine));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRect(rect());
+    }
+
+    // Draw all the Boundary Ports of the Group
+    GraphicItemPort::PaintPorts(painter, m_GraphicalPortArray, m_SelectedPort);
+}
+
+QString GraphicItemGroup::MakeValidInstanceName(QString Name)
+{
+    // Anything that is not a letter, digit or underscore becomes an underscore
+    Name = Name.trimmed();
+    Name.replace(QRegExp("[^A-Za-z0-9_]"), "_");
+
+    // Identifiers cannot start with a digit
+    if ((Name.isEmpty() == false) && (Name.at(0).isDigit() == true)) {
+        Name.prepend('_');
+    }
+    return Name;
+}
+
+bool GraphicItemGroup::IsInstanceNameUsed(QString Name)
+{
+    GraphicItemGroup* Group;
+
+    if (scene() == NULL) {
+        return false;
+    }
+
+    foreach (QGraphicsItem* Item, scene()->items()) {
+        Group = qgraphicsitem_cast<GraphicItemGroup*>(Item);
+        if ((Group != NULL) && (Group != this) && (Group->GetInstanceName() == Name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GraphicItemGroup::PropertyChanged(QString& PropName, QString& NewPropValue)
+{
+    QString NewInstanceName;
+
+    // A Property Changed, see if it was the User Defined Name
+    if (PropName == GROUP_PROPERTY_USERNAME) {
+        // Empty or Duplicate Names are rejected (The old Name is put back)
+        NewInstanceName = MakeValidInstanceName(NewPropValue);
+        if ((NewInstanceName.isEmpty() == true) || (IsInstanceNameUsed(NewInstanceName) == true)) {
+            NewInstanceName = m_InstanceName;
+        }
+        if (NewInstanceName != NewPropValue) {
+            GetItemProperties()->GetProperty(GROUP_PROPERTY_USERNAME)->SetValue(NewInstanceName, false);
+            emit ItemGroupRefreshPropertiesWindowProperty(PropName, NewInstanceName);
+        }
+        m_InstanceName = NewInstanceName;
+
+        CreateGroupDisplayName();
+        UpdateVisualLayoutOfGroup();
+    }
+
+    // Set the project dirty
+    emit ItemGroupSetProjectDirty();
+}
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GRAPHICITEMGROUP_H
+#define GRAPHICITEMGROUP_H
+
+#include "GlobalIncludes.h"
+
+#include "GraphicItemBase.h"
+#include "GraphicItemPort.h"
+#include "PortInfoData.h"
+#include "SubCircuitDefinition.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// A GraphicItemGroup is a single instance of a Sub-Circuit.  It is drawn as
+// one box with the Sub-Circuit's Boundary Ports; the internal Components and
+// Wires are held (once) by the SubCircuitDefinition and are never added to
+// the main scene.
+///////////////////////////////////////////////////////////////////////////////
+
+class GraphicItemGroup : public QObject, public QGraphicsRectItem, public GraphicItemBase
+{
+    Q_OBJECT
+
+public:
+    // Required Virtual function for any QGraphicItem to provide a type value for the qgraphicsitem_cast function
+    enum { Type = UserType + ITEMTYPE_GROUP };
+    int type() const {return Type;}
+
+    // Constructor / Destructor
+    GraphicItemGroup(int GroupIndex, SubCircuitDefinition* Definition, QMenu* ItemMenu, const QPointF& startPos, QGraphicsItem* parent = 0);
+    GraphicItemGroup(QDataStream& DataStreamIn, SubCircuitDefinition* Definition, QMenu* ItemMenu, QGraphicsItem* parent = 0);  // Only used for serialization
+    virtual ~GraphicItemGroup();
+
+    // Control of Group Index
+    int  GetGroupIndex() {return m_GroupIndex;}
+    void SetGroupIndex(int NewIndex);
+
+    // Serialization
+    // NOTE: The Definition Name is always the first item saved so that
+    //       the scene can find the definition before creating the Group
+    void SaveData(QDataStream& DataStreamOut);
+
+    // Info on the Group
+    SubCircuitDefinition* GetSubCircuitDefinition() {return m_Definition;}
+    QString GetInstanceName() {return m_InstanceName;}
+
+    // Instance Names prefix the Python names of the internal Components, so they
+    // are kept as identifiers and must be unique in the Scene
+    static QString MakeValidInstanceName(QString Name);
+    bool IsInstanceNameUsed(QString Name);
+    QString GetGroupDisplayName() {return m_GroupDisplayName;}
+
+    // Expand / Collapse the view of the internals
+    bool IsGroupExpanded() {return m_ExpandedFlag;}
+    void SetGroupExpanded(bool ExpandedFlag);
+
+    // Info on Boundary Ports
+    int GetNumGraphicalPortsOnGroup() {return m_GraphicalPortArray.count();}
+    QList<GraphicItemPort*>& GetGraphicalPortArray() {return m_GraphicalPortArray;}
+    SubCircuitBoundaryPort* GetBoundaryPortForGraphicalPort(GraphicItemPort* Port);
+
+    // Disconnect wires from any connected ports
+    void DisconnectPortsFromAllWires();
+
+    // Place the Group exactly (Used by Undo / Redo)
+    void MoveToPosition(const QPointF& NewPos);
+
+    // Called by the Ports (which do not have signals) when one of their properties changes
+    void SetProjectDirty() {emit ItemGroupSetProjectDirty();}
+
+signals:
+    void ItemGroupSetProjectDirty();
+    void ItemGroupRefreshPropertiesWindowProperty(QString, QString);
+    void ItemGroupGeometryChanged(GraphicItemGroup*);
+
+private:
+    void CreateGroupDisplayName();
+    void CreateBoundaryPorts();
+    void UpdateVisualLayoutOfGroup();
+    void UpdatePortsGeometry();
+
+    // Initialization
+    void CommonInit();
+    void CommonSetup();
+
+private:
+    // Mouse Handling
+    void mousePressEvent(QGraphicsSceneMouseEvent* event);
+    void mouseMoveEvent(QGraphicsSceneMouseEvent* event);
+    void mouseReleaseEvent(QGraphicsSceneMouseEvent* event);
+    void mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event);
+    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event);
+    void focusOutEvent(QFocusEvent* event);
+
+    // Something Changed on the Group
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value);
+    QRectF boundingRect() const;
+    QPainterPath shape() const;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = 0);
+
+    // Handle a property change
+    void PropertyChanged(QString& PropName, QString& NewPropValue);
+
+private:
+    SubCircuitDefinition*       m_Definition;
+    int                         m_GroupIndex;
+    QString                     m_InstanceName;
+    QString                     m_GroupDisplayName;
+    bool                        m_ExpandedFlag;
+
+    QList<PortInfoData*>        m_PortInfoDataArray;   // One per Boundary Port (Holds the Latency and Comment for this instance)
+    QList<GraphicItemPort*>     m_GraphicalPortArray;  // Graphical Boundary Ports (Same order as the Definition Boundary Ports)
+    QRectF                      m_PortsBoundingRect;   // Cached area covered by all the Ports
+    QPainterPath                m_PortsShape;          // Cached clickable area of all the Ports
+    GraphicItemPort*            m_SelectedPort;
+    GraphicItemPort*            m_PressedPort;
+
+    QGraphicsSimpleTextItem*    m_GroupGraphicDisplayName;
+    QRectF                      m_InternalsRect;       // Area the internals are drawn into when expanded
+
+    QMenu*                      m_ItemMenu;
+    qreal                       m_MoveDelayDistance;
+};
+
+#endif // GRAPHICITEMGROUP_H
@@ -16,12 +16,18 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "GraphicItemPort.h"
+#include "GraphicItemComponent.h"
+#include "GraphicItemGroup.h"
+#include "WiringScene.h"
 
 ////////////////////////////////////////////////////////////
 
-GraphicItemPort::GraphicItemPort(PortInfoData* ParentPortInfo, QGraphicsItem* parent /*=0*/)
-    : QObject(), QGraphicsEllipseItem(parent), GraphicItemBase(GraphicItemBase::ITEMTYPE_PORT)
+GraphicItemPort::GraphicItemPort(PortInfoData* ParentPortInfo, QGraphicsItem* OwnerItem)
+    : GraphicItemBase(GraphicItemBase::ITEMTYPE_PORT)
 {
+    // Save off the Owner (The Component or Group that draws this port)
+    m_OwnerItem = OwnerItem;
+
     // Save off the SSTInfoPort Information
     m_ParentPortInfo = ParentPortInfo;
     m_PortName = ParentPortInfo->GetSSTInfoPortName();
@@ -33,9 +39,6 @@ GraphicItemPort::GraphicItemPort(PortInfoData* ParentPortInfo, QGraphicsItem* pa
     m_SSTInfoPortName = m_PortName;
     m_ConfiguredPortName = m_PortName;
 
-    // Init the Dynamic Port data
-    m_NextPeerDynamicPort = NULL;
-
     // Initial Port Color
     m_PortColor = PORT_COLOR_DISCONNECTED;
 
@@ -53,34 +56,6 @@ GraphicItemPort::GraphicItemPort(PortInfoData* ParentPortInfo, QGraphicsItem* pa
     // Set the initial size of the Ellipse for the port circle
     m_PortSizeRect = QRectF(PORT_ELLIPSE_SIZE);
 
-    // Create the pen for the port line
-    m_PortLinePen = QPen(PORT_LINE_COLOR, PORT_LINE_WIDTH);
-
-    // Now create the port Line
-    m_PortLine = new QGraphicsLineItem(this);
-    m_PortLine->setPen(m_PortLinePen);
-    m_PortLine->setFlag(QGraphicsItem::ItemStacksBehindParent);  // Draw Line behind Ellipse
-
-    // Build the Unconfigured Marker display
-    m_UnconfiguredPortMarker = new QGraphicsRectItem(this);
-    m_UnconfiguredPortMarker->setRect(PORT_UNCONFIG_MARKER_SIZE);
-    m_UnconfiguredPortMarker->setBrush(PORT_UNCONFIG_MARKER_COLOR);
-    m_UnconfiguredPortMarker->setRotation(PORT_UNCONFIG_MARKER_ROTATION);
-
-    // Set the Font for Port Name Text
-    m_PortNameFont = QApplication::font();            // Get the default application font
-    m_PortNameFont.setPointSize(PORT_NAME_FONT_SIZE);
-
-    // Build the Text for the port
-    m_PortNameText = new QGraphicsSimpleTextItem(this);
-    m_PortNameText->setText(m_ConfiguredPortName);
-    m_PortNameText->setFont(m_PortNameFont);
-
-    // Set Graphic parameters
-    setFlag(QGraphicsItem::ItemIsSelectable);
-    setFlag(QGraphicsItem::ItemSendsGeometryChanges);
-    setFlag(QGraphicsItem::ItemSendsScenePositionChanges);
-
     // Now set the Properties for this Port
     GetItemProperties()->AddProperty(PORT_PROPERTY_CONFIGURED_NAME, m_ConfiguredPortName, "Port Name", ItemProperty::READONLY, false);
     if (ParentPortInfo->IsPortDynamic() == true) {
@@ -128,6 +103,8 @@ void GraphicItemPort::SaveData(QDataStream& DataStreamOut)
 
 void GraphicItemPort::SetPortPosition(qreal CompEdge_x, qreal CompEdge_y, bool UpdateInitialPoint/*=true*/)
 {
+    QPointF OldConnectionPoint = m_ConnectionPoint;
+
     // Save off the start point in the parents coordinate system
     m_StartPoint = QPointF(CompEdge_x, CompEdge_y);
 
@@ -149,6 +126,11 @@ void GraphicItemPort::SetPortPosition(qreal CompEdge_x, qreal CompEdge_y, bool U
     }
 
     UpdatePortPosition();
+
+    // If the Port moved on its Owner, any connected wire must follow it
+    if (m_ConnectionPoint != OldConnectionPoint) {
+        UpdateConnectedWirePosition();
+    }
 }
 
 PortInfoData::ComponentSide GraphicItemPort::GetAssignedComponentSide()
@@ -174,32 +156,72 @@ void GraphicItemPort::SetPortConfigured(bool ConfiguredFlag, int DynamicSequence
         m_PortDynamicSequenceID = 0;
 
         m_ConfiguredPortName = PORT_UNCONFIGURED_STRING + m_PortName;
-
-        // Set the Visual Text that Displays with the Port to always display the Configured Port Name
-        m_PortNameText->setText(m_ConfiguredPortName);
     } else {
         // Set the Port as configured (DYNAMIC AND STATIC PORTS)
         m_PortIsConfigured = true;
         m_PortDynamicSequenceID = DynamicSequenceID;
 
         // Now build the Configured Port Name by replacing the %d (if found) with the DynamicSequenceID
+        // (or the range of Instances for a Bus Port)
         m_ConfiguredPortName = m_PortName;
-        m_ConfiguredPortName.replace("%d", QString("%1").arg(DynamicSequenceID));
+        if (IsPortBus() == true) {
+            m_ConfiguredPortName.replace("%d", QString(PORT_BUS_RANGE_FORMAT).arg(DynamicSequenceID).arg(DynamicSequenceID + GetPortWidth() - 1));
+        } else {
+            m_ConfiguredPortName.replace("%d", QString("%1").arg(DynamicSequenceID));
+        }
+    }
 
-        // Set the visual text
-        m_PortNameText->setText(m_ConfiguredPortName);
+    // Show if a Dynamic Port is drawn as a Bus
+    if (m_PortIsDynamic == true) {
+        GetItemProperties()->GetProperty(PROPKEY_PORT_PORTTYPE)->SetValue(IsPortBus() ? PORT_TYPE_BUS : PORT_TYPE_DYNAMIC, false);
     }
 
+    // The Visual Text that Displays with the Port always displays the Configured Port Name
+    UpdatePortPosition();
+
     // Change the Configured Port Name Property
-    GetItemProperties()->GetProperty(PORT_PROPERTY_CONFIGURED_NAME)->SetValue(m_ConfiguredPortName);
+    GetItemProperties()->GetProperty(PROPKEY_PORT_CONFIGURED_NAME)->SetValue(m_ConfiguredPortName);
 
     // Set the Comment from the Parent
     ParentComment = m_ParentPortInfo->GetPortComment(DynamicSequenceID);
-    GetItemProperties()->GetProperty(PORT_PROPERTY_COMMENT)->SetValue(ParentComment, false);
+    GetItemProperties()->GetProperty(PROPKEY_PORT_COMMENT)->SetValue(ParentComment, false);
 
     // Set the Latency Value from the Parent
     ParentLatencyValue = m_ParentPortInfo->GetPortLatencyValue(DynamicSequenceID);
-    GetItemProperties()->GetProperty(PORT_PROPERTY_LATENCY)->SetValue(ParentLatencyValue, false);
+    GetItemProperties()->GetProperty(PROPKEY_PORT_LATENCY)->SetValue(ParentLatencyValue, false);
+}
+
+int GraphicItemPort::GetPortWidth()
+{
+    // A Configured Bus Port carries all the Instances of the Dynamic Port
+    if ((IsPortBus() == true) && (m_PortIsConfigured == true)) {
+        return qMax(m_ParentPortInfo->GetNumTotalInstances(), 1);
+    }
+    return 1;
+}
+
+QString GraphicItemPort::GetInstancePortName(int Instance)
+{
+    QString InstanceName;
+
+    // Static Ports only have the one name
+    if (m_PortIsDynamic == false) {
+        return m_ConfiguredPortName;
+    }
+
+    // Instance is relative to the first Instance this Port stands for
+    InstanceName = m_PortName;
+    InstanceName.replace("%d", QString("%1").arg(m_PortDynamicSequenceID + Instance));
+    return InstanceName;
+}
+
+QString GraphicItemPort::GetInstancePortLatency(int Instance)
+{
+    // The first Instance uses the Port's Latency Property
+    if (Instance == 0) {
+        return GetItemProperties()->GetPropertyValue(PROPKEY_PORT_LATENCY);
+    }
+    return m_ParentPortInfo->GetPortLatencyValue(m_PortDynamicSequenceID + Instance);
 }
 
 void GraphicItemPort::SetPortConnectedWireHandle(GraphicItemWireHandle* ptrHandle)
@@ -210,9 +232,11 @@ void GraphicItemPort::SetPortConnectedWireHandle(GraphicItemWireHandle* ptrHandl
     } else {
         m_PortColor = PORT_COLOR_DISCONNECTED;
     }
-    setBrush(m_PortColor);
 
     m_PortConnectedHandle = ptrHandle;
+
+    // Have the Owner redraw the port in its new color
+    UpdateOwnerItem();
 }
 
 GraphicItemWire* GraphicItemPort::GetPortConnectedWire()
@@ -233,15 +257,41 @@ void GraphicItemPort::DisconnectPortFromWire(int MoveXOffset /*=0*/)
     }
 }
 
-void GraphicItemPort::UpdatePortPosition()
+void GraphicItemPort::UpdateConnectedWirePosition()
 {
-    qreal LineStartEdgeOffset;
-    qreal LineEndEdgeOffset;
+    GraphicItemWireHandle* ptrWireHandle;
+    GraphicItemWire*       ptrWire;
+    QPointF                NewScenePos;
+
+    // Called when the Port or its Owner has moved position on the scene
+    ptrWireHandle = GetPortConnectedWireHandle();
+    if ((ptrWireHandle == NULL) || (m_OwnerItem->scene() == NULL)) {
+        return;
+    }
+
+    ptrWire = GetPortConnectedWire();
+    if (ptrWire == NULL) {
+        return;
+    }
+
+    // Depending upon what end of the wire this handle is attached to, queue an update of that point
+    // (The Scene reroutes the wire once per frame, even if both of its ends moved)
+    NewScenePos = GetConnectionScenePoint();
+    if (ptrWireHandle->GetWireHandlePointPosition() == GraphicItemWireHandle::STARTPOINT) {
+        ptrWire->QueueStartPointPosition(NewScenePos);
+    } else {
+        ptrWire->QueueEndPointPosition(NewScenePos);
+    }
+}
 
-    // Set the Ellipse to indicate the port size and color, and its position
-    setRect(m_PortSizeRect);
-    setBrush(m_PortColor);
-    setPos(m_ConnectionPoint);
+void GraphicItemPort::UpdatePortPosition()
+{
+    qreal        LineStartEdgeOffset;
+    qreal        LineEndEdgeOffset;
+    QFontMetrics NameFontMetric(GetPortNameFont());
+    QPointF      NamePos;
+    qreal        HalfLineWidth = PORT_BUS_LINE_WIDTH / 2.0;  // Widest line a port can draw
+    qreal        MarkerExtent;
 
     // Draw the Line from the edge of the component to the edge of the Port Ellipse
     if (GetAssignedComponentSide() == PortInfoData::SIDE_LEFT) {
@@ -251,78 +301,220 @@ void GraphicItemPort::UpdatePortPosition()
         LineEndEdgeOffset = -PORT_LINE_END_EDGE_OFFSET;
         LineStartEdgeOffset = PORT_LINE_START_EDGE_OFFSET;
     }
-
-    // Note: Since the Line is a child of the Ellipse, its coordinate system is relative to
-    //       the Ellipse, we actually want it relative to the Ellipse Parent (component)
-    m_PortLine->setLine(mapFromParent(m_StartPoint).x() + LineStartEdgeOffset, mapFromParent(m_StartPoint).y(),
-                         mapFromParent(m_EndPoint).x() + LineEndEdgeOffset, mapFromParent(m_EndPoint).y());
+    m_PortLine = QLineF(m_StartPoint.x() + LineStartEdgeOffset, m_StartPoint.y(),
+                        m_EndPoint.x() + LineEndEdgeOffset, m_EndPoint.y());
 
     // Set Port Name Text Position
     if (GetAssignedComponentSide() == PortInfoData::SIDE_LEFT)
     {
-        m_PortNameText->setPos(mapFromParent(m_EndPoint).x() - 5, mapFromParent(m_EndPoint).y() + PORT_NAME_Y_OFFSET);
+        NamePos = QPointF(m_EndPoint.x() - 5, m_EndPoint.y() + PORT_NAME_Y_OFFSET);
     } else {
-        m_PortNameText->setPos(mapFromParent(m_StartPoint).x() + 2, mapFromParent(m_StartPoint).y() + PORT_NAME_Y_OFFSET);
+        NamePos = QPointF(m_StartPoint.x() + 2, m_StartPoint.y() + PORT_NAME_Y_OFFSET);
+    }
+    m_PortNameRect = QRectF(NamePos, QSizeF(NameFontMetric.width(m_ConfiguredPortName), NameFontMetric.height()));
+
+    // Lay out the Port Name only when it changes (Not on every paint)
+    if (m_PortNameStaticText.text() != m_ConfiguredPortName) {
+        m_PortNameStaticText.setTextFormat(Qt::PlainText);
+        m_PortNameStaticText.setText(m_ConfiguredPortName);
+        m_PortNameStaticText.prepare(QTransform(), GetPortNameFont());
+    }
+
+    // Bounding Rect covers the Line (with its pen), the Ellipse, the
+    // Unconfigured Marker (rotated, so use its diagonal) and the Name
+    MarkerExtent = (QRectF(PORT_UNCONFIG_MARKER_SIZE).width() / 2) * qSqrt(2.0) + 1;
+    m_PortBoundingRect = QRectF(m_PortLine.p1(), m_PortLine.p2()).normalized().adjusted(-HalfLineWidth, -HalfLineWidth, HalfLineWidth, HalfLineWidth);
+    m_PortBoundingRect |= GetConnectionRect().adjusted(-1, -1, 1, 1);
+    m_PortBoundingRect |= QRectF(m_ConnectionPoint.x() - MarkerExtent, m_ConnectionPoint.y() - MarkerExtent, 2 * MarkerExtent, 2 * MarkerExtent);
+    m_PortBoundingRect |= m_PortNameRect;
+}
+
+void GraphicItemPort::UpdateOwnerItem()
+{
+    // Redraw just the area of the Owner covered by this port
+    if (m_OwnerItem != NULL) {
+        m_OwnerItem->update(m_PortBoundingRect);
     }
+}
+
+const QFont& GraphicItemPort::GetPortNameFont()
+{
+    // Built once from the default application font (Must be after the QApplication exists)
+    static QFont PortNameFont;
+    static bool  FontInitialized = false;
+
+    if (FontInitialized == false) {
+        PortNameFont = QApplication::font();
+        PortNameFont.setPointSize(PORT_NAME_FONT_SIZE);
+        FontInitialized = true;
+    }
+    return PortNameFont;
+}
+
+void GraphicItemPort::PaintPort(QPainter* painter, bool SelectedFlag)
+{
+    // Line from the edge of the Owner to the Port Ellipse (Drawn behind the Ellipse)
+    painter->setPen(QPen(PORT_LINE_COLOR, (GetPortWidth() > 1) ? PORT_BUS_LINE_WIDTH : PORT_LINE_WIDTH));
+    painter->setBrush(Qt::NoBrush);
+    painter->drawLine(m_PortLine);
 
-    // Setup the unconfigured Marker; This will display on top of the
+    // The Port Ellipse shows the port size and color
+    painter->setPen(QPen());
+    painter->setBrush(m_PortColor);
+    painter->drawEllipse(GetConnectionRect());
+
+    // The unconfigured Marker displays on top of the
     // normal port ellipse if the port is not configured
-    m_UnconfiguredPortMarker->setPos(mapFromParent(m_ConnectionPoint));
-    m_UnconfiguredPortMarker->setVisible(!m_PortIsConfigured);
+    if (m_PortIsConfigured == false) {
+        painter->save();
+        painter->translate(m_ConnectionPoint);
+        painter->rotate(PORT_UNCONFIG_MARKER_ROTATION);
+        painter->setBrush(PORT_UNCONFIG_MARKER_COLOR);
+        painter->drawRect(QRectF(PORT_UNCONFIG_MARKER_SIZE));
+        painter->restore();
+    }
+
+    // The Port Name
+    painter->setFont(GetPortNameFont());
+    painter->setPen(Qt::black);
+    painter->drawStaticText(m_PortNameRect.topLeft(), m_PortNameStaticText);
+
+    // Outline the Ellipse if the port is selected
+    if (SelectedFlag == true) {
+        painter->setPen(QPen(Qt::black, 0, Qt::DashLine));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRect(GetConnectionRect());
+    }
 }
 
-QVariant GraphicItemPort::itemChange(GraphicsItemChange change, const QVariant& value)
+bool GraphicItemPort::ContainsConnectionPoint(const QPointF& OwnerPoint) const
 {
-    bool SelectedState;
-
-    // Did this get called to to a Selection Change?
-    if (change == ItemSelectedChange && scene()) {
-        // value is the selected state
-        SelectedState = value.toBool();
-    }
-
-    // See if the port has moved position on the scene
-    if (change == ItemScenePositionHasChanged && scene()) {
-        // value is the new position.
-        QPointF newPos = value.toPointF();
-
-        // Now see if there is a Wire Handle Attached to this port
-        GraphicItemWireHandle* ptrWireHandle = GetPortConnectedWireHandle();
-        if (ptrWireHandle != NULL) {
-            GraphicItemWire*  ptrWire = GetPortConnectedWire();
-
-            // Depending upon what end of the wire this handle is attached to, update that point
-            if (ptrWireHandle->GetWireHandlePointPosition() == GraphicItemWireHandle::STARTPOINT) {
-                ptrWire->UpdateStartPointPosition(newPos);
-            } else {
-                ptrWire->UpdateEndPointPosition(newPos);
-            }
-        }
+    QPointF Delta = OwnerPoint - m_ConnectionPoint;
+    qreal   Radius = (m_PortSizeRect.width() + 1) / 2;  // Ellipse plus its outline
+
+    return ((Delta.x() * Delta.x()) + (Delta.y() * Delta.y())) <= (Radius * Radius);
+}
+
+void GraphicItemPort::PaintPorts(QPainter* painter, const QList<GraphicItemPort*>& PortArray, GraphicItemPort* SelectedPort)
+{
+    int x;
+
+    painter->save();
+    for (x = 0; x < PortArray.count(); x++) {
+        PortArray.at(x)->PaintPort(painter, PortArray.at(x) == SelectedPort);
     }
+    painter->restore();
+}
 
-    // If the position has moved, then mark the Project as dirty
-    if (change == QGraphicsItem::ItemPositionHasChanged) {
-        emit ItemPortSetProjectDirty();
-        emit ItemPortMovedPosition(this);
+QRectF GraphicItemPort::GetPortsBoundingRect(const QList<GraphicItemPort*>& PortArray)
+{
+    int    x;
+    QRectF BoundingRect;
+
+    for (x = 0; x < PortArray.count(); x++) {
+        BoundingRect |= PortArray.at(x)->GetPortBoundingRect();
     }
+    return BoundingRect;
+}
 
-    return QGraphicsItem::itemChange(change, value);
+QPainterPath GraphicItemPort::GetPortsShape(const QList<GraphicItemPort*>& PortArray)
+{
+    int          x;
+    QPainterPath Path;
+
+    // Only the Port Ellipses can be clicked on (Same as when they were scene items)
+    Path.setFillRule(Qt::WindingFill);
+    for (x = 0; x < PortArray.count(); x++) {
+        Path.addEllipse(PortArray.at(x)->GetConnectionRect().adjusted(-0.5, -0.5, 0.5, 0.5));
+    }
+    return Path;
 }
 
-void GraphicItemPort::PropertyChanged(QString& PropName, QString& NewPropValue)
+GraphicItemPort* GraphicItemPort::GetPortAtPoint(const QList<GraphicItemPort*>& PortArray, const QPointF& OwnerPoint)
+{
+    int x;
+
+    // Search from the last drawn port so the one on top wins
+    for (x = PortArray.count() - 1; x >= 0; x--) {
+        if (PortArray.at(x)->ContainsConnectionPoint(OwnerPoint) == true) {
+            return PortArray.at(x);
+        }
+    }
+    return NULL;
+}
+
+GraphicItemPort* GraphicItemPort::GetOwnersPortAtScenePoint(QGraphicsItem* OwnerItem, const QPointF& ScenePoint)
 {
-    if (PropName == PORT_PROPERTY_LATENCY) {
-        // Tell the Parent what the new Latency Value is
-        m_ParentPortInfo->SetPortLatencyValue(m_PortDynamicSequenceID, NewPropValue);
+    GraphicItemComponent* ptrComponent;
+    GraphicItemGroup*     ptrGroup;
+
+    // Only Components and Groups own ports
+    ptrComponent = qgraphicsitem_cast<GraphicItemComponent*>(OwnerItem);
+    if (ptrComponent != NULL) {
+        return GetPortAtPoint(ptrComponent->GetGraphicalPortArray(), ptrComponent->mapFromScene(ScenePoint));
+    }
+
+    ptrGroup = qgraphicsitem_cast<GraphicItemGroup*>(OwnerItem);
+    if (ptrGroup != NULL) {
+        return GetPortAtPoint(ptrGroup->GetGraphicalPortArray(), ptrGroup->mapFromScene(ScenePoint));
     }
 
-    if (PropName == PORT_PROPERTY_COMMENT) {
-        // Tell the Parent what the new Comment is
-        m_ParentPortInfo->SetPortComment(m_PortDynamicSequenceID, NewPropValue);
+    return NULL;
+}
+
+QList<GraphicItemPort*> GraphicItemPort::GetPortsAtScenePoint(QGraphicsScene* Scene, const QPointF& ScenePoint)
+{
+    int                     x;
+    QList<QGraphicsItem*>   PointItems;
+    QList<GraphicItemPort*> FoundPorts;
+    GraphicItemPort*        ptrPort;
+    WiringScene*            ptrWiringScene;
+
+    // The Wiring Scene keeps a Spatial Hash of the Port Owners
+    ptrWiringScene = qobject_cast<WiringScene*>(Scene);
+    if (ptrWiringScene != NULL) {
+        return ptrWiringScene->GetPortsAtScenePoint(ScenePoint);
     }
 
-    // Set the project dirty
-    emit ItemPortSetProjectDirty();
+    // Otherwise, the Owners shape includes their Port Ellipses, so the owner
+    // of any port at this point will be in the list of items
+    PointItems = Scene->items(ScenePoint);
+    for (x = 0; x < PointItems.count(); x++) {
+        ptrPort = GetOwnersPortAtScenePoint(PointItems.at(x), ScenePoint);
+        if (ptrPort != NULL) {
+            FoundPorts.append(ptrPort);
+        }
+    }
+    return FoundPorts;
 }
 
+void GraphicItemPort::PropertyChanged(QString& PropName, QString& NewPropValue)
+{
+    GraphicItemComponent* ptrComponent;
+    GraphicItemGroup*     ptrGroup;
+    int                   Instance;
+
+    // Tell the Parent the new value for every Instance this Port stands for (More than 1 for a Bus)
+    // (Set from the last Instance down so the Parent's lists only grow once)
+    for (Instance = GetPortWidth() - 1; Instance >= 0; Instance--) {
+        if (PropName == PORT_PROPERTY_LATENCY) {
+            // Tell the Parent what the new Latency Value is
+            m_ParentPortInfo->SetPortLatencyValue(m_PortDynamicSequenceID + Instance, NewPropValue);
+        }
+
+        if (PropName == PORT_PROPERTY_COMMENT) {
+            // Tell the Parent what the new Comment is
+            m_ParentPortInfo->SetPortComment(m_PortDynamicSequenceID + Instance, NewPropValue);
+        }
+    }
 
+    // Set the project dirty (Through the Owner, Ports do not have signals)
+    ptrComponent = qgraphicsitem_cast<GraphicItemComponent*>(m_OwnerItem);
+    if (ptrComponent != NULL) {
+        ptrComponent->SetProjectDirty();
+    }
+    ptrGroup = qgraphicsitem_cast<GraphicItemGroup*>(m_OwnerItem);
+    if (ptrGroup != NULL) {
+        ptrGroup->SetProjectDirty();
+    }
+}
@@ -29,24 +29,26 @@
 class GraphicItemWire;
 class GraphicItemWireHandle;
 
+////////////////////////////////////////////////////////////
+// A GraphicItemPort is NOT an item on the scene.  It is a lightweight record
+// owned by a GraphicItemComponent or GraphicItemGroup (the Owner Item), which
+// paints all of its ports, includes them in its bounding rect and shape and
+// hit tests them.  All Port coordinates are in the Owner Item's coordinates.
 ////////////////////////////////////////////////////////////
 
-class GraphicItemPort : public QObject, public QGraphicsEllipseItem, public GraphicItemBase
+class GraphicItemPort : public GraphicItemBase
 {
-    Q_OBJECT
-
 public:
-    // Required Virtual function for any QGraphicItem to provide a type value for the qgraphicsitem_cast function
-    enum { Type = UserType + ITEMTYPE_PORT };
-    int type() const {return Type;}
-
     // Constructor / Destructor
-    GraphicItemPort(PortInfoData* ParentPortInfo, QGraphicsItem* parent = 0);
+    GraphicItemPort(PortInfoData* ParentPortInfo, QGraphicsItem* OwnerItem);
     virtual ~GraphicItemPort();
 
     // Serialization
     void SaveData(QDataStream& DataStreamOut);
 
+    // The Component or Group that owns (and draws) this Port
+    QGraphicsItem* GetOwnerItem() const {return m_OwnerItem;}
+
     // Port Names
     QString GetSSTInfoPortName() {return m_SSTInfoPortName;}
     QString GetConfiguredPortName() {return m_ConfiguredPortName;}
@@ -68,37 +70,54 @@ public:
     bool IsPortConnectedToWire() {return (GetPortConnectedWire() != NULL);}
     int  GetPortDynamicSequenceID() {return m_PortDynamicSequenceID;}
 
-    // Graphic Port Linked List Control
-    GraphicItemPort* GetNextPeerDynamicPort() {return m_NextPeerDynamicPort;}
-    void SetNextPeerDynamicPort(GraphicItemPort* NextPort) {m_NextPeerDynamicPort = NextPort;}
+    // Bus Port Information (A Bus Port stands for all the Instances of a Dynamic Port)
+    bool    IsPortBus() {return m_PortIsDynamic && m_ParentPortInfo->IsPortBus();}
+    int     GetPortWidth();
+    QString GetInstancePortName(int Instance);
+    QString GetInstancePortLatency(int Instance);
 
     // Control for Connection to wires
     QPointF GetConnectionPoint() const {return m_ConnectionPoint;}
+    QPointF GetConnectionScenePoint() const {return m_OwnerItem->mapToScene(m_ConnectionPoint);}
     void SetPortConnectedWireHandle(GraphicItemWireHandle* ptrHandle);
     GraphicItemWireHandle* GetPortConnectedWireHandle() {return m_PortConnectedHandle;}
     GraphicItemWire* GetPortConnectedWire();
     void DisconnectPortFromWire(int MoveXOffset = 0);
+    void UpdateConnectedWirePosition();
 
     // Control for Moving Port Location on Component
     QPointF GetInitialPoint() const {return m_InitialPoint;}
     void    SetInitialPoint(QPointF NewPoint) {m_InitialPoint = NewPoint;}
 
-signals:
-    // Message to the Parent Scene
-    void ItemPortSetProjectDirty();
-    void ItemPortMovedPosition(GraphicItemPort*);
+    // Drawing and Hit Testing (Called by the Owner Item)
+    void    PaintPort(QPainter* painter, bool SelectedFlag);
+    QRectF  GetPortBoundingRect() const {return m_PortBoundingRect;}
+    QRectF  GetConnectionRect() const {return m_PortSizeRect.translated(m_ConnectionPoint);}
+    bool    ContainsConnectionPoint(const QPointF& OwnerPoint) const;
+
+    // Helpers for the Owner Items (STATIC FUNCTIONS)
+    static void             PaintPorts(QPainter* painter, const QList<GraphicItemPort*>& PortArray, GraphicItemPort* SelectedPort);
+    static QRectF           GetPortsBoundingRect(const QList<GraphicItemPort*>& PortArray);
+    static QPainterPath     GetPortsShape(const QList<GraphicItemPort*>& PortArray);
+    static GraphicItemPort* GetPortAtPoint(const QList<GraphicItemPort*>& PortArray, const QPointF& OwnerPoint);
+
+    // Find Ports on the Scene (STATIC FUNCTIONS)
+    static GraphicItemPort*        GetOwnersPortAtScenePoint(QGraphicsItem* OwnerItem, const QPointF& ScenePoint);
+    static QList<GraphicItemPort*> GetPortsAtScenePoint(QGraphicsScene* Scene, const QPointF& ScenePoint);
 
 private:
     void UpdatePortPosition();
+    void UpdateOwnerItem();
 
-private:
-    // Something changed on the Port
-    QVariant itemChange(GraphicsItemChange change, const QVariant &value);
+    // Font for all Port Names (Shared by all ports)
+    static const QFont& GetPortNameFont();
 
+private:
     // Handle Changes to the Ports Properties
     void PropertyChanged(QString& PropName, QString& NewPropValue);
 
 private:
+    QGraphicsItem*           m_OwnerItem;
     PortInfoData*            m_ParentPortInfo;
     QString                  m_PortName;
     QString                  m_PortDesc;
@@ -111,20 +130,18 @@ private:
     bool                     m_PortIsConfigured;      // Flag that identifies if port is fully Configured
     bool                     m_PortIsDynamic;         // Flag that identifies if port is a Dynamic Port (has a %d)
     int                      m_PortDynamicSequenceID; // Port Sequence in the Dynamic Group
-    GraphicItemPort*         m_NextPeerDynamicPort;
 
     QColor                   m_PortColor;
-    QPen                     m_PortLinePen;
     QPointF                  m_StartPoint;
     QPointF                  m_EndPoint;
     QPointF                  m_ConnectionPoint;
     QPointF                  m_InitialPoint;
     QRectF                   m_PortSizeRect;
-    QFont                    m_PortNameFont;
 
-    QGraphicsLineItem*       m_PortLine;
-    QGraphicsSimpleTextItem* m_PortNameText;
-    QGraphicsRectItem*       m_UnconfiguredPortMarker;
+    QLineF                   m_PortLine;              // Cached Geometry (Owner Coordinates)
+    QRectF                   m_PortNameRect;
+    QStaticText              m_PortNameStaticText;    // Cached layout of the Port Name
+    QRectF                   m_PortBoundingRect;
 
     GraphicItemWireHandle*   m_PortConnectedHandle;
 };
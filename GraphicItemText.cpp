@@ -99,6 +99,14 @@ void GraphicItemText::CommonSetup()
     m_MoveDelayDistance = MOUSEMOVE_DELAYPIXELS;
 }
 
+void GraphicItemText::MoveToPosition(const QPointF& NewPos)
+{
+    // The Move Delay only applies to mouse drags
+    m_MoveDelayDistance = 0;
+    setPos(NewPos);
+    m_MoveDelayDistance = MOUSEMOVE_DELAYPIXELS;
+}
+
 void GraphicItemText::HandleDocumentContentsChanged()
 {
     // Signal that the Text Contents changed
@@ -133,6 +141,7 @@ QVariant GraphicItemText::itemChange(GraphicsItemChange change, const QVariant&
     // If the position has moved, then mark the Project as dirty
     if (change == QGraphicsItem::ItemPositionHasChanged) {
         emit ItemTextSetProjectDirty();
+        emit ItemTextGeometryChanged(this);
     }
 
     return QGraphicsItem::itemChange(change, value);
@@ -41,10 +41,14 @@ public:
     // Serialization
     void SaveData(QDataStream& DataStreamOut);
 
+    // Place the Text exactly (Used by Undo / Redo)
+    void MoveToPosition(const QPointF& NewPos);
+
 signals:
     // Signals to the Scene
     void ItemTextLostFocus(GraphicItemText* item);
     void ItemTextSetProjectDirty();
+    void ItemTextGeometryChanged(GraphicItemText* item);
 
 private:
     void CommonSetup();
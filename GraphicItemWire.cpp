@@ -16,6 +16,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "GraphicItemWire.h"
+#include "WiringScene.h"
 
 ////////////////////////////////////////////////////////////
 
@@ -24,54 +25,66 @@ GraphicItemWire::GraphicItemWire(int WireIndex, const QPointF& StartPoint, const
 {
     m_WireIndex = WireIndex;
 
-    // Build the Wire Line Segments
-    m_StartPointLine = new GraphicItemWireLineSegment(GraphicItemWireLineSegment::SEGPOS_STARTLINE, GetItemProperties(), this);
-    m_MiddleVLine1   = new GraphicItemWireLineSegment(GraphicItemWireLineSegment::SEGPOS_MIDDLEVLINE1, GetItemProperties(), this);
-    m_EndPointLine   = new GraphicItemWireLineSegment(GraphicItemWireLineSegment::SEGPOS_ENDLINE, GetItemProperties(), this);
+    // Set Graphic parameters for the Wire (Moving the Wire only slides its Middle Segment)
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setFlag(QGraphicsItem::ItemIsMovable);
+    setFlag(QGraphicsItem::ItemSendsGeometryChanges);
+    setAcceptHoverEvents(true);
+    m_DraggingMiddleSegment = false;
+    m_WireHovered = false;
+
+    // The Wire is not in a Bundle until the Scene puts it in one
+    m_WireBundleState = BUNDLE_NONE;
+    m_WireBundleCount = 0;
+    m_BundleBadgeFont.setPointSize(WIRE_BUNDLE_BADGE_FONT_SIZE);
+
+    // Build the handles at the end of the lines, start them off as invisible
+    m_StartPointHandle = new GraphicItemWireHandle(StartPoint, GraphicItemWireHandle::STARTPOINT, this);
+    m_EndPointHandle = new GraphicItemWireHandle(EndPoint, GraphicItemWireHandle::ENDPOINT, this);
 
     // Flag to control if we automatically move the middle line segments
     // Once cleared, we used the saved positions with any updates
     m_AutomaticWireLinePositioning = true;
 
+    // Wires are drawn as 3 Line Segments until the Scene turns on Routing
+    m_AutoRouted = false;
+
     // Identify that the wire is selected
     // (the user created it, so they must want a wire to move around)
     m_WireSelectedState = true;
     m_WireConnectedState = NO_CONNECTIONS;
 
+    // Nothing is waiting to be rerouted
+    m_RerouteQueued = false;
+    m_QueuedStartPointValid = false;
+    m_QueuedEndPointValid = false;
+
     // Set the wire color and style for the pen  selected mode
     m_CurrentWireColor = WIRE_COLOR_DISCONNECTED;
     m_CurrentPenStyle  = WIRE_STYLE_SELECTED;
 
-    // Initialize the Graphical Pen for the wires
-    UpdateWireLinePens();
+    // Init variables that track when ports are touched
+    m_StartPointCurrentPortConnected = NULL;
+    m_EndPointCurrentPortConnected = NULL;
+    m_NotifiedStartPort = NULL;
+    m_NotifiedEndPort = NULL;
 
     // Save off the line points
     m_StartPoint = StartPoint;
     m_EndPoint = EndPoint;
     m_PointToPointLine = QLineF(m_StartPoint, m_EndPoint);
 
-    // Init variables that track when ports are touched
-    m_StartPointCurrentPortConnected = NULL;
-    m_EndPointCurrentPortConnected = NULL;
-
-    // Now draw a initial line.  User will later move it via endpoint
-    QLineF InitialLine(m_StartPoint, m_EndPoint);
+    // Initialize the Graphical Pen for the wires
+    UpdateWireLinePens();
 
-    // And draw the initial 3 wires at the start/end points
-    // User will later move it via endpoint
-    m_StartPointLine->setLine(InitialLine);
-    m_MiddleVLine1->setLine(InitialLine);
-    m_EndPointLine->setLine(InitialLine);
+    // Now draw a initial line from the start to end point.  User will later move it via endpoint
+    m_MiddleStartVertical1Point = m_StartPoint;
+    m_MiddleEndVertical1Point = m_EndPoint;
+    UpdateWireGeometry();
 
     // Set the Z height (Wires are on top of Components, but lower than Text)
     setZValue(WIRE_SELECTED_ZVALUE);
 
-    // Build the handles at the end of the lines, start them off as invisible
-    m_StartPointHandle = new GraphicItemWireHandle(m_StartPoint, GraphicItemWireHandle::STARTPOINT, this);
-    m_StartPointHandle->MakeVisible(false);
-    m_EndPointHandle = new GraphicItemWireHandle(m_EndPoint, GraphicItemWireHandle::ENDPOINT, this);
-    m_EndPointHandle->MakeVisible(false);
-
     // Now set the Properties for this Wire
     GetItemProperties()->AddProperty(WIRE_PROPERTY_NUMBER, QString("%1").arg(m_WireIndex), "Wire Index", ItemProperty::READONLY, false);
     GetItemProperties()->AddProperty(WIRE_PROPERTY_COMMENT, "", "Comment on this Wire", ItemProperty::READWRITE, false);
@@ -100,6 +113,8 @@ GraphicItemWire::GraphicItemWire(QDataStream& DataStreamIn, int NewWireIndex /*=
     DataStreamIn >> m_CurrentWireColor;
     DataStreamIn >> nCurrentPenStyle;
     DataStreamIn >> nWireConnectedState;
+    DataStreamIn >> m_AutoRouted;
+    DataStreamIn >> m_RoutePointList;
     m_CurrentPenStyle = (Qt::PenStyle)nCurrentPenStyle;
     m_WireConnectedState = (ConnectedState)nWireConnectedState;
 
@@ -112,39 +127,46 @@ GraphicItemWire::GraphicItemWire(QDataStream& DataStreamIn, int NewWireIndex /*=
     // Default this ware to not selected
     m_WireSelectedState = false;
 
-    // Build the Wire Line Segments
-    m_StartPointLine = new GraphicItemWireLineSegment(GraphicItemWireLineSegment::SEGPOS_STARTLINE, GetItemProperties(), this);
-    m_MiddleVLine1   = new GraphicItemWireLineSegment(GraphicItemWireLineSegment::SEGPOS_MIDDLEVLINE1, GetItemProperties(), this);
-    m_EndPointLine   = new GraphicItemWireLineSegment(GraphicItemWireLineSegment::SEGPOS_ENDLINE, GetItemProperties(), this);
+    // Nothing is waiting to be rerouted
+    m_RerouteQueued = false;
+    m_QueuedStartPointValid = false;
+    m_QueuedEndPointValid = false;
 
-    // Initialize the Graphical Pen for the wires
-    UpdateWireLinePens();
+    // Set Graphic parameters for the Wire (Moving the Wire only slides its Middle Segment)
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setFlag(QGraphicsItem::ItemIsMovable);
+    setFlag(QGraphicsItem::ItemSendsGeometryChanges);
+    setAcceptHoverEvents(true);
+    m_DraggingMiddleSegment = false;
+    m_WireHovered = false;
 
-    // Save off the line points
-    m_PointToPointLine = QLineF(m_StartPoint, m_EndPoint);
+    // The Wire is not in a Bundle until the Scene puts it in one
+    m_WireBundleState = BUNDLE_NONE;
+    m_WireBundleCount = 0;
+    m_BundleBadgeFont.setPointSize(WIRE_BUNDLE_BADGE_FONT_SIZE);
+
+    // Build the handles at the end of the lines, start them off as invisible
+    m_StartPointHandle = new GraphicItemWireHandle(m_StartPoint, GraphicItemWireHandle::STARTPOINT, this);
+    m_EndPointHandle = new GraphicItemWireHandle(m_EndPoint, GraphicItemWireHandle::ENDPOINT, this);
 
     // Init variables that track when ports are touched
     m_StartPointCurrentPortConnected = NULL;
     m_EndPointCurrentPortConnected = NULL;
+    m_NotifiedStartPort = NULL;
+    m_NotifiedEndPort = NULL;
 
-    // Now draw a initial line.  User will later move it via endpoint
-    QLineF InitialLine(m_StartPoint, m_EndPoint);
+    // Initialize the Graphical Pen for the wires
+    UpdateWireLinePens();
 
-    // And draw the initial 3 wires at the start/end points
-    // User will later move it via endpoint
-    m_StartPointLine->setLine(InitialLine);
-    m_MiddleVLine1->setLine(InitialLine);
-    m_EndPointLine->setLine(InitialLine);
+    // Save off the line points
+    m_PointToPointLine = QLineF(m_StartPoint, m_EndPoint);
+
+    // Draw the Wire along its saved path (or saved Route)
+    UpdateWireGeometry();
 
     // Set the Z height (Wires are on top of Components, but lower than Text)
     setZValue(NewZValue);
 
-    // Build the handles at the end of the lines, start them off as invisible
-    m_StartPointHandle = new GraphicItemWireHandle(m_StartPoint, GraphicItemWireHandle::STARTPOINT, this);
-    m_StartPointHandle->MakeVisible(false);
-    m_EndPointHandle = new GraphicItemWireHandle(m_EndPoint, GraphicItemWireHandle::ENDPOINT, this);
-    m_EndPointHandle->MakeVisible(false);
-
     // Turn off the selected state
     UpdateWireSelectedState(false);
 
@@ -158,6 +180,9 @@ GraphicItemWire::GraphicItemWire(QDataStream& DataStreamIn, int NewWireIndex /*=
 GraphicItemWire::~GraphicItemWire()
 {
     DisconnectAllAttachedPorts();
+
+    delete m_StartPointHandle;
+    delete m_EndPointHandle;
 }
 
 void GraphicItemWire::SaveData(QDataStream& DataStreamOut)
@@ -177,6 +202,8 @@ void GraphicItemWire::SaveData(QDataStream& DataStreamOut)
     DataStreamOut << m_CurrentWireColor;
     DataStreamOut << (qint32)m_CurrentPenStyle;
     DataStreamOut << (qint32)m_WireConnectedState;
+    DataStreamOut << m_AutoRouted;
+    DataStreamOut << m_RoutePointList;
 
     // Save the Wire Properties
     GetItemProperties()->SaveData(DataStreamOut);
@@ -187,7 +214,7 @@ void GraphicItemWire::UpdateStartPointPosition(const QPointF& NewPointLocation)
     // Save off the updated line point
     m_StartPoint = NewPointLocation;
 
-    UpdatePointPositions(m_StartPointLine);
+    UpdatePointPositions();
 }
 
 void GraphicItemWire::UpdateEndPointPosition(const QPointF& NewPointLocation)
@@ -195,7 +222,7 @@ void GraphicItemWire::UpdateEndPointPosition(const QPointF& NewPointLocation)
     // Save off the updated line point
     m_EndPoint = NewPointLocation;
 
-    UpdatePointPositions(m_EndPointLine);
+    UpdatePointPositions();
 }
 
 void GraphicItemWire::SetPastePosition(int PasteOffset)
@@ -208,6 +235,55 @@ void GraphicItemWire::SetPastePosition(int PasteOffset)
     UpdateEndPointPosition(GetEndPoint() + QPointF(PasteOffset, PasteOffset));
 }
 
+void GraphicItemWire::QueueStartPointPosition(const QPointF& NewPointLocation)
+{
+    // Remember the latest point, the Wire is rerouted once when the queue is processed
+    m_QueuedStartPoint = NewPointLocation;
+    m_QueuedStartPointValid = true;
+
+    if (m_RerouteQueued == false) {
+        m_RerouteQueued = true;
+        emit ItemWireRerouteQueued(this);
+    }
+}
+
+void GraphicItemWire::QueueEndPointPosition(const QPointF& NewPointLocation)
+{
+    // Remember the latest point, the Wire is rerouted once when the queue is processed
+    m_QueuedEndPoint = NewPointLocation;
+    m_QueuedEndPointValid = true;
+
+    if (m_RerouteQueued == false) {
+        m_RerouteQueued = true;
+        emit ItemWireRerouteQueued(this);
+    }
+}
+
+bool GraphicItemWire::ProcessQueuedReroute()
+{
+    bool Rerouted = false;
+
+    // The Wire may have been removed from the Scene since it was queued; then the queued points are dropped
+    if ((m_RerouteQueued == true) && (scene() != NULL)) {
+        if (m_QueuedStartPointValid == true) {
+            m_StartPoint = m_QueuedStartPoint;
+        }
+        if (m_QueuedEndPointValid == true) {
+            m_EndPoint = m_QueuedEndPoint;
+        }
+
+        // Reroute both ends at once
+        UpdatePointPositions();
+        Rerouted = true;
+    }
+
+    m_RerouteQueued = false;
+    m_QueuedStartPointValid = false;
+    m_QueuedEndPointValid = false;
+
+    return Rerouted;
+}
+
 void GraphicItemWire::DisconnectAllAttachedPorts()
 {
     // Tell the ports that they are not connected to the wire anymore
@@ -261,109 +337,76 @@ void GraphicItemWire::DisconnectPort(GraphicItemPort* Port, int MoveXOffset /*=0
 
 void GraphicItemWire::SetWireSelected(bool SelectedState)
 {
-    // Just select one of the child WireLineSegments and set its
-    // select state, this will call back into this parent object
-    // to setup change the colors, pens, line style, etc
-    m_EndPointLine->setSelected(SelectedState);
-}
-
-void GraphicItemWire::HandleWireLineSegmentItemChange(const QPointF& NewPos, GraphicItemWireLineSegment* CallingWireLineSegment, GraphicsItemChange change, const QVariant& value)
-{
-    bool SelectedState;
-
-    ///////////////////////////////////////////////////////////////////////
-    // If any of Wire Line Segments change, they will call this routine
-
-    // Did this get called to to a Selection Change?
-    if (change == ItemSelectedChange && scene()) {
-        // value is the selected state
-        SelectedState = value.toBool();
-        UpdateWireSelectedState(SelectedState);
-    }
-
-    // Did the items position change (note: we don't allow the position to actually change),
-    // we just want the offset the user provided to tell us how far to move the wire
-    if (change == ItemPositionChange && scene()) {
-
-        // Set this wire to user controlled
-        CallingWireLineSegment->ClearAutoMoveFlag();
-
-        // Turn off automatic wire positioning, now we use what was last set
-        m_AutomaticWireLinePositioning = false;
-
-        // Now redraw the wire line segments in the new position
-        UpdateWireLineSegmentPositions(NewPos, CallingWireLineSegment);
-    }
+    // Selecting the Wire will call itemChange() to
+    // change the colors, pens, line style, etc
+    setSelected(SelectedState);
 }
 
-void GraphicItemWire::HandleWireLineSegmentMouseReleaseEvent(QGraphicsSceneMouseEvent* event)
+void GraphicItemWire::SyncWireSelectedState()
 {
-    Q_UNUSED(event)
-
-    // When the mouse is released on a WireLineSegment (When updating its position)
-    m_Current_x_VerticalDrawPoint = m_MiddleStartVertical1Point.x();
+    UpdateWireSelectedState(isSelected());
 }
 
-void GraphicItemWire::UpdatePointPositions(GraphicItemWireLineSegment* CallingWireLineSegment)
+GraphicItemWireHandle* GraphicItemWire::GetWireHandleAtScenePoint(const QPointF& ScenePoint)
 {
-    int                   x;
-    GraphicItemPort*      StartPointFoundPort = NULL;
-    GraphicItemPort*      EndPointFoundPort = NULL;
-    QList<QGraphicsItem*> StartPointItems;
-    QList<QGraphicsItem*> EndPointItems;
-    GraphicItemPort*      ptrPort;
-
-    // Get a list of items at each of the points
-    StartPointItems = scene()->items(m_StartPoint);
-    EndPointItems = scene()->items(m_EndPoint);
+    QPointF WirePoint = mapFromScene(ScenePoint);
 
-    // Remove this GraphicItemWire Graphical Object from the list of Items
-    if (StartPointItems.count() && StartPointItems.first() == this) {
-       StartPointItems.removeFirst();
+    // Only visible Handles can be grabbed (The End Handle is checked first as it is drawn on top)
+    if ((m_EndPointHandle->IsVisible() == true) && (m_EndPointHandle->GetHandleRect().contains(WirePoint) == true)) {
+        return m_EndPointHandle;
     }
-    if (EndPointItems.count() && EndPointItems.first() == this) {
-       EndPointItems.removeFirst();
+    if ((m_StartPointHandle->IsVisible() == true) && (m_StartPointHandle->GetHandleRect().contains(WirePoint) == true)) {
+        return m_StartPointHandle;
     }
+    return NULL;
+}
 
-    // Search all the Items at the START POINT to see if it is a GraphicItemPort Object
+void GraphicItemWire::UpdatePointPositions()
+{
+    int                     x;
+    GraphicItemPort*        StartPointFoundPort = NULL;
+    GraphicItemPort*        EndPointFoundPort = NULL;
+    QList<GraphicItemPort*> StartPointPorts;
+    QList<GraphicItemPort*> EndPointPorts;
+    GraphicItemPort*        ptrPort;
+
+    // Get a list of the Ports at each of the points (Ports are drawn by their Component or Group)
+    StartPointPorts = GraphicItemPort::GetPortsAtScenePoint(scene(), mapToScene(m_StartPoint));
+    EndPointPorts = GraphicItemPort::GetPortsAtScenePoint(scene(), mapToScene(m_EndPoint));
+
+    // Search all the Ports at the START POINT
     // and find any unconnected PORTS at the point that are not connected to this wire
-    for (x = 0; x < StartPointItems.count(); x++) {
-        // Cast the item to a GraphicItemPort (or NULL if this item is not a port)
-        ptrPort = qgraphicsitem_cast<GraphicItemPort*>(StartPointItems.at(x));
-        if (ptrPort != NULL) {
-            // See if this port does not have a connection, or is connected to this wire's start handle
-            if ((ptrPort->GetPortConnectedWireHandle() == NULL) ||
-                (ptrPort->GetPortConnectedWireHandle() == m_StartPointHandle)) {
-                // This point is touching the connection point of the port
-                // Check to see if the port is configured, if yes, when we can use it
-                if (ptrPort->IsPortConfigured() == true) {
-                    // Save off the found port for later analysis
-                    StartPointFoundPort = ptrPort;
-
-                    // Snap the point to the center of the port
-                    m_StartPoint = mapFromItem(ptrPort->parentItem(), ptrPort->GetConnectionPoint());
-                }
+    for (x = 0; x < StartPointPorts.count(); x++) {
+        ptrPort = StartPointPorts.at(x);
+        // See if this port does not have a connection, or is connected to this wire's start handle
+        if ((ptrPort->GetPortConnectedWireHandle() == NULL) ||
+            (ptrPort->GetPortConnectedWireHandle() == m_StartPointHandle)) {
+            // This point is touching the connection point of the port
+            // Check to see if the port is configured, if yes, when we can use it
+            if (ptrPort->IsPortConfigured() == true) {
+                // Save off the found port for later analysis
+                StartPointFoundPort = ptrPort;
+
+                // Snap the point to the center of the port
+                m_StartPoint = mapFromItem(ptrPort->GetOwnerItem(), ptrPort->GetConnectionPoint());
             }
         }
     }
 
-    // Search all the Items at the END POINT to see if it is a GraphicItemPort Object
+    // Search all the Ports at the END POINT
     // and find any unconnected PORTS at the point that are not connected to this wire
-    for (x = 0; x < EndPointItems.count(); x++) {
-        // Cast the item to a GraphicItemPort (or NULL if this item is not a port)
-        ptrPort = qgraphicsitem_cast<GraphicItemPort*>(EndPointItems.at(x));
-        if (ptrPort != NULL) {
-            // See if this port does not have a connection, or is connected to this wire's end handle,
-            if ((ptrPort->GetPortConnectedWireHandle() == NULL) ||
-                (ptrPort->GetPortConnectedWireHandle() == m_EndPointHandle)) {
-                // This point is touching the connection point of the port
-                // Check to see if the port is configured, if yes, when we can use it
-                if (ptrPort->IsPortConfigured() == true) {
-                    EndPointFoundPort = ptrPort;
-
-                    // Snap the point to the center of the port
-                    m_EndPoint = mapFromItem(ptrPort->parentItem(), ptrPort->GetConnectionPoint());
-                }
+    for (x = 0; x < EndPointPorts.count(); x++) {
+        ptrPort = EndPointPorts.at(x);
+        // See if this port does not have a connection, or is connected to this wire's end handle,
+        if ((ptrPort->GetPortConnectedWireHandle() == NULL) ||
+            (ptrPort->GetPortConnectedWireHandle() == m_EndPointHandle)) {
+            // This point is touching the connection point of the port
+            // Check to see if the port is configured, if yes, when we can use it
+            if (ptrPort->IsPortConfigured() == true) {
+                EndPointFoundPort = ptrPort;
+
+                // Snap the point to the center of the port
+                m_EndPoint = mapFromItem(ptrPort->GetOwnerItem(), ptrPort->GetConnectionPoint());
             }
         }
     }
@@ -412,7 +455,7 @@ void GraphicItemWire::UpdatePointPositions(GraphicItemWireLineSegment* CallingWi
     // Finally Move the Line's position
     m_PointToPointLine = QLineF(m_StartPoint, m_EndPoint);
 
-    UpdateWireLineSegmentPositions(QPointF(0, 0), CallingWireLineSegment);
+    UpdateWireLineSegmentPositions(0);
 }
 
 void GraphicItemWire::UpdatePortAndWireHandleSettings()
@@ -443,13 +486,25 @@ void GraphicItemWire::UpdatePortAndWireHandleSettings()
     m_EndPointHandle->SetWireHandleConnectedPort(m_EndPointCurrentPortConnected);
 
     UpdateWireSelectedState(m_WireSelectedState);
+
+    // Tell the Scene when the Ports at the ends of the Wire change (The Wire may join or leave a Bundle)
+    if ((m_StartPointCurrentPortConnected != m_NotifiedStartPort) || (m_EndPointCurrentPortConnected != m_NotifiedEndPort)) {
+        m_NotifiedStartPort = m_StartPointCurrentPortConnected;
+        m_NotifiedEndPort = m_EndPointCurrentPortConnected;
+        emit ItemWireConnectionChanged(this);
+    }
 }
 
-void GraphicItemWire::UpdateWireLineSegmentPositions(const QPointF& NewPos, GraphicItemWireLineSegment* CallingWireLineSegment)
+void GraphicItemWire::UpdateWireLineSegmentPositions(qreal MiddleXOffset)
 {
-    qreal Delta_x;
-    qreal MidPoint_x;
-    qreal VerticalDrawPoint_x;
+    qreal                     Delta_x;
+    qreal                     MidPoint_x;
+    qreal                     VerticalDrawPoint_x;
+    WiringScene*              Scene;
+    QPointF                   RouteStartPoint;
+    QPointF                   RouteEndPoint;
+    WireRouter::ExitDirection RouteStartExit;
+    WireRouter::ExitDirection RouteEndExit;
 
     // If we are doing automatic line positioning figure out the mid line points
     // and save their positions
@@ -462,31 +517,79 @@ void GraphicItemWire::UpdateWireLineSegmentPositions(const QPointF& NewPos, Grap
         m_Current_x_VerticalDrawPoint = MidPoint_x;
     }
 
-    // Figure out if the the Vertical Line is Controlled by Program or by User
-    // If this is a middle Wire Line Segment, and the its AutoMoveFlag is set, then figure out the
-    // middle position, otherwise, the user set the position and we use that
-    if ((CallingWireLineSegment->IsWireLineAMiddleSegment() == true) && (CallingWireLineSegment->GetAutoMoveFlag() == true)) {
-        // Changed via Program Control
-        VerticalDrawPoint_x = m_Current_x_VerticalDrawPoint;
-    } else {
-        // Changed User Control
-        VerticalDrawPoint_x = m_Current_x_VerticalDrawPoint + NewPos.x();
-    }
+    // The Vertical Line is at the Program (or last User) set position,
+    // plus any offset the user is currently dragging the Middle Segment by
+    VerticalDrawPoint_x = m_Current_x_VerticalDrawPoint + MiddleXOffset;
 
     // Compute where the lines go
     m_MiddleStartVertical1Point = QPointF(VerticalDrawPoint_x, m_StartPoint.y());
     m_MiddleEndVertical1Point = QPointF(VerticalDrawPoint_x, m_EndPoint.y());
 
-    QLineF Line1 = QLineF(m_StartPoint, m_MiddleStartVertical1Point);
-    QLineF Line2 = QLineF(m_MiddleStartVertical1Point, m_MiddleEndVertical1Point);
-    QLineF Line3 = QLineF(m_MiddleEndVertical1Point, m_EndPoint);
-
-    m_StartPointLine->setLine(Line1);
-    m_MiddleVLine1->setLine(Line2);
-    m_EndPointLine->setLine(Line3);
+    // Routed Wires go around the Components (If no Route is found, the 3 Line Segments are drawn)
+    m_RoutePointList.clear();
+    Scene = qobject_cast<WiringScene*>(scene());
+    if ((m_AutoRouted == true) && (Scene != NULL)) {
+        GetRouteEndPoints(RouteStartPoint, RouteStartExit, RouteEndPoint, RouteEndExit);
+        foreach (const QPointF& RoutePoint, Scene->GetWireRouter()->RouteWire(RouteStartPoint, RouteStartExit, RouteEndPoint, RouteEndExit)) {
+            m_RoutePointList.append(mapFromScene(RoutePoint));
+        }
+    }
+    UpdateWireGeometry();
 
     // Set the project dirty
     emit ItemWireSetProjectDirty();
+    emit ItemWireGeometryChanged(this);
+}
+
+void GraphicItemWire::UpdateWireGeometry()
+{
+    int                 x;
+    QPainterPathStroker Stroker;
+    QPainterPath        MiddleSegmentPath;
+    qreal               HalfPenWidth = m_CurrentPen.widthF() / 2;
+    QSizeF              BadgeSize;
+
+    // Build the path along the Route, or the 3 Line Segments (Start -> Middle Vertical -> End)
+    prepareGeometryChange();
+    if (m_RoutePointList.isEmpty() == false) {
+        m_WirePath = QPainterPath(m_RoutePointList.first());
+        for (x = 1; x < m_RoutePointList.count(); x++) {
+            m_WirePath.lineTo(m_RoutePointList.at(x));
+        }
+    } else {
+        m_WirePath = QPainterPath(m_StartPoint);
+        m_WirePath.lineTo(m_MiddleStartVertical1Point);
+        m_WirePath.lineTo(m_MiddleEndVertical1Point);
+        m_WirePath.lineTo(m_EndPoint);
+    }
+
+    // The clickable outline is the width of the pen
+    Stroker.setWidth(qMax(m_CurrentPen.widthF(), (qreal)1.0));
+    m_WireShape = Stroker.createStroke(m_WirePath);
+
+    // A Routed Wire can be grabbed anywhere to hand move it (which turns off its Routing)
+    if (m_RoutePointList.isEmpty() == false) {
+        m_MiddleSegmentShape = m_WireShape;
+    } else {
+        MiddleSegmentPath.moveTo(m_MiddleStartVertical1Point);
+        MiddleSegmentPath.lineTo(m_MiddleEndVertical1Point);
+        m_MiddleSegmentShape = Stroker.createStroke(MiddleSegmentPath);
+    }
+
+    // The Bounding Rect covers the pen and both Handles (visible or not)
+    m_WireBoundingRect = m_WirePath.boundingRect().adjusted(-HalfPenWidth, -HalfPenWidth, HalfPenWidth, HalfPenWidth);
+    m_WireBoundingRect |= m_StartPointHandle->GetHandleRect().adjusted(-1, -1, 1, 1);
+    m_WireBoundingRect |= m_EndPointHandle->GetHandleRect().adjusted(-1, -1, 1, 1);
+
+    // The Lead of a Bundle shows the count of the Wires in the middle of the Bundle
+    m_BundleBadgeRect = QRectF();
+    if (m_WireBundleState == BUNDLE_LEAD) {
+        BadgeSize = m_BundleBadgeStaticText.size() + QSizeF(2 * WIRE_BUNDLE_BADGE_MARGIN, 2 * WIRE_BUNDLE_BADGE_MARGIN);
+        m_BundleBadgeRect = QRectF(QPointF(0, 0), BadgeSize);
+        m_BundleBadgeRect.moveCenter(m_WirePath.pointAtPercent(0.5));
+        m_WireBoundingRect |= m_BundleBadgeRect.adjusted(-1, -1, 1, 1);
+    }
+    update();
 }
 
 void GraphicItemWire::UpdateWireSelectedState(bool SelectedState)
@@ -513,76 +616,251 @@ void GraphicItemWire::UpdateWireSelectedState(bool SelectedState)
     // Enable the Wire Handles as appropriate
     m_StartPointHandle->MakeVisible((m_StartPointCurrentPortConnected == NULL) || m_WireSelectedState);
     m_EndPointHandle->MakeVisible((m_EndPointCurrentPortConnected == NULL) || m_WireSelectedState);
+    update();
 }
 
 void GraphicItemWire::UpdateWireLineZOrder(qreal z)
 {
-    // Set z value on parent also sets the value for children wire line segments
     setZValue(z);
 }
 
+bool GraphicItemWire::IsBusWire()
+{
+    if ((m_StartPointCurrentPortConnected != NULL) && (m_StartPointCurrentPortConnected->GetPortWidth() > 1)) {
+        return true;
+    }
+    if ((m_EndPointCurrentPortConnected != NULL) && (m_EndPointCurrentPortConnected->GetPortWidth() > 1)) {
+        return true;
+    }
+    return false;
+}
+
 void GraphicItemWire::UpdateWireLinePens()
 {
-    m_CurrentPen = QPen(m_CurrentWireColor, WIRE_PEN_WIDTH, m_CurrentPenStyle, Qt::RoundCap, Qt::RoundJoin);
+    qreal PenWidth = WIRE_PEN_WIDTH;
 
-    m_StartPointLine->setPen(m_CurrentPen);
-    m_MiddleVLine1->setPen(m_CurrentPen);
-    m_EndPointLine->setPen(m_CurrentPen);
+    // Bundles and Bus Wires are drawn wider than single Link Wires
+    if (m_WireBundleState == BUNDLE_LEAD) {
+        PenWidth = WIRE_BUNDLE_PEN_WIDTH;
+    } else if (IsBusWire() == true) {
+        PenWidth = WIRE_BUS_PEN_WIDTH;
+    }
+    QPen NewPen(m_CurrentWireColor, PenWidth, m_CurrentPenStyle, Qt::RoundCap, Qt::RoundJoin);
+
+    // A change of the pen width changes the outline of the Wire
+    if (NewPen.widthF() != m_CurrentPen.widthF()) {
+        m_CurrentPen = NewPen;
+        UpdateWireGeometry();
+    } else {
+        m_CurrentPen = NewPen;
+        update();
+    }
+}
+
+void GraphicItemWire::GetRouteEndPoints(QPointF& StartPoint, WireRouter::ExitDirection& StartExit, QPointF& EndPoint, WireRouter::ExitDirection& EndExit)
+{
+    StartPoint = mapToScene(m_StartPoint);
+    EndPoint = mapToScene(m_EndPoint);
+
+    // A Wire leaves a Port away from the side of the Component the Port is on
+    StartExit = WireRouter::EXIT_ANY;
+    if (m_StartPointCurrentPortConnected != NULL) {
+        StartExit = (m_StartPointCurrentPortConnected->GetAssignedComponentSide() == PortInfoData::SIDE_LEFT) ? WireRouter::EXIT_LEFT : WireRouter::EXIT_RIGHT;
+    }
+    EndExit = WireRouter::EXIT_ANY;
+    if (m_EndPointCurrentPortConnected != NULL) {
+        EndExit = (m_EndPointCurrentPortConnected->GetAssignedComponentSide() == PortInfoData::SIDE_LEFT) ? WireRouter::EXIT_LEFT : WireRouter::EXIT_RIGHT;
+    }
+}
+
+void GraphicItemWire::SetRoutePoints(const QVector<QPointF>& RoutePointList)
+{
+    // Use a Route found by the Scene (in Scene coordinates)
+    m_AutoRouted = true;
+    m_RoutePointList.clear();
+    foreach (const QPointF& RoutePoint, RoutePointList) {
+        m_RoutePointList.append(mapFromScene(RoutePoint));
+    }
+    UpdateWireGeometry();
+
+    // Set the project dirty
+    emit ItemWireSetProjectDirty();
+    emit ItemWireGeometryChanged(this);
+}
+
+void GraphicItemWire::SetWireBundleState(WireBundleState State, int BundleCount)
+{
+    if ((State == m_WireBundleState) && (BundleCount == m_WireBundleCount)) {
+        return;
+    }
+    m_WireBundleState = State;
+    m_WireBundleCount = BundleCount;
+
+    // Prepare the Badge Text once (The Count only changes when Wires join or leave the Bundle)
+    if (m_WireBundleState == BUNDLE_LEAD) {
+        m_BundleBadgeStaticText.setText(QString::number(m_WireBundleCount));
+        m_BundleBadgeStaticText.setTextFormat(Qt::PlainText);
+        m_BundleBadgeStaticText.prepare(QTransform(), m_BundleBadgeFont);
+    }
+
+    // The Lead is drawn with the Bundle Pen
+    UpdateWireLinePens();
+    UpdateWireGeometry();
 }
 
 QPainterPath GraphicItemWire::shape() const
 {
     // Provide a accurate outline of the object
-    // Used for collision algorithms
-    QPainterPath path;
+    // Used for collision algorithms and for clicking on the Wire
+    QPainterPath path = m_WireShape;
 
-    // Return the path of the WireLineSegments
-    path.addPath(m_StartPointLine->shape());
-    path.addPath(m_MiddleVLine1->shape());
-    path.addPath(m_EndPointLine->shape());
+    // The Members of a Bundle cannot be clicked on (They are drawn by the Lead)
+    if (m_WireBundleState == BUNDLE_MEMBER) {
+        return QPainterPath();
+    }
 
+    // The visible Handles and the Bundle Badge can also be clicked on
+    path.setFillRule(Qt::WindingFill);
+    if (m_WireBundleState == BUNDLE_LEAD) {
+        path.addRect(m_BundleBadgeRect);
+    }
+    if (m_StartPointHandle->IsVisible() == true) {
+        path.addRect(m_StartPointHandle->GetHandleRect());
+    }
+    if (m_EndPointHandle->IsVisible() == true) {
+        path.addRect(m_EndPointHandle->GetHandleRect());
+    }
     return path;
 }
 
 QRectF GraphicItemWire::boundingRect() const
 {
-    // boundingRect() is used for re-drawing the object, and
-    // also for rough collision detection.  We have to implement this
-    // routine since is QGraphicsItem::boundingRect is pure virtual.
-
-    QRectF RtnRect;
-
-    // Return the union of the WireLineSegments
-    RtnRect = RtnRect.united(m_StartPointLine->boundingRect());
-    RtnRect = RtnRect.united(m_MiddleVLine1->boundingRect());
-    RtnRect = RtnRect.united(m_EndPointLine->boundingRect());
-
-    return RtnRect;
+    return m_WireBoundingRect;
 }
 
 void GraphicItemWire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,  QWidget* widget /*=0*/)
 {
-    // Painting for this object is actually done by the WireSegments, but we have
-    // to implement this routine since is QGraphicsItem::paint is pure virtual.
-
     Q_UNUSED(option)
     Q_UNUSED(widget)
-    Q_UNUSED(painter)
+
+    // The Members of a Bundle are drawn by the Lead
+    if (m_WireBundleState == BUNDLE_MEMBER) {
+        return;
+    }
+
+    // We paint our own path because normally when an item is selected,
+    // a large bounding rectable is shown by the base class
+    painter->setPen(m_CurrentPen);
+    painter->setBrush(Qt::NoBrush);
+    painter->drawPath(m_WirePath);
+
+    // The Handles are drawn on top of the Wire
+    m_StartPointHandle->PaintHandle(painter);
+    m_EndPointHandle->PaintHandle(painter);
+
+    // The Badge with the count of the Wires in the Bundle
+    if (m_WireBundleState == BUNDLE_LEAD) {
+        painter->setPen(QPen(m_CurrentWireColor, 1));
+        painter->setBrush(WIRE_BUNDLE_BADGE_COLOR);
+        painter->drawRoundedRect(m_BundleBadgeRect, WIRE_BUNDLE_BADGE_MARGIN, WIRE_BUNDLE_BADGE_MARGIN);
+        painter->setPen(Qt::black);
+        painter->setFont(m_BundleBadgeFont);
+        painter->drawStaticText(m_BundleBadgeRect.topLeft() + QPointF(WIRE_BUNDLE_BADGE_MARGIN, WIRE_BUNDLE_BADGE_MARGIN), m_BundleBadgeStaticText);
+    }
 }
 
 QVariant GraphicItemWire::itemChange(GraphicsItemChange change, const QVariant& value)
 {
-    bool    SelectedState;
+    QPointF NewPos;
 
     // Did this get called to to a Selection Change?
     if (change == ItemSelectedChange && scene()) {
         // value is the selected state
-        SelectedState = value.toBool();
+        UpdateWireSelectedState(value.toBool());
+    }
+
+    // Selecting a Wire expands its Bundle
+    if (change == ItemSelectedHasChanged && scene()) {
+        emit ItemWireBundleStateChanged(this);
+    }
+
+    // Check to see if the X/Y position of the Wire is potentially changing
+    // NOTE: We dont want the position to change, but we do want to know what
+    //       the user has requested it to move by.  Only the Middle Segment is moved, and
+    //       only in the X direction (Horizontal).  This may be called multiple times
+    //       as the user drags, with the offset from where the drag started.
+    if (change == ItemPositionChange && scene()) {
+        NewPos = value.toPointF();
+
+        // Moving a Routed Wire turns off its Routing; Its Middle Segment starts where the Wire was grabbed
+        // (A Routed Wire moved along with other selected items is rerouted by its Ports instead)
+        if (m_AutoRouted == true) {
+            if (m_DraggingMiddleSegment == false) {
+                return QVariant(pos());
+            }
+            m_AutoRouted = false;
+            m_Current_x_VerticalDrawPoint = m_DragPressPoint.x();
+        }
+
+        // Turn off automatic wire positioning, now we use what was last set
+        m_AutomaticWireLinePositioning = false;
+
+        // Now redraw the wire line segments in the new position
+        UpdateWireLineSegmentPositions(NewPos.x() - pos().x());
+
+        // Dont move the position
+        return QVariant(pos());
     }
 
     return QGraphicsItem::itemChange(change, value);
 }
 
+void GraphicItemWire::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    // Only a press on the Middle Segment can drag the Wire (A press on a Handle moves the Handle instead)
+    m_DraggingMiddleSegment = (m_MiddleSegmentShape.contains(event->pos()) == true) && (GetWireHandleAtScenePoint(event->scenePos()) == NULL);
+    m_DragPressPoint = event->pos();
+
+    QGraphicsObject::mousePressEvent(event);
+}
+
+void GraphicItemWire::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
+{
+    // Dragging the Start or End Segments does nothing
+    if (m_DraggingMiddleSegment == false) {
+        return;
+    }
+
+    QGraphicsObject::mouseMoveEvent(event);
+}
+
+void GraphicItemWire::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
+{
+    // When the mouse is released on the Middle Segment (When updating its position)
+    if (m_DraggingMiddleSegment == true) {
+        m_Current_x_VerticalDrawPoint = m_MiddleStartVertical1Point.x();
+        m_DraggingMiddleSegment = false;
+    }
+
+    QGraphicsObject::mouseReleaseEvent(event);
+}
+
+void GraphicItemWire::hoverEnterEvent(QGraphicsSceneHoverEvent* event)
+{
+    m_WireHovered = true;
+    emit ItemWireBundleStateChanged(this);
+
+    QGraphicsObject::hoverEnterEvent(event);
+}
+
+void GraphicItemWire::hoverLeaveEvent(QGraphicsSceneHoverEvent* event)
+{
+    m_WireHovered = false;
+    emit ItemWireBundleStateChanged(this);
+
+    QGraphicsObject::hoverLeaveEvent(event);
+}
+
 void GraphicItemWire::PropertyChanged(QString& PropName, QString& NewPropValue)
 {
     Q_UNUSED(PropName)
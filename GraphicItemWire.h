@@ -20,15 +20,17 @@
 
 #include "GlobalIncludes.h"
 
-#include "GraphicItemWireLineSegment.h"
 #include "GraphicItemWireHandle.h"
 #include "GraphicItemPort.h"
+#include "WireRouter.h"
 
 // Forward declarations to allow compile
-class GraphicItemWireLineSegment;
+class GraphicItemWireHandle;
 
 ////////////////////////////////////////////////////////////
 
+// A Wire is a single Scene Item. It draws its three Line Segments as one cached
+// path, and hit tests its draggable Middle Segment and its two End Handles itself.
 class GraphicItemWire : public QGraphicsObject, public GraphicItemBase
 {
     Q_OBJECT
@@ -37,6 +39,9 @@ public:
     // Enumerations for Identifying the Wire Point Position
     enum ConnectedState { NO_CONNECTIONS, STARTPOINT_CONNECTED, ENDPOINT_CONNECTED, FULL_CONNECTION };
 
+    // How the Wire is drawn in a Bundle (The Lead draws the whole Bundle, the Members draw nothing)
+    enum WireBundleState { BUNDLE_NONE, BUNDLE_LEAD, BUNDLE_MEMBER };
+
     // Required Virtual function for any QGraphicItem to provide a type value for the qgraphicsitem_cast function
     enum { Type = UserType + ITEMTYPE_WIRE };
     int type() const {return Type;}
@@ -57,6 +62,11 @@ public:
     void UpdateEndPointPosition(const QPointF& NewPointLocation);
     void SetPastePosition(int PasteOffset);
 
+    // Queue an Update of the Start / End Point Positions (Processed once per frame by the Scene)
+    void QueueStartPointPosition(const QPointF& NewPointLocation);
+    void QueueEndPointPosition(const QPointF& NewPointLocation);
+    bool ProcessQueuedReroute();
+
     // Disconnect Ports
     void DisconnectAllAttachedPorts();
     void DisconnectPort(GraphicItemPort* Port, int MoveXOffset = 0);
@@ -65,30 +75,51 @@ public:
     GraphicItemPort* GetStartPointConnectedPort() {return m_StartPointCurrentPortConnected;}
     GraphicItemPort* GetEndPointConnectedPort() {return m_EndPointCurrentPortConnected;}
 
-    // Set the Wire Selected State (Will call the sub objects to select them as necessary)
+    // Set the Wire Selected State
     void SetWireSelected(bool SelectedState);
 
+    // Restyle the Wire from its Selected State (without changing the selection)
+    void SyncWireSelectedState();
+
+    // Get the visible End Handle under a Scene Point (or NULL)
+    GraphicItemWireHandle* GetWireHandleAtScenePoint(const QPointF& ScenePoint);
+
     // Get Start / End Point Positions
     QPointF GetStartPoint() {return m_StartPoint;}
     QPointF GetEndPoint() {return m_EndPoint;}
 
-    // Callback Handlers from the Lower Level WireLiineSegments
-    void HandleWireLineSegmentItemChange(const QPointF& NewPos, GraphicItemWireLineSegment* CallingWireLineSegment, GraphicsItemChange change, const QVariant& value);
-    void HandleWireLineSegmentMouseReleaseEvent(QGraphicsSceneMouseEvent* event);
-
     ConnectedState GetWireConnectedState() {return m_WireConnectedState;}
 
+    // Bus Wires (A wire connected to a Bus Port carries all of the Bus Instances)
+    bool IsBusWire();
+    void UpdateWireLinePens();
+
+    // Automatic Routing around the Components (Turned off when the user moves the Middle Segment)
+    void SetAutoRouted(bool AutoRouted) {m_AutoRouted = AutoRouted;}
+    bool IsAutoRouted() {return m_AutoRouted;}
+    void GetRouteEndPoints(QPointF& StartPoint, WireRouter::ExitDirection& StartExit, QPointF& EndPoint, WireRouter::ExitDirection& EndExit);
+    void SetRoutePoints(const QVector<QPointF>& RoutePointList);
+
+    // Bundling of the Wires between the same two Components (Set by the Scene)
+    void SetWireBundleState(WireBundleState State, int BundleCount);
+    WireBundleState GetWireBundleState() {return m_WireBundleState;}
+    bool IsWireHovered() {return m_WireHovered;}
+
 signals:
     void ItemWireSetProjectDirty();
+    void ItemWireRerouteQueued(GraphicItemWire* Wire);
+    void ItemWireGeometryChanged(GraphicItemWire* Wire);
+    void ItemWireConnectionChanged(GraphicItemWire* Wire);
+    void ItemWireBundleStateChanged(GraphicItemWire* Wire);
 
 private:
     // Update routines for the Wire Positions
-    void UpdatePointPositions(GraphicItemWireLineSegment* CallingWireLineSegment);
+    void UpdatePointPositions();
     void UpdatePortAndWireHandleSettings();
-    void UpdateWireLineSegmentPositions(const QPointF& NewPos, GraphicItemWireLineSegment* CallingWireLineSegment);
+    void UpdateWireLineSegmentPositions(qreal MiddleXOffset);
+    void UpdateWireGeometry();
     void UpdateWireSelectedState(bool SelectedState);
     void UpdateWireLineZOrder(qreal z);
-    void UpdateWireLinePens();
 
 private:
     // Overridden virtual functions
@@ -98,6 +129,15 @@ private:
 
     QVariant itemChange(GraphicsItemChange change, const QVariant& value);
 
+    // Mouse Handling (Only the Middle Segment can be dragged)
+    void mousePressEvent(QGraphicsSceneMouseEvent* event);
+    void mouseMoveEvent(QGraphicsSceneMouseEvent* event);
+    void mouseReleaseEvent(QGraphicsSceneMouseEvent* event);
+
+    // Hovering over a Bundle expands it
+    void hoverEnterEvent(QGraphicsSceneHoverEvent* event);
+    void hoverLeaveEvent(QGraphicsSceneHoverEvent* event);
+
     // Handle Changes to the Ports Properties
     void PropertyChanged(QString& PropName, QString& NewPropValue);
 
@@ -115,13 +155,28 @@ private:
 
     GraphicItemPort*            m_StartPointCurrentPortConnected;
     GraphicItemPort*            m_EndPointCurrentPortConnected;
+    GraphicItemPort*            m_NotifiedStartPort;    // Connected Ports the Scene was last told about
+    GraphicItemPort*            m_NotifiedEndPort;
 
     GraphicItemWireHandle*      m_StartPointHandle;
     GraphicItemWireHandle*      m_EndPointHandle;
 
-    GraphicItemWireLineSegment* m_StartPointLine;
-    GraphicItemWireLineSegment* m_MiddleVLine1;
-    GraphicItemWireLineSegment* m_EndPointLine;
+    bool                        m_AutoRouted;
+    QVector<QPointF>            m_RoutePointList;       // Points of the Routed Wire (Empty if the Wire is drawn as 3 Line Segments)
+
+    QPainterPath                m_WirePath;             // Cached Geometry of the Line Segments
+    QPainterPath                m_WireShape;            // Cached Stroked outline of the Segments
+    QPainterPath                m_MiddleSegmentShape;   // Cached Stroked outline of the Middle Segment
+    QRectF                      m_WireBoundingRect;
+    bool                        m_DraggingMiddleSegment;
+    QPointF                     m_DragPressPoint;
+    bool                        m_WireHovered;
+
+    WireBundleState             m_WireBundleState;
+    int                         m_WireBundleCount;
+    QFont                       m_BundleBadgeFont;
+    QStaticText                 m_BundleBadgeStaticText;
+    QRectF                      m_BundleBadgeRect;
 
     bool                        m_AutomaticWireLinePositioning;
 
@@ -131,6 +186,12 @@ private:
 
     bool                        m_WireSelectedState;
     ConnectedState              m_WireConnectedState;
+
+    bool                        m_RerouteQueued;
+    bool                        m_QueuedStartPointValid;
+    bool                        m_QueuedEndPointValid;
+    QPointF                     m_QueuedStartPoint;
+    QPointF                     m_QueuedEndPoint;
 };
 
 #endif // GRAPHICITEMWIRE_H
@@ -19,19 +19,16 @@
 
 ////////////////////////////////////////////////////////////
 
-GraphicItemWireHandle::GraphicItemWireHandle(const QPointF& InitPosition, WirePointPosition WirePointPos, QGraphicsItem* parent /*=0*/)
-    : QGraphicsRectItem(parent), GraphicItemBase(GraphicItemBase::ITEMTYPE_WIREHANDLE)
+GraphicItemWireHandle::GraphicItemWireHandle(const QPointF& InitPosition, WirePointPosition WirePointPos, GraphicItemWire* OwnerWire)
 {
     m_HandleConnectedPort = NULL;
     m_WirePointPosition = WirePointPos;
-
-    // Setup the size and color of the handle
-    setRect(WIRE_HANDLE_RECT);
+    m_OwnerWire = OwnerWire;
 
     // Initially Set the handle as not connected
     SetWireHandleConnectedPort(NULL);
 
-    // Update the position and make visible
+    // Update the position and make invisible
     UpdatePosition(InitPosition);
     MakeVisible(false);
 }
@@ -40,23 +37,6 @@ GraphicItemWireHandle::~GraphicItemWireHandle()
 {
 }
 
-void GraphicItemWireHandle::SaveData(QDataStream& DataStreamOut)
-{
-    Q_UNUSED(DataStreamOut)
-    // All Wire Data is saved in GraphicItemWire
-}
-
-void GraphicItemWireHandle::UpdatePosition(const QPointF& NewPosition)
-{
-    m_CurrentPosition = NewPosition;
-    setPos(NewPosition);
-}
-
-void GraphicItemWireHandle::MakeVisible(bool VisibleFlag)
-{
-    setVisible(VisibleFlag);
-}
-
 void GraphicItemWireHandle::SetWireHandleConnectedPort(GraphicItemPort* ptrPort)
 {
     // If the Port is NULL, then this handle is not connected to a port
@@ -65,16 +45,16 @@ void GraphicItemWireHandle::SetWireHandleConnectedPort(GraphicItemPort* ptrPort)
     {
         // Color of handle when connected to a port
         if (m_WirePointPosition == STARTPOINT) {
-            setBrush(WIRE_HANDLE_START_CONNECTED);
+            m_HandleColor = WIRE_HANDLE_START_CONNECTED;
         } else {
-            setBrush(WIRE_HANDLE_END_CONNECTED);
+            m_HandleColor = WIRE_HANDLE_END_CONNECTED;
         }
     } else {
         // Color of handle when NOT connected to a port
         if (m_WirePointPosition == STARTPOINT) {
-            setBrush(WIRE_HANDLE_START_DISCONNECTED);
+            m_HandleColor = WIRE_HANDLE_START_DISCONNECTED;
         } else {
-            setBrush(WIRE_HANDLE_END_DISCONNECTED);
+            m_HandleColor = WIRE_HANDLE_END_DISCONNECTED;
         }
     }
 
@@ -86,29 +66,14 @@ void GraphicItemWireHandle::SetWireHandleConnectedPort(GraphicItemPort* ptrPort)
     }
 }
 
-QVariant GraphicItemWireHandle::itemChange(GraphicsItemChange change, const QVariant& value)
+void GraphicItemWireHandle::PaintHandle(QPainter* painter)
 {
-    bool    SelectedState;
-
-    // Did this get called to to a Selection Change?
-    if (change == ItemSelectedChange && scene()) {
-        // value is the selected state
-        SelectedState = value.toBool();
+    if (m_VisibleFlag == false) {
+        return;
     }
 
-    return QGraphicsItem::itemChange(change, value);
-}
-
-
-GraphicItemWire* GraphicItemWireHandle::GetConnectedWire()
-{
-    GraphicItemWire* ptrWire;
-    QGraphicsItem*    ParentItem;
-
-    ParentItem = parentItem();
-
-    // Cast the parent of this WireHandle to a GraphicItemWire (or NULL if this item is not a wire)
-    ptrWire = qgraphicsitem_cast<GraphicItemWire*>(parentItem());
-    return ptrWire;
+    painter->setPen(QPen());
+    painter->setBrush(m_HandleColor);
+    painter->drawRect(GetHandleRect());
 }
 
@@ -20,55 +20,55 @@
 
 #include "GlobalIncludes.h"
 
-#include "GraphicItemBase.h"
 #include "GraphicItemWire.h"
 #include "GraphicItemPort.h"
 
-// Forward declarations to allow compile
 class GraphicItemPort;
 class GraphicItemWire;
 
 ////////////////////////////////////////////////////////////
 
-class GraphicItemWireHandle : public QGraphicsRectItem, public GraphicItemBase
+// A Wire Handle is not a Scene Item, it is the end point of a Wire,
+// and is drawn and hit tested by the Wire that owns it.
+class GraphicItemWireHandle
 {
 public:
     // Enumerations for Identifying the Wire Point Position
     enum WirePointPosition { STARTPOINT, ENDPOINT };
 
-    // Required Virtual function for any QGraphicItem to provide a type value for the qgraphicsitem_cast function
-    enum { Type = UserType + ITEMTYPE_WIREHANDLE };
-    int type() const {return Type;}
-
     // Constructor / Destructor
-    GraphicItemWireHandle(const QPointF& InitPosition, WirePointPosition WirePointPos, QGraphicsItem* parent=0);
+    GraphicItemWireHandle(const QPointF& InitPosition, WirePointPosition WirePointPos, GraphicItemWire* OwnerWire);
     virtual ~GraphicItemWireHandle();
 
-    // Serialization
-    void SaveData(QDataStream& DataStreamOut);
-
 public:
     // Update Positition and Control Visibility
-    void UpdatePosition(const QPointF& NewPosition);
-    void MakeVisible(bool VisibleFlag);
+    void UpdatePosition(const QPointF& NewPosition) {m_CurrentPosition = NewPosition;}
+    void MakeVisible(bool VisibleFlag) {m_VisibleFlag = VisibleFlag;}
+    bool IsVisible() {return m_VisibleFlag;}
+
+    // The Handle Rect (in Wire coordinates)
+    QRectF GetHandleRect() const {return QRectF(WIRE_HANDLE_RECT).translated(m_CurrentPosition);}
 
     // Set / Get Connected Port
     void SetWireHandleConnectedPort(GraphicItemPort* ptrPort);
     GraphicItemPort* GetWireHandleConnectedPort() {return m_HandleConnectedPort;}
 
-    // Get the parent GraphicItemWire
-    GraphicItemWire* GetConnectedWire();
+    // Get the GraphicItemWire that owns this Handle
+    GraphicItemWire* GetConnectedWire() {return m_OwnerWire;}
 
     // Get the current Point Position of this Wire Handle
     WirePointPosition GetWireHandlePointPosition() {return m_WirePointPosition;}
 
-private:
-    QVariant itemChange(GraphicsItemChange change, const QVariant& value);
+    // Drawing (Called by the Wire)
+    void PaintHandle(QPainter* painter);
 
 private:
     QPointF           m_CurrentPosition;
     WirePointPosition m_WirePointPosition;
     GraphicItemPort*  m_HandleConnectedPort;
+    GraphicItemWire*  m_OwnerWire;
+    QColor            m_HandleColor;
+    bool              m_VisibleFlag;
 };
 
 #endif // GRAPHICITEMWIREHANDLE_H
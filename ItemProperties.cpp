@@ -19,6 +19,35 @@
 
 ////////////////////////////////////////////////////////////
 
+ItemPropertyKey::ItemPropertyKey(const QString& PropertyName)
+{
+    m_PropertyName = PropertyName;
+    m_PropertyHash = qHash(PropertyName);
+}
+
+const ItemPropertyKey PROPKEY_COMPONENT_USERNAME(COMPONENT_PROPERTY_USERNAME);
+const ItemPropertyKey PROPKEY_COMPONENT_UNIQUENAME(COMPONENT_PROPERTY_UNIQUENAME);
+const ItemPropertyKey PROPKEY_COMPONENT_COMPNAME(COMPONENT_PROPERTY_COMPNAME);
+const ItemPropertyKey PROPKEY_COMPONENT_COMPPARENTELEM(COMPONENT_PROPERTY_COMPPARENTELEM);
+const ItemPropertyKey PROPKEY_COMPONENT_DESCRIPTION(COMPONENT_PROPERTY_DESCRIPTION);
+const ItemPropertyKey PROPKEY_COMPONENT_TYPE(COMPONENT_PROPERTY_TYPE);
+const ItemPropertyKey PROPKEY_COMPONENT_INDEX(COMPONENT_PROPERTY_INDEX);
+const ItemPropertyKey PROPKEY_COMPONENT_COMMENT(COMPONENT_PROPERTY_COMMENT);
+const ItemPropertyKey PROPKEY_COMPONENT_RANK(COMPONENT_PROPERTY_RANK);
+const ItemPropertyKey PROPKEY_COMPONENT_WEIGHT(COMPONENT_PROPERTY_WEIGHT);
+const ItemPropertyKey PROPKEY_COMPONENT_PARAMSET(COMPONENT_PROPERTY_PARAMSET);
+
+const ItemPropertyKey PROPKEY_PORT_DESCRIPTION(PORT_PROPERTY_DESCRIPTION);
+const ItemPropertyKey PROPKEY_PORT_CONFIGURED_NAME(PORT_PROPERTY_CONFIGURED_NAME);
+const ItemPropertyKey PROPKEY_PORT_GENERIC_NAME(PORT_PROPERTY_GENERIC_NAME);
+const ItemPropertyKey PROPKEY_PORT_PORTTYPE(PORT_PROPERTY_PORTTYPE);
+const ItemPropertyKey PROPKEY_PORT_LATENCY(PORT_PROPERTY_LATENCY);
+const ItemPropertyKey PROPKEY_PORT_COMMENT(PORT_PROPERTY_COMMENT);
+const ItemPropertyKey PROPKEY_PORT_ORIG_NAME(PORT_PROPERTY_ORIG_NAME);
+const ItemPropertyKey PROPKEY_PORT_CONTROLPARAM(PORT_PROPERTY_CONTROLPARAM);
+
+////////////////////////////////////////////////////////////
+
 ItemProperty::ItemProperty(ItemProperties* ParentItemProperties, QString PropertyName, QString OrigPropertyName, QString PropertyValue, QString PropertyDesc, bool ReadOnly, bool Exportable, bool DynamicFlag, QString ControllingParam)
 {
     // Init the Variables
@@ -33,21 +62,39 @@ ItemProperty::ItemProperty(ItemProperties* ParentItemProperties, QString Propert
     m_DynamicFlag = DynamicFlag;
     m_DefaultValue = PropertyValue;
     m_ControllingProperty = ControllingParam;
-    m_NumInstances = 0;
+    m_PropertyBlock = NULL;
+    m_BlockPosition = 0;
+
+    ParseValue();
 }
 
 ItemProperty::~ItemProperty()
 {
 }
 
+void ItemProperty::SetName(QString NewName)
+{
+    QString OldName = m_PropertyName;
+
+    m_PropertyName = NewName;
+
+    // Tell the Parent Properties List so it can reindex its Names
+    m_ParentProperties->PropertyNameChanged(this, OldName);
+}
+
 void ItemProperty::SetValue(QString NewValue, bool PerformCallback /*=true*/)
 {
+    bool WasRequired = m_ValueRequired;
+
     // Set the Property Value, Callback the PropertyChanged if requested (happens most of the time)
-    m_PropertyValue = NewValue;
+    if (NewValue != m_PropertyValue) {
+        m_PropertyValue = NewValue;
+        ParseValue();
+    }
 
     // Tell the Parent Properties List that this property changed, it may also tell the
     // Graphical Item if the PerformCallback is true
-    m_ParentProperties->PropertyChanged(m_PropertyName, m_PropertyValue, PerformCallback);
+    m_ParentProperties->PropertyChanged(this, WasRequired, PerformCallback);
 }
 
 void ItemProperty::SaveData(QDataStream& DataStreamOut)
@@ -63,13 +110,17 @@ void ItemProperty::SaveData(QDataStream& DataStreamOut)
     DataStreamOut << m_Exportable;
     DataStreamOut << m_DynamicFlag;
     DataStreamOut << m_ControllingProperty;
-    DataStreamOut << (qint32)m_NumInstances;
+    DataStreamOut << (qint32)GetNumInstances();
 }
 
 ItemProperty::ItemProperty(ItemProperties* ParentItemProperties, QDataStream& DataStreamIn)
 {
+    qint32 NumInstances;
+
     // Serialization Load
     m_ParentProperties = ParentItemProperties;
+    m_PropertyBlock = NULL;
+    m_BlockPosition = 0;
 
     // Read In the data
     DataStreamIn >> m_PropertyName;
@@ -81,7 +132,18 @@ ItemProperty::ItemProperty(ItemProperties* ParentItemProperties, QDataStream& Da
     DataStreamIn >> m_Exportable;
     DataStreamIn >> m_DynamicFlag;
     DataStreamIn >> m_ControllingProperty;
-    DataStreamIn >> m_NumInstances;
+
+    // The Number of Instances is kept by the Property Block (The Parent rebuilds it from the loaded Properties)
+    DataStreamIn >> NumInstances;
+
+    ParseValue();
+}
+
+void ItemProperty::ParseValue()
+{
+    // Cache what is read over and over (Dynamic Port and Property counts, the REQUIRED check on export)
+    m_IntValue = m_PropertyValue.toInt();
+    m_ValueRequired = (m_PropertyValue == COMPONENT_PROPERTY_VALUE_REQUIRED);
 }
 
 ////////////////////////////////////////////////////////////
@@ -90,21 +152,29 @@ ItemProperties::ItemProperties(GraphicItemBase* ParentGraphicItemBase)
 {
     // Init Variables
     m_ParentGraphicItemBase = ParentGraphicItemBase;  // Base Graphic Item that holds these properties
-    m_PropertyList.clear();
+    m_PropertyBlockList.clear();
+    m_NumProperties = 0;
+    m_NumRequiredValues = 0;
+    m_BlockStartIndexesValid = true;
+    m_PropertyNameMap.clear();
+    m_ControlledBlockMap.clear();
 }
 
 ItemProperties::~ItemProperties()
 {
-    ItemProperty* PropItem;
-    int           x;
-    int           NumProperties = GetNumProperties();
-
-    // Delete all the properties that were created
-    for (x = 0; x < NumProperties; x++) {
-        PropItem = m_PropertyList.at(0);
-        delete PropItem;
-        m_PropertyList.removeAt(0);
+    ItemPropertyBlock* PropertyBlock;
+    int                x;
+    int                y;
+
+    // Delete all the properties and blocks that were created
+    for (x = 0; x < m_PropertyBlockList.count(); x++) {
+        PropertyBlock = m_PropertyBlockList.at(x);
+        for (y = 0; y < PropertyBlock->PropertyList.count(); y++) {
+            delete PropertyBlock->PropertyList.at(y);
+        }
+        delete PropertyBlock;
     }
+    m_PropertyBlockList.clear();
 }
 
 void ItemProperties::AddProperty(QString PropertyName, QString PropertyValue /*=""*/, QString PropertyDesc /*=""*/, bool ReadOnly /*=false*/, bool Exportable/*=true*/)
@@ -155,7 +225,7 @@ void ItemProperties::AddProperty(QString PropertyName, QString PropertyValue /*=
 
 int ItemProperties::GetNumProperties()
 {
-    return m_PropertyList.count();
+    return m_NumProperties;
 }
 
 void ItemProperties::SetPropertyValue(QString PropertyName, QString PropertyValue)
@@ -172,83 +242,132 @@ void ItemProperties::SetPropertyValue(int Index, QString PropertyValue)
 {
     ItemProperty* PropItem;
 
-    if (Index < GetNumProperties()) {
-        PropItem = m_PropertyList.at(Index);
+    PropItem = GetProperty(Index);
+    if (PropItem != NULL) {
         PropItem->SetValue(PropertyValue);
     }
 }
 
 int ItemProperties::GetPropertyIndex(QString PropertyName)
 {
-    int x;
+    ItemProperty* PropItem = FindProperty(PropertyName, qHash(PropertyName));
 
-    for (x = 0; x < GetNumProperties(); x++) {
-        if (PropertyName == m_PropertyList.at(x)->GetName()) {
-            return x;
-        }
+    if (PropItem == NULL) {
+        return -1;
+    }
+
+    if (m_BlockStartIndexesValid == false) {
+        UpdateBlockStartIndexes();
+    }
+    return PropItem->GetPropertyBlock()->StartIndex + PropItem->GetBlockPosition();
+}
+
+int ItemProperties::GetPropertyIndex(const ItemPropertyKey& PropertyKey)
+{
+    ItemProperty* PropItem = FindProperty(PropertyKey.GetName(), PropertyKey.GetHash());
+
+    if (PropItem == NULL) {
+        return -1;
+    }
+
+    if (m_BlockStartIndexesValid == false) {
+        UpdateBlockStartIndexes();
     }
-    return -1;
+    return PropItem->GetPropertyBlock()->StartIndex + PropItem->GetBlockPosition();
 }
 
 QString ItemProperties::GetPropertyValue(QString PropertyName)
 {
-    int x;
+    ItemProperty* PropItem = GetProperty(PropertyName);
 
-    for (x = 0; x < GetNumProperties(); x++) {
-        if (PropertyName == m_PropertyList.at(x)->GetName()) {
-            return m_PropertyList.at(x)->GetValue();
-        }
+    if (PropItem != NULL) {
+        return PropItem->GetValue();
+    }
+    return "";
+}
+
+QString ItemProperties::GetPropertyValue(const ItemPropertyKey& PropertyKey)
+{
+    ItemProperty* PropItem = GetProperty(PropertyKey);
+
+    if (PropItem != NULL) {
+        return PropItem->GetValue();
     }
     return "";
 }
 
 QString ItemProperties::GetPropertyDesc(QString PropertyName)
 {
-    int x;
+    ItemProperty* PropItem = GetProperty(PropertyName);
 
-    for (x = 0; x < GetNumProperties(); x++) {
-        if (PropertyName == m_PropertyList.at(x)->GetName()) {
-            return m_PropertyList.at(x)->GetDesc();
-        }
+    if (PropItem != NULL) {
+        return PropItem->GetDesc();
     }
     return "";
 }
 
 ItemProperty* ItemProperties::GetProperty(QString PropertyName)
 {
-    int x;
+    return FindProperty(PropertyName, qHash(PropertyName));
+}
 
-    for (x = 0; x < GetNumProperties(); x++) {
-        if (PropertyName == m_PropertyList.at(x)->GetName()) {
-            return m_PropertyList.at(x);
-        }
-    }
-    return NULL;
+ItemProperty* ItemProperties::GetProperty(const ItemPropertyKey& PropertyKey)
+{
+    return FindProperty(PropertyKey.GetName(), PropertyKey.GetHash());
 }
 
 ItemProperty* ItemProperties::GetProperty(int Index)
 {
-    if (Index < GetNumProperties()) {
-        return m_PropertyList.at(Index);
+    ItemPropertyBlock* PropertyBlock;
+    int                Low;
+    int                High;
+    int                Mid;
+
+    if ((Index < 0) || (Index >= m_NumProperties)) {
+        return NULL;
     }
-    return NULL;
+
+    if (m_BlockStartIndexesValid == false) {
+        UpdateBlockStartIndexes();
+    }
+
+    // Binary search for the last Block that starts at or before the Index
+    Low = 0;
+    High = m_PropertyBlockList.count() - 1;
+    while (Low < High) {
+        Mid = (Low + High + 1) / 2;
+        if (m_PropertyBlockList.at(Mid)->StartIndex <= Index) {
+            Low = Mid;
+        } else {
+            High = Mid - 1;
+        }
+    }
+    PropertyBlock = m_PropertyBlockList.at(Low);
+    return PropertyBlock->PropertyList.at(Index - PropertyBlock->StartIndex);
 }
 
 void ItemProperties::SaveData(QDataStream& DataStreamOut)
 {
-    int x;
+    ItemPropertyBlock* PropertyBlock;
+    int                x;
+    int                y;
 
     // Serialization Save
     // Save the number of Properties and then each one
-    DataStreamOut << (qint32)m_PropertyList.count();
-    for (x = 0; x < m_PropertyList.count(); x++) {
-        m_PropertyList[x]->SaveData(DataStreamOut);
+    DataStreamOut << (qint32)m_NumProperties;
+    for (x = 0; x < m_PropertyBlockList.count(); x++) {
+        PropertyBlock = m_PropertyBlockList.at(x);
+        for (y = 0; y < PropertyBlock->PropertyList.count(); y++) {
+            PropertyBlock->PropertyList.at(y)->SaveData(DataStreamOut);
+        }
     }
 }
 
 void ItemProperties::LoadData(QDataStream& DataStreamIn)
 {
-    int NumProperties;
+    int                NumProperties;
+    ItemPropertyBlock* PropertyBlock = NULL;
+    ItemProperty*      FirstProperty;
 
     // Serialization Load
     // Load the number of properties
@@ -259,126 +378,84 @@ void ItemProperties::LoadData(QDataStream& DataStreamIn)
         // Create the new ItemProperty
         ItemProperty* PropItem = new ItemProperty(this, DataStreamIn);
 
-        // Add it to the list
-        m_PropertyList.push_back(PropItem);
+        // The Instances of a Dynamic Property are saved one after the other, so
+        // they continue the Block of the previous Property
+        if ((PropertyBlock != NULL) && (PropItem->GetDynamicFlag() == true)) {
+            FirstProperty = PropertyBlock->PropertyList.at(0);
+            if ((FirstProperty->GetDynamicFlag() == true) && (FirstProperty->GetOriginalPropertyName() == PropItem->GetOriginalPropertyName())) {
+                AddPropertyToBlock(PropertyBlock, PropItem);
+                PropertyBlock->NumInstances = PropertyBlock->PropertyList.count();
+                continue;
+            }
+        }
+
+        // Add it to the list in its own Block
+        PropertyBlock = AddNewPropertyBlock(PropItem);
+
+        // A Dynamic Property with no Instances keeps its Original Name
+        if ((PropItem->GetDynamicFlag() == true) && (PropItem->GetName() != PropItem->GetOriginalPropertyName())) {
+            PropertyBlock->NumInstances = 1;
+        }
     }
 }
 
-void ItemProperties::PropertyChanged(QString PropName, QString PropNewValue, bool PerformCallback)
+void ItemProperties::PropertyChanged(ItemProperty* Property, bool WasRequired, bool PerformCallback)
 {
+    QString PropName = Property->GetName();
+    QString PropNewValue = Property->GetValue();
+
+    // Keep the count of REQUIRED Values up to date
+    if (WasRequired != Property->IsValueRequired()) {
+        m_NumRequiredValues += (Property->IsValueRequired() == true) ? 1 : -1;
+    }
+
     // This property has changed, tell the Graphical Item if the PerformCallback is true
     if (PerformCallback == true) {
         GetParentGraphicItemBase()->PropertyChanged(PropName, PropNewValue);
     }
 
-    CheckIfDynamicPropertyChanged(PropName, PropNewValue, PerformCallback);
+    CheckIfDynamicPropertyChanged(Property, PerformCallback);
 }
 
-void ItemProperties::CheckIfDynamicPropertyChanged(QString PropName, QString PropNewValue, bool PerformCallback)
+void ItemProperties::CheckIfDynamicPropertyChanged(ItemProperty* Property, bool PerformCallback)
 {
-    int           x;
-    ItemProperty* Property;
-    int           NumNewInstances;
-    QStringList   ProcessedPropertyNamesList;
-    QString       PropertyOriginalName;
-
-    // Now check to see if this parameter is a controlling parameter for any dynamic parameters
-    for (x = 0; x < m_PropertyList.count(); x++) {
-        Property = m_PropertyList.at(x);
-        PropertyOriginalName = Property->GetOriginalPropertyName();
-
-        // See if we have already processed this property
-        if (ProcessedPropertyNamesList.contains(PropertyOriginalName) == false) {
-            // See if the property Name matches a controlling Property name
-            if ((PropName == Property->GetControllingProperty()) && (Property->GetDynamicFlag() == true)) {
-                // Get the number of current instances of the dynamic property
-                NumNewInstances = PropNewValue.toInt();
-
-                // Adust Property in Main array
-                AdjustDynamicPropertyInList(Property->GetName(), NumNewInstances, PerformCallback);
-
-                // Reset the loop and do it again
-                x = -1;
-            }
-        }
-        ProcessedPropertyNamesList.append(PropertyOriginalName);
+    QList<ItemPropertyBlock*> ControlledBlockList;
+    int                       NumNewInstances;
+    int                       x;
+
+    // Only the Dynamic Properties controlled by this parameter are touched
+    ControlledBlockList = m_ControlledBlockMap.values(Property->GetName());
+    if (ControlledBlockList.isEmpty() == true) {
+        return;
+    }
+
+    // Get the number of new instances of the dynamic properties
+    NumNewInstances = Property->GetIntValue();
+
+    // The Map returns the most recently added Block first, adjust them in list order
+    for (x = ControlledBlockList.count() - 1; x >= 0; x--) {
+        ResizeDynamicPropertyBlock(ControlledBlockList.at(x), NumNewInstances, PerformCallback);
     }
 }
 
 void ItemProperties::AdjustDynamicPropertyInList(QString PropertyName, int NumInstances, bool PerformCallback)
 {
-    int           x;
-    int           StartingListIndex;
     ItemProperty* CurrentProperty;
-    ItemProperty* NewProperty;
-    int           CurrentInstances;
-    QString       OrigPropertyName;
-    QString       NewName;
-    QString       RemoveName;
-    bool          AdjustmentMade = false;
 
-    // Find the Index of the Dynamic Property Name and a pointer to the object.  Note: Name will either have a %d or a 0 inside it
-    StartingListIndex = GetPropertyIndex(PropertyName);
+    // Find the Dynamic Property.  Note: Name will either have a %d or a 0 inside it
     CurrentProperty = GetProperty(PropertyName);
-    CurrentInstances = CurrentProperty->GetNumInstances();
-    OrigPropertyName = CurrentProperty->GetOriginalPropertyName();
-
-    // Do we add new instances
-    if (NumInstances > CurrentInstances) {
-        for (x = CurrentInstances; x < NumInstances; x++) {
-            // Replace the %d in the original name with the new Index
-            NewName = OrigPropertyName;
-            NewName.replace("%d", QString("%1").arg(x));
-
-            if (x == 0) {
-                // Special case for the first entry
-                CurrentProperty->SetName(NewName);
-            } else {
-                // Create the new ItemProperty
-                NewProperty = new ItemProperty(this, NewName, CurrentProperty->GetOriginalPropertyName(), CurrentProperty->GetDefaultValue(), CurrentProperty->GetDesc(), CurrentProperty->GetReadOnly(), CurrentProperty->GetExportable(), true, CurrentProperty->GetControllingProperty());
-
-                // Add it to the list at the right location
-                m_PropertyList.insert(StartingListIndex + x, NewProperty);
-            }
-            AdjustmentMade = true;
-        }
-    }
-
-    // Do we remove instances
-    if (NumInstances < CurrentInstances) {
-        for (x = CurrentInstances - 1; x >= NumInstances; x--) {
-            RemoveName = OrigPropertyName;
-            RemoveName.replace("%d", QString("%1").arg(x));
-            StartingListIndex = GetPropertyIndex(RemoveName);
-            CurrentProperty = GetProperty(RemoveName);
-
-            if (x == 0) {
-                // Special Case for the first entry
-                CurrentProperty->SetName(OrigPropertyName);
-            } else {
-                // Figure out what the name that we want to remove
-                m_PropertyList.removeAt(StartingListIndex);
-                delete CurrentProperty;
-            }
-            AdjustmentMade = true;
-        }
+    if ((CurrentProperty == NULL) || (CurrentProperty->GetDynamicFlag() == false)) {
+        return;
     }
 
-    // Perform the callback if an adjustment was made
-    if (AdjustmentMade == true) {
-        // Go through all properties with the original name we first processed and update the number of instances
-        for (x = 0; x < m_PropertyList.count(); x++)
-        {
-            CurrentProperty = m_PropertyList.at(x);
-            if (CurrentProperty->GetOriginalPropertyName() == OrigPropertyName) {
-                CurrentProperty->SetNumInstances(NumInstances);
-            }
-        }
+    ResizeDynamicPropertyBlock(CurrentProperty->GetPropertyBlock(), NumInstances, PerformCallback);
+}
 
-        if (PerformCallback == true) {
-            m_ParentGraphicItemBase->DynamicPropertiesChanged(this);
-        }
-    }
+void ItemProperties::PropertyNameChanged(ItemProperty* Property, QString OldPropName)
+{
+    // Move the Property to its new Name in the Name Map
+    m_PropertyNameMap.remove(qHash(OldPropName), Property);
+    m_PropertyNameMap.insert(qHash(Property->GetName()), Property);
 }
 
 void ItemProperties::AddStaticProperty(QString PropertyName, QString PropertyValue, QString PropertyDesc, bool ReadOnly, bool Exportable)
@@ -392,7 +469,7 @@ void ItemProperties::AddStaticProperty(QString PropertyName, QString PropertyVal
         PropItem = new ItemProperty(this, PropertyName, PropertyName, PropertyValue, PropertyDesc, ReadOnly, Exportable, false, "");
 
         // Add it to the list
-        m_PropertyList.push_back(PropItem);
+        AddNewPropertyBlock(PropItem);
     }
 }
 
@@ -407,19 +484,142 @@ void ItemProperties::AddDynamicProperty(QString PropertyName, QString PropertyVa
         PropItem = new ItemProperty(this, PropertyName, PropertyName, PropertyValue, PropertyDesc, ReadOnly, Exportable, true, ControllingParam);
 
         // Add it to the list
-        m_PropertyList.push_back(PropItem);
+        AddNewPropertyBlock(PropItem);
     }
 }
 
 bool ItemProperties::IsPropertyNameNotInList(QString PropertyName)
+{
+    // See if the property name is already in the list
+    return (GetProperty(PropertyName) == NULL);
+}
+
+ItemPropertyBlock* ItemProperties::AddNewPropertyBlock(ItemProperty* PropItem)
+{
+    ItemPropertyBlock* PropertyBlock;
+
+    // Create a new Block at the end of the list (This does not move any other Block)
+    PropertyBlock = new ItemPropertyBlock;
+    PropertyBlock->NumInstances = 0;
+    PropertyBlock->StartIndex = m_NumProperties;
+    m_PropertyBlockList.push_back(PropertyBlock);
+
+    AddPropertyToBlock(PropertyBlock, PropItem);
+
+    // Dynamic Properties are found by their Controlling Parameter
+    if ((PropItem->GetDynamicFlag() == true) && (PropItem->GetControllingProperty().isEmpty() == false)) {
+        m_ControlledBlockMap.insert(PropItem->GetControllingProperty(), PropertyBlock);
+    }
+    return PropertyBlock;
+}
+
+void ItemProperties::AddPropertyToBlock(ItemPropertyBlock* PropertyBlock, ItemProperty* PropItem)
+{
+    // Add the Property to the end of the Block
+    PropItem->SetPropertyBlock(PropertyBlock, PropertyBlock->PropertyList.count());
+    PropertyBlock->PropertyList.push_back(PropItem);
+    m_PropertyNameMap.insert(qHash(PropItem->GetName()), PropItem);
+    m_NumProperties++;
+    if (PropItem->IsValueRequired() == true) {
+        m_NumRequiredValues++;
+    }
+
+    // Growing any Block but the last one moves the Blocks after it
+    if (PropertyBlock != m_PropertyBlockList.last()) {
+        m_BlockStartIndexesValid = false;
+    }
+}
+
+void ItemProperties::ResizeDynamicPropertyBlock(ItemPropertyBlock* PropertyBlock, int NumInstances, bool PerformCallback)
 {
     int           x;
+    ItemProperty* FirstProperty;
+    ItemProperty* NewProperty;
+    ItemProperty* RemoveProperty;
+    int           CurrentInstances;
+    QString       OrigPropertyName;
+    QString       NewName;
 
-    // See if the property name is already in the list
-    for (x = 0; x < m_PropertyList.count(); x++) {
-        if (PropertyName == m_PropertyList.at(x)->GetName()) {
-            return false;
+    FirstProperty = PropertyBlock->PropertyList.at(0);
+    CurrentInstances = PropertyBlock->NumInstances;
+    OrigPropertyName = FirstProperty->GetOriginalPropertyName();
+
+    // A negative count removes all the instances
+    if (NumInstances < 0) {
+        NumInstances = 0;
+    }
+    if (NumInstances == CurrentInstances) {
+        return;
+    }
+
+    // Do we add new instances (to the end of the Block)
+    for (x = CurrentInstances; x < NumInstances; x++) {
+        // Replace the %d in the original name with the new Index
+        NewName = OrigPropertyName;
+        NewName.replace("%d", QString("%1").arg(x));
+
+        if (x == 0) {
+            // Special case for the first entry
+            FirstProperty->SetName(NewName);
+        } else {
+            // Create the new ItemProperty
+            NewProperty = new ItemProperty(this, NewName, OrigPropertyName, FirstProperty->GetDefaultValue(), FirstProperty->GetDesc(), FirstProperty->GetReadOnly(), FirstProperty->GetExportable(), true, FirstProperty->GetControllingProperty());
+            AddPropertyToBlock(PropertyBlock, NewProperty);
         }
     }
-    return true;
+
+    // Do we remove instances (from the end of the Block)
+    for (x = CurrentInstances - 1; x >= NumInstances; x--) {
+        if (x == 0) {
+            // Special Case for the first entry
+            FirstProperty->SetName(OrigPropertyName);
+        } else {
+            RemoveProperty = PropertyBlock->PropertyList.takeLast();
+            m_PropertyNameMap.remove(qHash(RemoveProperty->GetName()), RemoveProperty);
+            m_NumProperties--;
+            if (RemoveProperty->IsValueRequired() == true) {
+                m_NumRequiredValues--;
+            }
+            delete RemoveProperty;
+
+            // Shrinking any Block but the last one moves the Blocks after it
+            if (PropertyBlock != m_PropertyBlockList.last()) {
+                m_BlockStartIndexesValid = false;
+            }
+        }
+    }
+
+    // All the Instances share the count held by the Block
+    PropertyBlock->NumInstances = NumInstances;
+
+    if (PerformCallback == true) {
+        m_ParentGraphicItemBase->DynamicPropertiesChanged(this);
+    }
+}
+
+void ItemProperties::UpdateBlockStartIndexes()
+{
+    ItemPropertyBlock* PropertyBlock;
+    int                StartIndex = 0;
+    int                x;
+
+    for (x = 0; x < m_PropertyBlockList.count(); x++) {
+        PropertyBlock = m_PropertyBlockList.at(x);
+        PropertyBlock->StartIndex = StartIndex;
+        StartIndex += PropertyBlock->PropertyList.count();
+    }
+    m_BlockStartIndexesValid = true;
+}
+
+ItemProperty* ItemProperties::FindProperty(const QString& PropertyName, uint PropertyHash)
+{
+    QMultiHash<uint, ItemProperty*>::const_iterator it;
+
+    // Several Names may share a Hash, so check the Name of each candidate
+    for (it = m_PropertyNameMap.constFind(PropertyHash); (it != m_PropertyNameMap.constEnd()) && (it.key() == PropertyHash); ++it) {
+        if (PropertyName == it.value()->GetName()) {
+            return it.value();
+        }
+    }
+    return NULL;
 }
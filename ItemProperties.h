@@ -23,6 +23,58 @@
 // Forward declarations to allow compile
 class GraphicItemBase;
 class ItemProperties;
+class ItemProperty;
+
+////////////////////////////////////////////////////////////
+
+// A Block of the Property List; either one Static Property, or all the Instances of
+// one Dynamic Property (A Dynamic Property with no Instances keeps its "%d" Property)
+struct ItemPropertyBlock
+{
+    QList<ItemProperty*> PropertyList;
+    int                  NumInstances;     // Instances of the Dynamic Property (0 for a Static Property)
+    int                  StartIndex;       // Index of the first Property of the Block in the whole Property List
+};
+
+////////////////////////////////////////////////////////////
+
+// A Property Name with its Hash precomputed (Used for the fixed Property Names
+// that are looked up on every Item)
+class ItemPropertyKey
+{
+public:
+    explicit ItemPropertyKey(const QString& PropertyName);
+
+    const QString& GetName() const {return m_PropertyName;}
+    uint GetHash() const {return m_PropertyHash;}
+
+private:
+    QString m_PropertyName;
+    uint    m_PropertyHash;
+};
+
+// Keys for the fixed Component Properties
+extern const ItemPropertyKey PROPKEY_COMPONENT_USERNAME;
+extern const ItemPropertyKey PROPKEY_COMPONENT_UNIQUENAME;
+extern const ItemPropertyKey PROPKEY_COMPONENT_COMPNAME;
+extern const ItemPropertyKey PROPKEY_COMPONENT_COMPPARENTELEM;
+extern const ItemPropertyKey PROPKEY_COMPONENT_DESCRIPTION;
+extern const ItemPropertyKey PROPKEY_COMPONENT_TYPE;
+extern const ItemPropertyKey PROPKEY_COMPONENT_INDEX;
+extern const ItemPropertyKey PROPKEY_COMPONENT_COMMENT;
+extern const ItemPropertyKey PROPKEY_COMPONENT_RANK;
+extern const ItemPropertyKey PROPKEY_COMPONENT_WEIGHT;
+extern const ItemPropertyKey PROPKEY_COMPONENT_PARAMSET;
+
+// Keys for the fixed Port Properties
+extern const ItemPropertyKey PROPKEY_PORT_DESCRIPTION;
+extern const ItemPropertyKey PROPKEY_PORT_CONFIGURED_NAME;
+extern const ItemPropertyKey PROPKEY_PORT_GENERIC_NAME;
+extern const ItemPropertyKey PROPKEY_PORT_PORTTYPE;
+extern const ItemPropertyKey PROPKEY_PORT_LATENCY;
+extern const ItemPropertyKey PROPKEY_PORT_COMMENT;
+extern const ItemPropertyKey PROPKEY_PORT_ORIG_NAME;
+extern const ItemPropertyKey PROPKEY_PORT_CONTROLPARAM;
 
 ////////////////////////////////////////////////////////////
 
@@ -41,13 +93,17 @@ public:
     ItemProperties* GetParentProperties() {return m_ParentProperties;}
 
     // Property Name
-    void SetName(QString NewName) {m_PropertyName = NewName;}
+    void SetName(QString NewName);
     QString GetName() {return m_PropertyName;}
 
     // Property  Value
     void SetValue(QString NewValue, bool PerformCallback = true);
     QString GetValue() {return m_PropertyValue;}
 
+    // Property Parsed Value (Parsed once when the Value is set)
+    int GetIntValue() {return m_IntValue;}                // Same as GetValue().toInt()
+    bool IsValueRequired() {return m_ValueRequired;}     // Value is still the REQUIRED placeholder
+
     // Property  Description
     void SetDesc(QString NewDesc) {m_PropertyDesc = NewDesc;}
     QString GetDesc() {return m_PropertyDesc;}
@@ -65,24 +121,34 @@ public:
     QString GetDefaultValue() {return m_DefaultValue;}
     QString GetOriginalPropertyName() {return m_OriginalPropertyName;}
     QString GetControllingProperty() {return m_ControllingProperty;}
-    void SetNumInstances(int NumInstances) {m_NumInstances = NumInstances;}
-    int GetNumInstances() {return m_NumInstances;}
+    int GetNumInstances() {return (m_PropertyBlock != NULL) ? m_PropertyBlock->NumInstances : 0;}
+
+    // Location in the Parent Properties List (Set by the Parent Properties)
+    void SetPropertyBlock(ItemPropertyBlock* PropertyBlock, int BlockPosition) {m_PropertyBlock = PropertyBlock; m_BlockPosition = BlockPosition;}
+    ItemPropertyBlock* GetPropertyBlock() {return m_PropertyBlock;}
+    int GetBlockPosition() {return m_BlockPosition;}
 
     // Save the Property Data (Used for serialization)
     void SaveData(QDataStream& DataStreamOut);
 
 private:
-    QString          m_PropertyName;
-    QString          m_OriginalPropertyName;
-    QString          m_PropertyValue;
-    QString          m_DefaultValue;
-    QString          m_PropertyDesc;
-    bool             m_ReadOnly;
-    bool             m_Exportable;
-    bool             m_DynamicFlag;
-    QString          m_ControllingProperty;
-    int              m_NumInstances;
-    ItemProperties*  m_ParentProperties;
+    void ParseValue();
+
+private:
+    QString            m_PropertyName;
+    QString            m_OriginalPropertyName;
+    QString            m_PropertyValue;
+    int                m_IntValue;
+    bool               m_ValueRequired;
+    QString            m_DefaultValue;
+    QString            m_PropertyDesc;
+    bool               m_ReadOnly;
+    bool               m_Exportable;
+    bool               m_DynamicFlag;
+    QString            m_ControllingProperty;
+    ItemProperties*    m_ParentProperties;
+    ItemPropertyBlock* m_PropertyBlock;
+    int                m_BlockPosition;
 };
 
 ////////////////////////////////////////////////////////////
@@ -103,17 +169,23 @@ public:
     // Return the Number of properties this object holds
     int GetNumProperties();
 
+    // Return the Number of properties whose Value is still REQUIRED
+    int GetNumRequiredValues() {return m_NumRequiredValues;}
+
     // Set a Property Value
     void SetPropertyValue(QString PropertyName, QString PropertyValue);
     void SetPropertyValue(int Index, QString PropertyValue);
 
     // Get a Property Value
     int GetPropertyIndex(QString PropertyName);
+    int GetPropertyIndex(const ItemPropertyKey& PropertyKey);
     QString GetPropertyValue(QString PropertyName);
+    QString GetPropertyValue(const ItemPropertyKey& PropertyKey);
     QString GetPropertyDesc(QString PropertyName);
 
     // Get an actual Property Object
     ItemProperty* GetProperty(QString PropertyName);
+    ItemProperty* GetProperty(const ItemPropertyKey& PropertyKey);
     ItemProperty* GetProperty(int Index);
 
     // Serialization
@@ -121,18 +193,35 @@ public:
     void LoadData(QDataStream& DataStreamIn);
 
     // Called only when a property changed
-    void PropertyChanged(QString PropName, QString PropNewValue, bool PerformCallback);
-    void CheckIfDynamicPropertyChanged(QString PropName, QString PropNewValue, bool PerformCallback);
+    void PropertyChanged(ItemProperty* Property, bool WasRequired, bool PerformCallback);
+    void CheckIfDynamicPropertyChanged(ItemProperty* Property, bool PerformCallback);
     void AdjustDynamicPropertyInList(QString PropertyName, int NumInstances, bool PerformCallback);
 
+    // Called only when a property is renamed
+    void PropertyNameChanged(ItemProperty* Property, QString OldPropName);
+
 private:
     void AddStaticProperty(QString PropertyName, QString PropertyValue, QString PropertyDesc, bool ReadOnly, bool Exportable);
     void AddDynamicProperty(QString PropertyName, QString PropertyValue, QString PropertyDesc, bool ReadOnly, bool Exportable, QString ControllingParam);
     bool IsPropertyNameNotInList(QString PropertyName);
 
+    // Property Blocks
+    ItemPropertyBlock* AddNewPropertyBlock(ItemProperty* PropItem);
+    void AddPropertyToBlock(ItemPropertyBlock* PropertyBlock, ItemProperty* PropItem);
+    void ResizeDynamicPropertyBlock(ItemPropertyBlock* PropertyBlock, int NumInstances, bool PerformCallback);
+    void UpdateBlockStartIndexes();
+
+    // Name Lookup through the Name Map
+    ItemProperty* FindProperty(const QString& PropertyName, uint PropertyHash);
+
 private:
-    QList<ItemProperty*> m_PropertyList;
-    GraphicItemBase*     m_ParentGraphicItemBase;
+    QList<ItemPropertyBlock*>               m_PropertyBlockList;
+    int                                     m_NumProperties;
+    int                                     m_NumRequiredValues;
+    bool                                    m_BlockStartIndexesValid;  // Cleared when a Block before the last one is resized
+    QMultiHash<uint, ItemProperty*>         m_PropertyNameMap;         // Property Name Hash -> Property
+    QMultiHash<QString, ItemPropertyBlock*> m_ControlledBlockMap;      // Controlling Parameter Name -> Dynamic Property Blocks
+    GraphicItemBase*                        m_ParentGraphicItemBase;
 };
 
 #endif // ITEMPROPERTIES_H
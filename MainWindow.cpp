@@ -24,7 +24,7 @@ MainWindow::MainWindow(QWidget* parent /*=0*/)
     : QMainWindow(parent)
 {
     // Create the Undo Stack
-    m_UndoStack = new QUndoStack(this);
+    m_UndoStack = new UndoRedoStack(this);
 
     // Create the User Actions
     CreateActions();
@@ -67,14 +67,17 @@ MainWindow::MainWindow(QWidget* parent /*=0*/)
     connect(m_WiringScene, SIGNAL(SceneEventSetProjectDirty()),                                 this, SLOT(HandleSceneEventSetProjectDirty()));
     connect(m_WiringScene, SIGNAL(SceneEventRefreshPropertiesWindowProperty(QString, QString)), this, SLOT(HandleSceneEventRefreshPropertiesWindowProperty(QString, QString)));
     connect(m_WiringScene, SIGNAL(SceneEventRefreshPropertiesWindow(ItemProperties*)),    this, SLOT(HandleSceneEventRefreshPropertiesWindow(ItemProperties*)));
+    connect(m_WiringScene, SIGNAL(SceneEventRefreshAllPropertiesWindow()),                      this, SLOT(HandleSceneEventRefreshAllPropertiesWindow()));
     connect(m_WiringScene, SIGNAL(SceneEventDragAndDropFinished()),                             this, SLOT(HandleSceneEventDragAndDropFinished()));
-    connect(m_UndoStack,   SIGNAL(cleanChanged(bool)),                                          this, SLOT(HandleUndoStackCleanChanged(bool)));
+    connect(m_WiringScene, SIGNAL(SceneEventWireReroutesPerSecond(int)),                        this, SLOT(HandleSceneEventWireReroutesPerSecond(int)));
+    connect(m_UndoStack,   SIGNAL(CleanChanged(bool)),                                          this, SLOT(HandleUndoStackCleanChanged(bool)));
 
     // Create the Components Right Side Window
     m_CompToolBox = new WindowComponentToolBox(this);
 
     // Create the Properties Left Side Window
     m_PropWin = new WindowItemProperties(this);
+    connect(m_PropWin, SIGNAL(PropertyValueEdited(QString, QString)), this, SLOT(HandlePropWinPropertyValueEdited(QString, QString)));
 
     // Layout the 3 Main Windows (Components, Scene, Properties) from left to right
     m_MainSplitterWidget = new QSplitter;
@@ -85,6 +88,15 @@ MainWindow::MainWindow(QWidget* parent /*=0*/)
     // Set the Main widget as the Main window.
     setCentralWidget(m_MainSplitterWidget);
 
+    // Create the Overview Minimap of the Scene in a Dock Window (Shown/Hidden from the View Menu)
+    m_Minimap = new WindowSceneMinimap(m_WiringScene, m_WiringView, this);
+    m_MinimapDock = new QDockWidget(tr(MINIMAP_DOCKTITLE), this);
+    m_MinimapDock->setObjectName("MinimapDock");   // Needed to save/restore the dock state
+    m_MinimapDock->setWidget(m_Minimap);
+    addDockWidget(Qt::RightDockWidgetArea, m_MinimapDock);
+    m_ViewMenu->addSeparator();
+    m_ViewMenu->addAction(m_MinimapDock->toggleViewAction());
+
     // Set the window title
     setWindowTitle(tr("SST Workbench"));
 
@@ -96,8 +108,10 @@ MainWindow::MainWindow(QWidget* parent /*=0*/)
     m_LoadedProjectDataFilePathName = "";
     m_ProjectIsDirty = false;
     m_SelectedComponent = NULL;
+    m_MultipleSelectionPropertiesPending = false;
     m_ComponentMovingPorts = NULL;
     m_SelectedText = NULL;
+    m_SelectedGroup = NULL;
     m_PasteOffset = DEFAULT_PASTE_OFFSET;
 
     // Start the Focus on the main Wiring Window
@@ -127,7 +141,7 @@ void MainWindow::SetMainTabTitle(QFileInfo FileInfo)
 
 bool MainWindow::IsSceneEmpty()
 {
-    return m_WiringScene->items().isEmpty();
+    return m_WiringScene->IsSceneEmpty();
 }
 
 bool MainWindow::AreSceneComponentsSelected()
@@ -247,11 +261,17 @@ void MainWindow::SavePersistentStorage()
     settings->setValue(PERSISTVALUE_SSTINFOXMLFILEPATHNAME, m_SSTInfoXMLDataFilePathName);
     settings->setValue(PERSISTVALUE_PROJECTFILEPATHNAME, m_LastSavedProjectDataFilePathName);
     settings->setValue(PERSISTVALUE_PYTHONEXPORTFILEPATHNAME, m_LastExportedPythonFilePathName);
+    settings->setValue(PERSISTVALUE_IMAGEEXPORTFILEPATHNAME, m_LastExportedImageFilePathName);
     settings->endGroup();
 
     settings->beginGroup(PERSISTGROUP_PREFERENCES);
     settings->setValue(PERSISTVALUE_PREF_RETURNTOSELAFTERWIRE, m_ReturnToSelectToolAfterPlacingWire);
     settings->setValue(PERSISTVALUE_PREF_RETURNTOSELAFTERTEXT, m_ReturnToSelectToolAfterPlacingText);
+    settings->setValue(PERSISTVALUE_PREF_CACHECOMPONENTS, m_CacheComponentRendering);
+    settings->setValue(PERSISTVALUE_PREF_VIEWUPDATEMODE, m_ViewUpdateMode);
+    settings->setValue(PERSISTVALUE_PREF_OPTIMIZEVIEWPAINTING, m_OptimizeViewPainting);
+    settings->setValue(PERSISTVALUE_PREF_AUTOROUTEWIRES, m_AutoRouteNewWires);
+    settings->setValue(PERSISTVALUE_PREF_UNDOMEMORYBUDGET, m_UndoMemoryBudget);
     settings->endGroup();
 }
 
@@ -273,12 +293,40 @@ void MainWindow::RestorePersistentStorage()
     m_SSTInfoXMLDataFilePathName = settings->value(PERSISTVALUE_SSTINFOXMLFILEPATHNAME, QDir::homePath()).toString();
     m_LastSavedProjectDataFilePathName = settings->value(PERSISTVALUE_PROJECTFILEPATHNAME, QDir::homePath()).toString();
     m_LastExportedPythonFilePathName = settings->value(PERSISTVALUE_PYTHONEXPORTFILEPATHNAME, QDir::homePath()).toString();
+    m_LastExportedImageFilePathName = settings->value(PERSISTVALUE_IMAGEEXPORTFILEPATHNAME, QDir::homePath()).toString();
     settings->endGroup();
 
     settings->beginGroup(PERSISTGROUP_PREFERENCES);
     m_ReturnToSelectToolAfterPlacingWire = settings->value(PERSISTVALUE_PREF_RETURNTOSELAFTERWIRE, true).toBool();
     m_ReturnToSelectToolAfterPlacingText = settings->value(PERSISTVALUE_PREF_RETURNTOSELAFTERTEXT, true).toBool();
+    m_CacheComponentRendering = settings->value(PERSISTVALUE_PREF_CACHECOMPONENTS, RENDER_DEFAULT_CACHECOMPONENTS).toBool();
+    m_ViewUpdateMode = settings->value(PERSISTVALUE_PREF_VIEWUPDATEMODE, (int)RENDER_DEFAULT_VIEWUPDATEMODE).toInt();
+    m_OptimizeViewPainting = settings->value(PERSISTVALUE_PREF_OPTIMIZEVIEWPAINTING, RENDER_DEFAULT_OPTIMIZEVIEWPAINTING).toBool();
+    m_AutoRouteNewWires = settings->value(PERSISTVALUE_PREF_AUTOROUTEWIRES, WIRE_ROUTER_DEFAULT_AUTOROUTE).toBool();
+    m_UndoMemoryBudget = settings->value(PERSISTVALUE_PREF_UNDOMEMORYBUDGET, (qint64)UNDO_DEFAULT_MEMORY_BUDGET).toLongLong();
     settings->endGroup();
+
+    ApplyRenderingPreferences();
+    m_WiringScene->SetAutoRouteNewWires(m_AutoRouteNewWires);
+    m_UndoStack->SetMemoryBudget(m_UndoMemoryBudget);
+}
+
+void MainWindow::ApplyRenderingPreferences()
+{
+    QGraphicsView::OptimizationFlags OptimizationFlags = 0;
+
+    // Cache the rasterized Components
+    m_WiringScene->SetComponentRenderCaching(m_CacheComponentRendering);
+
+    // How much of the viewport gets repainted when items change
+    m_WiringView->setViewportUpdateMode((QGraphicsView::ViewportUpdateMode)m_ViewUpdateMode);
+
+    // All of our items set their own pens and brushes, and the view does not antialias,
+    // so the view can skip saving the painter state and the antialiasing adjustments
+    if (m_OptimizeViewPainting == true) {
+        OptimizationFlags = QGraphicsView::DontSavePainterState | QGraphicsView::DontAdjustForAntialiasing;
+    }
+    m_WiringView->setOptimizationFlags(OptimizationFlags);
 }
 
 bool MainWindow::SaveProjectData(QString ProjectFilePathName)
@@ -382,7 +430,7 @@ bool MainWindow::LoadProjectData(QString ProjectFilePathName)
     m_CompToolBox->LoadSSTInfo(NewSSTInfoData, false);
 
     // Build the Wiring Scene
-    m_WiringScene->LoadData(DataStreamIn);
+    m_WiringScene->LoadData(DataStreamIn, FileVersion);
 
     // Set nothing selected
     m_WiringScene->SetNothingSelected();
@@ -426,11 +474,11 @@ void MainWindow::CreateActions()
     connect(m_DeleteAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerDeleteItem()));
 
     ///
-    m_UndoAction = m_UndoStack->createUndoAction(this, tr("&Undo"));
+    m_UndoAction = m_UndoStack->CreateUndoAction(this, tr("&Undo"));
     m_UndoAction->setIcon(QIcon(":/images/Undo.png"));
     m_UndoAction->setShortcuts(QKeySequence::Undo);
 
-    m_RedoAction = m_UndoStack->createRedoAction(this, tr("&Redo"));
+    m_RedoAction = m_UndoStack->CreateRedoAction(this, tr("&Redo"));
     m_RedoAction->setIcon(QIcon(":/images/Redo.png"));
     m_RedoAction->setShortcuts(QKeySequence::Redo);
 
@@ -455,6 +503,14 @@ void MainWindow::CreateActions()
     m_PasteAction->setStatusTip(tr("Paste Items"));
     connect(m_PasteAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerPaste()));
 
+    m_GenerateTopologyAction = new QAction(tr("Generate &Topology..."), this);
+    m_GenerateTopologyAction->setStatusTip(tr("Generate a Network of Routers and Endpoints"));
+    connect(m_GenerateTopologyAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerGenerateTopology()));
+
+    m_RerouteAllWiresAction = new QAction(tr("&Reroute All Wires"), this);
+    m_RerouteAllWiresAction->setStatusTip(tr("Route every Wire around the Components and Groups"));
+    connect(m_RerouteAllWiresAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerRerouteAllWires()));
+
     ///
     m_WorkBenchNewProjectAction = new QAction(QIcon(":/images/ProjectNew.png"), tr("&New Project..."), this);
     m_WorkBenchNewProjectAction->setShortcuts(QKeySequence::New);
@@ -489,6 +545,14 @@ void MainWindow::CreateActions()
     m_ExportSSTInputDeckAction->setEnabled(false);
     connect(m_ExportSSTInputDeckAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerExportSSTInputDeck()));
 
+    m_ExportImageAction = new QAction(tr("Export &Image..."), this);
+    m_ExportImageAction->setStatusTip(tr("Export the Entire Design to a PNG, PDF or SVG File"));
+    connect(m_ExportImageAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerExportImage()));
+
+    m_ExportSelectedImageAction = new QAction(tr("Export Se&lection as Image..."), this);
+    m_ExportSelectedImageAction->setStatusTip(tr("Export the Selected Items to a PNG, PDF or SVG File"));
+    connect(m_ExportSelectedImageAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerExportSelectedImage()));
+
     m_ExitAction = new QAction(tr("E&xit"), this);
     m_ExitAction->setShortcuts(QKeySequence::Quit);
     m_ExitAction->setStatusTip(tr("Quit SST Workbench"));
@@ -505,7 +569,7 @@ void MainWindow::CreateActions()
 
     m_PrintAction = new QAction(tr("&Print..."), this);
     m_PrintAction->setShortcuts(QKeySequence::Print);
-    m_PrintAction->setStatusTip(tr("Print Current View"));
+    m_PrintAction->setStatusTip(tr("Print the Current View or the Entire Design"));
     connect(m_PrintAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerPrint()));
 
     ///
@@ -545,6 +609,23 @@ void MainWindow::CreateActions()
     m_ManageModulesAction->setVisible(false);
     connect(m_ManageModulesAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerManageModules()));
 
+    ///
+    // Build the Sub-Circuit Menu Actions
+    m_CreateSubCircuitAction = new QAction("Create Su&b-Circuit...", this);
+    m_CreateSubCircuitAction->setStatusTip(tr("Collapse the Selected Components into a Sub-Circuit"));
+    m_CreateSubCircuitAction->setEnabled(false);
+    connect(m_CreateSubCircuitAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerCreateSubCircuit()));
+
+    m_ExpandCollapseSubCircuitAction = new QAction("E&xpand/Collapse Sub-Circuit", this);
+    m_ExpandCollapseSubCircuitAction->setStatusTip(tr("Show or Hide the Internals of the Sub-Circuit"));
+    m_ExpandCollapseSubCircuitAction->setVisible(false);
+    connect(m_ExpandCollapseSubCircuitAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerExpandCollapseSubCircuit()));
+
+    m_CreateParameterSetAction = new QAction("Create &Parameter Set...", this);
+    m_CreateParameterSetAction->setStatusTip(tr("Share the Parameters of the Selected Component with all Selected Components of the same type"));
+    m_CreateParameterSetAction->setEnabled(false);
+    connect(m_CreateParameterSetAction, SIGNAL(triggered()), this, SLOT(UserActionHandlerCreateParameterSet()));
+
     ///
     // Actions for displaying the Toolbars
     m_ShowToolsToolbarAction = new QAction("Tools", this);
@@ -625,6 +706,9 @@ void MainWindow::CreateMenus()
     m_FileMenu->addSeparator();
     m_FileMenu->addAction(m_ExportSSTInputDeckAction);
     m_FileMenu->addSeparator();
+    m_FileMenu->addAction(m_ExportImageAction);
+    m_FileMenu->addAction(m_ExportSelectedImageAction);
+    m_FileMenu->addSeparator();
     m_FileMenu->addAction(m_PrintAction);
     m_FileMenu->addSeparator();
     m_FileMenu->addAction(m_PreferencesAction);
@@ -642,6 +726,9 @@ void MainWindow::CreateMenus()
     m_EditMenu->addAction(m_CutAction);
     m_EditMenu->addAction(m_CopyAction);
     m_EditMenu->addAction(m_PasteAction);
+    m_EditMenu->addSeparator();
+    m_EditMenu->addAction(m_GenerateTopologyAction);
+    m_EditMenu->addAction(m_RerouteAllWiresAction);
 
     // Item Menu
     m_GenericItemMenu = menuBar()->addMenu(tr("&Item"));
@@ -655,6 +742,10 @@ void MainWindow::CreateMenus()
     m_GenericItemMenu->addAction(m_SetDynamicPortsAction);
     m_GenericItemMenu->addSeparator();
     m_GenericItemMenu->addAction(m_ManageModulesAction);
+    m_GenericItemMenu->addSeparator();
+    m_GenericItemMenu->addAction(m_CreateSubCircuitAction);
+    m_GenericItemMenu->addAction(m_ExpandCollapseSubCircuitAction);
+    m_GenericItemMenu->addAction(m_CreateParameterSetAction);
 
     // View Menu
     m_ViewMenu = menuBar()->addMenu(tr("&View"));
@@ -1034,14 +1125,55 @@ void MainWindow::HandleSceneEventWireAddedFinalPlacement(GraphicItemWire* Item)
 
 void MainWindow::HandleSceneEventSelectionChanged()
 {
+    bool ItemsSelected = (m_WiringScene->selectedItems().isEmpty() == false);
+
     // Enable/Disable the Delete Actions (Menu and Toolbar)
-    m_DeleteAction->setEnabled(m_WiringScene->selectedItems().count() > 0);
+    m_DeleteAction->setEnabled(ItemsSelected);
+    m_CreateSubCircuitAction->setEnabled(ItemsSelected);
+    m_CreateParameterSetAction->setEnabled(ItemsSelected);
+
+    // Show the shared Properties of the selected Components once the selection settles
+    // (A rubber band drag changes the selection on every mouse move)
+    if (m_MultipleSelectionPropertiesPending == false) {
+        m_MultipleSelectionPropertiesPending = true;
+        QTimer::singleShot(0, this, SLOT(UpdateMultipleSelectionProperties()));
+    }
+}
+
+void MainWindow::UpdateMultipleSelectionProperties()
+{
+    QList<ItemProperties*> PropertiesList;
+    GraphicItemComponent*  Component;
+
+    m_MultipleSelectionPropertiesPending = false;
+
+    // Collect the Properties of the selected Components
+    foreach (QGraphicsItem* Item, m_WiringScene->selectedItems()) {
+        Component = qgraphicsitem_cast<GraphicItemComponent*>(Item);
+        if (Component != NULL) {
+            PropertiesList.append(Component->GetItemProperties());
+        }
+    }
+
+    if (PropertiesList.count() > 1) {
+        m_PropWin->SetMultipleGraphicItemProperties(PropertiesList);
+    } else if (m_PropWin->IsShowingMultipleItems() == true) {
+        // The Multi-Selection is gone, show what is left of it
+        if (PropertiesList.count() == 1) {
+            m_PropWin->SetGraphicItemProperties(PropertiesList.first());
+        } else {
+            m_PropWin->ClearProperiesWindow();
+        }
+    }
 }
 
 void MainWindow::HandleSceneEventGraphicItemSelected(QGraphicsItem* Item)
 {
     // NOTE: Item may be NULL, to represent that no item is selected
 
+    // Let any queued property refreshes land on the previous selection before it goes away
+    m_WiringScene->DispatchPendingNotifications();
+
     // The scene has some item selected, we first just want to clear the properties window
     m_PropWin->ClearProperiesWindow();
 
@@ -1049,8 +1181,10 @@ void MainWindow::HandleSceneEventGraphicItemSelected(QGraphicsItem* Item)
     m_MovePortsAction->setVisible(false);
     m_SetDynamicPortsAction->setVisible(false);
     m_ManageModulesAction->setVisible(false);
+    m_ExpandCollapseSubCircuitAction->setVisible(false);
     m_SelectedComponent = NULL;
     m_SelectedText = NULL;
+    m_SelectedGroup = NULL;
 
     // Decide if an Item was selected (Item is not NULL)
     if (Item != NULL) {
@@ -1063,6 +1197,13 @@ void MainWindow::HandleSceneEventGraphicItemSelected(QGraphicsItem* Item)
             return;
         }
 
+        // Is the Item a GraphicItemGroup?
+        m_SelectedGroup = qgraphicsitem_cast<GraphicItemGroup*>(Item);
+        if (m_SelectedGroup != NULL) {
+            m_ExpandCollapseSubCircuitAction->setVisible(true);
+            return;
+        }
+
         // Check is see if the item is a GraphicItemText
         m_SelectedText = qgraphicsitem_cast<GraphicItemText*>(Item);
         if (m_SelectedText != NULL) {
@@ -1110,7 +1251,37 @@ void MainWindow::HandleSceneEventRefreshPropertiesWindow(ItemProperties* Propert
     EnableMovingPorts(false);
 
     // Refresh all the Properties in the properties window
-    m_PropWin->SetGraphicItemProperties(Properties);
+    if (m_PropWin->IsShowingMultipleItems() == true) {
+        // One of the selected Items changed, rebuild the shared Properties once
+        m_WiringScene->RefreshPropertiesWindow();
+    } else {
+        m_PropWin->SetGraphicItemProperties(Properties);
+    }
+}
+
+void MainWindow::HandleSceneEventRefreshAllPropertiesWindow()
+{
+    // Disable Moving Ports
+    EnableMovingPorts(false);
+
+    // Rebuild the properties window from the Items it is showing
+    m_PropWin->RefreshProperiesWindow();
+}
+
+void MainWindow::HandlePropWinPropertyValueEdited(QString PropertyName, QString NewValue)
+{
+    QList<ItemProperties*> PropertiesList;
+
+    // Set the Value on all the Items shown in the properties window as one Undo step
+    if (m_PropWin->IsShowingMultipleItems() == true) {
+        PropertiesList = m_PropWin->GetMultipleGraphicItemProperties();
+    } else if (m_PropWin->GetGraphicItemProperties() != NULL) {
+        PropertiesList.append(m_PropWin->GetGraphicItemProperties());
+    }
+
+    if (PropertiesList.isEmpty() == false) {
+        m_WiringScene->SetPropertyValueOnItems(PropertiesList, PropertyName, NewValue);
+    }
 }
 
 void MainWindow::HandleSceneEventDragAndDropFinished()
@@ -1122,6 +1293,12 @@ void MainWindow::HandleSceneEventDragAndDropFinished()
     emit m_PointerTypeGroup->buttonClicked(int(WiringScene::MODE_SELECTMOVEITEM));
 }
 
+void MainWindow::HandleSceneEventWireReroutesPerSecond(int ReroutesPerSecond)
+{
+    // Show how many Wires the scene is rerouting while items are being dragged
+    statusBar()->showMessage(QString("Wire Reroutes: %1 per second").arg(ReroutesPerSecond), 2 * WIRE_REROUTE_RATE_PERIOD);
+}
+
 void MainWindow::HandleUndoStackCleanChanged(bool NewState)
 {
     Q_UNUSED(NewState)
@@ -1197,6 +1374,7 @@ void MainWindow::UserActionHandlerDeleteItem()
     // Set the selected objects to NULL
     m_SelectedComponent = NULL;
     m_SelectedText = NULL;
+    m_SelectedGroup = NULL;
 }
 
 void MainWindow::UserActionHandlerSelectAll()
@@ -1205,9 +1383,7 @@ void MainWindow::UserActionHandlerSelectAll()
     EnableMovingPorts(false);
 
     // Select all Graphic items
-    foreach (QGraphicsItem* item, m_WiringScene->items(Qt::DescendingOrder)) {
-        item->setSelected(true);
-    }
+    m_WiringScene->SetAllSelected();
 }
 
 void MainWindow::ClearCopyPasteBuffer()
@@ -1222,12 +1398,17 @@ void MainWindow::ClearCopyPasteBuffer()
     }
     m_CopyPasteBufferListComps.clear();
 
+    count = m_CopyPasteBufferListGroups.count();
+    for (x = 0; x < count; x++) {
+        delete m_CopyPasteBufferListGroups.at(x);
+    }
+    m_CopyPasteBufferListGroups.clear();
+
     count = m_CopyPasteBufferListWires.count();
     for (x = 0; x < count; x++) {
         delete m_CopyPasteBufferListWires.at(x);
     }
     m_CopyPasteBufferListWires.clear();
-    m_CopyPasteWireBasesList.clear();
 
     count = m_CopyPasteBufferListTexts.count();
     for (x = 0; x < count; x++) {
@@ -1259,8 +1440,8 @@ void MainWindow::UserActionHandlerCopy()
     QByteArray*                 ItemBuffer;
     QDataStream*                DataStream;
     GraphicItemComponent*       Component;
+    GraphicItemGroup*           Group;
     GraphicItemWire*            Wire;
-    GraphicItemWireLineSegment* WireSeg;
     GraphicItemText*            Text;
 
     ClearCopyPasteBuffer();
@@ -1268,7 +1449,6 @@ void MainWindow::UserActionHandlerCopy()
     foreach (QGraphicsItem* SelectedItem, m_WiringScene->selectedItems()) {
         BaseItem = NULL;
         Wire = NULL;
-        WireSeg = NULL;
 
         // Convert the SelectedItem into one of the 3 types of GraphicItemXXX classes
         // Note: The GraphicItemXXX variable will be null if type is incorrect
@@ -1277,15 +1457,12 @@ void MainWindow::UserActionHandlerCopy()
             BaseItem = qgraphicsitem_cast<GraphicItemComponent*>(SelectedItem);
         }
         if (BaseItem == NULL) {
-            // User can only select WireSegments (not actual GraphicItemWires)
-            WireSeg = qgraphicsitem_cast<GraphicItemWireLineSegment*>(SelectedItem);
-            // If it is a wire segment, get its parent wire
-            // There are muliple segments to a wire, so the wire may be redundant,
-            // We handle this below
-            if (WireSeg != NULL) {
-                Wire = (GraphicItemWire*)WireSeg->parentItem();
-                BaseItem = (GraphicItemBase*)Wire;
-            }
+            Group = qgraphicsitem_cast<GraphicItemGroup*>(SelectedItem);
+            BaseItem = qgraphicsitem_cast<GraphicItemGroup*>(SelectedItem);
+        }
+        if (BaseItem == NULL) {
+            Wire = qgraphicsitem_cast<GraphicItemWire*>(SelectedItem);
+            BaseItem = qgraphicsitem_cast<GraphicItemWire*>(SelectedItem);
         }
         if (BaseItem == NULL) {
             Text = qgraphicsitem_cast<GraphicItemText*>(SelectedItem);
@@ -1308,16 +1485,11 @@ void MainWindow::UserActionHandlerCopy()
             if (BaseItem->GetItemType() == GraphicItemBase::ITEMTYPE_COMPONENT) {
                 m_CopyPasteBufferListComps.append(ItemBuffer);
             }
+            if (BaseItem->GetItemType() == GraphicItemBase::ITEMTYPE_GROUP) {
+                m_CopyPasteBufferListGroups.append(ItemBuffer);
+            }
             if (BaseItem->GetItemType() == GraphicItemBase::ITEMTYPE_WIRE) {
-                // Check to see if we are processing a redundant wire
-                if (m_CopyPasteWireBasesList.contains(BaseItem) == false) {
-                    // Not Redundant; add its databuffer and the wire to the lists
-                    m_CopyPasteBufferListWires.append(ItemBuffer);
-                    m_CopyPasteWireBasesList.append(BaseItem);
-                } else {
-                    // This wire was redundant, throw away the created buffer
-                    delete ItemBuffer;
-                }
+                m_CopyPasteBufferListWires.append(ItemBuffer);
             }
             if (BaseItem->GetItemType() == GraphicItemBase::ITEMTYPE_TEXT) {
                 m_CopyPasteBufferListTexts.append(ItemBuffer);
@@ -1356,6 +1528,21 @@ void MainWindow::UserActionHandlerPaste()
         delete DataStream;
     }
 
+    // Add Paste all Group Items
+    // NOTE: Groups are pasted before the Wires so the Wires can connect to the Group Ports
+    count = m_CopyPasteBufferListGroups.count();
+    for (x = 0; x < count; x++) {
+
+        // Build a DataStream on top of the ByteArray
+        DataStream = new QDataStream(m_CopyPasteBufferListGroups.at(x), QIODevice::ReadOnly);
+
+        // Tell the Scene to Paste the Item
+        m_WiringScene->PasteNewGroupItem(*DataStream, m_PasteOffset);
+
+        // Delete the datastream as it is no longer needed
+        delete DataStream;
+    }
+
     // Add Paste all Wire Items
     count = m_CopyPasteBufferListWires.count();
     for (x = 0; x < count; x++) {
@@ -1669,6 +1856,158 @@ void MainWindow::UserActionHandlerExportSSTInputDeck()
     }
 }
 
+void MainWindow::UserActionHandlerExportImage()
+{
+    ExportSceneImage(false);
+}
+
+void MainWindow::UserActionHandlerExportSelectedImage()
+{
+    ExportSceneImage(true);
+}
+
+void MainWindow::ExportSceneImage(bool SelectedItemsOnly)
+{
+    // Disable Moving Ports
+    EnableMovingPorts(false);
+
+    QString ImageFilePathName;
+    QString StartingDir;
+    QDir    DirInfo;
+    QString Filter;
+    QString SelectedFilter;
+    QString TempPath;
+    int     ScalePercent;
+    bool    ScaleOK;
+    bool    ExportResult;
+
+    // Create the Scene Exporter, it figures out what area will be exported
+    SceneExporter ImageExport(m_WiringScene, SelectedItemsOnly, this);
+    if (ImageExport.IsExportAreaEmpty() == true) {
+        if (SelectedItemsOnly == true) {
+            QMessageBox::information(this, IMAGEEXPORT_DLGTITLE, "No Items are Selected.\nSelect the Items to Export first.");
+        } else {
+            QMessageBox::information(this, IMAGEEXPORT_DLGTITLE, "The Design is Empty, there is nothing to Export.");
+        }
+        return;
+    }
+
+    // Look at the Location for the last exported image to see if its good
+    TempPath = QFileInfo(m_LastExportedImageFilePathName).dir().absolutePath();
+    DirInfo.setPath(TempPath);
+
+    // Check to see that the Starting Directory Exists
+    if (DirInfo.exists() == false) {
+        // Starting Dir does not exist for some reason, so lets
+        // fallback to the users home directory
+        DirInfo.setPath(QDir::homePath());
+
+        // Now lets check again, if the directory is still bad, then tell the user something is wrong
+        if (DirInfo.exists() == false) {
+            QString errorString = "ERROR: SSTWorkbench cannot find a starting directory, try deleting the ~/.SSTWorkbench file";
+            QMessageBox::critical(NULL, "Cannot Identify Starting Directory", errorString);
+            return;
+        }
+    }
+
+    // Get the Starting Directory
+    StartingDir = DirInfo.absolutePath();
+
+    // Execute the File Save As Dialog
+    Filter = QString(IMAGEEXPORT_PNGFILTER) + ";;" + IMAGEEXPORT_PDFFILTER + ";;" + IMAGEEXPORT_SVGFILTER;
+    ImageFilePathName = QFileDialog::getSaveFileName(this, tr("Export Image to"), StartingDir, Filter, &SelectedFilter, QFileDialog::DontUseNativeDialog);
+    if (ImageFilePathName.isEmpty() == true) {
+        return;
+    }
+
+    // Check to see if the ImageFileName has a proper extension, if not use the one from the selected Filter
+    if ((ImageFilePathName.endsWith(IMAGEEXPORT_PNGFILEEXTENSION, Qt::CaseInsensitive) == false) &&
+        (ImageFilePathName.endsWith(IMAGEEXPORT_PDFFILEEXTENSION, Qt::CaseInsensitive) == false) &&
+        (ImageFilePathName.endsWith(IMAGEEXPORT_SVGFILEEXTENSION, Qt::CaseInsensitive) == false)) {
+        if (SelectedFilter == IMAGEEXPORT_PDFFILTER) {
+            ImageFilePathName += IMAGEEXPORT_PDFFILEEXTENSION;
+        } else if (SelectedFilter == IMAGEEXPORT_SVGFILTER) {
+            ImageFilePathName += IMAGEEXPORT_SVGFILEEXTENSION;
+        } else {
+            ImageFilePathName += IMAGEEXPORT_PNGFILEEXTENSION;
+        }
+    }
+
+    // Export to the requested format
+    if (ImageFilePathName.endsWith(IMAGEEXPORT_PDFFILEEXTENSION, Qt::CaseInsensitive) == true) {
+        ExportResult = ImageExport.ExportToPDFFile(ImageFilePathName);
+    } else if (ImageFilePathName.endsWith(IMAGEEXPORT_SVGFILEEXTENSION, Qt::CaseInsensitive) == true) {
+        ExportResult = ImageExport.ExportToSVGFile(ImageFilePathName);
+    } else {
+        // PNG Images need a resolution
+        ScalePercent = QInputDialog::getInt(this, IMAGEEXPORT_DLGTITLE, "Image Scale (%):", IMAGEEXPORT_DEFAULTSCALEPERCENT,
+                                            IMAGEEXPORT_MINSCALEPERCENT, IMAGEEXPORT_MAXSCALEPERCENT, ZOOM_STEP_SIZE, &ScaleOK);
+        if (ScaleOK == false) {
+            return;
+        }
+        ExportResult = ImageExport.ExportToPNGFile(ImageFilePathName, ScalePercent / 100.0);
+    }
+
+    if (ExportResult == false) {
+        QMessageBox::warning(this, IMAGEEXPORT_DLGTITLE, ImageExport.GetLastErrorString());
+        return;
+    }
+
+    // Save the File Name and Path settings
+    m_LastExportedImageFilePathName = ImageFilePathName;
+}
+
+void MainWindow::UserActionHandlerRerouteAllWires()
+{
+    // Disable Moving Ports
+    EnableMovingPorts(false);
+
+    m_WiringScene->RerouteAllWires();
+}
+
+void MainWindow::UserActionHandlerGenerateTopology()
+{
+    // Disable Moving Ports
+    EnableMovingPorts(false);
+
+    int                   nRtn;
+    QString               ErrorMsg;
+    QPointF               StartPos;
+    TopologyGenerator*    Generator;
+
+    // We need the SST Info Data to pick the Router & Endpoint Components
+    if (m_CompToolBox->GetSSTInfoData() == NULL) {
+        QMessageBox::warning(this, TOPOLOGYDLG_DLGTITLE, "SST Information Data has not been imported.\nImport SSTInfo Data before Generating a Topology.");
+        return;
+    }
+
+    // Create the Dialog
+    m_TopologyDialog = new DialogTopologyGenerator(m_CompToolBox->GetSSTInfoData(), this);
+
+    // Run the dialog box (Modal)
+    nRtn = m_TopologyDialog->exec();
+
+    if (nRtn == QDialog::Accepted) {
+        Generator = new TopologyGenerator(m_TopologyDialog->GetTopologyType(), m_TopologyDialog->GetShapeParam1(), m_TopologyDialog->GetShapeParam2(),
+                                          m_TopologyDialog->GetShapeParam3(), m_TopologyDialog->GetEndpointsPerRouter());
+
+        if (Generator->BuildTopology(ErrorMsg) == true) {
+            // Start the Topology at the Top Left of the visible part of the Scene
+            StartPos = m_WiringView->mapToScene(0, 0) + QPointF(TOPOLOGY_LAYOUT_SPACING, TOPOLOGY_LAYOUT_SPACING);
+
+            m_WiringScene->GenerateTopology(Generator, m_TopologyDialog->GetRouterComponent(), m_TopologyDialog->GetRouterPortName(),
+                                            m_TopologyDialog->GetEndpointComponent(), m_TopologyDialog->GetEndpointPortName(), StartPos);
+        } else {
+            QMessageBox::warning(this, TOPOLOGYDLG_DLGTITLE, ErrorMsg);
+        }
+
+        delete Generator;
+    }
+
+    // Delete the Dialog
+    delete m_TopologyDialog;
+}
+
 void MainWindow::UserActionHandlerPreferences()
 {
     // Disable Moving Ports
@@ -1680,6 +2019,11 @@ void MainWindow::UserActionHandlerPreferences()
     m_PreferencesDialog = new DialogPreferences(this);
     m_PreferencesDialog->SetFlagReturnToSelectAfterWirePlaced(m_ReturnToSelectToolAfterPlacingWire);
     m_PreferencesDialog->SetFlagReturnToSelectAfterTextPlaced(m_ReturnToSelectToolAfterPlacingText);
+    m_PreferencesDialog->SetFlagCacheComponentRendering(m_CacheComponentRendering);
+    m_PreferencesDialog->SetViewUpdateMode(m_ViewUpdateMode);
+    m_PreferencesDialog->SetFlagOptimizeViewPainting(m_OptimizeViewPainting);
+    m_PreferencesDialog->SetFlagAutoRouteNewWires(m_AutoRouteNewWires);
+    m_PreferencesDialog->SetUndoMemoryBudget(m_UndoMemoryBudget);
 
     // Run the dialog box (Modal)
     nRtn = m_PreferencesDialog->exec();
@@ -1687,6 +2031,14 @@ void MainWindow::UserActionHandlerPreferences()
     if (nRtn == QDialog::Accepted) {
         m_ReturnToSelectToolAfterPlacingWire = m_PreferencesDialog->GetFlagReturnToSelectAfterWirePlaced();
         m_ReturnToSelectToolAfterPlacingText = m_PreferencesDialog->GetFlagReturnToSelectAfterTextPlaced();
+        m_CacheComponentRendering = m_PreferencesDialog->GetFlagCacheComponentRendering();
+        m_ViewUpdateMode = m_PreferencesDialog->GetViewUpdateMode();
+        m_OptimizeViewPainting = m_PreferencesDialog->GetFlagOptimizeViewPainting();
+        m_AutoRouteNewWires = m_PreferencesDialog->GetFlagAutoRouteNewWires();
+        m_UndoMemoryBudget = m_PreferencesDialog->GetUndoMemoryBudget();
+        ApplyRenderingPreferences();
+        m_WiringScene->SetAutoRouteNewWires(m_AutoRouteNewWires);
+        m_UndoStack->SetMemoryBudget(m_UndoMemoryBudget);
     }
 
     // Delete the Dialog
@@ -1736,19 +2088,52 @@ void MainWindow::UserActionHandlerPrint()
     // Disable Moving Ports
     EnableMovingPorts(false);
 
-    QPrinter printer;
-    QString  DocName;
+    QPrinter    printer;
+    QString     DocName;
+    QStringList PrintChoices;
+    QString     PrintChoice;
+    bool        ChoiceOK;
+    bool        PrintResult;
+
+    // Ask the user what to print
+    PrintChoices << "Current View" << "Entire Design - Fit to One Page" << "Entire Design - Full Size on Multiple Pages";
+    PrintChoice = QInputDialog::getItem(this, tr("Print"), tr("Print:"), PrintChoices, 0, false, &ChoiceOK);
+    if (ChoiceOK == false) {
+        return;
+    }
+
+    // Whole design printing needs something to print
+    if ((PrintChoice != PrintChoices.at(0)) && (m_WiringScene->IsSceneEmpty() == true)) {
+        QMessageBox::information(this, tr("Print"), "The Design is Empty, there is nothing to Print.");
+        return;
+    }
 
     //  Ask the user what printer to go to
     if (QPrintDialog(&printer).exec() == QDialog::Accepted) {
         // Setup the Document Name
+        DocName = m_TabWiringWindow->tabText(0);
+        printer.setDocName(DocName);
 
-        // Build the painter canvas using the printer info
-        QPainter painter(&printer);
-        painter.setRenderHint(QPainter::Antialiasing);
+        if (PrintChoice == PrintChoices.at(0)) {
+            // Build the painter canvas using the printer info
+            QPainter painter(&printer);
+            painter.setRenderHint(QPainter::Antialiasing);
 
-        // Render the current view to the Painter
-        m_WiringView->render(&painter);
+            // Render the current view to the Painter
+            m_WiringView->render(&painter);
+        } else {
+            // Print the Entire Design
+            SceneExporter PrintExport(m_WiringScene, false, this);
+            if (PrintChoice == PrintChoices.at(1)) {
+                PrintResult = PrintExport.PrintToPages(&printer, SceneExporter::PRINT_FITTOONEPAGE);
+            } else {
+                PrintResult = PrintExport.PrintToPages(&printer, SceneExporter::PRINT_TILEDPAGES);
+            }
+
+            if (PrintResult == false) {
+                QMessageBox::warning(this, tr("Print"), PrintExport.GetLastErrorString());
+            }
+        }
     }
 }
 
@@ -1897,7 +2282,7 @@ void MainWindow::UserActionSceneScaleZoomAll()
     } else {
         // SCENE HAS SOMETHING IN IT
         // Get the rect that contains all items
-        ItemsBoundingRect = m_WiringScene->itemsBoundingRect();
+        ItemsBoundingRect = m_WiringScene->GetItemsBoundingRect();
 
         // Adjust the Rect to add a little buffer
         ItemsBoundingRect.adjust(-20,-20, 20, 20);
@@ -1931,13 +2316,18 @@ void MainWindow::UserActionHandlerSetDynamicPorts()
     // If a port has been selected, and this menu choosen then bring up the
     // dialog box (Menu Items are controlled by the type of component)
     if (m_SelectedComponent != NULL) {
+        // Remember the Ports (and the Wires on them) so the change can be undone
+        QList<int> OldPortsState = m_SelectedComponent->GetDynamicPortsState();
+        QList<GraphicItemComponent::PortWireConnection> OldConnectionList = m_SelectedComponent->GetPortWireConnections();
+        m_WiringScene->BeginUndoGesture();
+
         // Create the Dialog
         m_ConfigurePortsDialog = new DialogPortsConfig(m_SelectedComponent, this);
 
         // Run the dialog box (Modal)
         m_ConfigurePortsDialog->exec();
 
-        SetProjectDirty();
+        m_WiringScene->CommitComponentDynamicPortsChange(m_SelectedComponent, OldPortsState, OldConnectionList);
 
         // Delete the Dialog
         delete m_ConfigurePortsDialog;
@@ -1965,6 +2355,79 @@ void MainWindow::UserActionHandlerManageModules()
     }
 }
 
+void MainWindow::UserActionHandlerCreateSubCircuit()
+{
+    QString DefinitionName;
+    bool    OkFlag;
+
+    // Disable Moving Ports
+    EnableMovingPorts(false);
+
+    // Ask the user for the name of the new Sub-Circuit
+    DefinitionName = QInputDialog::getText(this, "Create Sub-Circuit", "Sub-Circuit Name:", QLineEdit::Normal, "", &OkFlag).trimmed();
+    if ((OkFlag == false) || (DefinitionName.isEmpty() == true)) {
+        return;
+    }
+
+    // Definition names must be unique within the project
+    if (m_WiringScene->IsSubCircuitDefinitionNameUsed(DefinitionName) == true) {
+        QMessageBox::critical(NULL, "Cannot Create Sub-Circuit", QString("ERROR: A Sub-Circuit named %1 already exists").arg(DefinitionName));
+        return;
+    }
+
+    // Have the scene collapse the selected components into the Sub-Circuit
+    if (m_WiringScene->CreateSubCircuitFromSelection(DefinitionName) == false) {
+        QMessageBox::critical(NULL, "Cannot Create Sub-Circuit", "ERROR: No Components are Selected");
+    }
+}
+
+void MainWindow::UserActionHandlerCreateParameterSet()
+{
+    GraphicItemComponent* SourceComponent = NULL;
+    GraphicItemComponent* Component;
+    QString               SetName;
+    bool                  OkFlag;
+
+    // The first selected Component provides the Parameter Values of the Set
+    foreach (QGraphicsItem* Item, m_WiringScene->selectedItems()) {
+        Component = qgraphicsitem_cast<GraphicItemComponent*>(Item);
+        if ((Component != NULL) && (Component->GetComponentType() != SSTInfoDataComponent::COMP_SSTSTARTUPCONFIGURATION)) {
+            SourceComponent = Component;
+            break;
+        }
+    }
+    if (SourceComponent == NULL) {
+        QMessageBox::critical(NULL, "Cannot Create Parameter Set", "ERROR: No Components are Selected");
+        return;
+    }
+
+    // Ask the user for the name of the new Parameter Set
+    SetName = QInputDialog::getText(this, "Create Parameter Set", "Parameter Set Name:", QLineEdit::Normal, "", &OkFlag).trimmed();
+    if ((OkFlag == false) || (SetName.isEmpty() == true)) {
+        return;
+    }
+
+    // Set names must be unique within the project
+    if (m_WiringScene->IsParameterSetNameUsed(SetName) == true) {
+        QMessageBox::critical(NULL, "Cannot Create Parameter Set", QString("ERROR: A Parameter Set named %1 already exists").arg(SetName));
+        return;
+    }
+
+    // Have the scene create the Set and point the selected Components at it
+    m_WiringScene->CreateParameterSetFromSelection(SetName, SourceComponent);
+}
+
+void MainWindow::UserActionHandlerExpandCollapseSubCircuit()
+{
+    // Disable Moving Ports
+    EnableMovingPorts(false);
+
+    // Toggle the expanded state of the selected Group
+    if (m_SelectedGroup != NULL) {
+        m_SelectedGroup->SetGroupExpanded(!m_SelectedGroup->IsGroupExpanded());
+    }
+}
+
 void MainWindow::UserActionTextColorButtonTriggered()
 {
     // Disable Moving Ports
@@ -2017,12 +2480,17 @@ void MainWindow::UserActionComponentFillColorChanged()
 
 void MainWindow::SetProjectDirty(bool DirtyFlag /*=true*/)
 {
+    // Flush any queued dirty notifications from the scene so they cannot re-dirty the project later
+    if (DirtyFlag == false) {
+        m_WiringScene->DispatchPendingNotifications();
+    }
+
     // Set the Dirty Flag
     m_ProjectIsDirty = DirtyFlag;
 
     // Also set the undo stack as clean at this point
     if (DirtyFlag == false) {
-        m_UndoStack->setClean();
+        m_UndoStack->SetClean();
     }
 
     UpdateDisplayBasedUponDirtyStatus();
@@ -2044,7 +2512,7 @@ void MainWindow::UpdateDisplayBasedUponDirtyStatus()
 
 bool MainWindow::IsProjectDirty()
 {
-    return m_ProjectIsDirty || !(m_UndoStack->isClean());
+    return m_ProjectIsDirty || !(m_UndoStack->IsClean());
 }
 
 void MainWindow::closeEvent(QCloseEvent* event)
@@ -23,6 +23,7 @@
 #include "WiringScene.h"
 #include "WindowItemProperties.h"
 #include "WindowComponentToolbox.h"
+#include "WindowSceneMinimap.h"
 
 #include "GraphicItemComponent.h"
 #include "GraphicItemText.h"
@@ -30,8 +31,10 @@
 #include "DialogPortsConfig.h"
 #include "DialogManageModules.h"
 #include "DialogPreferences.h"
+#include "DialogTopologyGenerator.h"
 #include "SSTInfoXMLFileParser.h"
 #include "PythonExporter.h"
+#include "SceneExporter.h"
 
 ////////////////////////////////////////////////////////////
 
@@ -68,6 +71,7 @@ private:
     // Handling of Persistant Storage
     void SavePersistentStorage();
     void RestorePersistentStorage();
+    void ApplyRenderingPreferences();
 
     // Handling of Project Data (Serialization)
     bool SaveProjectData(QString ProjectFilePathName);
@@ -90,6 +94,9 @@ private:
     QMenu* CreateColorMenu(const char* slot, QColor defaultColor, bool ComponentColors = false);
     QIcon  CreateColorToolButtonIcon(const QString& image, QColor color);
 
+    // Export the Scene (or the Selected Items) to a PNG, PDF or SVG file
+    void ExportSceneImage(bool SelectedItemsOnly);
+
     // Control of Moving Ports
     void EnableMovingPorts(bool Enable);
     bool IsMovingPortsEnabled() {return (m_ComponentMovingPorts != NULL);}
@@ -110,7 +117,11 @@ private slots:
     void HandleSceneEventSetProjectDirty();
     void HandleSceneEventRefreshPropertiesWindowProperty(QString, QString);
     void HandleSceneEventRefreshPropertiesWindow(ItemProperties*);
+    void HandleSceneEventRefreshAllPropertiesWindow();
+    void HandlePropWinPropertyValueEdited(QString PropertyName, QString NewValue);
+    void UpdateMultipleSelectionProperties();
     void HandleSceneEventDragAndDropFinished();
+    void HandleSceneEventWireReroutesPerSecond(int ReroutesPerSecond);
     void HandleUndoStackCleanChanged(bool NewState);
 
     // Handlers for User Actions From Menus or Toolbars
@@ -124,12 +135,17 @@ private slots:
     void UserActionHandlerCopy();
     void UserActionHandlerPaste();
 
+    void UserActionHandlerGenerateTopology();
+    void UserActionHandlerRerouteAllWires();
+
     void UserActionHandlerNewProject();
     void UserActionHandlerLoadDesign();
     void UserActionHandlerSaveDesign();
     void UserActionHandlerSaveAs();
     void UserActionHandlerImportSSTInfo();
     void UserActionHandlerExportSSTInputDeck();
+    void UserActionHandlerExportImage();
+    void UserActionHandlerExportSelectedImage();
     void UserActionHandlerPreferences();
     void UserActionHandlerAbout();
     void UserActionHandlerPrint();
@@ -148,6 +164,9 @@ private slots:
     void UserActionHandlerMovePorts();
     void UserActionHandlerSetDynamicPorts();
     void UserActionHandlerManageModules();
+    void UserActionHandlerCreateSubCircuit();
+    void UserActionHandlerExpandCollapseSubCircuit();
+    void UserActionHandlerCreateParameterSet();
 
     void UserActionTextColorButtonTriggered();
     void UserActionComponentFillColorButtonTriggered();
@@ -166,14 +185,17 @@ private:
     QGraphicsView*          m_WiringView;
     WindowComponentToolBox* m_CompToolBox;
     WindowItemProperties*   m_PropWin;
+    WindowSceneMinimap*     m_Minimap;
+    QDockWidget*            m_MinimapDock;
     DialogPortsConfig*      m_ConfigurePortsDialog;
     DialogManageModules*    m_ManageModulesDialog;
     DialogPreferences*      m_PreferencesDialog;
+    DialogTopologyGenerator* m_TopologyDialog;
     QSplitter*              m_MainSplitterWidget;
     QTabWidget*             m_TabWiringWindow;
 
     // Undo / Redo Processing
-    QUndoStack*             m_UndoStack;
+    UndoRedoStack*          m_UndoStack;
 //  QUndoView*              m_UndoViewWindow;
 
     // Menus for the Main Window
@@ -212,6 +234,8 @@ private:
     QAction*                m_CutAction;
     QAction*                m_CopyAction;
     QAction*                m_PasteAction;
+    QAction*                m_GenerateTopologyAction;
+    QAction*                m_RerouteAllWiresAction;
 
     QAction*                m_WorkBenchNewProjectAction;
     QAction*                m_WorkBenchLoadDesignAction;
@@ -219,6 +243,8 @@ private:
     QAction*                m_WorkBenchSaveAsAction;
     QAction*                m_ImportSSTInfoAction;
     QAction*                m_ExportSSTInputDeckAction;
+    QAction*                m_ExportImageAction;
+    QAction*                m_ExportSelectedImageAction;
     QAction*                m_ExitAction;
     QAction*                m_PreferencesAction;
     QAction*                m_AboutAction;
@@ -233,6 +259,9 @@ private:
     QAction*                m_MovePortsAction;
     QAction*                m_SetDynamicPortsAction;
     QAction*                m_ManageModulesAction;
+    QAction*                m_CreateSubCircuitAction;
+    QAction*                m_ExpandCollapseSubCircuitAction;
+    QAction*                m_CreateParameterSetAction;
 
     QAction*                m_ShowFileActionsToolbarAction;
     QAction*                m_ShowEditToolbarAction;
@@ -247,8 +276,10 @@ private:
 
     // Pointer to the Currently Selected GraphicItems
     GraphicItemComponent*   m_SelectedComponent;
+    bool                    m_MultipleSelectionPropertiesPending;
     GraphicItemComponent*   m_ComponentMovingPorts;
     GraphicItemText*        m_SelectedText;
+    GraphicItemGroup*       m_SelectedGroup;
 
     // Window Persistent Data
     QSettings*              m_PersistentSettings;
@@ -267,15 +298,23 @@ private:
     // Python Export
     QString                 m_LastExportedPythonFilePathName;
 
+    // Image Export
+    QString                 m_LastExportedImageFilePathName;
+
     // Preferences
     bool                    m_ReturnToSelectToolAfterPlacingWire;
     bool                    m_ReturnToSelectToolAfterPlacingText;
+    bool                    m_CacheComponentRendering;
+    int                     m_ViewUpdateMode;
+    bool                    m_OptimizeViewPainting;
+    bool                    m_AutoRouteNewWires;
+    qint64                  m_UndoMemoryBudget;
 
     // Copy/Paste Support
     QList<QByteArray*>      m_CopyPasteBufferListComps;
+    QList<QByteArray*>      m_CopyPasteBufferListGroups;
     QList<QByteArray*>      m_CopyPasteBufferListWires;
     QList<QByteArray*>      m_CopyPasteBufferListTexts;
-    QList<GraphicItemBase*> m_CopyPasteWireBasesList;
     int                     m_PasteOffset;
 };
 
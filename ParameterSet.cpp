@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+#include "ParameterSet.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+ParameterSet::ParameterSet(QString SetName, ItemProperties* SourceProperties)
+{
+    int           x;
+    ItemProperty* Property;
+
+    m_SetName = SetName;
+    m_ElementName = SourceProperties->GetPropertyValue(PROPKEY_COMPONENT_COMPPARENTELEM);
+    m_ComponentName = SourceProperties->GetPropertyValue(PROPKEY_COMPONENT_COMPNAME);
+
+    // Capture the Parameters that would be exported for the Source Component
+    for (x = 0; x < SourceProperties->GetNumProperties(); x++) {
+        Property = SourceProperties->GetProperty(x);
+        if ((Property->GetExportable() == true) && (Property->GetValue().isEmpty() == false)) {
+            m_ParameterNameList.append(Property->GetName());
+            m_ParameterValueMap.insert(Property->GetName(), Property->GetValue());
+        }
+    }
+}
+
+ParameterSet::ParameterSet(QDataStream& DataStreamIn)
+{
+    int     x;
+    qint32  NumParameters;
+    QString ParameterName;
+    QString ParameterValue;
+
+    // Serialization - Load the Data
+    DataStreamIn >> m_SetName;
+    DataStreamIn >> m_ElementName;
+    DataStreamIn >> m_ComponentName;
+    DataStreamIn >> NumParameters;
+
+    for (x = 0; x < NumParameters; x++) {
+        DataStreamIn >> ParameterName;
+        DataStreamIn >> ParameterValue;
+        m_ParameterNameList.append(ParameterName);
+        m_ParameterValueMap.insert(ParameterName, ParameterValue);
+    }
+}
+
+ParameterSet::~ParameterSet()
+{
+}
+
+bool ParameterSet::IsCompatibleWith(ItemProperties* Properties)
+{
+    // Only Components of the same type can share the Parameters
+    return ((Properties->GetPropertyValue(PROPKEY_COMPONENT_COMPPARENTELEM) == m_ElementName) &&
+            (Properties->GetPropertyValue(PROPKEY_COMPONENT_COMPNAME) == m_ComponentName));
+}
+
+void ParameterSet::SaveData(QDataStream& DataStreamOut)
+{
+    int x;
+
+    // Serialization - Save the Data
+    DataStreamOut << m_SetName;
+    DataStreamOut << m_ElementName;
+    DataStreamOut << m_ComponentName;
+    DataStreamOut << (qint32)m_ParameterNameList.count();
+
+    for (x = 0; x < m_ParameterNameList.count(); x++) {
+        DataStreamOut << m_ParameterNameList.at(x);
+        DataStreamOut << m_ParameterValueMap.value(m_ParameterNameList.at(x));
+    }
+}
@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef PARAMETERSET_H
+#define PARAMETERSET_H
+
+#include "GlobalIncludes.h"
+
+#include "ItemProperties.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A Named set of Parameter Values shared by many Components of the same type.
+// Components reference a set through their Parameter Set property; any of their
+// Parameters that differ from the set are that Component's overrides.
+class ParameterSet
+{
+public:
+    // Constructor / Destructor
+    ParameterSet(QString SetName, ItemProperties* SourceProperties);
+    ParameterSet(QDataStream& DataStreamIn);  // Only used for serialization
+    ~ParameterSet();
+
+    // Name of the Set and the type of Component it applies to
+    QString GetSetName() {return m_SetName;}
+    QString GetElementName() {return m_ElementName;}
+    QString GetComponentName() {return m_ComponentName;}
+    bool IsCompatibleWith(ItemProperties* Properties);
+
+    // The Parameters of the Set (In the order of the Source Component)
+    int GetNumParameters() {return m_ParameterNameList.count();}
+    QString GetParameterName(int Index) {return m_ParameterNameList.at(Index);}
+    QString GetParameterValue(QString ParameterName) {return m_ParameterValueMap.value(ParameterName);}
+    bool ContainsParameter(QString ParameterName) {return m_ParameterValueMap.contains(ParameterName);}
+
+    // Serialization of data
+    void SaveData(QDataStream& DataStreamOut);
+
+private:
+    QString                 m_SetName;
+    QString                 m_ElementName;
+    QString                 m_ComponentName;
+    QStringList             m_ParameterNameList;
+    QHash<QString, QString> m_ParameterValueMap;
+};
+
+#endif // PARAMETERSET_H
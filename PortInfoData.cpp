@@ -106,12 +106,35 @@ void PortInfoData::CommonSetup()
     // Init the Dynamic Port data
     m_DynamicPortTotalInstances = 0;
     m_DynamicPortCreatedInstances = 0;
-    m_StartingGraphicalPort = NULL;
+    m_PortIsBus = false;
+    m_GraphicalPortArray.clear();
 
     m_PortLatencyValuesList.clear();
     m_PortCommentsList.clear();
 }
 
+void PortInfoData::SetNumTotalInstances(int NumInstances)
+{
+    // Large Dynamic Ports are shown as a single Bus Port unless told otherwise
+    if ((m_DynamicPortTotalInstances <= PORT_BUS_AUTO_THRESHOLD) && (NumInstances > PORT_BUS_AUTO_THRESHOLD)) {
+        SetPortBus(true);
+    }
+    m_DynamicPortTotalInstances = NumInstances;
+}
+
+GraphicItemPort* PortInfoData::TakeLastGraphicalPort()
+{
+    GraphicItemPort* LastPort;
+
+    // Remove the highest Instance; Caller is responsible for deleting it
+    if (m_GraphicalPortArray.isEmpty() == true) {
+        return NULL;
+    }
+    LastPort = m_GraphicalPortArray.last();
+    m_GraphicalPortArray.removeLast();
+    return LastPort;
+}
+
 void PortInfoData::SetPortLatencyValue(int Index, QString LatencyValue)
 {
     // Get the Number of Items in the list
@@ -177,6 +200,7 @@ void PortInfoData::SaveData(QDataStream& DataStreamOut)
     DataStreamOut << m_DynamicPortControllingParameterName;
     DataStreamOut << m_PortIsConfigured;
     DataStreamOut << m_PortIsDynamic;
+    DataStreamOut << m_PortIsBus;
     DataStreamOut << (qint32)m_DynamicPortTotalInstances;
     DataStreamOut << (qint32)m_AssignedComponentSide;
     DataStreamOut << (qint32)m_AssignedComponentSideSequence;
@@ -202,6 +226,7 @@ PortInfoData::PortInfoData(QDataStream& DataStreamIn)
     DataStreamIn >> m_DynamicPortControllingParameterName;
     DataStreamIn >> m_PortIsConfigured;
     DataStreamIn >> m_PortIsDynamic;
+    DataStreamIn >> m_PortIsBus;
     DataStreamIn >> m_DynamicPortTotalInstances;
     DataStreamIn >> n_AssignedComponentSide;
     DataStreamIn >> m_AssignedComponentSideSequence;
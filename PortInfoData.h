@@ -56,14 +56,20 @@ public:
     bool IsPortConfigured() {return m_PortIsConfigured;}
     void SetPortConfigured(bool ConfigFlag) {m_PortIsConfigured = ConfigFlag;}
 
+    // A Dynamic Port shown as a Bus is drawn as a single graphical port that stands for all of its Instances
+    bool IsPortBus() {return m_PortIsBus;}
+    void SetPortBus(bool BusFlag) {m_PortIsBus = (m_PortIsDynamic && BusFlag);}
+
     // NOTE: The Difference between the TOTAL Number of Dynamic Port Instances and CREATED Number
     //       of Dynamic Port Instances identifies how many Ports need to be created or destroyed
     //       on the component.  Normally these two values will be equal.  They will be different
     //       when the user changes the TOTAL value to change the number of dynamic ports.
 
     // Control of the TOTAL Number of Instances that this Port will have
+    // NOTE: Growing past PORT_BUS_AUTO_THRESHOLD Instances turns the Bus on as a default,
+    //       a later SetPortBus() overrides it
     int  GetNumTotalInstances() {return m_DynamicPortTotalInstances;}
-    void SetNumTotalInstances(int NumInstances) {m_DynamicPortTotalInstances = NumInstances;}
+    void SetNumTotalInstances(int NumInstances);
 
     // Control of the CREATED Number of Instances that this Port currently has
     int  GetNumCreatedInstances() {return m_DynamicPortCreatedInstances;}
@@ -80,9 +86,12 @@ public:
     // Dynamic Port Control
     // The Dynamic port is represented by 1 or more graphical ports (each have have a different name)
     // that are all tied to this PortInfoData.  Static Ports always have 1 graphical port.
-    // The graphical ports are tied together via a linked list.
-    void SetStartingGraphicalPort(GraphicItemPort* port) {m_StartingGraphicalPort = port;}
-    GraphicItemPort* GetStartingGraphicalPort() {return m_StartingGraphicalPort;}
+    // The graphical ports are held in Instance order, so the port for Instance N is at Index N.
+    int              GetNumGraphicalPorts() {return m_GraphicalPortArray.count();}
+    GraphicItemPort* GetGraphicalPort(int Index) {return m_GraphicalPortArray.at(Index);}
+    GraphicItemPort* GetStartingGraphicalPort() {return m_GraphicalPortArray.isEmpty() ? NULL : m_GraphicalPortArray.first();}
+    void             AddGraphicalPort(GraphicItemPort* port) {m_GraphicalPortArray.append(port);}
+    GraphicItemPort* TakeLastGraphicalPort();
 
     // Latency and Comments
     void SetPortLatencyValue(int Index, QString LatencyValue);
@@ -108,11 +117,12 @@ private:
     QString          m_ConfiguredPortName;                   // Name of port after it is configured
     ComponentSide    m_AssignedComponentSide;                // Assigned Component Side
     int              m_AssignedComponentSideSequence;        // The order that this port should be drawn on its assigned side
-    GraphicItemPort* m_StartingGraphicalPort;                // Ptr to the first in the series of static or dynamic GraphicalItemPort objects
+    QVector<GraphicItemPort*> m_GraphicalPortArray;          // The static or dynamic GraphicalItemPort objects (Not Owned)
 
     QString          m_DynamicPortControllingParameterName;  // The Parameter on the Component that controls the size of the dynamic port
     bool             m_PortIsConfigured;                     // Flag that identifies if port is fully Configured
     bool             m_PortIsDynamic;                        // Flag that identifies if port is a Dynamic Port (has a %d)
+    bool             m_PortIsBus;                            // Flag that identifies if a Dynamic Port is shown as a single Bus Port
     int              m_DynamicPortTotalInstances;            // Total number of Instances of Dynamic Ports that the user as defined
     int              m_DynamicPortCreatedInstances;          // Total number of Instances of Dynamic Ports Currently Created; The difference
                                                              // from m_DynamicPortTotalInstances is the number of GraphicItemPorts that need
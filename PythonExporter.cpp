@@ -88,12 +88,8 @@ bool PythonExporter::CheckSSTStartupConfigComponent()
 bool PythonExporter::CheckComponentParameters()
 {
     GraphicItemComponent* ptrComponent;
-    int                   x;
-    int                   NumProperties;
-    ItemProperty*         Property;
-    QString               PropName;
-    QString               PropValue;
-    QString               CompName;
+    GraphicItemGroup*     ptrGroup;
+    QString               NamePrefix;
     bool                  bRtn = true;
 
     // Search all the items on the Wiring Scene
@@ -101,27 +97,52 @@ bool PythonExporter::CheckComponentParameters()
         if (item->type() == GraphicItemComponent::Type) {
             // Get the item as a Graphic Ccomponent item
             ptrComponent = (GraphicItemComponent*)item;
-            CompName = ptrComponent->GetItemProperties()->GetPropertyValue(COMPONENT_PROPERTY_USERNAME);
-
-            // Get the number of properties for Component
-            NumProperties = ptrComponent->GetItemProperties()->GetNumProperties();
-            for (x = 0; x < NumProperties; x++) {
-                // Get the property data
-                Property  = ptrComponent->GetItemProperties()->GetProperty(x);
-                PropName  = Property->GetName();
-                PropValue = Property->GetValue();
-
-                // Detirmine if the Value is Required
-                if (PropValue == "REQUIRED") {
-                    bRtn = false;
-                    m_ExportErrorsList.append(QString("ERROR: Component %1 - Parameter %2 is REQUIRED.").arg(CompName).arg(PropName));
-                }
+            bRtn &= CheckComponentParameters(ptrComponent, "");
+        }
+        if (item->type() == GraphicItemGroup::Type) {
+            // Check all the Components inside of the Group
+            ptrGroup = (GraphicItemGroup*)item;
+            NamePrefix = ptrGroup->GetInstanceName() + ".";
+            foreach (GraphicItemComponent* InternalComponent, ptrGroup->GetSubCircuitDefinition()->GetInternalComponentList()) {
+                bRtn &= CheckComponentParameters(InternalComponent, NamePrefix);
             }
         }
     }
     return bRtn;
 }
 
+bool PythonExporter::CheckComponentParameters(GraphicItemComponent* ptrComponent, QString NamePrefix)
+{
+    int                   x;
+    int                   NumProperties;
+    ItemProperty*         Property;
+    QString               PropName;
+    QString               CompName;
+    bool                  bRtn = true;
+
+    // The Properties keep a count of their REQUIRED Values, most Components have none
+    if (ptrComponent->GetItemProperties()->GetNumRequiredValues() == 0) {
+        return true;
+    }
+
+    CompName = NamePrefix + ptrComponent->GetItemProperties()->GetPropertyValue(PROPKEY_COMPONENT_USERNAME);
+
+    // Get the number of properties for Component
+    NumProperties = ptrComponent->GetItemProperties()->GetNumProperties();
+    for (x = 0; x < NumProperties; x++) {
+        // Get the property data
+        Property  = ptrComponent->GetItemProperties()->GetProperty(x);
+        PropName  = Property->GetName();
+
+        // Detirmine if the Value is Required
+        if (Property->IsValueRequired() == true) {
+            bRtn = false;
+            m_ExportErrorsList.append(QString("ERROR: Component %1 - Parameter %2 is REQUIRED.").arg(CompName).arg(PropName));
+        }
+    }
+    return bRtn;
+}
+
 bool PythonExporter::CheckComponentUnconnectedPorts()
 {
     GraphicItemComponent* ptrComponent;
@@ -137,7 +158,7 @@ bool PythonExporter::CheckComponentUnconnectedPorts()
         if (item->type() == GraphicItemComponent::Type) {
             // Get the item as a Graphic Ccomponent item
             ptrComponent = (GraphicItemComponent*)item;
-            CompName = ptrComponent->GetItemProperties()->GetPropertyValue(COMPONENT_PROPERTY_USERNAME);
+            CompName = ptrComponent->GetItemProperties()->GetPropertyValue(PROPKEY_COMPONENT_USERNAME);
 
             NumGraphicPorts = ptrComponent->GetNumGraphicalPortsOnComponent();
             for (x = 0; x < NumGraphicPorts; x++) {
@@ -161,34 +182,26 @@ bool PythonExporter::CheckComponentUnconnectedPorts()
 bool PythonExporter::CheckUnconnectedWires()
 {
     GraphicItemWire*         ptrParentWire;
-    QList<GraphicItemWire*>  ProcessedWiresList;
     QString                  WireIndex;
     bool                     bRtn = true;
 
     // We need to get the lists of objects from the selections
     foreach (QGraphicsItem* item, m_Scene->items(Qt::DescendingOrder)) {
-        if (item->type() == GraphicItemWireLineSegment::Type) {
-            // Get the items Parent (Graphic Wire item)
-            ptrParentWire = (GraphicItemWire*)item->parentItem();
-
-            // Check to see if we have already processed this parent wire
-            if (ProcessedWiresList.contains(ptrParentWire) == false) {
-                // This parent wire has not been processed it, so add it to the ProcessedWiresList
-                ProcessedWiresList.append(ptrParentWire);
-
-                // Get the Wire's Properties
-                WireIndex = ptrParentWire->GetItemProperties()->GetPropertyValue(WIRE_PROPERTY_NUMBER);
-
-                // Check the wire for its status
-                if (ptrParentWire->GetWireConnectedState() == GraphicItemWire::NO_CONNECTIONS) {
-                    bRtn = false;
-                    m_ExportErrorsList.append(QString("ERROR: Wire %1 - Has No Connections.").arg(WireIndex));
-                }
-                if ((ptrParentWire->GetWireConnectedState() == GraphicItemWire::STARTPOINT_CONNECTED) ||
-                    (ptrParentWire->GetWireConnectedState() == GraphicItemWire::ENDPOINT_CONNECTED)) {
-                    bRtn = false;
-                    m_ExportErrorsList.append(QString("ERROR: Wire %1 - Has only one connection to a Component Port.").arg(WireIndex));
-                }
+        if (item->type() == GraphicItemWire::Type) {
+            ptrParentWire = (GraphicItemWire*)item;
+
+            // Get the Wire's Properties
+            WireIndex = ptrParentWire->GetItemProperties()->GetPropertyValue(WIRE_PROPERTY_NUMBER);
+
+            // Check the wire for its status
+            if (ptrParentWire->GetWireConnectedState() == GraphicItemWire::NO_CONNECTIONS) {
+                bRtn = false;
+                m_ExportErrorsList.append(QString("ERROR: Wire %1 - Has No Connections.").arg(WireIndex));
+            }
+            if ((ptrParentWire->GetWireConnectedState() == GraphicItemWire::STARTPOINT_CONNECTED) ||
+                (ptrParentWire->GetWireConnectedState() == GraphicItemWire::ENDPOINT_CONNECTED)) {
+                bRtn = false;
+                m_ExportErrorsList.append(QString("ERROR: Wire %1 - Has only one connection to a Component Port.").arg(WireIndex));
             }
         }
     }
@@ -233,6 +246,9 @@ bool PythonExporter::CreatePythonFile()
         // Write the Program Options
         WriteSSTStartupProgramOptions(output);
 
+        // Write the Parameter Sets used by the Components
+        WriteParameterSets(output);
+
         // Write the Components
         WriteComponents(output);
 
@@ -308,9 +324,120 @@ void PythonExporter::WriteSSTStartupProgramOptions(QTextStream& out)
     }
 }
 
+void PythonExporter::WriteParameterSets(QTextStream& out)
+{
+    QList<GraphicItemComponent*> ComponentList;
+    GraphicItemGroup*            ptrGroup;
+    ParameterSet*                Set;
+    QString                      SetVarName;
+
+    m_ParameterSetVarNameMap.clear();
+
+    // Collect all the Components that will be written (Including the ones inside Groups)
+    foreach (QGraphicsItem* item, m_Scene->items(Qt::DescendingOrder)) {
+        if (item->type() == GraphicItemComponent::Type) {
+            ComponentList.append((GraphicItemComponent*)item);
+        }
+        if (item->type() == GraphicItemGroup::Type) {
+            ptrGroup = (GraphicItemGroup*)item;
+            ComponentList.append(ptrGroup->GetSubCircuitDefinition()->GetInternalComponentList());
+        }
+    }
+
+    // Write each Set that is used once, the Components pass it by reference
+    foreach (GraphicItemComponent* ptrComponent, ComponentList) {
+        Set = GetComponentParameterSet(ptrComponent->GetItemProperties());
+        if ((Set != NULL) && (m_ParameterSetVarNameMap.contains(Set) == false)) {
+            if (m_ParameterSetVarNameMap.isEmpty() == true) {
+                BLANKLINE;
+                HEADER;
+                out << "# Setup Parameter Sets" << endl;
+            }
+            SetVarName = QString("ParameterSet%1").arg(m_ParameterSetVarNameMap.count());
+            m_ParameterSetVarNameMap.insert(Set, SetVarName);
+            WriteParameterSet(out, Set, SetVarName);
+        }
+    }
+}
+
+void PythonExporter::WriteParameterSet(QTextStream& out, ParameterSet* Set, QString SetVarName)
+{
+    int     x;
+    QString ParamName;
+
+    BLANKLINE;
+    out << "# Parameter Set : " << QString("%1 (%2.%3)").arg(Set->GetSetName()).arg(Set->GetElementName()).arg(Set->GetComponentName()) << endl;
+    out << SetVarName << " = {";
+
+    for (x = 0; x < Set->GetNumParameters(); x++) {
+        ParamName = Set->GetParameterName(x);
+        out << ((x > 0) ? "," : "") << endl;
+        out << TAB << QString("\"%1\" : \"%2\"").arg(ParamName).arg(Set->GetParameterValue(ParamName));
+    }
+
+    out << endl << TAB << "}" << endl;
+}
+
+ParameterSet* PythonExporter::GetComponentParameterSet(ItemProperties* Properties)
+{
+    ParameterSet* Set;
+    ItemProperty* Property;
+    int           x;
+
+    // Find the Set the Component references
+    Set = m_Scene->GetParameterSet(Properties->GetPropertyValue(PROPKEY_COMPONENT_PARAMSET));
+    if ((Set == NULL) || (Set->IsCompatibleWith(Properties) == false)) {
+        return NULL;
+    }
+
+    // The Set can only be used if the Component exports every Parameter in it
+    // (A Parameter that the Component left empty cannot be taken back out of the Set)
+    for (x = 0; x < Set->GetNumParameters(); x++) {
+        Property = Properties->GetProperty(Set->GetParameterName(x));
+        if ((Property == NULL) || (Property->GetExportable() == false) || (Property->GetValue().isEmpty() == true)) {
+            return NULL;
+        }
+    }
+    return Set;
+}
+
 void PythonExporter::WriteComponents(QTextStream& out)
 {
     GraphicItemComponent* ptrComponent;
+    GraphicItemGroup*     ptrGroup;
+    QString               NamePrefix;
+
+    BLANKLINE;
+    HEADER;
+    out << "# Setup Components" << endl;
+
+    // Search all the items on the Wiring Scene
+    foreach (QGraphicsItem* item, m_Scene->items(Qt::DescendingOrder)) {
+        if (item->type() == GraphicItemComponent::Type) {
+            // Get the item as a Graphic Ccomponent item
+            ptrComponent = (GraphicItemComponent*)item;
+
+            // Check to see that this object is Not a SSTStartupConfigurationObject
+            if (ptrComponent->GetComponentType() != SSTInfoDataComponent::COMP_SSTSTARTUPCONFIGURATION) {
+                WriteComponent(out, ptrComponent, "");
+            }
+        }
+        if (item->type() == GraphicItemGroup::Type) {
+            // Flatten the Group; Each Instance gets its own copy of the Sub-Circuit Components
+            ptrGroup = (GraphicItemGroup*)item;
+            NamePrefix = ptrGroup->GetInstanceName() + ".";
+
+            BLANKLINE;
+            out << "# Sub-Circuit : " << QString("%1 (%2)").arg(ptrGroup->GetInstanceName()).arg(ptrGroup->GetSubCircuitDefinition()->GetDefinitionName()) << endl;
+            foreach (GraphicItemComponent* InternalComponent, ptrGroup->GetSubCircuitDefinition()->GetInternalComponentList()) {
+                WriteComponent(out, InternalComponent, NamePrefix);
+            }
+        }
+    }
+}
+
+void PythonExporter::WriteComponent(QTextStream& out, GraphicItemComponent* ptrComponent, QString NamePrefix)
+{
     int                   x;
     int                   NumProperties;
     ItemProperties*       Properties;
@@ -328,148 +455,159 @@ void PythonExporter::WriteComponents(QTextStream& out)
     QString               Weight;
     QString               CompVariableName;
     bool                  FirstLineDone;
+    ParameterSet*         Set = NULL;
+
+    // Get some specific properties
+    Properties = ptrComponent->GetItemProperties();
+    CompUniqueName = NamePrefix + Properties->GetPropertyValue(PROPKEY_COMPONENT_UNIQUENAME);
+    CompUserName = Properties->GetPropertyValue(PROPKEY_COMPONENT_USERNAME);
+    CompElementName = Properties->GetPropertyValue(PROPKEY_COMPONENT_COMPPARENTELEM);
+    CompBaseName = Properties->GetPropertyValue(PROPKEY_COMPONENT_COMPNAME);
+    CompType = Properties->GetPropertyValue(PROPKEY_COMPONENT_TYPE);
+    CompComment = Properties->GetPropertyValue(PROPKEY_COMPONENT_COMMENT);
+    Rank = Properties->GetPropertyValue(PROPKEY_COMPONENT_RANK);
+    Weight = Properties->GetPropertyValue(PROPKEY_COMPONENT_WEIGHT);
+
+    // Create the Component's Variable Name
+    CompVariableName = GetComponentVarName(CompUniqueName);
 
+    // Write the Component Instantiation
     BLANKLINE;
-    HEADER;
-    out << "# Setup Components" << endl;
+    out << "# Component : " << QString("[%1] %2 (%3) - %4").arg(CompType).arg(CompUniqueName).arg(CompUserName).arg(CompComment) << endl;
+    out << CompVariableName << QString(" = sst.Component(\"%1\", \"%2.%3\")").arg(CompUniqueName).arg(CompElementName).arg(CompBaseName) << endl;
 
-    // Search all the items on the Wiring Scene
-    foreach (QGraphicsItem* item, m_Scene->items(Qt::DescendingOrder)) {
-        if (item->type() == GraphicItemComponent::Type) {
-            // Get the item as a Graphic Ccomponent item
-            ptrComponent = (GraphicItemComponent*)item;
+    // Set Global Component Settings
+    if (Rank.isEmpty() == false) {
+        out << CompVariableName << QString(".setRank(%1)").arg(Rank) << endl;
+    }
+    if (Weight.isEmpty() == false) {
+        out << CompVariableName << QString(".setWeight(%1)").arg(Weight) << endl;
+    }
 
-            // Check to see that this object is Not a SSTStartupConfigurationObject
-            if (ptrComponent->GetComponentType() != SSTInfoDataComponent::COMP_SSTSTARTUPCONFIGURATION) {
-                // Get some specific properties
-                Properties = ptrComponent->GetItemProperties();
-                CompUniqueName = Properties->GetPropertyValue(COMPONENT_PROPERTY_UNIQUENAME);
-                CompUserName = Properties->GetPropertyValue(COMPONENT_PROPERTY_USERNAME);
-                CompElementName = Properties->GetPropertyValue(COMPONENT_PROPERTY_COMPPARENTELEM);
-                CompBaseName = Properties->GetPropertyValue(COMPONENT_PROPERTY_COMPNAME);
-                CompType = Properties->GetPropertyValue(COMPONENT_PROPERTY_TYPE);
-                CompComment = Properties->GetPropertyValue(COMPONENT_PROPERTY_COMMENT);
-                Rank = Properties->GetPropertyValue(COMPONENT_PROPERTY_RANK);
-                Weight = Properties->GetPropertyValue(COMPONENT_PROPERTY_WEIGHT);
-
-                // Create the Component's Variable Name
-                CompVariableName = GetComponentVarName(CompUniqueName);
-
-                // Write the Component Instantiation
-                BLANKLINE;
-                out << "# Component : " << QString("[%1] %2 (%3) - %4").arg(CompType).arg(CompUniqueName).arg(CompUserName).arg(CompComment) << endl;
-                out << CompVariableName << QString(" = sst.Component(\"%1\", \"%2.%3\")").arg(CompUniqueName).arg(CompElementName).arg(CompBaseName) << endl;
+    // Pass the shared Parameter Set by reference, only the overridden values are written below
+    Set = GetComponentParameterSet(Properties);
+    if ((Set != NULL) && (m_ParameterSetVarNameMap.contains(Set) == true)) {
+        out << CompVariableName << QString(".addParams(%1)").arg(m_ParameterSetVarNameMap.value(Set)) << endl;
+    } else {
+        Set = NULL;
+    }
 
-                // Set Global Component Settings
-                if (Rank.isEmpty() == false) {
-                    out << CompVariableName << QString(".setRank(%1)").arg(Rank) << endl;
-                }
-                if (Weight.isEmpty() == false) {
-                    out << CompVariableName << QString(".setWeight(%1)").arg(Weight) << endl;
-                }
+    FirstLineDone = false;
 
-                FirstLineDone = false;
-                // Set Component Parameters
-                out << CompVariableName << ".addParams( {";
-
-                // Get the number of properties for Component
-                NumProperties = Properties->GetNumProperties();
-                for (x = 0; x < NumProperties; x++) {
-                    // Get the property data
-                    Property  = Properties->GetProperty(x);
-                    PropName  = Property->GetName();
-                    PropValue = Property->GetValue();
-                    PropExportable = Property->GetExportable();
-
-                    // Make sure we are only writing the Exportable Properties (not the Generic Info)
-                    if ((PropExportable == true) && (PropValue.isEmpty() == false)) {
-                        if (FirstLineDone == true) {
-                            out << "," << endl;
-                        } else {
-                            out << endl;
-                        }
-
-                        // Write the parameter out to the export file
-                        out << TAB << QString("\"%1\" : \"%2\"").arg(PropName).arg(PropValue);
-                        FirstLineDone = true;
-                    }
-                }
+    // Get the number of properties for Component
+    NumProperties = Properties->GetNumProperties();
+    for (x = 0; x < NumProperties; x++) {
+        // Get the property data
+        Property  = Properties->GetProperty(x);
+        PropName  = Property->GetName();
+        PropValue = Property->GetValue();
+        PropExportable = Property->GetExportable();
 
-                out << endl << TAB << "} )" << endl;
-                BLANKLINE;
+        // Make sure we are only writing the Exportable Properties (not the Generic Info)
+        if ((PropExportable == true) && (PropValue.isEmpty() == false)) {
+            // Skip the values that the Parameter Set already provides
+            if ((Set != NULL) && (Set->ContainsParameter(PropName) == true) && (Set->GetParameterValue(PropName) == PropValue)) {
+                continue;
             }
+
+            if (FirstLineDone == true) {
+                out << "," << endl;
+            } else {
+                // Set Component Parameters
+                out << CompVariableName << ".addParams( {" << endl;
+            }
+
+            // Write the parameter out to the export file
+            out << TAB << QString("\"%1\" : \"%2\"").arg(PropName).arg(PropValue);
+            FirstLineDone = true;
         }
     }
+
+    if (FirstLineDone == true) {
+        out << endl << TAB << "} )" << endl;
+    } else if (Set == NULL) {
+        // Keep the empty parameter block for Components without any Parameters
+        out << CompVariableName << ".addParams( {" << endl << TAB << "} )" << endl;
+    }
+    BLANKLINE;
 }
 
 void PythonExporter::WriteLinks(QTextStream& out)
 {
     GraphicItemWire*         ptrParentWire;
-    QList<GraphicItemWire*>  ProcessedWiresList;
+    GraphicItemGroup*        ptrGroup;
+    QString                  NamePrefix;
+    int                      LinkIndex = 0;
+
+    BLANKLINE;
+    HEADER;
+    out << "# Setup Links" << endl;
+
+    // We need to get the lists of objects from the selections
+    foreach (QGraphicsItem* item, m_Scene->items(Qt::DescendingOrder)) {
+        if (item->type() == GraphicItemWire::Type) {
+            ptrParentWire = (GraphicItemWire*)item;
+            WriteLink(out, ptrParentWire, "", LinkIndex++);
+        }
+        if (item->type() == GraphicItemGroup::Type) {
+            // Write the Links that are internal to each Group Instance
+            ptrGroup = (GraphicItemGroup*)item;
+            NamePrefix = ptrGroup->GetInstanceName() + ".";
+            foreach (GraphicItemWire* InternalWire, ptrGroup->GetSubCircuitDefinition()->GetInternalWireList()) {
+                WriteLink(out, InternalWire, NamePrefix, LinkIndex++);
+            }
+        }
+    }
+}
+
+void PythonExporter::WriteLink(QTextStream& out, GraphicItemWire* ptrParentWire, QString NamePrefix, int LinkIndex)
+{
     QString                  WireIndex;
     QString                  WireComment;
     QString                  LinkVarName;
-    int                      LinkIndex = 0;
-
-    GraphicItemPort*         ptrStartConnectionPort;
-    GraphicItemPort*         ptrEndConnectionPort;
-    GraphicItemComponent*    ptrStartConnectionComponent;
-    GraphicItemComponent*    ptrEndConnectionComponent;
 
     QString                  StartPortLatency;
     QString                  EndPortLatency;
     QString                  StartPortName;
     QString                  EndPortName;
-    QString                  StartComponentUniqueName;
-    QString                  EndComponentUniqueName;
     QString                  StartComponentVarName;
     QString                  EndComponentVarName;
+    int                      StartWidth;
+    int                      EndWidth;
+    int                      NumLinks;
+    int                      x;
+
+    // Get the Wire's Properties
+    WireIndex = ptrParentWire->GetItemProperties()->GetPropertyValue(WIRE_PROPERTY_NUMBER);
+    WireComment = ptrParentWire->GetItemProperties()->GetPropertyValue(WIRE_PROPERTY_COMMENT);
+
+    // A Bus Wire is expanded into one Link per Bus Instance
+    StartWidth = GetLinkEndPointWidth(ptrParentWire->GetStartPointConnectedPort());
+    EndWidth = GetLinkEndPointWidth(ptrParentWire->GetEndPointConnectedPort());
+    NumLinks = qMin(StartWidth, EndWidth);
+    if (StartWidth != EndWidth) {
+        m_ExportWarningsList.append(QString("Warning: Wire %1 - Bus widths differ (%2 vs %3); only %4 links exported.").arg(WireIndex).arg(StartWidth).arg(EndWidth).arg(NumLinks));
+    }
 
-    BLANKLINE;
-    HEADER;
-    out << "# Setup Links" << endl;
-
-    // We need to get the lists of objects from the selections
-    foreach (QGraphicsItem* item, m_Scene->items(Qt::DescendingOrder)) {
-        if (item->type() == GraphicItemWireLineSegment::Type) {
-            // Get the items Parent (Graphic Wire item)
-            ptrParentWire = (GraphicItemWire*)item->parentItem();
-
-            // Check to see if we have already processed this parent wire
-            if (ProcessedWiresList.contains(ptrParentWire) == false) {
-                // This parent wire has not been processed it, so add it to the ProcessedWiresList
-                ProcessedWiresList.append(ptrParentWire);
-
-                // Get the Wire's Properties
-                WireIndex = ptrParentWire->GetItemProperties()->GetPropertyValue(WIRE_PROPERTY_NUMBER);
-                WireComment = ptrParentWire->GetItemProperties()->GetPropertyValue(WIRE_PROPERTY_COMMENT);
-                LinkVarName = QString("Link_%1").arg(LinkIndex++);
-
-                // Get the Ports that the Wire Ends are tied to and asssociated data
-                ptrStartConnectionPort = ptrParentWire->GetStartPointConnectedPort();
-                ptrEndConnectionPort   = ptrParentWire->GetEndPointConnectedPort();
-                StartPortLatency = ptrStartConnectionPort->GetItemProperties()->GetPropertyValue(PORT_PROPERTY_LATENCY);
-                EndPortLatency   = ptrEndConnectionPort->GetItemProperties()->GetPropertyValue(PORT_PROPERTY_LATENCY);
-                StartPortName = ptrStartConnectionPort->GetConfiguredPortName();
-                EndPortName = ptrEndConnectionPort->GetConfiguredPortName();
-
-                // Get the Components (of the ports) that the Wire Ends are tied to and asssociated data
-                ptrStartConnectionComponent = (GraphicItemComponent*)ptrStartConnectionPort->parentItem();
-                ptrEndConnectionComponent   = (GraphicItemComponent*)ptrEndConnectionPort->parentItem();
-                StartComponentUniqueName = ptrStartConnectionComponent->GetItemProperties()->GetPropertyValue(COMPONENT_PROPERTY_UNIQUENAME);
-                EndComponentUniqueName   = ptrEndConnectionComponent->GetItemProperties()->GetPropertyValue(COMPONENT_PROPERTY_UNIQUENAME);
-                StartComponentVarName = GetComponentVarName(StartComponentUniqueName);
-                EndComponentVarName = GetComponentVarName(EndComponentUniqueName);
-
-                // Write the Wire Instantiation and Connection
-                BLANKLINE;
-                out << "# " << QString("%1 : Wire %2 - %3").arg(LinkVarName).arg(WireIndex).arg(WireComment) << endl;
-                out << LinkVarName << QString(" = sst.Link(\"%1_Wire_%2\")").arg(LinkVarName).arg(WireIndex) << endl;
-                out << LinkVarName << ".connect( " << QString("(%1, \"%2\", \"%3\")").arg(StartComponentVarName).arg(StartPortName).arg(StartPortLatency)
-                                   << ", "         << QString("(%1, \"%2\", \"%3\")").arg(EndComponentVarName).arg(EndPortName).arg(EndPortLatency)
-                                   << " )" << endl;
-            }
+    for (x = 0; x < NumLinks; x++) {
+        // Single Links keep their original name
+        if ((StartWidth == 1) && (EndWidth == 1)) {
+            LinkVarName = QString("Link_%1").arg(LinkIndex);
+        } else {
+            LinkVarName = QString("Link_%1_%2").arg(LinkIndex).arg(x);
         }
+
+        // Get the Components and Ports that the Wire Ends are tied to and asssociated data
+        GetLinkEndPointInfo(ptrParentWire->GetStartPointConnectedPort(), NamePrefix, x, StartComponentVarName, StartPortName, StartPortLatency);
+        GetLinkEndPointInfo(ptrParentWire->GetEndPointConnectedPort(), NamePrefix, x, EndComponentVarName, EndPortName, EndPortLatency);
+
+        // Write the Wire Instantiation and Connection
+        BLANKLINE;
+        out << "# " << QString("%1 : %2Wire %3 - %4").arg(LinkVarName).arg(NamePrefix).arg(WireIndex).arg(WireComment) << endl;
+        out << LinkVarName << QString(" = sst.Link(\"%1_Wire_%2\")").arg(LinkVarName).arg(WireIndex) << endl;
+        out << LinkVarName << ".connect( " << QString("(%1, \"%2\", \"%3\")").arg(StartComponentVarName).arg(StartPortName).arg(StartPortLatency)
+                           << ", "         << QString("(%1, \"%2\", \"%3\")").arg(EndComponentVarName).arg(EndPortName).arg(EndPortLatency)
+                           << " )" << endl;
     }
 }
 
@@ -487,10 +625,40 @@ QString PythonExporter::GetComponentVarName(QString CompUniqueName)
 {
     QString CompVariableName;
 
-    // Create the Component's Variable Name
-    CompVariableName = CompUniqueName;
-    CompVariableName.replace(".", "_");
+    // Create the Component's Variable Name (Anything that is not valid in a Python identifier becomes an underscore)
+    CompVariableName = GraphicItemGroup::MakeValidInstanceName(CompUniqueName);
     return CompVariableName;
 }
 
+int PythonExporter::GetLinkEndPointWidth(GraphicItemPort* ptrPort)
+{
+    // Ports on a Group (Sub-Circuit Boundary Ports) are never Buses
+    if (qgraphicsitem_cast<GraphicItemGroup*>(ptrPort->GetOwnerItem()) != NULL) {
+        return 1;
+    }
+    return ptrPort->GetPortWidth();
+}
 
+void PythonExporter::GetLinkEndPointInfo(GraphicItemPort* ptrPort, QString NamePrefix, int Instance, QString& ComponentVarName, QString& PortName, QString& PortLatency)
+{
+    GraphicItemGroup*       ptrGroup;
+    GraphicItemComponent*   ptrComponent;
+    SubCircuitBoundaryPort* ptrBoundaryPort;
+
+    // If the Port is on a Group, the Link really connects to the Port of the Component inside of the Group
+    ptrGroup = qgraphicsitem_cast<GraphicItemGroup*>(ptrPort->GetOwnerItem());
+    if (ptrGroup != NULL) {
+        // The Latency is always set by the Port the Wire is connected to
+        PortLatency = ptrPort->GetItemProperties()->GetPropertyValue(PROPKEY_PORT_LATENCY);
+        ptrBoundaryPort = ptrGroup->GetBoundaryPortForGraphicalPort(ptrPort);
+        ComponentVarName = GetComponentVarName(NamePrefix + ptrGroup->GetInstanceName() + "." + ptrBoundaryPort->GetComponentUniqueName());
+        PortName = ptrBoundaryPort->GetInternalPortName();
+        return;
+    }
+
+    // Otherwise it is a Port on a Component
+    ptrComponent = (GraphicItemComponent*)ptrPort->GetOwnerItem();
+    ComponentVarName = GetComponentVarName(NamePrefix + ptrComponent->GetItemProperties()->GetPropertyValue(PROPKEY_COMPONENT_UNIQUENAME));
+    PortName = ptrPort->GetInstancePortName(Instance);
+    PortLatency = ptrPort->GetInstancePortLatency(Instance);
+}
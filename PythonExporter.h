@@ -42,6 +42,7 @@ public:
 private:
     bool CheckSSTStartupConfigComponent();
     bool CheckComponentParameters();
+    bool CheckComponentParameters(GraphicItemComponent* ptrComponent, QString NamePrefix);
     bool CheckComponentUnconnectedPorts();
     bool CheckUnconnectedWires();
     void DisplayExportStatus();
@@ -49,11 +50,18 @@ private:
 
     void WriteHeader(QTextStream& out);
     void WriteSSTStartupProgramOptions(QTextStream& out);
+    void WriteParameterSets(QTextStream& out);
+    void WriteParameterSet(QTextStream& out, ParameterSet* Set, QString SetVarName);
     void WriteComponents(QTextStream& out);
+    void WriteComponent(QTextStream& out, GraphicItemComponent* ptrComponent, QString NamePrefix);
     void WriteLinks(QTextStream& out);
+    void WriteLink(QTextStream& out, GraphicItemWire* ptrParentWire, QString NamePrefix, int LinkIndex);
     void WriteFooter(QTextStream& out);
 
     QString GetComponentVarName(QString CompUniqueName);
+    ParameterSet* GetComponentParameterSet(ItemProperties* Properties);
+    void    GetLinkEndPointInfo(GraphicItemPort* ptrPort, QString NamePrefix, int Instance, QString& ComponentVarName, QString& PortName, QString& PortLatency);
+    int     GetLinkEndPointWidth(GraphicItemPort* ptrPort);
 
 private:
     WiringScene*          m_Scene;
@@ -62,6 +70,7 @@ private:
     bool                  m_bFinalResult;
     QStringList           m_ExportErrorsList;
     QStringList           m_ExportWarningsList;
+    QHash<ParameterSet*, QString> m_ParameterSetVarNameMap;   // Parameter Sets written to the file and their Variable Names
 };
 
 #endif // PYTHONEXPORTER_H
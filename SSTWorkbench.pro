@@ -47,7 +47,10 @@ linux {
 
 message("BUILDING USING QT VERSION = "$$QT_MAJOR_VERSION"."$$QT_MINOR_VERSION"."$$QT_PATCH_VERSION)
 
-QT += core gui widgets xml printsupport
+QT += core gui widgets xml printsupport svg concurrent
+
+# zlib is used to stream large PNG image exports
+LIBS += -lz
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -70,23 +73,31 @@ SOURCES += \
     DialogExportDisplayStatus.cpp \
     DialogPreferences.cpp \
     DialogManageModules.cpp \
+    DialogTopologyGenerator.cpp \
     WiringScene.cpp \
     WindowItemProperties.cpp \
     WindowComponentToolbox.cpp \
+    WindowSceneMinimap.cpp \
     SSTInfoData.cpp \
     SSTInfoXMLFileParser.cpp \
     GraphicItemBase.cpp \
     GraphicItemComponent.cpp \
+    GraphicItemGroup.cpp \
     GraphicItemText.cpp \
     GraphicItemWire.cpp \
     GraphicItemWireHandle.cpp \
-    GraphicItemWireLineSegment.cpp \
     GraphicItemPort.cpp \
     ItemProperties.cpp \
+    ParameterSet.cpp \
     PortInfoData.cpp \
     SupportClasses.cpp \
+    SubCircuitDefinition.cpp \
+    TopologyGenerator.cpp \
     UndoRedoCommands.cpp \
-    PythonExporter.cpp
+    UndoRedoStack.cpp \
+    PythonExporter.cpp \
+    SceneExporter.cpp \
+    WireRouter.cpp
 
 HEADERS += \
     GlobalDef.h \
@@ -97,23 +108,31 @@ HEADERS += \
     DialogExportDisplayStatus.h \
     DialogPreferences.h \
     DialogManageModules.h \
+    DialogTopologyGenerator.h \
     WiringScene.h \
     WindowItemProperties.h \
     WindowComponentToolbox.h \
+    WindowSceneMinimap.h \
     SSTInfoData.h \
     SSTInfoXMLFileParser.h \
     GraphicItemBase.h \
     GraphicItemComponent.h \
+    GraphicItemGroup.h \
     GraphicItemText.h \
     GraphicItemWire.h \
     GraphicItemWireHandle.h \
-    GraphicItemWireLineSegment.h \
     GraphicItemPort.h \
     ItemProperties.h \
+    ParameterSet.h \
     PortInfoData.h \
     SupportClasses.h \
+    SubCircuitDefinition.h \
+    TopologyGenerator.h \
     UndoRedoCommands.h \
-    PythonExporter.h
+    UndoRedoStack.h \
+    PythonExporter.h \
+    SceneExporter.h \
+    WireRouter.h
 
 RESOURCES += \
     SSTWorkbench.qrc
@@ -123,7 +142,8 @@ FORMS += \
     DialogExportDisplayStatus.ui \
     DialogPreferences.ui \
     DialogParametersConfig.ui \
-    DialogManageModules.ui
+    DialogManageModules.ui \
+    DialogTopologyGenerator.ui
 
 OTHER_FILES += \
     build_linux_release.sh \
@@ -0,0 +1,401 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#include "SceneExporter.h"
+
+#include <QtConcurrent>
+#include <QtPrintSupport>
+#include <QtSvg>
+#include <zlib.h>
+
+////////////////////////////////////////////////////////////
+
+// Filter and Compress a Strip of raw RGB PNG rows.  This runs on a worker thread
+// while the next Strip is rendered; the zlib stream is only used by one Strip at a time.
+static QByteArray CompressPNGStrip(z_stream* Stream, const QByteArray* RawStrip, int RowBytes, int NumRows, bool FinalStrip)
+{
+    QByteArray   FilteredRow;
+    QByteArray   OutBuffer;
+    QByteArray   CompressedData;
+    const uchar* RawRow;
+    uchar*       OutRow;
+    int          Row;
+    int          Index;
+    int          FlushMode;
+
+    FilteredRow.resize(RowBytes + 1);
+    OutBuffer.resize(IMAGEEXPORT_DEFLATEBUFFERSIZE);
+    OutRow = (uchar*)FilteredRow.data();
+
+    for (Row = 0; Row < NumRows; Row++) {
+        RawRow = (const uchar*)RawStrip->constData() + (Row * RowBytes);
+
+        // PNG "Sub" Filter, each byte is stored as the difference from the same byte of the pixel to its left
+        OutRow[0] = 1;
+        for (Index = 0; Index < RowBytes; Index++) {
+            OutRow[Index + 1] = (Index < 3) ? RawRow[Index] : (uchar)(RawRow[Index] - RawRow[Index - 3]);
+        }
+
+        // Feed the Row to the compressor, the very last Row finishes the stream
+        FlushMode = ((FinalStrip == true) && (Row == NumRows - 1)) ? Z_FINISH : Z_NO_FLUSH;
+        Stream->next_in = (Bytef*)FilteredRow.data();
+        Stream->avail_in = FilteredRow.size();
+        do {
+            Stream->next_out = (Bytef*)OutBuffer.data();
+            Stream->avail_out = OutBuffer.size();
+            deflate(Stream, FlushMode);
+            CompressedData.append(OutBuffer.constData(), OutBuffer.size() - Stream->avail_out);
+        } while (Stream->avail_out == 0);
+    }
+    return CompressedData;
+}
+
+static void WritePNGChunk(QDataStream& Out, const char* ChunkType, const QByteArray& ChunkData)
+{
+    uLong CRC;
+
+    // The CRC covers the Chunk Type and the Chunk Data
+    CRC = crc32(0L, Z_NULL, 0);
+    CRC = crc32(CRC, (const Bytef*)ChunkType, 4);
+    CRC = crc32(CRC, (const Bytef*)ChunkData.constData(), ChunkData.size());
+
+    Out << (quint32)ChunkData.size();
+    Out.writeRawData(ChunkType, 4);
+    Out.writeRawData(ChunkData.constData(), ChunkData.size());
+    Out << (quint32)CRC;
+}
+
+////////////////////////////////////////////////////////////
+
+SceneExporter::SceneExporter(WiringScene* Scene, bool SelectedItemsOnly, QWidget* ParentWidget /*=0*/)
+{
+    QRectF ItemsRect;
+
+    m_Scene = Scene;
+    m_ParentWidget = ParentWidget;
+    m_SelectedItemsOnly = SelectedItemsOnly;
+
+    // Figure out what part of the Scene will be exported
+    if (m_SelectedItemsOnly == true) {
+        ItemsRect = m_Scene->GetSelectedItemsBoundingRect();
+    } else {
+        ItemsRect = m_Scene->GetItemsBoundingRect();
+    }
+
+    if (ItemsRect.isEmpty() == false) {
+        m_SourceRect = ItemsRect.adjusted(-IMAGEEXPORT_MARGIN, -IMAGEEXPORT_MARGIN, IMAGEEXPORT_MARGIN, IMAGEEXPORT_MARGIN);
+    }
+}
+
+SceneExporter::~SceneExporter()
+{
+}
+
+bool SceneExporter::ExportToPNGFile(QString FilePath, qreal Scale)
+{
+    qint64              ImageWidth;
+    qint64              ImageHeight;
+    int                 RowBytes;
+    int                 StripHeight;
+    int                 NumStrips;
+    int                 Strip;
+    int                 StripTop;
+    int                 RowsInStrip;
+    int                 TileLeft;
+    int                 TileWidth;
+    int                 Row;
+    int                 Col;
+    bool                ExportCanceled = false;
+    const QRgb*         TilePixels;
+    uchar*              StripPixels;
+    QByteArray          HeaderData;
+    QByteArray          CompressedData;
+    QByteArray          StripBuffers[2];
+    QFuture<QByteArray> CompressFuture;
+    z_stream            Stream;
+
+    // Size of the final image
+    ImageWidth = qCeil(m_SourceRect.width() * Scale);
+    ImageHeight = qCeil(m_SourceRect.height() * Scale);
+    if ((ImageWidth <= 0) || (ImageHeight <= 0) || (ImageWidth > IMAGEEXPORT_PNGMAXDIMENSION) || (ImageHeight > IMAGEEXPORT_PNGMAXDIMENSION)) {
+        m_LastErrorString = QString("The Image Size (%1 x %2) is not supported, try a smaller Scale.").arg(ImageWidth).arg(ImageHeight);
+        return false;
+    }
+
+    // The image is built as horizontal Strips (each rendered as Tiles), only two Strips
+    // are ever in memory: one being rendered and one being compressed to the file
+    RowBytes = ImageWidth * 3;
+    StripHeight = qBound(1, IMAGEEXPORT_STRIPMEMORYBUDGET / RowBytes, IMAGEEXPORT_TILESIZE);
+    NumStrips = (ImageHeight + StripHeight - 1) / StripHeight;
+
+    QFile File(FilePath);
+    if (File.open(QIODevice::WriteOnly) == false) {
+        m_LastErrorString = QString("Cannot Open File %1 for Writing:\n%2").arg(FilePath).arg(File.errorString());
+        return false;
+    }
+    QDataStream Out(&File);
+
+    // PNG Signature and Header (8 Bit RGB, No Interlace)
+    File.write("\x89PNG\r\n\x1a\n", 8);
+    QDataStream HeaderStream(&HeaderData, QIODevice::WriteOnly);
+    HeaderStream << (quint32)ImageWidth << (quint32)ImageHeight << (quint8)8 << (quint8)2 << (quint8)0 << (quint8)0 << (quint8)0;
+    WritePNGChunk(Out, "IHDR", HeaderData);
+
+    memset(&Stream, 0, sizeof(Stream));
+    deflateInit(&Stream, Z_DEFAULT_COMPRESSION);
+
+    QImage Tile(IMAGEEXPORT_TILESIZE, StripHeight, QImage::Format_RGB32);
+
+    QProgressDialog Progress(QString("Exporting %1...").arg(QFileInfo(FilePath).fileName()), "Cancel", 0, NumStrips, m_ParentWidget);
+    Progress.setWindowModality(Qt::WindowModal);
+    Progress.setMinimumDuration(500);
+
+    PrepareSceneForExport();
+
+    for (Strip = 0; Strip < NumStrips; Strip++) {
+        StripTop = Strip * StripHeight;
+        RowsInStrip = qMin((qint64)StripHeight, ImageHeight - StripTop);
+
+        // Render the Tiles of this Strip and pack them as raw RGB rows
+        QByteArray& RawStrip = StripBuffers[Strip % 2];
+        RawStrip.resize(RowBytes * RowsInStrip);
+        for (TileLeft = 0; TileLeft < ImageWidth; TileLeft += IMAGEEXPORT_TILESIZE) {
+            TileWidth = qMin((qint64)IMAGEEXPORT_TILESIZE, ImageWidth - TileLeft);
+            RenderPNGTile(Tile, TileLeft, StripTop, TileWidth, RowsInStrip, Scale);
+
+            for (Row = 0; Row < RowsInStrip; Row++) {
+                TilePixels = (const QRgb*)Tile.constScanLine(Row);
+                StripPixels = (uchar*)RawStrip.data() + (Row * RowBytes) + (TileLeft * 3);
+                for (Col = 0; Col < TileWidth; Col++) {
+                    StripPixels[(Col * 3) + 0] = qRed(TilePixels[Col]);
+                    StripPixels[(Col * 3) + 1] = qGreen(TilePixels[Col]);
+                    StripPixels[(Col * 3) + 2] = qBlue(TilePixels[Col]);
+                }
+            }
+        }
+
+        // Write out the previous Strip once it has been compressed, then start compressing this one
+        if (CompressFuture.isStarted() == true) {
+            CompressedData = CompressFuture.result();
+            if (CompressedData.isEmpty() == false) {
+                WritePNGChunk(Out, "IDAT", CompressedData);
+            }
+        }
+        CompressFuture = QtConcurrent::run(CompressPNGStrip, &Stream, &StripBuffers[Strip % 2], RowBytes, RowsInStrip, (Strip == NumStrips - 1));
+
+        Progress.setValue(Strip + 1);
+        if (Progress.wasCanceled() == true) {
+            ExportCanceled = true;
+            break;
+        }
+    }
+
+    // Write out the Final Strip
+    CompressFuture.waitForFinished();
+    if ((ExportCanceled == false) && (CompressFuture.isStarted() == true)) {
+        CompressedData = CompressFuture.result();
+        if (CompressedData.isEmpty() == false) {
+            WritePNGChunk(Out, "IDAT", CompressedData);
+        }
+    }
+    deflateEnd(&Stream);
+
+    RestoreSceneAfterExport();
+
+    if (ExportCanceled == true) {
+        File.remove();
+        m_LastErrorString = "Image Export was Canceled.";
+        return false;
+    }
+
+    WritePNGChunk(Out, "IEND", QByteArray());
+    File.close();
+
+    if ((Out.status() != QDataStream::Ok) || (File.error() != QFileDevice::NoError)) {
+        m_LastErrorString = QString("Error Writing File %1:\n%2").arg(FilePath).arg(File.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool SceneExporter::ExportToPDFFile(QString FilePath)
+{
+    QSizeF   PageSize;
+
+    // One Scene unit per point, shrunk if needed to fit the largest PDF page
+    // (The PDF is vector data written as it is painted, so it does not need tiling)
+    PageSize = m_SourceRect.size();
+    if ((PageSize.width() > IMAGEEXPORT_PDFMAXPAGEPOINTS) || (PageSize.height() > IMAGEEXPORT_PDFMAXPAGEPOINTS)) {
+        PageSize.scale(IMAGEEXPORT_PDFMAXPAGEPOINTS, IMAGEEXPORT_PDFMAXPAGEPOINTS, Qt::KeepAspectRatio);
+    }
+
+    QPdfWriter Writer(FilePath);
+    Writer.setCreator("SST Workbench");
+    Writer.setTitle(QFileInfo(FilePath).completeBaseName());
+    Writer.setPageSize(QPageSize(PageSize, QPageSize::Point, QString(), QPageSize::ExactMatch));
+    Writer.setPageMargins(QMarginsF(0, 0, 0, 0));
+
+    QPainter Painter;
+    if (Painter.begin(&Writer) == false) {
+        m_LastErrorString = QString("Cannot Open File %1 for Writing.").arg(FilePath);
+        return false;
+    }
+
+    PrepareSceneForExport();
+    RenderSceneRegion(&Painter, QRectF(0, 0, Writer.width(), Writer.height()), m_SourceRect, Qt::KeepAspectRatio);
+    Painter.end();
+    RestoreSceneAfterExport();
+
+    return true;
+}
+
+bool SceneExporter::ExportToSVGFile(QString FilePath)
+{
+    QSvgGenerator Generator;
+
+    // One Scene unit per SVG unit, the SVG is written to the file as it is painted
+    Generator.setFileName(FilePath);
+    Generator.setSize(m_SourceRect.size().toSize());
+    Generator.setViewBox(QRectF(QPointF(0, 0), m_SourceRect.size()));
+    Generator.setTitle(QFileInfo(FilePath).completeBaseName());
+    Generator.setDescription("Created by SST Workbench");
+
+    QPainter Painter;
+    if (Painter.begin(&Generator) == false) {
+        m_LastErrorString = QString("Cannot Open File %1 for Writing.").arg(FilePath);
+        return false;
+    }
+
+    PrepareSceneForExport();
+    RenderSceneRegion(&Painter, QRectF(QPointF(0, 0), m_SourceRect.size()), m_SourceRect, Qt::KeepAspectRatio);
+    Painter.end();
+    RestoreSceneAfterExport();
+
+    return true;
+}
+
+bool SceneExporter::PrintToPages(QPrinter* Printer, PrintLayout Layout)
+{
+    QRectF PageArea;
+    QSizeF PageSourceSize;
+    QRectF PageSourceRect;
+    qreal  PixelsPerUnit;
+    int    NumColumns;
+    int    NumRows;
+    int    Column;
+    int    Row;
+
+    QPainter Painter;
+    if (Painter.begin(Printer) == false) {
+        m_LastErrorString = "Cannot Start Printing.";
+        return false;
+    }
+
+    // The Printable Area of each page in device pixels
+    PageArea = QRectF(0, 0, Printer->width(), Printer->height());
+
+    PrepareSceneForExport();
+
+    if (Layout == PRINT_FITTOONEPAGE) {
+        RenderSceneRegion(&Painter, PageArea, m_SourceRect, Qt::KeepAspectRatio);
+    } else {
+        // Full size printing, split the area into page sized pieces (Left to Right, then Top to Bottom)
+        PixelsPerUnit = Printer->resolution() / PRINT_POINTSPERINCH;
+        PageSourceSize = PageArea.size() / PixelsPerUnit;
+        NumColumns = qCeil(m_SourceRect.width() / PageSourceSize.width());
+        NumRows = qCeil(m_SourceRect.height() / PageSourceSize.height());
+
+        for (Row = 0; Row < NumRows; Row++) {
+            for (Column = 0; Column < NumColumns; Column++) {
+                if ((Row != 0) || (Column != 0)) {
+                    Printer->newPage();
+                }
+
+                PageSourceRect = QRectF(m_SourceRect.left() + (Column * PageSourceSize.width()),
+                                        m_SourceRect.top() + (Row * PageSourceSize.height()),
+                                        PageSourceSize.width(), PageSourceSize.height()) & m_SourceRect;
+
+                RenderSceneRegion(&Painter, QRectF(QPointF(0, 0), PageSourceRect.size() * PixelsPerUnit), PageSourceRect, Qt::IgnoreAspectRatio);
+            }
+        }
+    }
+
+    Painter.end();
+    RestoreSceneAfterExport();
+
+    return true;
+}
+
+void SceneExporter::PrepareSceneForExport()
+{
+    QSet<QGraphicsItem*> SelectedTopLevelItemSet;
+
+    // Keep the rest of the application from reacting to the temporary changes below
+    m_SavedSelectionList = m_Scene->selectedItems();
+    SelectedTopLevelItemSet = m_Scene->GetSelectedTopLevelItems().toSet();
+    m_Scene->blockSignals(true);
+
+    // Hide everything that is not selected when only exporting the Selection
+    m_HiddenItemList.clear();
+    if (m_SelectedItemsOnly == true) {
+        foreach (QGraphicsItem* Item, m_Scene->GetTopLevelItems()) {
+            if ((SelectedTopLevelItemSet.contains(Item) == false) && (Item->isVisible() == true)) {
+                Item->hide();
+                m_HiddenItemList.append(Item);
+            }
+        }
+    }
+
+    // Exported images do not show the Selection Highlighting
+    m_Scene->clearSelection();
+}
+
+void SceneExporter::RestoreSceneAfterExport()
+{
+    foreach (QGraphicsItem* Item, m_HiddenItemList) {
+        Item->show();
+    }
+    m_HiddenItemList.clear();
+
+    foreach (QGraphicsItem* Item, m_SavedSelectionList) {
+        Item->setSelected(true);
+    }
+    m_SavedSelectionList.clear();
+
+    m_Scene->blockSignals(false);
+}
+
+void SceneExporter::RenderSceneRegion(QPainter* Painter, const QRectF& TargetRect, const QRectF& SourceRect, Qt::AspectRatioMode AspectRatioMode)
+{
+    Painter->setRenderHint(QPainter::Antialiasing);
+    Painter->setRenderHint(QPainter::TextAntialiasing);
+    m_Scene->render(Painter, TargetRect, SourceRect, AspectRatioMode);
+}
+
+void SceneExporter::RenderPNGTile(QImage& Tile, int TileLeft, int TileTop, int TileWidth, int TileHeight, qreal Scale)
+{
+    QRectF SourceRect;
+
+    // The part of the Scene that lands in this Tile of the final image
+    SourceRect = QRectF(m_SourceRect.left() + (TileLeft / Scale), m_SourceRect.top() + (TileTop / Scale),
+                        TileWidth / Scale, TileHeight / Scale);
+
+    Tile.fill(Qt::white);
+    QPainter Painter(&Tile);
+    RenderSceneRegion(&Painter, QRectF(0, 0, TileWidth, TileHeight), SourceRect, Qt::IgnoreAspectRatio);
+}
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SCENEEXPORTER_H
+#define SCENEEXPORTER_H
+
+#include "GlobalIncludes.h"
+
+#include "WiringScene.h"
+
+class WiringScene;
+class QPrinter;
+
+///////////////////////////////////////////////////////////////////////////////
+
+class SceneExporter
+{
+public:
+    // Enumerations for the Printed Page Layout
+    enum PrintLayout { PRINT_FITTOONEPAGE, PRINT_TILEDPAGES };
+
+    SceneExporter(WiringScene* Scene, bool SelectedItemsOnly, QWidget* ParentWidget = 0);
+    ~SceneExporter();
+
+    // The area of the Scene that will be exported
+    QRectF GetExportSourceRect() {return m_SourceRect;}
+    bool   IsExportAreaEmpty() {return m_SourceRect.isEmpty();}
+
+    // Export the area to a file (PNG is rendered in tiles so memory use does not depend on the image size)
+    bool ExportToPNGFile(QString FilePath, qreal Scale);
+    bool ExportToPDFFile(QString FilePath);
+    bool ExportToSVGFile(QString FilePath);
+
+    // Print the area on one page or full size across multiple pages
+    bool PrintToPages(QPrinter* Printer, PrintLayout Layout);
+
+    QString GetLastErrorString() {return m_LastErrorString;}
+
+private:
+    void PrepareSceneForExport();
+    void RestoreSceneAfterExport();
+    void RenderSceneRegion(QPainter* Painter, const QRectF& TargetRect, const QRectF& SourceRect, Qt::AspectRatioMode AspectRatioMode);
+    void RenderPNGTile(QImage& Tile, int TileLeft, int TileTop, int TileWidth, int TileHeight, qreal Scale);
+
+private:
+    WiringScene*          m_Scene;
+    QWidget*              m_ParentWidget;
+    bool                  m_SelectedItemsOnly;
+    QRectF                m_SourceRect;
+    QString               m_LastErrorString;
+    QList<QGraphicsItem*> m_SavedSelectionList;
+    QList<QGraphicsItem*> m_HiddenItemList;
+};
+
+#endif // SCENEEXPORTER_H
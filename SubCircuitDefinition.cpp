@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#include "SubCircuitDefinition.h"
+#include "WiringScene.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+SubCircuitBoundaryPort::SubCircuitBoundaryPort(QString ComponentUniqueName, QString InternalPortName, QString InternalPortLatency, PortInfoData::ComponentSide AssignedSide)
+{
+    m_ComponentUniqueName = ComponentUniqueName;
+    m_InternalPortName = InternalPortName;
+    m_InternalPortLatency = InternalPortLatency;
+    m_AssignedSide = AssignedSide;
+}
+
+SubCircuitBoundaryPort::SubCircuitBoundaryPort(QDataStream& DataStreamIn)
+{
+    qint32 nAssignedSide;
+
+    // Serialization - Load the Data
+    DataStreamIn >> m_ComponentUniqueName;
+    DataStreamIn >> m_InternalPortName;
+    DataStreamIn >> m_InternalPortLatency;
+    DataStreamIn >> nAssignedSide;
+
+    m_AssignedSide = (PortInfoData::ComponentSide)nAssignedSide;
+}
+
+void SubCircuitBoundaryPort::SaveData(QDataStream& DataStreamOut)
+{
+    // Serialization - Save the Data
+    DataStreamOut << m_ComponentUniqueName;
+    DataStreamOut << m_InternalPortName;
+    DataStreamOut << m_InternalPortLatency;
+    DataStreamOut << (qint32)m_AssignedSide;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SubCircuitDefinition::SubCircuitDefinition(QString DefinitionName, const QByteArray& ContentsData, QList<SubCircuitBoundaryPort*>& BoundaryPortList)
+{
+    m_DefinitionName = DefinitionName;
+    m_ContentsData = ContentsData;
+    m_BoundaryPortList = BoundaryPortList;
+
+    // The Internals are not built until someone needs them
+    m_InternalsUndoStack = NULL;
+    m_InternalsScene = NULL;
+
+    ReadContentsCounts();
+}
+
+SubCircuitDefinition::SubCircuitDefinition(QDataStream& DataStreamIn)
+{
+    int    x;
+    qint32 NumBoundaryPorts;
+
+    // Serialization - Load the Data
+    DataStreamIn >> m_DefinitionName;
+    DataStreamIn >> m_ContentsData;
+    DataStreamIn >> NumBoundaryPorts;
+
+    for (x = 0; x < NumBoundaryPorts; x++) {
+        m_BoundaryPortList.append(new SubCircuitBoundaryPort(DataStreamIn));
+    }
+
+    // The Internals are not built until someone needs them
+    m_InternalsUndoStack = NULL;
+    m_InternalsScene = NULL;
+
+    ReadContentsCounts();
+}
+
+SubCircuitDefinition::~SubCircuitDefinition()
+{
+    // Deleting the scene will delete all the internal items
+    delete m_InternalsScene;
+    delete m_InternalsUndoStack;
+
+    qDeleteAll(m_BoundaryPortList);
+    m_BoundaryPortList.clear();
+}
+
+void SubCircuitDefinition::SaveData(QDataStream& DataStreamOut)
+{
+    // Serialization - Save the Data
+    DataStreamOut << m_DefinitionName;
+    DataStreamOut << m_ContentsData;
+    DataStreamOut << (qint32)m_BoundaryPortList.count();
+
+    foreach (SubCircuitBoundaryPort* BoundaryPort, m_BoundaryPortList) {
+        BoundaryPort->SaveData(DataStreamOut);
+    }
+}
+
+QList<GraphicItemComponent*>& SubCircuitDefinition::GetInternalComponentList()
+{
+    BuildInternals();
+    return m_InternalComponentList;
+}
+
+QList<GraphicItemWire*>& SubCircuitDefinition::GetInternalWireList()
+{
+    BuildInternals();
+    return m_InternalWireList;
+}
+
+GraphicItemComponent* SubCircuitDefinition::FindInternalComponent(QString ComponentUniqueName)
+{
+    // Search the internal components for the matching unique name
+    foreach (GraphicItemComponent* Component, GetInternalComponentList()) {
+        if (Component->GetItemProperties()->GetPropertyValue(PROPKEY_COMPONENT_UNIQUENAME) == ComponentUniqueName) {
+            return Component;
+        }
+    }
+    return NULL;
+}
+
+QRectF SubCircuitDefinition::GetInternalsBoundingRect()
+{
+    BuildInternals();
+    return m_InternalsScene->itemsBoundingRect();
+}
+
+void SubCircuitDefinition::RenderInternals(QPainter* painter, const QRectF& TargetRect)
+{
+    QRectF SourceRect;
+    qreal  Scale;
+
+    // Render the Internals to a pixmap only once, all instances share the pixmap
+    if (m_InternalsPixmap.isNull() == true) {
+        SourceRect = GetInternalsBoundingRect();
+
+        // Keep the pixmap to a sane size for very large Sub-Circuits
+        Scale = 1.0;
+        if (qMax(SourceRect.width(), SourceRect.height()) > GROUP_EXPANDED_MAX_PIXMAP_SIZE) {
+            Scale = GROUP_EXPANDED_MAX_PIXMAP_SIZE / qMax(SourceRect.width(), SourceRect.height());
+        }
+
+        m_InternalsPixmap = QPixmap(qCeil(SourceRect.width() * Scale) + 1, qCeil(SourceRect.height() * Scale) + 1);
+        m_InternalsPixmap.fill(Qt::transparent);
+
+        QPainter PixmapPainter(&m_InternalsPixmap);
+        PixmapPainter.setRenderHint(QPainter::Antialiasing);
+        m_InternalsScene->render(&PixmapPainter, QRectF(m_InternalsPixmap.rect()), SourceRect);
+    }
+
+    // Draw the cached pixmap into the target area
+    painter->drawPixmap(TargetRect, m_InternalsPixmap, QRectF(m_InternalsPixmap.rect()));
+}
+
+void SubCircuitDefinition::ReadContentsCounts()
+{
+    qint32 ComponentCount;
+    qint32 WireCount;
+
+    // The counts are at the front of the Contents Data
+    QDataStream DataStreamIn(m_ContentsData);
+    DataStreamIn.setVersion(QDataStream::Qt_5_2);
+    DataStreamIn >> ComponentCount;
+    DataStreamIn >> WireCount;
+
+    m_NumInternalComponents = ComponentCount;
+    m_NumInternalWires = WireCount;
+}
+
+void SubCircuitDefinition::BuildInternals()
+{
+    int                   x;
+    qint32                ComponentCount;
+    qint32                WireCount;
+    GraphicItemComponent* Component;
+    GraphicItemWire*      Wire;
+
+    // Only build the internals once
+    if (m_InternalsScene != NULL) {
+        return;
+    }
+
+    // Build a private (never displayed) scene to hold the internals.
+    m_InternalsUndoStack = new UndoRedoStack();
+    m_InternalsScene = new WiringScene(NULL, m_InternalsUndoStack);
+
+    // Load the Components and then the Wires (Wires will connect to the Component Ports)
+    QDataStream DataStreamIn(m_ContentsData);
+    DataStreamIn.setVersion(QDataStream::Qt_5_2);
+    DataStreamIn >> ComponentCount;
+    DataStreamIn >> WireCount;
+
+    for (x = 0; x < ComponentCount; x++) {
+        m_InternalsScene->CreateNewComponentItem(DataStreamIn);
+    }
+    for (x = 0; x < WireCount; x++) {
+        m_InternalsScene->CreateNewWireItem(DataStreamIn);
+    }
+
+    // Build the lists of internal items
+    foreach (QGraphicsItem* Item, m_InternalsScene->items()) {
+        // Cast to a pointer, if the cast is invalid, the pointer will be NULL
+        Component = qgraphicsitem_cast<GraphicItemComponent*>(Item);
+        Wire = qgraphicsitem_cast<GraphicItemWire*>(Item);
+
+        if (Component != NULL) {
+            m_InternalComponentList.append(Component);
+        }
+        if (Wire != NULL) {
+            m_InternalWireList.append(Wire);
+        }
+    }
+}
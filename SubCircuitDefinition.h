@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SUBCIRCUITDEFINITION_H
+#define SUBCIRCUITDEFINITION_H
+
+#include "GlobalIncludes.h"
+
+#include "PortInfoData.h"
+
+// Forward declarations to allow compile
+class WiringScene;
+class UndoRedoStack;
+class GraphicItemComponent;
+class GraphicItemWire;
+
+///////////////////////////////////////////////////////////////////////////////
+
+class SubCircuitBoundaryPort
+{
+public:
+    // Constructor / Destructor
+    SubCircuitBoundaryPort(QString ComponentUniqueName, QString InternalPortName, QString InternalPortLatency, PortInfoData::ComponentSide AssignedSide);
+    SubCircuitBoundaryPort(QDataStream& DataStreamIn);  // Only used for serialization
+
+    // Information on the Internal Port that this Boundary Port exports
+    QString GetComponentUniqueName() {return m_ComponentUniqueName;}
+    QString GetInternalPortName() {return m_InternalPortName;}
+    QString GetInternalPortLatency() {return m_InternalPortLatency;}
+
+    // The Name of the Port as seen on the outside of the Sub-Circuit
+    QString GetBoundaryPortName() {return m_ComponentUniqueName + GROUP_BOUNDARYPORT_SEPERATOR + m_InternalPortName;}
+
+    // What side of the Collapsed Group this port is drawn on
+    PortInfoData::ComponentSide GetAssignedSide() {return m_AssignedSide;}
+
+    // Serialization of data
+    void SaveData(QDataStream& DataStreamOut);
+
+private:
+    QString                     m_ComponentUniqueName;   // Unique Name of the Component inside the Sub-Circuit
+    QString                     m_InternalPortName;      // Configured Port name on that Component
+    QString                     m_InternalPortLatency;   // Latency of the internal port when the Sub-Circuit was captured
+    PortInfoData::ComponentSide m_AssignedSide;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+class SubCircuitDefinition
+{
+public:
+    // Constructor / Destructor
+    SubCircuitDefinition(QString DefinitionName, const QByteArray& ContentsData, QList<SubCircuitBoundaryPort*>& BoundaryPortList);
+    SubCircuitDefinition(QDataStream& DataStreamIn);  // Only used for serialization
+    ~SubCircuitDefinition();
+
+    // Name of the Definition
+    QString GetDefinitionName() {return m_DefinitionName;}
+
+    // Boundary Ports of the Sub-Circuit
+    int GetNumBoundaryPorts() {return m_BoundaryPortList.count();}
+    SubCircuitBoundaryPort* GetBoundaryPort(int Index) {return m_BoundaryPortList.at(Index);}
+
+    // Access to the Internals of the Sub-Circuit.  The internals are only
+    // built (materialized) the first time they are requested; all instances
+    // of the Sub-Circuit share the same set of internal items.
+    QList<GraphicItemComponent*>& GetInternalComponentList();
+    QList<GraphicItemWire*>&      GetInternalWireList();
+    GraphicItemComponent*         FindInternalComponent(QString ComponentUniqueName);
+    int GetNumInternalComponents() {return m_NumInternalComponents;}
+    int GetNumInternalWires() {return m_NumInternalWires;}
+
+    // Visual Rendering of the Internals (Used by expanded Group Instances)
+    QRectF GetInternalsBoundingRect();
+    void   RenderInternals(QPainter* painter, const QRectF& TargetRect);
+
+    // Serialization of data
+    void SaveData(QDataStream& DataStreamOut);
+
+private:
+    void ReadContentsCounts();
+    void BuildInternals();
+
+private:
+    QString                         m_DefinitionName;
+    QByteArray                      m_ContentsData;           // Serialized Components and Wires of the Sub-Circuit
+    QList<SubCircuitBoundaryPort*>  m_BoundaryPortList;
+    int                             m_NumInternalComponents;
+    int                             m_NumInternalWires;
+
+    // Materialized Internals (Created on demand)
+    UndoRedoStack*                  m_InternalsUndoStack;
+    WiringScene*                    m_InternalsScene;
+    QList<GraphicItemComponent*>    m_InternalComponentList;
+    QList<GraphicItemWire*>         m_InternalWireList;
+    QPixmap                         m_InternalsPixmap;        // Cached render of the internals
+};
+
+#endif // SUBCIRCUITDEFINITION_H
@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#include "TopologyGenerator.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+TopologyGenerator::TopologyGenerator(TopologyType Type, int Param1, int Param2, int Param3, int EndpointsPerRouter)
+{
+    // Init Member Variables
+    m_TopologyType = Type;
+    m_Param1 = Param1;
+    m_Param2 = Param2;
+    m_Param3 = Param3;
+    m_EndpointsPerRouter = EndpointsPerRouter;
+}
+
+TopologyGenerator::~TopologyGenerator()
+{
+}
+
+bool TopologyGenerator::BuildTopology(QString& ErrorMsg)
+{
+    // Clear any previously built Topology
+    m_RouterGridPosList.clear();
+    m_RouterNumNetworkPortsList.clear();
+    m_RouterNumEndpointsList.clear();
+    m_RouterLinkList.clear();
+
+    // All Shape Parameters in use must be at least 1
+    if ((m_Param1 < 1) || (m_Param2 < 1) || ((m_TopologyType == TOPO_DRAGONFLY) && (m_Param3 < 1)) || (m_EndpointsPerRouter < 0)) {
+        ErrorMsg = QString("Invalid %1 Shape Parameters").arg(GetTopologyTypeName(m_TopologyType));
+        return false;
+    }
+
+    switch (m_TopologyType) {
+        case TOPO_MESH      : BuildMeshOrTorus(false); break;
+        case TOPO_TORUS     : BuildMeshOrTorus(true); break;
+        case TOPO_FATTREE   : BuildFatTree(); break;
+        case TOPO_DRAGONFLY : if (BuildDragonfly(ErrorMsg) == false) return false; break;
+        default             : ErrorMsg = "Unknown Topology Type"; return false;
+    }
+
+    // Make sure we are not going to bury the scene
+    if (GetNumRouters() + GetNumEndpoints() > TOPOLOGY_MAX_COMPONENTS) {
+        ErrorMsg = QString("%1 would create %2 Components; The limit is %3").arg(GetTopologyDescription()).arg(GetNumRouters() + GetNumEndpoints()).arg(TOPOLOGY_MAX_COMPONENTS);
+        return false;
+    }
+
+    return true;
+}
+
+QString TopologyGenerator::GetTopologyDescription()
+{
+    switch (m_TopologyType) {
+        case TOPO_MESH      : return QString("Mesh %1x%2").arg(m_Param1).arg(m_Param2);
+        case TOPO_TORUS     : return QString("Torus %1x%2").arg(m_Param1).arg(m_Param2);
+        case TOPO_FATTREE   : return QString("Fat-Tree %1 Leaf x %2 Spine").arg(m_Param1).arg(m_Param2);
+        case TOPO_DRAGONFLY : return QString("Dragonfly %1 Groups x %2 Routers").arg(m_Param1).arg(m_Param2);
+        default             : return GetTopologyTypeName(m_TopologyType);
+    }
+}
+
+int TopologyGenerator::GetNumEndpoints()
+{
+    int NumEndpoints = 0;
+
+    foreach (int RouterEndpoints, m_RouterNumEndpointsList) {
+        NumEndpoints += RouterEndpoints;
+    }
+    return NumEndpoints;
+}
+
+int TopologyGenerator::GetNumLinks()
+{
+    // Every Endpoint has one link to its Router
+    return m_RouterLinkList.count() + GetNumEndpoints();
+}
+
+QString TopologyGenerator::GetTopologyTypeName(TopologyType Type)
+{
+    switch (Type) {
+        case TOPO_MESH      : return TOPOLOGY_TYPESTR_MESH;
+        case TOPO_TORUS     : return TOPOLOGY_TYPESTR_TORUS;
+        case TOPO_FATTREE   : return TOPOLOGY_TYPESTR_FATTREE;
+        case TOPO_DRAGONFLY : return TOPOLOGY_TYPESTR_DRAGONFLY;
+        default             : return TOPOLOGY_TYPESTR_UNDEFINED;
+    }
+}
+
+QStringList TopologyGenerator::GetTopologyParamNames(TopologyType Type)
+{
+    QStringList ParamNames;
+
+    // An empty name means the Parameter is not used by the Topology
+    switch (Type) {
+        case TOPO_MESH      :
+        case TOPO_TORUS     : ParamNames << "X Size" << "Y Size" << ""; break;
+        case TOPO_FATTREE   : ParamNames << "Leaf Routers" << "Spine Routers" << ""; break;
+        case TOPO_DRAGONFLY : ParamNames << "Groups" << "Routers per Group" << "Global Links per Router"; break;
+        default             : ParamNames << "" << "" << ""; break;
+    }
+    return ParamNames;
+}
+
+void TopologyGenerator::AddRouter(int GridX, int GridY, int NumNetworkPorts, int NumEndpoints)
+{
+    m_RouterGridPosList.append(QPoint(GridX, GridY));
+    m_RouterNumNetworkPortsList.append(NumNetworkPorts);
+    m_RouterNumEndpointsList.append(NumEndpoints);
+}
+
+void TopologyGenerator::BuildMeshOrTorus(bool WrapAround)
+{
+    int x;
+    int y;
+    int SizeX = m_Param1;
+    int SizeY = m_Param2;
+    int Router;
+
+    // NOTE: Each Router has 4 Network Ports: 0 = East (+X), 1 = West (-X), 2 = South (+Y), 3 = North (-Y)
+    //       Router Number = (y * SizeX) + x
+
+    // Create the Routers
+    for (y = 0; y < SizeY; y++) {
+        for (x = 0; x < SizeX; x++) {
+            AddRouter(x, y, 4, m_EndpointsPerRouter);
+        }
+    }
+
+    // Create the Links to the Neighbors
+    for (y = 0; y < SizeY; y++) {
+        for (x = 0; x < SizeX; x++) {
+            Router = (y * SizeX) + x;
+
+            // East to West Links
+            if (x < SizeX - 1) {
+                m_RouterLinkList.append(TopologyLink(Router, 0, Router + 1, 1));
+            } else if ((WrapAround == true) && (SizeX > 2)) {
+                // The Wrap link is skipped when there are only 2 Routers (it would duplicate the normal link)
+                m_RouterLinkList.append(TopologyLink(Router, 0, y * SizeX, 1));
+            }
+
+            // South to North Links
+            if (y < SizeY - 1) {
+                m_RouterLinkList.append(TopologyLink(Router, 2, Router + SizeX, 3));
+            } else if ((WrapAround == true) && (SizeY > 2)) {
+                m_RouterLinkList.append(TopologyLink(Router, 2, x, 3));
+            }
+        }
+    }
+}
+
+void TopologyGenerator::BuildFatTree()
+{
+    int Leaf;
+    int Spine;
+    int NumLeafs = m_Param1;
+    int NumSpines = m_Param2;
+    int SpineOffset;
+
+    // NOTE: This is a 2 Level Folded Clos; Leaf Routers are numbered first followed by the Spine Routers.
+    //       Leaf Network Port N goes up to Spine N; Spine Network Port N goes down to Leaf N.
+    //       Only the Leaf Routers have Endpoints.
+
+    // Create the Leaf Routers (Bottom Row)
+    for (Leaf = 0; Leaf < NumLeafs; Leaf++) {
+        AddRouter(Leaf, 1, NumSpines, m_EndpointsPerRouter);
+    }
+
+    // Create the Spine Routers (Top Row, centered over the Leafs)
+    SpineOffset = qMax(0, (NumLeafs - NumSpines) / 2);
+    for (Spine = 0; Spine < NumSpines; Spine++) {
+        AddRouter(SpineOffset + Spine, 0, NumLeafs, 0);
+    }
+
+    // Every Leaf connects to every Spine
+    for (Leaf = 0; Leaf < NumLeafs; Leaf++) {
+        for (Spine = 0; Spine < NumSpines; Spine++) {
+            m_RouterLinkList.append(TopologyLink(Leaf, Spine, NumLeafs + Spine, Leaf));
+        }
+    }
+}
+
+bool TopologyGenerator::BuildDragonfly(QString& ErrorMsg)
+{
+    int Group;
+    int PeerGroup;
+    int Router;
+    int PeerRouter;
+    int NumGroups = m_Param1;
+    int RoutersPerGroup = m_Param2;
+    int GlobalPerRouter = m_Param3;
+    int LocalPorts = RoutersPerGroup - 1;
+    int Slot;
+    int PeerSlot;
+
+    // NOTE: Router Number = (Group * RoutersPerGroup) + Router in Group
+    //       Network Ports 0 to (RoutersPerGroup - 2) are the Local (all-to-all inside of the group) Ports,
+    //       followed by the Global Ports. Each Group has (RoutersPerGroup * GlobalPerRouter) Global Slots
+    //       and one Global Link to every other Group.
+    if (RoutersPerGroup * GlobalPerRouter < NumGroups - 1) {
+        ErrorMsg = QString("Dragonfly needs at least %1 Global Links per Group (Routers per Group x Global Links per Router) to connect %2 Groups")
+                   .arg(NumGroups - 1).arg(NumGroups);
+        return false;
+    }
+
+    // Create the Routers (One column per Group)
+    for (Group = 0; Group < NumGroups; Group++) {
+        for (Router = 0; Router < RoutersPerGroup; Router++) {
+            AddRouter(Group, Router, LocalPorts + GlobalPerRouter, m_EndpointsPerRouter);
+        }
+    }
+
+    // Create the Local Links (All-to-All inside of each Group)
+    for (Group = 0; Group < NumGroups; Group++) {
+        for (Router = 0; Router < RoutersPerGroup; Router++) {
+            for (PeerRouter = Router + 1; PeerRouter < RoutersPerGroup; PeerRouter++) {
+                // The Local Port to a Peer skips over the Router itself
+                m_RouterLinkList.append(TopologyLink((Group * RoutersPerGroup) + Router, PeerRouter - 1,
+                                                     (Group * RoutersPerGroup) + PeerRouter, Router));
+            }
+        }
+    }
+
+    // Create the Global Links (One between every pair of Groups)
+    for (Group = 0; Group < NumGroups; Group++) {
+        for (PeerGroup = Group + 1; PeerGroup < NumGroups; PeerGroup++) {
+            // The Global Slot of a Group used for a Peer Group skips over the Group itself
+            Slot = PeerGroup - 1;
+            PeerSlot = Group;
+            m_RouterLinkList.append(TopologyLink((Group * RoutersPerGroup) + (Slot / GlobalPerRouter), LocalPorts + (Slot % GlobalPerRouter),
+                                                 (PeerGroup * RoutersPerGroup) + (PeerSlot / GlobalPerRouter), LocalPorts + (PeerSlot % GlobalPerRouter)));
+        }
+    }
+
+    return true;
+}
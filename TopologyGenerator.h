@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TOPOLOGYGENERATOR_H
+#define TOPOLOGYGENERATOR_H
+
+#include "GlobalIncludes.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+class TopologyLink
+{
+public:
+    // Constructor
+    TopologyLink(int SrcRouter, int SrcPort, int DstRouter, int DstPort)
+        : m_SrcRouter(SrcRouter), m_SrcPort(SrcPort), m_DstRouter(DstRouter), m_DstPort(DstPort) {}
+
+    int GetSrcRouter() const {return m_SrcRouter;}
+    int GetSrcPort() const {return m_SrcPort;}
+    int GetDstRouter() const {return m_DstRouter;}
+    int GetDstPort() const {return m_DstPort;}
+
+private:
+    int m_SrcRouter;
+    int m_SrcPort;
+    int m_DstRouter;
+    int m_DstPort;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+class TopologyGenerator
+{
+public:
+    // Enumerations for Identifying the Topology (NOTE: TOPO_END MUST ALWAYS BE LAST)
+    enum TopologyType { TOPO_MESH, TOPO_TORUS, TOPO_FATTREE, TOPO_DRAGONFLY, TOPO_END };
+
+    // Constructor / Destructor
+    // NOTE: The meaning of the Shape Parameters depends upon the Topology:
+    //       MESH/TORUS - Param1 = X Size; Param2 = Y Size; Param3 = Unused
+    //       FATTREE    - Param1 = Number of Leaf Routers; Param2 = Number of Spine Routers; Param3 = Unused
+    //       DRAGONFLY  - Param1 = Number of Groups; Param2 = Routers per Group; Param3 = Global Links per Router
+    TopologyGenerator(TopologyType Type, int Param1, int Param2, int Param3, int EndpointsPerRouter);
+    ~TopologyGenerator();
+
+    // Build the Routers and Links of the Topology (returns false with an error message if the shape is invalid)
+    bool BuildTopology(QString& ErrorMsg);
+
+    // Information on the built Topology
+    TopologyType GetTopologyType() {return m_TopologyType;}
+    QString GetTopologyDescription();
+    int GetNumRouters() {return m_RouterGridPosList.count();}
+    int GetNumEndpoints();
+    int GetNumLinks();
+
+    // Information on each Router
+    // NOTE: The Network Ports of a Router are numbered first, followed by its Endpoint Ports
+    QPoint GetRouterGridPos(int Router) {return m_RouterGridPosList.at(Router);}
+    int GetRouterNumNetworkPorts(int Router) {return m_RouterNumNetworkPortsList.at(Router);}
+    int GetRouterNumEndpoints(int Router) {return m_RouterNumEndpointsList.at(Router);}
+    int GetRouterNumPorts(int Router) {return GetRouterNumNetworkPorts(Router) + GetRouterNumEndpoints(Router);}
+
+    // The Router to Router Links
+    QList<TopologyLink>& GetRouterLinkList() {return m_RouterLinkList;}
+
+    // Names and Shape Parameter Labels for each Topology (STATIC FUNCTIONS)
+    static QString GetTopologyTypeName(TopologyType Type);
+    static QStringList GetTopologyParamNames(TopologyType Type);
+
+private:
+    void AddRouter(int GridX, int GridY, int NumNetworkPorts, int NumEndpoints);
+    void BuildMeshOrTorus(bool WrapAround);
+    void BuildFatTree();
+    bool BuildDragonfly(QString& ErrorMsg);
+
+private:
+    TopologyType        m_TopologyType;
+    int                 m_Param1;
+    int                 m_Param2;
+    int                 m_Param3;
+    int                 m_EndpointsPerRouter;
+
+    QList<QPoint>       m_RouterGridPosList;
+    QList<int>          m_RouterNumNetworkPortsList;
+    QList<int>          m_RouterNumEndpointsList;
+    QList<TopologyLink> m_RouterLinkList;
+};
+
+#endif // TOPOLOGYGENERATOR_H
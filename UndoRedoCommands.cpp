@@ -19,32 +19,109 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
-ComandAddGraphicItemComponent::ComandAddGraphicItemComponent(GraphicItemComponent* Component, WiringScene* Scene, bool PasteMode /*=false*/, QUndoCommand* parent /*=0*/)
+ComandBase::ComandBase(QUndoCommand* parent /*=0*/)
     : QUndoCommand(parent)
+{
+}
+
+int ComandBase::GetCommandSize() const
+{
+    // The Command itself and its Text
+    return sizeof(ComandBase) + (text().size() * sizeof(QChar));
+}
+
+// The Undo Item Ids of a list of Items
+template <class T> static QList<quint32> GetUndoItemIdList(WiringScene* Scene, const QList<T*>& ItemList)
+{
+    QList<quint32> ItemIdList;
+
+    foreach (T* Item, ItemList) {
+        ItemIdList.append(Scene->GetUndoItemId(Item));
+    }
+    return ItemIdList;
+}
+
+// Find the Items from their Undo Item Ids (Items that no longer exist are left out)
+template <class T> static QList<T*> GetUndoItemList(WiringScene* Scene, const QList<quint32>& ItemIdList)
+{
+    QList<T*> ItemList;
+    T*        Item;
+
+    foreach (quint32 ItemId, ItemIdList) {
+        Item = qgraphicsitem_cast<T*>(Scene->GetUndoItem(ItemId));
+        if (Item != NULL) {
+            ItemList.append(Item);
+        }
+    }
+    return ItemList;
+}
+
+// Destroy Items held by a Command (Their Ids are forgotten first)
+template <class T> static void DeleteUndoItems(WiringScene* Scene, const QList<T*>& ItemList)
+{
+    foreach (T* Item, ItemList) {
+        Scene->ForgetUndoItem(Item);
+        delete Item;
+    }
+}
+
+// The Ports of a Component or Group (Ports are not Scene Items, they are drawn by their Owner)
+static QList<GraphicItemPort*> GetItemPortList(QGraphicsItem* Item)
+{
+    if (Item->type() == GraphicItemComponent::Type) {
+        return ((GraphicItemComponent*)Item)->GetGraphicalPortArray();
+    }
+    if (Item->type() == GraphicItemGroup::Type) {
+        return ((GraphicItemGroup*)Item)->GetGraphicalPortArray();
+    }
+    return QList<GraphicItemPort*>();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+ComandAddGraphicItemComponent::ComandAddGraphicItemComponent(GraphicItemComponent* Component, WiringScene* Scene, bool PasteMode /*=false*/, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
 {
     m_Component = Component;
     m_WiringScene = Scene;
+    m_ItemId = Scene->GetUndoItemId(Component);
     m_PasteMode = PasteMode;
+    m_ItemAdded = false;
 }
 
 ComandAddGraphicItemComponent::~ComandAddGraphicItemComponent()
 {
-    // Delete the Component
-    delete m_Component;
+    // Delete the Component only if it was undone (Otherwise the Scene owns it)
+    if (m_ItemAdded == false) {
+        m_WiringScene->ForgetUndoItem(m_Component);
+        delete m_Component;
+    }
 }
 
 void ComandAddGraphicItemComponent::undo()
 {
+    // Find the Object (A Delete Command may have rebuilt it since it was added)
+    m_Component = qgraphicsitem_cast<GraphicItemComponent*>(m_WiringScene->GetUndoItem(m_ItemId));
+    if (m_Component == NULL) {
+        return;
+    }
+
     // Delete the Object
     m_WiringScene->DeleteComponentFromScene(m_Component);
+    m_ItemAdded = false;
 
     UpdateCommandText();
 }
 
 void ComandAddGraphicItemComponent::redo()
 {
+    if (m_Component == NULL) {
+        return;
+    }
+
     // Add the Object
     m_WiringScene->AddNewComponentItemToScene(m_Component, !m_PasteMode);
+    m_ItemAdded = true;
 
     UpdateCommandText();
 
@@ -56,6 +133,12 @@ void ComandAddGraphicItemComponent::redo()
     //       command, its possible that existing wires might not connect back up.
 }
 
+int ComandAddGraphicItemComponent::GetCommandSize() const
+{
+    // An undone Component is only held by this Command
+    return ComandBase::GetCommandSize() + ((m_ItemAdded == true) ? 0 : UNDO_ITEM_MEMORY_ESTIMATE);
+}
+
 void ComandAddGraphicItemComponent::UpdateCommandText()
 {
     QString ModeText;
@@ -68,35 +151,58 @@ void ComandAddGraphicItemComponent::UpdateCommandText()
 ///////////////////////////////////////////////////////////////////////////////////////
 
 ComandAddGraphicItemText::ComandAddGraphicItemText(GraphicItemText* Text, WiringScene* Scene, bool PasteMode /*=false*/, QUndoCommand* parent /*=0*/)
-    : QUndoCommand(parent)
+    : ComandBase(parent)
 {
     m_Text = Text;
     m_WiringScene = Scene;
+    m_ItemId = Scene->GetUndoItemId(Text);
     m_PasteMode = PasteMode;
+    m_ItemAdded = false;
 }
 
 ComandAddGraphicItemText::~ComandAddGraphicItemText()
 {
-    // Delete the Text
-    delete m_Text;
+    // Delete the Text only if it was undone (Otherwise the Scene owns it)
+    if (m_ItemAdded == false) {
+        m_WiringScene->ForgetUndoItem(m_Text);
+        delete m_Text;
+    }
 }
 
 void ComandAddGraphicItemText::undo()
 {
+    // Find the Object (A Delete Command may have rebuilt it since it was added)
+    m_Text = qgraphicsitem_cast<GraphicItemText*>(m_WiringScene->GetUndoItem(m_ItemId));
+    if (m_Text == NULL) {
+        return;
+    }
+
     // Delete the Object
     m_WiringScene->DeleteTextFromScene(m_Text);
+    m_ItemAdded = false;
 
     UpdateCommandText();
 }
 
 void ComandAddGraphicItemText::redo()
 {
+    if (m_Text == NULL) {
+        return;
+    }
+
     // Add the Object
     m_WiringScene->AddNewTextItemToScene(m_Text, !m_PasteMode);
+    m_ItemAdded = true;
 
     UpdateCommandText();
 }
 
+int ComandAddGraphicItemText::GetCommandSize() const
+{
+    // An undone Text is only held by this Command
+    return ComandBase::GetCommandSize() + ((m_ItemAdded == true) ? 0 : UNDO_ITEM_MEMORY_ESTIMATE);
+}
+
 void ComandAddGraphicItemText::UpdateCommandText()
 {
     QString CommandText;
@@ -114,35 +220,58 @@ void ComandAddGraphicItemText::UpdateCommandText()
 ///////////////////////////////////////////////////////////////////////////////////////
 
 ComandAddGraphicItemWire::ComandAddGraphicItemWire(GraphicItemWire* Wire, WiringScene* Scene, bool PasteMode /*=false*/, QUndoCommand* parent /*=0*/)
-    : QUndoCommand(parent)
+    : ComandBase(parent)
 {
     m_Wire = Wire;
     m_WiringScene = Scene;
+    m_ItemId = Scene->GetUndoItemId(Wire);
     m_PasteMode = PasteMode;
+    m_ItemAdded = false;
 }
 
 ComandAddGraphicItemWire::~ComandAddGraphicItemWire()
 {
-    // Delete the Component
-    delete m_Wire;
+    // Delete the Wire only if it was undone (Otherwise the Scene owns it)
+    if (m_ItemAdded == false) {
+        m_WiringScene->ForgetUndoItem(m_Wire);
+        delete m_Wire;
+    }
 }
 
 void ComandAddGraphicItemWire::undo()
 {
+    // Find the Object (A Delete Command may have rebuilt it since it was added)
+    m_Wire = qgraphicsitem_cast<GraphicItemWire*>(m_WiringScene->GetUndoItem(m_ItemId));
+    if (m_Wire == NULL) {
+        return;
+    }
+
     // Delete the Object
     m_WiringScene->DeleteWireFromScene(m_Wire);
+    m_ItemAdded = false;
 
     UpdateCommandText();
 }
 
 void ComandAddGraphicItemWire::redo()
 {
+    if (m_Wire == NULL) {
+        return;
+    }
+
     // Add the Object
     m_WiringScene->AddNewWireItemToScene(m_Wire, true);
+    m_ItemAdded = true;
 
     UpdateCommandText();
 }
 
+int ComandAddGraphicItemWire::GetCommandSize() const
+{
+    // An undone Wire is only held by this Command
+    return ComandBase::GetCommandSize() + ((m_ItemAdded == true) ? 0 : UNDO_ITEM_MEMORY_ESTIMATE);
+}
+
 void ComandAddGraphicItemWire::UpdateCommandText()
 {
     QString ModeText;
@@ -152,121 +281,762 @@ void ComandAddGraphicItemWire::UpdateCommandText()
     setText(CommandText);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////
+
+ComandAddGraphicItemGroup::ComandAddGraphicItemGroup(GraphicItemGroup* Group, WiringScene* Scene, bool PasteMode /*=false*/, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
+{
+    m_Group = Group;
+    m_WiringScene = Scene;
+    m_ItemId = Scene->GetUndoItemId(Group);
+    m_PasteMode = PasteMode;
+    m_ItemAdded = false;
+}
+
+ComandAddGraphicItemGroup::~ComandAddGraphicItemGroup()
+{
+    // Delete the Group only if it was undone (Otherwise the Scene owns it)
+    if (m_ItemAdded == false) {
+        m_WiringScene->ForgetUndoItem(m_Group);
+        delete m_Group;
+    }
+}
+
+void ComandAddGraphicItemGroup::undo()
+{
+    // Find the Object (A Delete Command may have rebuilt it since it was added)
+    m_Group = qgraphicsitem_cast<GraphicItemGroup*>(m_WiringScene->GetUndoItem(m_ItemId));
+    if (m_Group == NULL) {
+        return;
+    }
+
+    // Delete the Object
+    m_WiringScene->DeleteGroupFromScene(m_Group);
+    m_ItemAdded = false;
+
+    UpdateCommandText();
+}
+
+void ComandAddGraphicItemGroup::redo()
+{
+    if (m_Group == NULL) {
+        return;
+    }
+
+    // Add the Object
+    m_WiringScene->AddNewGroupItemToScene(m_Group, !m_PasteMode);
+    m_ItemAdded = true;
+
+    UpdateCommandText();
+}
+
+int ComandAddGraphicItemGroup::GetCommandSize() const
+{
+    // An undone Group is only held by this Command
+    return ComandBase::GetCommandSize() + ((m_ItemAdded == true) ? 0 : UNDO_ITEM_MEMORY_ESTIMATE);
+}
+
+void ComandAddGraphicItemGroup::UpdateCommandText()
+{
+    QString ModeText;
+
+    m_PasteMode ? ModeText = "Paste" : ModeText = "Add";
+    QString CommandText = ModeText + QString(" Sub-Circuit (%1)").arg(m_Group->GetGroupDisplayName());
+    setText(CommandText);
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
-ComandDeleteGraphicItems::ComandDeleteGraphicItems(WiringScene* Scene, QUndoCommand* parent /*=0*/)
-    : QUndoCommand(parent)
+ComandCreateSubCircuit::ComandCreateSubCircuit(GraphicItemGroup* Group, QList<GraphicItemComponent*>& CapturedComponentList, QList<GraphicItemWire*>& CapturedWireList,
+                                               QList<GraphicItemWire*>& CrossingWireList, QList<bool>& CrossingWireStartFlagList, QList<int>& CrossingBoundaryPortIndexList,
+                                               WiringScene* Scene, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
 {
     m_WiringScene = Scene;
-    m_Initialized = false;
+    m_GroupId = Scene->GetUndoItemId(Group);
+    m_CapturedComponentIdList = GetUndoItemIdList(Scene, CapturedComponentList);
+    m_CapturedWireIdList = GetUndoItemIdList(Scene, CapturedWireList);
+    m_CrossingWireIdList = GetUndoItemIdList(Scene, CrossingWireList);
+    m_CrossingWireStartFlagList = CrossingWireStartFlagList;
+    m_CrossingBoundaryPortIndexList = CrossingBoundaryPortIndexList;
+
+    // Remember where the inside end of each Crossing Wire was so undo can reconnect it
+    for (int x = 0; x < CrossingWireList.count(); x++) {
+        if (m_CrossingWireStartFlagList.at(x) == true) {
+            m_CrossingWireOriginalPointList.append(CrossingWireList.at(x)->GetStartPoint());
+        } else {
+            m_CrossingWireOriginalPointList.append(CrossingWireList.at(x)->GetEndPoint());
+        }
+    }
+
+    m_SubCircuitCreated = false;
+
+    setText(QString("Create Sub-Circuit (%1)").arg(Group->GetSubCircuitDefinition()->GetDefinitionName()));
 }
 
-ComandDeleteGraphicItems::~ComandDeleteGraphicItems()
+ComandCreateSubCircuit::~ComandCreateSubCircuit()
 {
+    // Delete whatever this Command took out of the Scene (The Scene owns the rest)
+    if (m_SubCircuitCreated == true) {
+        DeleteUndoItems(m_WiringScene, GetUndoItemList<GraphicItemWire>(m_WiringScene, m_CapturedWireIdList));
+        DeleteUndoItems(m_WiringScene, GetUndoItemList<GraphicItemComponent>(m_WiringScene, m_CapturedComponentIdList));
+    } else {
+        DeleteUndoItems(m_WiringScene, GetUndoItemList<GraphicItemGroup>(m_WiringScene, QList<quint32>() << m_GroupId));
+    }
 }
 
-void ComandDeleteGraphicItems::undo()
+void ComandCreateSubCircuit::undo()
 {
-    // Re-Add all Deleted Wires
-    foreach (GraphicItemWire* item, m_DeletedWireList) {
-        // Add the Object
-        m_WiringScene->AddNewWireItemToScene(item, true);
-        item->SetWireSelected(true);  // Have to toggle selection on off to sync all wire segments
-        item->SetWireSelected(false);
+    GraphicItemGroup* Group = qgraphicsitem_cast<GraphicItemGroup*>(m_WiringScene->GetUndoItem(m_GroupId));
+    GraphicItemWire*  Wire;
+
+    // Remove the Group
+    if (Group != NULL) {
+        m_WiringScene->DeleteGroupFromScene(Group);
     }
+    m_SubCircuitCreated = false;
 
-    // Re-Add all Deleted Components
-    foreach (GraphicItemComponent* item, m_DeletedComponentList) {
-        // Add the Object
+    // Re-Add all Captured Components
+    foreach (GraphicItemComponent* item, GetUndoItemList<GraphicItemComponent>(m_WiringScene, m_CapturedComponentIdList)) {
         m_WiringScene->AddNewComponentItemToScene(item);
         item->setSelected(false);
     }
 
-    // Re-Add all Deleted Text
-    foreach (GraphicItemText* item, m_DeletedTextList) {
-        // Add the Object
-        m_WiringScene->AddNewTextItemToScene(item);
-        item->setSelected(false);
+    // Re-Add all Captured Wires
+    foreach (GraphicItemWire* item, GetUndoItemList<GraphicItemWire>(m_WiringScene, m_CapturedWireIdList)) {
+        m_WiringScene->AddNewWireItemToScene(item, true);
+        item->SetWireSelected(true);  // Have to toggle selection on off to sync the wire style
+        item->SetWireSelected(false);
+    }
+
+    // Move the Crossing Wires back onto the Ports of the Captured Components
+    for (int x = 0; x < m_CrossingWireIdList.count(); x++) {
+        Wire = qgraphicsitem_cast<GraphicItemWire*>(m_WiringScene->GetUndoItem(m_CrossingWireIdList.at(x)));
+        if (Wire == NULL) {
+            continue;
+        }
+        if (m_CrossingWireStartFlagList.at(x) == true) {
+            Wire->UpdateStartPointPosition(m_CrossingWireOriginalPointList.at(x));
+        } else {
+            Wire->UpdateEndPointPosition(m_CrossingWireOriginalPointList.at(x));
+        }
     }
+
     m_WiringScene->RefreshAllCurrentWirePositions();
 }
 
-void ComandDeleteGraphicItems::redo()
+void ComandCreateSubCircuit::redo()
 {
-    GraphicItemWire*      ptrParentWire;
-    GraphicItemComponent* ptrComponent;
-    GraphicItemText*      ptrText;
-    int                   NumItemsDeleted = 0;
+    GraphicItemGroup* Group = qgraphicsitem_cast<GraphicItemGroup*>(m_WiringScene->GetUndoItem(m_GroupId));
+    GraphicItemWire*  Wire;
+    GraphicItemPort*  GroupPort;
+    QPointF           GroupPortPoint;
 
-    // Figure out if this is the first time running
-    if (m_Initialized == false)
-    {
-        // We need to get the lists of objects from the selections
-        foreach (QGraphicsItem* item, m_WiringScene->selectedItems()) {
-            if (item->type() == GraphicItemWireLineSegment::Type) {
-                // Get the items Parent (Graphic Wire item)
-                ptrParentWire = (GraphicItemWire*)item->parentItem();
-
-                // Ensure that only one copy of the Parent Wire is in the list
-                if (m_DeletedWireList.indexOf(ptrParentWire) == -1) {
-                    // Add this Item to the list of deleted Wires
-                    m_DeletedWireList.append(ptrParentWire);
-                }
-            }
+    if (Group == NULL) {
+        return;
+    }
+
+    // Remove the Captured Wires and Components from the Scene
+    foreach (GraphicItemWire* item, GetUndoItemList<GraphicItemWire>(m_WiringScene, m_CapturedWireIdList)) {
+        m_WiringScene->DeleteWireFromScene(item);
+    }
+    foreach (GraphicItemComponent* item, GetUndoItemList<GraphicItemComponent>(m_WiringScene, m_CapturedComponentIdList)) {
+        m_WiringScene->DeleteComponentFromScene(item);
+    }
+
+    // Add the Group in their place
+    m_WiringScene->AddNewGroupItemToScene(Group, false);
+    m_SubCircuitCreated = true;
+
+    // Move the inside end of each Crossing Wire onto its Group Port (the Wire will connect to it)
+    for (int x = 0; x < m_CrossingWireIdList.count(); x++) {
+        Wire = qgraphicsitem_cast<GraphicItemWire*>(m_WiringScene->GetUndoItem(m_CrossingWireIdList.at(x)));
+        if (Wire == NULL) {
+            continue;
+        }
+        GroupPort = Group->GetGraphicalPortArray().at(m_CrossingBoundaryPortIndexList.at(x));
+        GroupPortPoint = Group->mapToScene(GroupPort->GetConnectionPoint());
+        if (m_CrossingWireStartFlagList.at(x) == true) {
+            Wire->UpdateStartPointPosition(GroupPortPoint);
+        } else {
+            Wire->UpdateEndPointPosition(GroupPortPoint);
         }
+    }
+}
+
+int ComandCreateSubCircuit::GetCommandSize() const
+{
+    int NumHeldItems;
+
+    // The Captured Items are held while the Sub-Circuit exists, the Group while it does not
+    NumHeldItems = (m_SubCircuitCreated == true) ? (m_CapturedComponentIdList.count() + m_CapturedWireIdList.count()) : 1;
+    return ComandBase::GetCommandSize() + (NumHeldItems * UNDO_ITEM_MEMORY_ESTIMATE) +
+           (m_CrossingWireIdList.count() * (sizeof(quint32) + sizeof(bool) + sizeof(int) + sizeof(QPointF)));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+ComandAddGeneratedTopology::ComandAddGeneratedTopology(QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                                                       QString TopologyDescription, WiringScene* Scene, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
+{
+    m_WiringScene = Scene;
+    m_ComponentIdList = GetUndoItemIdList(Scene, ComponentList);
+    m_WireIdList = GetUndoItemIdList(Scene, WireList);
+    m_TopologyAdded = false;
+
+    setText(QString("Generate %1").arg(TopologyDescription));
+}
+
+ComandAddGeneratedTopology::~ComandAddGeneratedTopology()
+{
+    // Delete the Objects only if they were undone (Otherwise the Scene owns them)
+    // The Wires are deleted before the Components they are attached to
+    if (m_TopologyAdded == false) {
+        DeleteUndoItems(m_WiringScene, GetUndoItemList<GraphicItemWire>(m_WiringScene, m_WireIdList));
+        DeleteUndoItems(m_WiringScene, GetUndoItemList<GraphicItemComponent>(m_WiringScene, m_ComponentIdList));
+    }
+}
+
+void ComandAddGeneratedTopology::undo()
+{
+    QList<GraphicItemComponent*> ComponentList = GetUndoItemList<GraphicItemComponent>(m_WiringScene, m_ComponentIdList);
+    QList<GraphicItemWire*>      WireList = GetUndoItemList<GraphicItemWire>(m_WiringScene, m_WireIdList);
+
+    // Delete all the Objects as one batch
+    m_WiringScene->DeleteItemBatchFromScene(ComponentList, WireList);
+    m_TopologyAdded = false;
+}
 
-        foreach (QGraphicsItem* item, m_WiringScene->selectedItems()) {
-            if (item->type() == GraphicItemComponent::Type) {
-                // Get the item as a Graphic Ccomponent item
-                ptrComponent = (GraphicItemComponent*)item;
+void ComandAddGeneratedTopology::redo()
+{
+    QList<GraphicItemComponent*> ComponentList = GetUndoItemList<GraphicItemComponent>(m_WiringScene, m_ComponentIdList);
+    QList<GraphicItemWire*>      WireList = GetUndoItemList<GraphicItemWire>(m_WiringScene, m_WireIdList);
+
+    // Add all the Objects as one batch
+    m_WiringScene->AddItemBatchToScene(ComponentList, WireList);
+    m_TopologyAdded = true;
+}
+
+int ComandAddGeneratedTopology::GetCommandSize() const
+{
+    int NumItems = m_ComponentIdList.count() + m_WireIdList.count();
+
+    // Undone Objects are only held by this Command
+    return ComandBase::GetCommandSize() + (NumItems * ((m_TopologyAdded == true) ? (int)sizeof(quint32) : UNDO_ITEM_MEMORY_ESTIMATE));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+ComandSetPropertyValues::ComandSetPropertyValues(QList<ItemProperties*>& PropertiesList, QString PropertyName, QString NewValue,
+                                                 WiringScene* Scene, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
+{
+    GraphicItemBase* ItemBase;
+    GraphicItemPort* Port;
+    QGraphicsItem*   Item;
+    int              PortIndex;
 
-                // Add this Item to the list of deleted Components
-                m_DeletedComponentList.append(ptrComponent);
+    m_WiringScene = Scene;
+    m_PropertyName = PropertyName;
+    m_NewValue = NewValue;
+
+    // Remember the Item (and Port) that owns each Properties, and the Value it had before the edit
+    foreach (ItemProperties* Properties, PropertiesList) {
+        ItemBase = Properties->GetParentGraphicItemBase();
+        if (ItemBase == NULL) {
+            continue;
+        }
+
+        if (ItemBase->GetItemType() == GraphicItemBase::ITEMTYPE_PORT) {
+            Port = (GraphicItemPort*)ItemBase;
+            Item = Port->GetOwnerItem();
+            if (Item == NULL) {
+                continue;
+            }
+            PortIndex = GetItemPortList(Item).indexOf(Port);
+            if (PortIndex < 0) {
+                continue;
+            }
+        } else {
+            Item = dynamic_cast<QGraphicsItem*>(ItemBase);
+            PortIndex = -1;
+            if (Item == NULL) {
+                continue;
             }
         }
 
-        foreach (QGraphicsItem* item, m_WiringScene->selectedItems()) {
-            if (item->type() == GraphicItemText::Type) {
-                // Get the item as a Graphic Text item
-                ptrText = (GraphicItemText*)item;
+        m_ItemIdList.append(m_WiringScene->GetUndoItemId(Item));
+        m_PortIndexList.append(PortIndex);
+        m_OldValueList.append(Properties->GetPropertyValue(m_PropertyName));
+    }
 
-                // Add this Item to the list of deleted Text
-                m_DeletedTextList.append(ptrText);
-            }
+    UpdateCommandText();
+}
+
+ComandSetPropertyValues::~ComandSetPropertyValues()
+{
+}
+
+void ComandSetPropertyValues::undo()
+{
+    int x;
+
+    // Put back the old Value of each Item (Each Item gets one PropertyChanged callback)
+    for (x = 0; x < m_ItemIdList.count(); x++) {
+        SetPropertyValue(x, m_OldValueList.at(x));
+    }
+
+    m_WiringScene->RefreshPropertiesWindow();
+}
+
+void ComandSetPropertyValues::redo()
+{
+    int x;
+
+    // Set the new Value on every Item in one pass (Each Item gets one PropertyChanged callback)
+    for (x = 0; x < m_ItemIdList.count(); x++) {
+        SetPropertyValue(x, m_NewValue);
+    }
+
+    m_WiringScene->RefreshPropertiesWindow();
+}
+
+bool ComandSetPropertyValues::mergeWith(const QUndoCommand* other)
+{
+    const ComandSetPropertyValues* OtherCommand = static_cast<const ComandSetPropertyValues*>(other);
+
+    // Repeated edits of the same Property on the same Items become one edit
+    if ((OtherCommand->m_PropertyName != m_PropertyName) || (OtherCommand->m_ItemIdList != m_ItemIdList) || (OtherCommand->m_PortIndexList != m_PortIndexList)) {
+        return false;
+    }
+
+    // Keep the original old Values, take the latest new Value
+    m_NewValue = OtherCommand->m_NewValue;
+    UpdateCommandText();
+    return true;
+}
+
+int ComandSetPropertyValues::GetCommandSize() const
+{
+    int Size;
+
+    Size = ComandBase::GetCommandSize() + ((m_PropertyName.size() + m_NewValue.size()) * sizeof(QChar));
+    Size += m_ItemIdList.count() * (sizeof(quint32) + sizeof(int));
+    foreach (const QString& OldValue, m_OldValueList) {
+        Size += sizeof(QString) + (OldValue.size() * sizeof(QChar));
+    }
+    return Size;
+}
+
+void ComandSetPropertyValues::SetPropertyValue(int Index, const QString& Value)
+{
+    QGraphicsItem*          Item = m_WiringScene->GetUndoItem(m_ItemIdList.at(Index));
+    int                     PortIndex = m_PortIndexList.at(Index);
+    GraphicItemBase*        ItemBase;
+    ItemProperty*           Property;
+    QList<GraphicItemPort*> PortList;
+
+    if (Item == NULL) {
+        return;
+    }
+
+    // Find the Properties through the Item (or its Port)
+    if (PortIndex >= 0) {
+        PortList = GetItemPortList(Item);
+        if (PortIndex >= PortList.count()) {
+            return;
+        }
+        ItemBase = PortList.at(PortIndex);
+    } else {
+        ItemBase = dynamic_cast<GraphicItemBase*>(Item);
+        if (ItemBase == NULL) {
+            return;
         }
     }
 
-    // Mark this object as Initialized
-    m_Initialized = true;
+    Property = ItemBase->GetItemProperties()->GetProperty(m_PropertyName);
+    if (Property != NULL) {
+        Property->SetValue(Value);
+    }
+}
 
-    // Delete All Wires in the DeleteWireList
-    foreach (GraphicItemWire* item, m_DeletedWireList) {
-        // Delete the Item from the Scene
-        m_WiringScene->DeleteWireFromScene(item);
+void ComandSetPropertyValues::UpdateCommandText()
+{
+    if (m_ItemIdList.count() > 1) {
+        setText(QString("Set Property %1 on %2 Items").arg(m_PropertyName).arg(m_ItemIdList.count()));
+    } else {
+        setText(QString("Set Property %1 to \"%2\"").arg(m_PropertyName).arg(m_NewValue));
     }
+}
 
-    // Delete All Components in the DeleteComponentList
-    foreach (GraphicItemComponent* item, m_DeletedComponentList) {
-        // Delete the Item from the Scene
-        m_WiringScene->DeleteComponentFromScene(item);
+///////////////////////////////////////////////////////////////////////////////////////
+
+ComandMoveGraphicItems::ComandMoveGraphicItems(QList<QGraphicsItem*>& ItemList, QList<QPointF>& OldPosList, QList<QPointF>& NewPosList,
+                                               WiringScene* Scene, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
+{
+    m_WiringScene = Scene;
+    m_GestureSerial = Scene->GetUndoGestureSerial();
+    m_ItemIdList = GetUndoItemIdList(Scene, ItemList);
+    m_OldPosList = OldPosList;
+    m_NewPosList = NewPosList;
+
+    if (m_ItemIdList.count() > 1) {
+        setText(QString("Move %1 Items").arg(m_ItemIdList.count()));
+    } else {
+        setText(QString("Move 1 Item"));
     }
+}
+
+ComandMoveGraphicItems::~ComandMoveGraphicItems()
+{
+}
+
+void ComandMoveGraphicItems::undo()
+{
+    QGraphicsItem* Item;
 
-    // Delete All Text in the DeleteTextList
-    foreach (GraphicItemText* item, m_DeletedTextList) {
-        // Delete the Item from the Scene
-        m_WiringScene->DeleteTextFromScene(item);
+    // Put each Item back where it started
+    for (int x = 0; x < m_ItemIdList.count(); x++) {
+        Item = m_WiringScene->GetUndoItem(m_ItemIdList.at(x));
+        if (Item != NULL) {
+            m_WiringScene->MoveItemToPosition(Item, m_OldPosList.at(x));
+        }
     }
+}
 
-    // Figure out how many items were deleted
-    NumItemsDeleted += m_DeletedWireList.count();
-    NumItemsDeleted += m_DeletedComponentList.count();
-    NumItemsDeleted += m_DeletedTextList.count();
+void ComandMoveGraphicItems::redo()
+{
+    QGraphicsItem* Item;
 
-    if (NumItemsDeleted > 1) {
-        setText(QString("Delete %1 Items").arg(NumItemsDeleted));
+    // Move each Item to where it was dropped (Nothing moves the first time, the Items are already there)
+    for (int x = 0; x < m_ItemIdList.count(); x++) {
+        Item = m_WiringScene->GetUndoItem(m_ItemIdList.at(x));
+        if (Item != NULL) {
+            m_WiringScene->MoveItemToPosition(Item, m_NewPosList.at(x));
+        }
+    }
+}
+
+bool ComandMoveGraphicItems::mergeWith(const QUndoCommand* other)
+{
+    const ComandMoveGraphicItems* OtherCommand = static_cast<const ComandMoveGraphicItems*>(other);
+
+    // Moving the same Items again in the same drag continues the same move
+    if ((OtherCommand->m_GestureSerial != m_GestureSerial) || (OtherCommand->m_ItemIdList != m_ItemIdList)) {
+        return false;
+    }
+
+    m_NewPosList = OtherCommand->m_NewPosList;
+    return true;
+}
+
+int ComandMoveGraphicItems::GetCommandSize() const
+{
+    return ComandBase::GetCommandSize() + (m_ItemIdList.count() * (sizeof(quint32) + (2 * sizeof(QPointF))));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+ComandReorderPorts::ComandReorderPorts(GraphicItemComponent* Component, QList<int>& OldPortLayout, QList<int>& NewPortLayout,
+                                       WiringScene* Scene, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
+{
+    m_WiringScene = Scene;
+    m_GestureSerial = Scene->GetUndoGestureSerial();
+    m_ComponentId = Scene->GetUndoItemId(Component);
+    m_OldPortLayout = OldPortLayout;
+    m_NewPortLayout = NewPortLayout;
+
+    setText(QString("Move Ports of Component (%1)").arg(Component->GetComponentDisplayName()));
+}
+
+ComandReorderPorts::~ComandReorderPorts()
+{
+}
+
+void ComandReorderPorts::undo()
+{
+    GraphicItemComponent* Component = qgraphicsitem_cast<GraphicItemComponent*>(m_WiringScene->GetUndoItem(m_ComponentId));
+
+    if (Component != NULL) {
+        Component->SetPortLayout(m_OldPortLayout);
+    }
+}
+
+void ComandReorderPorts::redo()
+{
+    GraphicItemComponent* Component = qgraphicsitem_cast<GraphicItemComponent*>(m_WiringScene->GetUndoItem(m_ComponentId));
+
+    if (Component != NULL) {
+        Component->SetPortLayout(m_NewPortLayout);
+    }
+}
+
+bool ComandReorderPorts::mergeWith(const QUndoCommand* other)
+{
+    const ComandReorderPorts* OtherCommand = static_cast<const ComandReorderPorts*>(other);
+
+    // Moving more Ports on the same Component in the same drag continues the same reorder
+    if ((OtherCommand->m_GestureSerial != m_GestureSerial) || (OtherCommand->m_ComponentId != m_ComponentId)) {
+        return false;
+    }
+
+    m_NewPortLayout = OtherCommand->m_NewPortLayout;
+    return true;
+}
+
+int ComandReorderPorts::GetCommandSize() const
+{
+    return ComandBase::GetCommandSize() + ((m_OldPortLayout.count() + m_NewPortLayout.count()) * sizeof(int));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+ComandSetDynamicPorts::ComandSetDynamicPorts(GraphicItemComponent* Component, QList<int>& OldPortsState, QList<int>& NewPortsState,
+                                             QList<GraphicItemComponent::PortWireConnection>& OldConnectionList,
+                                             WiringScene* Scene, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
+{
+    GraphicItemPort* ConnectedPort;
+
+    m_WiringScene = Scene;
+    m_GestureSerial = Scene->GetUndoGestureSerial();
+    m_ComponentId = Scene->GetUndoItemId(Component);
+    m_OldPortsState = OldPortsState;
+    m_NewPortsState = NewPortsState;
+
+    // The Ports are already set, remember the Wire Ends that lost their Port so undo() can connect them again
+    // (The Wire is kept as its Id, it is found again when needed)
+    foreach (GraphicItemComponent::PortWireConnection Connection, OldConnectionList) {
+        if (Connection.StartPoint == true) {
+            ConnectedPort = Connection.Wire->GetStartPointConnectedPort();
+        } else {
+            ConnectedPort = Connection.Wire->GetEndPointConnectedPort();
+        }
+        if (ConnectedPort == NULL) {
+            m_DroppedWireIdList.append(Scene->GetUndoItemId(Connection.Wire));
+            Connection.Wire = NULL;
+            m_DroppedConnectionList.append(Connection);
+        }
+    }
+
+    setText(QString("Set Dynamic Ports of Component (%1)").arg(Component->GetComponentDisplayName()));
+}
+
+ComandSetDynamicPorts::~ComandSetDynamicPorts()
+{
+}
+
+void ComandSetDynamicPorts::undo()
+{
+    GraphicItemComponent*                           Component = qgraphicsitem_cast<GraphicItemComponent*>(m_WiringScene->GetUndoItem(m_ComponentId));
+    QList<GraphicItemComponent::PortWireConnection> ConnectionList;
+    GraphicItemComponent::PortWireConnection        Connection;
+    int                                             x;
+
+    if (Component == NULL) {
+        return;
+    }
+
+    // Find the Wires of the dropped Connections (Wires that no longer exist are left out)
+    for (x = 0; x < m_DroppedConnectionList.count(); x++) {
+        Connection = m_DroppedConnectionList.at(x);
+        Connection.Wire = qgraphicsitem_cast<GraphicItemWire*>(m_WiringScene->GetUndoItem(m_DroppedWireIdList.at(x)));
+        if (Connection.Wire != NULL) {
+            ConnectionList.append(Connection);
+        }
+    }
+
+    Component->SetDynamicPortsState(m_OldPortsState);
+    Component->RestorePortWireConnections(ConnectionList);
+    m_WiringScene->RefreshPropertiesWindow();
+}
+
+void ComandSetDynamicPorts::redo()
+{
+    GraphicItemComponent* Component = qgraphicsitem_cast<GraphicItemComponent*>(m_WiringScene->GetUndoItem(m_ComponentId));
+
+    if (Component == NULL) {
+        return;
+    }
+
+    Component->SetDynamicPortsState(m_NewPortsState);
+    m_WiringScene->RefreshPropertiesWindow();
+}
+
+bool ComandSetDynamicPorts::mergeWith(const QUndoCommand* other)
+{
+    const ComandSetDynamicPorts* OtherCommand = static_cast<const ComandSetDynamicPorts*>(other);
+
+    // Configuring the same Component again in the same edit continues the same change
+    if ((OtherCommand->m_GestureSerial != m_GestureSerial) || (OtherCommand->m_ComponentId != m_ComponentId)) {
+        return false;
+    }
+
+    m_NewPortsState = OtherCommand->m_NewPortsState;
+    m_DroppedConnectionList.append(OtherCommand->m_DroppedConnectionList);
+    m_DroppedWireIdList.append(OtherCommand->m_DroppedWireIdList);
+    return true;
+}
+
+int ComandSetDynamicPorts::GetCommandSize() const
+{
+    return ComandBase::GetCommandSize() + ((m_OldPortsState.count() + m_NewPortsState.count()) * sizeof(int)) +
+           (m_DroppedConnectionList.count() * (sizeof(GraphicItemComponent::PortWireConnection) + sizeof(quint32)));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+ComandDeleteGraphicItems::ComandDeleteGraphicItems(WiringScene* Scene, QUndoCommand* parent /*=0*/)
+    : ComandBase(parent)
+{
+    m_WiringScene = Scene;
+    m_NumItems = 0;
+    m_Initialized = false;
+    m_ItemsDeleted = false;
+}
+
+ComandDeleteGraphicItems::~ComandDeleteGraphicItems()
+{
+    // NOTE: Nothing to delete; The Items are either in the Scene (which owns them)
+    //       or only kept here as their Saved Data
+}
+
+void ComandDeleteGraphicItems::undo()
+{
+    QList<GraphicItemComponent*> ComponentList;
+    QList<GraphicItemWire*>      WireList;
+    QList<GraphicItemGroup*>     GroupList;
+    QList<GraphicItemText*>      TextList;
+    int                          x;
+
+    if (m_ItemsDeleted == false) {
+        return;
+    }
+
+    // Rebuild the Items from their Saved Data (If any of them cannot be rebuilt, none
+    // are and the Items stay deleted; The Saved Data is kept)
+    QDataStream DataStreamIn(&m_DeletedItemsData, QIODevice::ReadOnly);
+    DataStreamIn.setVersion(QDataStream::Qt_5_2);
+    if (m_WiringScene->LoadItemBatch(DataStreamIn, ComponentList, WireList, GroupList, TextList) == false) {
+        return;
+    }
+
+    // Give the rebuilt Items the Ids of the deleted ones, so the other Commands find them
+    for (x = 0; x < TextList.count(); x++) {
+        m_WiringScene->SetUndoItemId(TextList.at(x), m_TextIdList.at(x));
+    }
+    for (x = 0; x < ComponentList.count(); x++) {
+        m_WiringScene->SetUndoItemId(ComponentList.at(x), m_ComponentIdList.at(x));
+    }
+    for (x = 0; x < WireList.count(); x++) {
+        m_WiringScene->SetUndoItemId(WireList.at(x), m_WireIdList.at(x));
+    }
+    for (x = 0; x < GroupList.count(); x++) {
+        m_WiringScene->SetUndoItemId(GroupList.at(x), m_GroupIdList.at(x));
+    }
+
+    // Re-Add them as one batch
+    m_WiringScene->AddItemBatchToScene(ComponentList, WireList, GroupList, TextList);
+
+    // The Saved Data is taken again on redo (The Items may change while they are back)
+    m_DeletedItemsData.clear();
+    m_ItemsDeleted = false;
+
+    m_WiringScene->RefreshAllCurrentWirePositions();
+}
+
+void ComandDeleteGraphicItems::redo()
+{
+    QList<GraphicItemComponent*> ComponentList;
+    QList<GraphicItemWire*>      WireList;
+    QList<GraphicItemGroup*>     GroupList;
+    QList<GraphicItemText*>      TextList;
+
+    // Figure out if this is the first time running
+    if (m_Initialized == false) {
+        GetSelectedItems();
+        m_Initialized = true;
+    }
+
+    // The Items are still deleted if the last undo could not rebuild them
+    if (m_ItemsDeleted == true) {
+        return;
+    }
+
+    // Find the Items by their Ids, the Id lists then match the order of the Saved Data
+    ComponentList = GetUndoItemList<GraphicItemComponent>(m_WiringScene, m_ComponentIdList);
+    WireList = GetUndoItemList<GraphicItemWire>(m_WiringScene, m_WireIdList);
+    GroupList = GetUndoItemList<GraphicItemGroup>(m_WiringScene, m_GroupIdList);
+    TextList = GetUndoItemList<GraphicItemText>(m_WiringScene, m_TextIdList);
+    m_ComponentIdList = GetUndoItemIdList(m_WiringScene, ComponentList);
+    m_WireIdList = GetUndoItemIdList(m_WiringScene, WireList);
+    m_GroupIdList = GetUndoItemIdList(m_WiringScene, GroupList);
+    m_TextIdList = GetUndoItemIdList(m_WiringScene, TextList);
+    m_NumItems = ComponentList.count() + WireList.count() + GroupList.count() + TextList.count();
+
+    // Keep the Items as their Saved Data
+    m_DeletedItemsData.clear();
+    QDataStream DataStreamOut(&m_DeletedItemsData, QIODevice::WriteOnly);
+    DataStreamOut.setVersion(QDataStream::Qt_5_2);
+    m_WiringScene->SaveItemBatch(DataStreamOut, ComponentList, WireList, GroupList, TextList);
+
+    // Remove all the Items from the Scene as one batch
+    m_WiringScene->DeleteItemBatchFromScene(ComponentList, WireList, GroupList, TextList);
+
+    // Destroy the Items (The Wires first, as they are attached to the Ports of the others)
+    DeleteUndoItems(m_WiringScene, WireList);
+    DeleteUndoItems(m_WiringScene, ComponentList);
+    DeleteUndoItems(m_WiringScene, GroupList);
+    DeleteUndoItems(m_WiringScene, TextList);
+
+    m_ItemsDeleted = true;
+
+    if (m_NumItems > 1) {
+        setText(QString("Delete %1 Items").arg(m_NumItems));
     } else {
-        setText(QString("Delete %1 Item").arg(NumItemsDeleted));
+        setText(QString("Delete %1 Item").arg(m_NumItems));
     }
 }
 
+int ComandDeleteGraphicItems::GetCommandSize() const
+{
+    // Deleted Items are only held as their Saved Data
+    return ComandBase::GetCommandSize() + m_DeletedItemsData.size() + (m_NumItems * (int)sizeof(quint32));
+}
+
+void ComandDeleteGraphicItems::GetSelectedItems()
+{
+    QSet<QGraphicsItem*> FoundItemSet;
+
+    // Sort the Selected Items by type in one pass (The Set makes sure an Item is only taken once)
+    foreach (QGraphicsItem* Item, m_WiringScene->selectedItems()) {
+        if (FoundItemSet.contains(Item) == true) {
+            continue;
+        }
+        FoundItemSet.insert(Item);
+
+        switch (Item->type()) {
+            case GraphicItemWire::Type:
+                m_WireIdList.append(m_WiringScene->GetUndoItemId(Item));
+            break;
+
+            case GraphicItemComponent::Type:
+                m_ComponentIdList.append(m_WiringScene->GetUndoItemId(Item));
+            break;
+
+            case GraphicItemGroup::Type:
+                m_GroupIdList.append(m_WiringScene->GetUndoItemId(Item));
+            break;
+
+            case GraphicItemText::Type:
+                m_TextIdList.append(m_WiringScene->GetUndoItemId(Item));
+            break;
+
+            default:
+            break;
+        }
+    }
+}
@@ -24,10 +24,27 @@
 
 #define PASTEID 100
 
+// Command IDs of the Commands that can be merged into the previous one
+#define COMANDID_MOVEGRAPHICITEMS   101
+#define COMANDID_SETPROPERTYVALUES  102
+#define COMANDID_REORDERPORTS       103
+#define COMANDID_SETDYNAMICPORTS    104
+
 class WiringScene;
 
 ///////////////////////////////////////////////////////////////////////////////////////
-class ComandAddGraphicItemComponent : public QUndoCommand
+// Base of all the Commands; Reports an estimate of the memory the Command holds so
+// the Undo Stack can keep within its memory budget
+class ComandBase : public QUndoCommand
+{
+public:
+    ComandBase(QUndoCommand* parent = 0);
+
+    virtual int GetCommandSize() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+class ComandAddGraphicItemComponent : public ComandBase
 {
 public:
     ComandAddGraphicItemComponent(GraphicItemComponent* Component, WiringScene* Scene,  bool PasteMode = false, QUndoCommand* parent = 0);
@@ -35,6 +52,7 @@ public:
 
     void undo();
     void redo();
+    int GetCommandSize() const;
 
 private:
     void UpdateCommandText();
@@ -42,11 +60,13 @@ private:
 private:
     GraphicItemComponent* m_Component;
     WiringScene*          m_WiringScene;
+    quint32               m_ItemId;
     bool             m_PasteMode;
+    bool             m_ItemAdded;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
-class ComandAddGraphicItemText : public QUndoCommand
+class ComandAddGraphicItemText : public ComandBase
 {
 public:
     ComandAddGraphicItemText(GraphicItemText* Text, WiringScene* Scene,  bool PasteMode = false, QUndoCommand* parent = 0);
@@ -54,6 +74,7 @@ public:
 
     void undo();
     void redo();
+    int GetCommandSize() const;
 
 private:
     void UpdateCommandText();
@@ -61,11 +82,13 @@ private:
 private:
     GraphicItemText* m_Text;
     WiringScene*     m_WiringScene;
+    quint32          m_ItemId;
     bool             m_PasteMode;
+    bool             m_ItemAdded;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
-class ComandAddGraphicItemWire : public QUndoCommand
+class ComandAddGraphicItemWire : public ComandBase
 {
 public:
     ComandAddGraphicItemWire(GraphicItemWire* Wire, WiringScene* Scene,  bool PasteMode = false, QUndoCommand* parent = 0);
@@ -73,6 +96,7 @@ public:
 
     void undo();
     void redo();
+    int GetCommandSize() const;
 
 private:
     void UpdateCommandText();
@@ -80,12 +104,179 @@ private:
 private:
     GraphicItemWire* m_Wire;
     WiringScene*     m_WiringScene;
+    quint32          m_ItemId;
     bool             m_PasteMode;
+    bool             m_ItemAdded;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+class ComandAddGraphicItemGroup : public ComandBase
+{
+public:
+    ComandAddGraphicItemGroup(GraphicItemGroup* Group, WiringScene* Scene,  bool PasteMode = false, QUndoCommand* parent = 0);
+    ~ComandAddGraphicItemGroup();
+
+    void undo();
+    void redo();
+    int GetCommandSize() const;
+
+private:
+    void UpdateCommandText();
+
+private:
+    GraphicItemGroup* m_Group;
+    WiringScene*      m_WiringScene;
+    quint32           m_ItemId;
+    bool              m_PasteMode;
+    bool              m_ItemAdded;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+class ComandCreateSubCircuit : public ComandBase
+{
+public:
+    ComandCreateSubCircuit(GraphicItemGroup* Group, QList<GraphicItemComponent*>& CapturedComponentList, QList<GraphicItemWire*>& CapturedWireList,
+                           QList<GraphicItemWire*>& CrossingWireList, QList<bool>& CrossingWireStartFlagList, QList<int>& CrossingBoundaryPortIndexList,
+                           WiringScene* Scene, QUndoCommand* parent = 0);
+    ~ComandCreateSubCircuit();
+
+    void undo();
+    void redo();
+    int GetCommandSize() const;
+
+private:
+    WiringScene*                 m_WiringScene;
+    quint32                      m_GroupId;
+    QList<quint32>               m_CapturedComponentIdList;
+    QList<quint32>               m_CapturedWireIdList;
+    QList<quint32>               m_CrossingWireIdList;
+    QList<bool>                  m_CrossingWireStartFlagList;
+    QList<int>                   m_CrossingBoundaryPortIndexList;
+    QList<QPointF>               m_CrossingWireOriginalPointList;
+    bool                         m_SubCircuitCreated;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+class ComandAddGeneratedTopology : public ComandBase
+{
+public:
+    ComandAddGeneratedTopology(QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                               QString TopologyDescription, WiringScene* Scene, QUndoCommand* parent = 0);
+    ~ComandAddGeneratedTopology();
+
+    void undo();
+    void redo();
+    int GetCommandSize() const;
+
+private:
+    WiringScene*                 m_WiringScene;
+    QList<quint32>               m_ComponentIdList;
+    QList<quint32>               m_WireIdList;
+    bool                         m_TopologyAdded;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+class ComandSetPropertyValues : public ComandBase
+{
+public:
+    ComandSetPropertyValues(QList<ItemProperties*>& PropertiesList, QString PropertyName, QString NewValue,
+                            WiringScene* Scene, QUndoCommand* parent = 0);
+    ~ComandSetPropertyValues();
+
+    void undo();
+    void redo();
+    int id() const {return COMANDID_SETPROPERTYVALUES;}
+    bool mergeWith(const QUndoCommand* other);
+    int GetCommandSize() const;
+
+private:
+    void SetPropertyValue(int Index, const QString& Value);
+    void UpdateCommandText();
+
+private:
+    // The Properties are found through the Id of their Item (and Port Index, -1 for the Item
+    // itself) when needed, as the Items and Ports that own them can be destroyed and rebuilt
+    WiringScene*                 m_WiringScene;
+    QList<quint32>               m_ItemIdList;
+    QList<int>                   m_PortIndexList;
+    QString                      m_PropertyName;
+    QString                      m_NewValue;
+    QStringList                  m_OldValueList;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
+class ComandMoveGraphicItems : public ComandBase
+{
+public:
+    ComandMoveGraphicItems(QList<QGraphicsItem*>& ItemList, QList<QPointF>& OldPosList, QList<QPointF>& NewPosList,
+                           WiringScene* Scene, QUndoCommand* parent = 0);
+    ~ComandMoveGraphicItems();
+
+    void undo();
+    void redo();
+    int id() const {return COMANDID_MOVEGRAPHICITEMS;}
+    bool mergeWith(const QUndoCommand* other);
+    int GetCommandSize() const;
 
-class ComandDeleteGraphicItems : public QUndoCommand
+private:
+    WiringScene*                 m_WiringScene;
+    int                          m_GestureSerial;
+    QList<quint32>               m_ItemIdList;
+    QList<QPointF>               m_OldPosList;
+    QList<QPointF>               m_NewPosList;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+class ComandReorderPorts : public ComandBase
+{
+public:
+    ComandReorderPorts(GraphicItemComponent* Component, QList<int>& OldPortLayout, QList<int>& NewPortLayout,
+                       WiringScene* Scene, QUndoCommand* parent = 0);
+    ~ComandReorderPorts();
+
+    void undo();
+    void redo();
+    int id() const {return COMANDID_REORDERPORTS;}
+    bool mergeWith(const QUndoCommand* other);
+    int GetCommandSize() const;
+
+private:
+    WiringScene*                 m_WiringScene;
+    int                          m_GestureSerial;
+    quint32                      m_ComponentId;
+    QList<int>                   m_OldPortLayout;
+    QList<int>                   m_NewPortLayout;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+class ComandSetDynamicPorts : public ComandBase
+{
+public:
+    ComandSetDynamicPorts(GraphicItemComponent* Component, QList<int>& OldPortsState, QList<int>& NewPortsState,
+                          QList<GraphicItemComponent::PortWireConnection>& OldConnectionList,
+                          WiringScene* Scene, QUndoCommand* parent = 0);
+    ~ComandSetDynamicPorts();
+
+    void undo();
+    void redo();
+    int id() const {return COMANDID_SETDYNAMICPORTS;}
+    bool mergeWith(const QUndoCommand* other);
+    int GetCommandSize() const;
+
+private:
+    WiringScene*                 m_WiringScene;
+    int                          m_GestureSerial;
+    quint32                      m_ComponentId;
+    QList<int>                   m_OldPortsState;
+    QList<int>                   m_NewPortsState;
+    QList<GraphicItemComponent::PortWireConnection> m_DroppedConnectionList;   // Wire Ends disconnected by the removed Ports
+    QList<quint32>               m_DroppedWireIdList;                          // Id of the Wire of each dropped Connection
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+// The Deleted Items are kept as their Saved Data and the Items themselves are destroyed;
+// On undo the Items are rebuilt (all of them or none) and given back their Undo Item Ids
+class ComandDeleteGraphicItems : public ComandBase
 {
 public:
     ComandDeleteGraphicItems(WiringScene* Scene, QUndoCommand* parent = 0);
@@ -93,13 +284,21 @@ public:
 
     void undo();
     void redo();
+    int GetCommandSize() const;
+
+private:
+    void GetSelectedItems();
 
 private:
     WiringScene*                 m_WiringScene;
-    QList<GraphicItemWire*>      m_DeletedWireList;
-    QList<GraphicItemComponent*> m_DeletedComponentList;
-    QList<GraphicItemText*>      m_DeletedTextList;
+    QList<quint32>               m_WireIdList;          // Undo Item Ids of the Items (In the Saved Data order of each type)
+    QList<quint32>               m_ComponentIdList;
+    QList<quint32>               m_GroupIdList;
+    QList<quint32>               m_TextIdList;
+    QByteArray                   m_DeletedItemsData;    // The Items while they are deleted
+    int                          m_NumItems;
     bool                         m_Initialized;
+    bool                         m_ItemsDeleted;
 };
 
 #endif // UNDOREDOCOMMANDS_H
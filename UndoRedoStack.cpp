@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+#include "UndoRedoStack.h"
+#include "UndoRedoCommands.h"
+
+////////////////////////////////////////////////////////////
+
+UndoRedoStack::UndoRedoStack(QObject* parent /*=0*/)
+    : QObject(parent)
+{
+    m_Index = 0;
+    m_CleanIndex = 0;
+    m_MemoryBudget = UNDO_DEFAULT_MEMORY_BUDGET;
+    m_TotalCommandSize = 0;
+}
+
+UndoRedoStack::~UndoRedoStack()
+{
+    qDeleteAll(m_CommandList);
+}
+
+void UndoRedoStack::Push(ComandBase* Command)
+{
+    ComandBase* TopCommand;
+    bool        WasClean = IsClean();
+    bool        Merged = false;
+
+    Command->redo();
+
+    // The Commands that could have been redone are discarded (The Clean State may go with them)
+    while (m_CommandList.count() > m_Index) {
+        DeleteCommand(m_CommandList.takeLast());
+    }
+    if (m_CleanIndex > m_Index) {
+        m_CleanIndex = -1;
+    }
+
+    // Try to Merge into the last Command (Never into the Clean State, that is what was saved)
+    TopCommand = (m_Index > 0) ? m_CommandList.at(m_Index - 1) : NULL;
+    if ((TopCommand != NULL) && (Command->id() != -1) && (Command->id() == TopCommand->id()) && (m_CleanIndex != m_Index)) {
+        m_TotalCommandSize -= TopCommand->GetCommandSize();
+        Merged = TopCommand->mergeWith(Command);
+        m_TotalCommandSize += TopCommand->GetCommandSize();
+    }
+
+    if (Merged == true) {
+        delete Command;
+    } else {
+        m_CommandList.append(Command);
+        m_TotalCommandSize += Command->GetCommandSize();
+        m_Index++;
+    }
+
+    TrimToMemoryBudget();
+    UpdateState(WasClean);
+}
+
+void UndoRedoStack::SetClean()
+{
+    bool WasClean = IsClean();
+
+    m_CleanIndex = m_Index;
+    UpdateState(WasClean);
+}
+
+void UndoRedoStack::SetMemoryBudget(qint64 Budget)
+{
+    bool WasClean = IsClean();
+
+    // A smaller budget takes effect right away
+    m_MemoryBudget = Budget;
+    TrimToMemoryBudget();
+    UpdateState(WasClean);
+}
+
+QAction* UndoRedoStack::CreateUndoAction(QObject* parent, const QString& Prefix)
+{
+    m_UndoActionPrefix = Prefix;
+    m_UndoAction = new QAction(Prefix, parent);
+    connect(m_UndoAction, SIGNAL(triggered()), this, SLOT(Undo()));
+
+    UpdateState(IsClean());
+    return m_UndoAction;
+}
+
+QAction* UndoRedoStack::CreateRedoAction(QObject* parent, const QString& Prefix)
+{
+    m_RedoActionPrefix = Prefix;
+    m_RedoAction = new QAction(Prefix, parent);
+    connect(m_RedoAction, SIGNAL(triggered()), this, SLOT(Redo()));
+
+    UpdateState(IsClean());
+    return m_RedoAction;
+}
+
+void UndoRedoStack::Undo()
+{
+    ComandBase* Command;
+    bool        WasClean = IsClean();
+
+    if (CanUndo() == false) {
+        return;
+    }
+
+    // The Command may hold more (or less) once it is undone
+    m_Index--;
+    Command = m_CommandList.at(m_Index);
+    m_TotalCommandSize -= Command->GetCommandSize();
+    Command->undo();
+    m_TotalCommandSize += Command->GetCommandSize();
+
+    UpdateState(WasClean);
+}
+
+void UndoRedoStack::Redo()
+{
+    ComandBase* Command;
+    bool        WasClean = IsClean();
+
+    if (CanRedo() == false) {
+        return;
+    }
+
+    Command = m_CommandList.at(m_Index);
+    m_TotalCommandSize -= Command->GetCommandSize();
+    Command->redo();
+    m_TotalCommandSize += Command->GetCommandSize();
+    m_Index++;
+
+    UpdateState(WasClean);
+}
+
+void UndoRedoStack::TrimToMemoryBudget()
+{
+    // Drop the oldest Commands until the Stack is within the budget
+    // NOTE: The newest Command is always kept, so the last edit can be undone
+    while ((m_TotalCommandSize > m_MemoryBudget) && (m_Index > 1)) {
+        DeleteCommand(m_CommandList.takeFirst());
+        m_Index--;
+
+        // The Clean State moves down with the Commands, unless it was dropped with them
+        if (m_CleanIndex > 0) {
+            m_CleanIndex--;
+        } else {
+            m_CleanIndex = -1;
+        }
+    }
+}
+
+void UndoRedoStack::DeleteCommand(ComandBase* Command)
+{
+    m_TotalCommandSize -= Command->GetCommandSize();
+    delete Command;
+}
+
+void UndoRedoStack::UpdateState(bool WasClean)
+{
+    // Show what will be Undone / Redone in the Actions
+    if (m_UndoAction != NULL) {
+        m_UndoAction->setEnabled(CanUndo());
+        m_UndoAction->setText((CanUndo() == true) ? QString("%1 %2").arg(m_UndoActionPrefix).arg(m_CommandList.at(m_Index - 1)->text()).trimmed() : m_UndoActionPrefix);
+    }
+    if (m_RedoAction != NULL) {
+        m_RedoAction->setEnabled(CanRedo());
+        m_RedoAction->setText((CanRedo() == true) ? QString("%1 %2").arg(m_RedoActionPrefix).arg(m_CommandList.at(m_Index)->text()).trimmed() : m_RedoActionPrefix);
+    }
+
+    emit IndexChanged(m_Index);
+    if (WasClean != IsClean()) {
+        emit CleanChanged(IsClean());
+    }
+}
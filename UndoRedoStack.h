@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef UNDOREDOSTACK_H
+#define UNDOREDOSTACK_H
+
+#include "GlobalIncludes.h"
+
+// Forward declarations to allow compile
+class ComandBase;
+
+////////////////////////////////////////////////////////////
+
+// The Undo Stack of the Scene.  Works like a QUndoStack (Merging, Clean State, Undo/Redo
+// Actions), but also keeps a running total of the memory its Commands hold.  When the
+// total goes over the memory budget, the oldest Commands are dropped first.
+// NOTE: QUndoStack cannot drop single Commands, its undo limit can only be set while empty
+class UndoRedoStack : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Constructor / Destructor
+    explicit UndoRedoStack(QObject* parent = 0);
+    ~UndoRedoStack();
+
+    // Push a Command (Calls its redo()), the Stack takes ownership of it
+    void Push(ComandBase* Command);
+
+    // Access to the Commands
+    int Count() const {return m_CommandList.count();}
+    int Index() const {return m_Index;}
+    ComandBase* GetCommand(int Index) const {return m_CommandList.value(Index, NULL);}
+    bool CanUndo() const {return (m_Index > 0);}
+    bool CanRedo() const {return (m_Index < m_CommandList.count());}
+
+    // The Clean State is the Index where the Project was last saved (-1 if it has been dropped)
+    void SetClean();
+    bool IsClean() const {return (m_CleanIndex == m_Index);}
+
+    // Memory the Commands may hold, the Stack is Trimmed to it on each Push
+    void SetMemoryBudget(qint64 Budget);
+
+    // Actions that Undo / Redo and show the Text of the Command they act on
+    QAction* CreateUndoAction(QObject* parent, const QString& Prefix);
+    QAction* CreateRedoAction(QObject* parent, const QString& Prefix);
+
+public slots:
+    void Undo();
+    void Redo();
+
+signals:
+    void IndexChanged(int Index);
+    void CleanChanged(bool Clean);
+
+private:
+    void TrimToMemoryBudget();
+    void DeleteCommand(ComandBase* Command);
+    void UpdateState(bool WasClean);
+
+private:
+    QList<ComandBase*>   m_CommandList;
+    int                  m_Index;               // Number of Commands that are done (Undo acts on the one below)
+    int                  m_CleanIndex;
+    qint64               m_MemoryBudget;
+    qint64               m_TotalCommandSize;    // Sum of GetCommandSize() of all the Commands
+    QPointer<QAction>    m_UndoAction;
+    QPointer<QAction>    m_RedoAction;
+    QString              m_UndoActionPrefix;
+    QString              m_RedoActionPrefix;
+};
+
+#endif // UNDOREDOSTACK_H
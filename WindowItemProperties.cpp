@@ -19,20 +19,315 @@
 
 ////////////////////////////////////////////////////////////
 
+ItemPropertiesTableModel::ItemPropertiesTableModel(QObject* parent /*=0*/)
+    : QAbstractTableModel(parent)
+{
+    m_Properties = NULL;
+    m_NumRows = 0;
+}
+
+ItemPropertiesTableModel::~ItemPropertiesTableModel()
+{
+}
+
+void ItemPropertiesTableModel::SetItemProperties(ItemProperties* Properties)
+{
+    beginResetModel();
+
+    m_PropertiesList.clear();
+    m_SharedNameList.clear();
+    m_SharedReadOnlyList.clear();
+    m_SharedValueList.clear();
+    m_SharedMixedList.clear();
+    m_SharedRowMap.clear();
+
+    // The rows are read from the Properties as the View needs them
+    m_Properties = Properties;
+    m_NumRows = (m_Properties != NULL) ? m_Properties->GetNumProperties() : 0;
+
+    endResetModel();
+}
+
+void ItemPropertiesTableModel::SetMultipleItemProperties(QList<ItemProperties*> PropertiesList)
+{
+    int             x;
+    int             y;
+    ItemProperties* FirstProperties;
+    ItemProperty*   Prop;
+    ItemProperty*   OtherProp;
+    bool            InAllItems;
+    bool            ReadOnly;
+    QString         Value;
+
+    beginResetModel();
+
+    m_Properties = NULL;
+    m_PropertiesList = PropertiesList;
+    m_SharedNameList.clear();
+    m_SharedReadOnlyList.clear();
+    m_SharedValueList.clear();
+    m_SharedMixedList.clear();
+    m_SharedRowMap.clear();
+
+    // Find each property that all the Items have, in the order of the first Item
+    if (PropertiesList.isEmpty() == false) {
+        FirstProperties = PropertiesList.first();
+        for (x = 0; x < FirstProperties->GetNumProperties(); x++) {
+            Prop = FirstProperties->GetProperty(x);
+            InAllItems = true;
+            ReadOnly = Prop->GetReadOnly();
+
+            for (y = 1; (y < PropertiesList.count()) && (InAllItems == true); y++) {
+                OtherProp = PropertiesList.at(y)->GetProperty(Prop->GetName());
+                if (OtherProp == NULL) {
+                    InAllItems = false;
+                } else {
+                    ReadOnly |= OtherProp->GetReadOnly();
+                }
+            }
+
+            // Compare the Values of all the Items once here, the View asks for each cell many times
+            if (InAllItems == true) {
+                m_SharedRowMap.insert(Prop->GetName(), m_SharedNameList.count());
+                m_SharedNameList.append(Prop->GetName());
+                m_SharedReadOnlyList.append(ReadOnly);
+                m_SharedMixedList.append(GetMultipleItemsPropertyValue(Prop->GetName(), Value) == false);
+                m_SharedValueList.append(Value);
+            }
+        }
+    }
+    m_NumRows = m_SharedNameList.count();
+
+    endResetModel();
+}
+
+void ItemPropertiesTableModel::ClearItemProperties()
+{
+    SetItemProperties(NULL);
+}
+
+void ItemPropertiesTableModel::RefreshProperty(QString PropertyName)
+{
+    int     Row;
+    QString Value;
+
+    // Find the Row of the Property, and only update its Value cell
+    if (IsShowingMultipleItems() == true) {
+        Row = m_SharedRowMap.value(PropertyName, -1);
+        if (Row >= 0) {
+            m_SharedMixedList[Row] = (GetMultipleItemsPropertyValue(PropertyName, Value) == false);
+            m_SharedValueList[Row] = Value;
+        }
+    } else if (m_Properties != NULL) {
+        Row = m_Properties->GetPropertyIndex(PropertyName);
+    } else {
+        Row = -1;
+    }
+
+    if ((Row >= 0) && (Row < m_NumRows)) {
+        emit dataChanged(index(Row, 1), index(Row, 1));
+    }
+}
+
+QString ItemPropertiesTableModel::GetPropertyName(int Row)
+{
+    ItemProperty* Prop;
+
+    if (IsShowingMultipleItems() == true) {
+        return m_SharedNameList.value(Row);
+    }
+
+    Prop = GetRowProperty(Row);
+    if (Prop != NULL) {
+        return Prop->GetName();
+    }
+    return "";
+}
+
+ItemProperty* ItemPropertiesTableModel::GetRowProperty(int Row) const
+{
+    // With many Items shown, the first Item describes the Property
+    if (IsShowingMultipleItems() == true) {
+        return m_PropertiesList.first()->GetProperty(m_SharedNameList.value(Row));
+    }
+
+    // NOTE: The Properties may have shrunk since the last reset, in that case NULL is returned
+    if (m_Properties != NULL) {
+        return m_Properties->GetProperty(Row);
+    }
+    return NULL;
+}
+
+bool ItemPropertiesTableModel::GetMultipleItemsPropertyValue(QString PropertyName, QString& Value) const
+{
+    ItemProperty* Prop;
+    int           x;
+
+    // Return false if the Items do not all have the same Value
+    for (x = 0; x < m_PropertiesList.count(); x++) {
+        Prop = m_PropertiesList.at(x)->GetProperty(PropertyName);
+        if (Prop == NULL) {
+            continue;
+        }
+        if (x == 0) {
+            Value = Prop->GetValue();
+        } else if (Prop->GetValue() != Value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ItemPropertiesTableModel::IsRowReadOnly(int Row) const
+{
+    ItemProperty* Prop;
+
+    if (IsShowingMultipleItems() == true) {
+        return m_SharedReadOnlyList.value(Row, true);
+    }
+
+    Prop = GetRowProperty(Row);
+    return (Prop == NULL) || (Prop->GetReadOnly() == true);
+}
+
+int ItemPropertiesTableModel::rowCount(const QModelIndex& parent /*=QModelIndex()*/) const
+{
+    if (parent.isValid() == true) {
+        return 0;
+    }
+    return m_NumRows;
+}
+
+int ItemPropertiesTableModel::columnCount(const QModelIndex& parent /*=QModelIndex()*/) const
+{
+    if (parent.isValid() == true) {
+        return 0;
+    }
+    return 2;
+}
+
+QVariant ItemPropertiesTableModel::data(const QModelIndex& index, int role /*=Qt::DisplayRole*/) const
+{
+    ItemProperty* Prop;
+    QString       Value;
+    bool          MixedValue = false;
+    QFont         ValueFont;
+
+    if ((index.isValid() == false) || (index.row() >= m_NumRows)) {
+        return QVariant();
+    }
+
+    Prop = GetRowProperty(index.row());
+    if (Prop == NULL) {
+        return QVariant();
+    }
+
+    // Items that do not share a Value show the Mixed text in italics (Both are cached per Row)
+    if (IsShowingMultipleItems() == true) {
+        Value = m_SharedValueList.at(index.row());
+        MixedValue = (index.column() == 1) && (m_SharedMixedList.at(index.row()) == true);
+    } else {
+        Value = Prop->GetValue();
+    }
+
+    switch (role) {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            if (index.column() == 0) {
+                return Prop->GetName();
+            }
+            return (MixedValue == true) ? QString(PROPERTIES_WINDOW_MIXED_VALUE) : Value;
+
+        case Qt::FontRole:
+            if (MixedValue == true) {
+                ValueFont.setItalic(true);
+                return ValueFont;
+            }
+            break;
+
+        case Qt::StatusTipRole:
+        case Qt::ToolTipRole:
+            return Prop->GetDesc();
+
+        default:
+            break;
+    }
+    return QVariant();
+}
+
+QVariant ItemPropertiesTableModel::headerData(int section, Qt::Orientation orientation, int role /*=Qt::DisplayRole*/) const
+{
+    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
+        return (section == 0) ? QString("Property") : QString("Value");
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags ItemPropertiesTableModel::flags(const QModelIndex& index) const
+{
+    if (index.isValid() == false) {
+        return Qt::NoItemFlags;
+    }
+
+    // Property Names are never editable, Read Only Values are shown disabled
+    if (index.column() == 0) {
+        return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    }
+    if (IsRowReadOnly(index.row()) == true) {
+        return Qt::ItemIsSelectable;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable;
+}
+
+bool ItemPropertiesTableModel::setData(const QModelIndex& index, const QVariant& value, int role /*=Qt::EditRole*/)
+{
+    ItemProperty* Prop;
+    QString       NewValue;
+
+    // Only process changes to Values
+    if ((index.isValid() == false) || (index.column() != 1) || (role != Qt::EditRole)) {
+        return false;
+    }
+
+    Prop = GetRowProperty(index.row());
+    if (Prop == NULL) {
+        return false;
+    }
+    NewValue = value.toString();
+
+    // The edit is applied by the owner as an undoable operation (on all the Items when many are shown)
+    if (IsShowingMultipleItems() == true) {
+        if (NewValue != PROPERTIES_WINDOW_MIXED_VALUE) {
+            emit PropertyValueEdited(Prop->GetName(), NewValue);
+        }
+        return true;
+    }
+
+    if (NewValue != Prop->GetValue()) {
+        emit PropertyValueEdited(Prop->GetName(), NewValue);
+        emit dataChanged(index, index);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+
 WindowItemProperties::WindowItemProperties(QWidget* parent /*=0*/)
     : QFrame(parent)
 {
-    m_CurrentProperties = NULL;
+    m_ConfigureDynamicParameter = NULL;
 
-    // Create the table widget
-    m_PropertiesTable = new QTableWidget();
+    // Create the Model and the table view that shows it
+    m_PropertiesModel = new ItemPropertiesTableModel(this);
+    m_PropertiesTable = new QTableView();
+    m_PropertiesTable->setModel(m_PropertiesModel);
 
     // Create a Group Box
     m_PropertiesGroupBox = new QGroupBox(this);
     m_PropertiesGroupBox->setTitle("Properties:");
 
     // Build a Vertical layout for the PropertiesGroupBox and
-    // put the TableWidget inside of it
+    // put the TableView inside of it
     QVBoxLayout* pPropertiesGroupBoxLayout = new QVBoxLayout();
     pPropertiesGroupBoxLayout->addWidget(m_PropertiesTable);
     m_PropertiesGroupBox->setLayout(pPropertiesGroupBoxLayout);
@@ -44,167 +339,97 @@ WindowItemProperties::WindowItemProperties(QWidget* parent /*=0*/)
     // Set the layout to this window
     setLayout(pLayout);
 
-    // Set the Row and Column sizes
-    m_PropertiesTable->setColumnCount(2);
-    m_PropertiesTable->setRowCount(0);
-
     // Set the Headers
-    QStringList HeaderList;
-    HeaderList.append("Property");
-    HeaderList.append("Value");
-    m_PropertiesTable->setHorizontalHeaderLabels(HeaderList);
     m_PropertiesTable->verticalHeader()->setVisible(false);
     m_PropertiesTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
     m_PropertiesTable->horizontalHeader()->setStretchLastSection(true);
     m_PropertiesTable->setMouseTracking(true);  // Enable StatusTips to work
 
-    // Handle when an Item changes
-    connect(m_PropertiesTable, SIGNAL(cellChanged(int, int)), this, SLOT(HandleCellChanged(int, int)));
-    connect(m_PropertiesTable, SIGNAL(itemDoubleClicked(QTableWidgetItem*)), this, SLOT(HandleItemDoubleClicked(QTableWidgetItem*)));
+    // Handle when an Item is double clicked, edits are written back by the Model
+    connect(m_PropertiesTable, SIGNAL(doubleClicked(QModelIndex)), this, SLOT(HandleItemDoubleClicked(QModelIndex)));
+    connect(m_PropertiesModel, SIGNAL(PropertyValueEdited(QString, QString)), this, SIGNAL(PropertyValueEdited(QString, QString)));
 
     //setSizePolicy(QSizePolicy(QSizePolicy::Maximum, QSizePolicy::Ignored));
     setMinimumWidth(m_PropertiesTable->sizeHint().width());
-
-    // Flag that indicates that we are populating the window
-    m_PopulatingWindow = false;
 }
 
 WindowItemProperties::~WindowItemProperties()
 {
 }
 
-void WindowItemProperties::AddPropertyData(QString Property, QString Value, QString Desc, bool ReadOnly /* =false*/)
+void WindowItemProperties::ResizePropertyColumn()
 {
-    int NumRows;
-
-    // Increment the number of rows
-    NumRows = m_PropertiesTable->rowCount();
-    NumRows++;
-    m_PropertiesTable->setRowCount(NumRows);
-
-    // Create new TableWidgetItem for the Property and turn off Editing for that cell
-    QTableWidgetItem* PropertyItem = new QTableWidgetItem(Property);
-    PropertyItem->setFlags(PropertyItem->flags() ^ Qt::ItemIsEditable);
-    PropertyItem->setStatusTip(Desc);
-
-    // Create new TableWidgetItem for the Value Control cell editing based upon ReadOnlyFlag
-    QTableWidgetItem* ValueItem = new QTableWidgetItem(Value);
-    if (ReadOnly == true) {
-        ValueItem->setFlags(ValueItem->flags() ^ Qt::ItemIsEditable);
-        ValueItem->setFlags(ValueItem->flags() ^ Qt::ItemIsEnabled);
-    }
-    ValueItem->setStatusTip(Desc);
-
-    // Add the data to the Table
-    m_PropertiesTable->setItem(NumRows - 1, 0, PropertyItem);
-    m_PropertiesTable->setItem(NumRows - 1, 1, ValueItem);
-
-    // Set the Headers to show the Columns
-    m_PropertiesTable->resizeColumnsToContents();
+    // Size the Property column once per reset (The View only measures the rows it shows)
+    m_PropertiesTable->resizeColumnToContents(0);
     m_PropertiesTable->horizontalHeader()->setStretchLastSection(true);
 }
 
 void WindowItemProperties::SetGraphicItemProperties(ItemProperties* Properties)
 {
-    int           x;
-    ItemProperty* Prop;
-
-    // Clear the properties window
-    ClearProperiesWindow();
-
-    // Save the ptr to the current set of properties
-    m_CurrentProperties = Properties;
+    m_PropertiesGroupBox->setTitle("Properties:");
 
-    m_PopulatingWindow = true;
+    // Point the Model at the Item's properties
+    m_PropertiesModel->SetItemProperties(Properties);
+    ResizePropertyColumn();
+}
 
-    // Add each property to the graphic display
-    if (m_CurrentProperties != NULL) {
-        for (x = 0; x < Properties->GetNumProperties(); x++) {
-            Prop = Properties->GetProperty(x);
-            AddPropertyData(Prop->GetName(), Prop->GetValue(), Prop->GetDesc(), Prop->GetReadOnly());
-        }
+void WindowItemProperties::SetMultipleGraphicItemProperties(QList<ItemProperties*> PropertiesList)
+{
+    if (PropertiesList.isEmpty() == true) {
+        ClearProperiesWindow();
+        return;
     }
 
-    m_PopulatingWindow = false;
+    m_PropertiesGroupBox->setTitle(QString("Properties (%1 Items):").arg(PropertiesList.count()));
+
+    // Point the Model at the shared properties of all the Items
+    m_PropertiesModel->SetMultipleItemProperties(PropertiesList);
+    ResizePropertyColumn();
 }
 
 void WindowItemProperties::ClearProperiesWindow()
 {
-    // Set the row count to 0, and remove the graphic display of properties
-    m_PropertiesTable->clearContents();
-    m_PropertiesTable->setRowCount(0);
-    m_CurrentProperties = NULL;
-
-    // Set the Headers to show the Columns
-    m_PropertiesTable->resizeColumnsToContents();
-    m_PropertiesTable->horizontalHeader()->setStretchLastSection(true);
+    m_PropertiesModel->ClearItemProperties();
+    m_PropertiesGroupBox->setTitle("Properties:");
 }
 
-void WindowItemProperties::RefreshProperiesWindowProperty(QString PropertyName, QString NewPropertyValue)
+void WindowItemProperties::RefreshProperiesWindow()
 {
-    int               RowCount;
-    int               row;
-    QString           PropName;
-    QTableWidgetItem* ItemProp;
-    QTableWidgetItem* ItemValue;
-
-    if (PropertyName.isEmpty() == false) {
-        RowCount = m_PropertiesTable->rowCount();
-        // Walk all the rows and find the Property Name that matches
-        for (row = 0; row < RowCount; row++) {
-            ItemProp = m_PropertiesTable->item(row, 0);
-            ItemValue = m_PropertiesTable->item(row, 1);
-            PropName = ItemProp->text();
-
-            if (PropName == PropertyName) {
-                ItemValue->setText(NewPropertyValue);
-            }
-        }
+    // Rebuild the window from the current Properties
+    if (IsShowingMultipleItems() == true) {
+        SetMultipleGraphicItemProperties(m_PropertiesModel->GetMultipleItemProperties());
+    } else {
+        SetGraphicItemProperties(m_PropertiesModel->GetItemProperties());
     }
 }
 
-void WindowItemProperties::HandleCellChanged(int row, int col)
+void WindowItemProperties::RefreshProperiesWindowProperty(QString PropertyName, QString NewPropertyValue)
 {
-    QTableWidgetItem* ItemProp;
-    QTableWidgetItem* ItemValue;
-    QString           Prop;
-    QString           NewValue;
+    Q_UNUSED(NewPropertyValue)
 
-    // Only process changes to Values
-    if (col == 1) {
-        ItemProp = m_PropertiesTable->item(row, 0);
-        ItemValue = m_PropertiesTable->item(row, 1);
-        if ((ItemProp != NULL) && (ItemValue != NULL)) {
-            Prop = ItemProp->text();
-            NewValue = ItemValue->text();
-
-            // Now Figure out which Property it is
-            ItemProperty* ptrPropertyData = m_CurrentProperties->GetProperty(Prop);
-            if (ptrPropertyData != NULL) {
-                if (m_PopulatingWindow == false) {
-                    //qDebug() << "WindowItemProperties::HandleCellChanged() --- UPDATING VALUE: Prop = " << Prop << " New Value = " << NewValue;
-                    ptrPropertyData->SetValue(NewValue, !m_PopulatingWindow);
-                }
-            }
-        }
+    // The Model reads the Value from the Properties, just tell the View which cell changed
+    if (PropertyName.isEmpty() == false) {
+        m_PropertiesModel->RefreshProperty(PropertyName);
     }
 }
 
-void WindowItemProperties::HandleItemDoubleClicked(QTableWidgetItem* Item)
+void WindowItemProperties::HandleItemDoubleClicked(const QModelIndex& Index)
 {
     QString           PropName;
     ItemProperty*     Property;
-    QString           ControllingParam;
-    QString           OrigPropertyName;
+    ItemProperties*   CurrentProperties;
+
+    // Dynamic Properties are only configured on a single Item
+    CurrentProperties = m_PropertiesModel->GetItemProperties();
+    if ((CurrentProperties == NULL) || (IsShowingMultipleItems() == true)) {
+        return;
+    }
 
     // Make sure this is a Dynamic Property & has no controlling parameter
-    PropName = Item->text();
-    Property = m_CurrentProperties->GetProperty(PropName);
-    if ((Item->column() == 0)  && (Property != NULL)) {
+    PropName = m_PropertiesModel->GetPropertyName(Index.row());
+    Property = CurrentProperties->GetProperty(PropName);
+    if ((Index.column() == 0)  && (Property != NULL)) {
         if ((Property->GetDynamicFlag() == true) && (Property->GetControllingProperty().isEmpty())) {
-            ControllingParam = Property->GetControllingProperty();
-            OrigPropertyName = Property->GetOriginalPropertyName();
-
             m_ConfigureDynamicParameter = new DialogParametersConfig(Property);
 
             // Run the dialog box (Modal)
@@ -212,6 +437,7 @@ void WindowItemProperties::HandleItemDoubleClicked(QTableWidgetItem* Item)
 
             // Delete the Dialog
             delete m_ConfigureDynamicParameter;
+            m_ConfigureDynamicParameter = NULL;
         }
     }
 }
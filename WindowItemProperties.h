@@ -25,6 +25,56 @@
 
 ////////////////////////////////////////////////////////////
 
+// Table Model over the Properties of one Item (or the shared Properties of many Items).
+// The View only asks for the rows it shows, so nothing is built per Property.
+class ItemPropertiesTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    // Constructor / Destructor
+    explicit ItemPropertiesTableModel(QObject* parent = 0);
+    ~ItemPropertiesTableModel();
+
+    void SetItemProperties(ItemProperties* Properties);
+    void SetMultipleItemProperties(QList<ItemProperties*> PropertiesList);
+    void ClearItemProperties();
+    void RefreshProperty(QString PropertyName);
+
+    ItemProperties* GetItemProperties() {return m_Properties;}
+    QList<ItemProperties*> GetMultipleItemProperties() {return m_PropertiesList;}
+    bool IsShowingMultipleItems() const {return (m_PropertiesList.isEmpty() == false);}
+    QString GetPropertyName(int Row);
+
+    // Overridden virtual functions
+    int rowCount(const QModelIndex& parent = QModelIndex()) const;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+    Qt::ItemFlags flags(const QModelIndex& index) const;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole);
+
+signals:
+    void PropertyValueEdited(QString PropertyName, QString NewValue);
+
+private:
+    ItemProperty* GetRowProperty(int Row) const;
+    bool GetMultipleItemsPropertyValue(QString PropertyName, QString& Value) const;
+    bool IsRowReadOnly(int Row) const;
+
+private:
+    ItemProperties*         m_Properties;
+    QList<ItemProperties*>  m_PropertiesList;
+    int                     m_NumRows;                  // Row Count given to the View at the last reset
+    QStringList             m_SharedNameList;           // Multi-Selection: Properties that all the Items have
+    QList<bool>             m_SharedReadOnlyList;
+    QStringList             m_SharedValueList;          // Multi-Selection: Cached Value of each Row (Valid when not Mixed)
+    QList<bool>             m_SharedMixedList;          // Multi-Selection: Cached flag, the Items do not share a Value
+    QHash<QString, int>     m_SharedRowMap;             // Multi-Selection: Property Name -> Row
+};
+
+////////////////////////////////////////////////////////////
+
 class WindowItemProperties : public QFrame
 {
     Q_OBJECT
@@ -36,24 +86,32 @@ public:
 
     void SetGraphicItemProperties(ItemProperties* Properties);
     void ClearProperiesWindow();
+    void RefreshProperiesWindow();
     void RefreshProperiesWindowProperty(QString PropertyName, QString NewPropertyValue);
 
+    // Multi-Selection (Shows the Properties that all the Items have)
+    void SetMultipleGraphicItemProperties(QList<ItemProperties*> PropertiesList);
+    QList<ItemProperties*> GetMultipleGraphicItemProperties() {return m_PropertiesModel->GetMultipleItemProperties();}
+    bool IsShowingMultipleItems() {return m_PropertiesModel->IsShowingMultipleItems();}
+
+    // The single Item being shown (or NULL)
+    ItemProperties* GetGraphicItemProperties() {return m_PropertiesModel->GetItemProperties();}
+
 private:
-    void AddPropertyData(QString Property, QString Value, QString Desc, bool ReadOnly = false);
+    void ResizePropertyColumn();
 
 public slots:
-    void HandleCellChanged(int, int);
-    void HandleItemDoubleClicked(QTableWidgetItem* Item);
+    void HandleItemDoubleClicked(const QModelIndex& Index);
 
 signals:
+    void PropertyValueEdited(QString PropertyName, QString NewValue);
 
 private:
-    QGroupBox*              m_PropertiesGroupBox;
-    QTableWidget*           m_PropertiesTable;
+    QGroupBox*                m_PropertiesGroupBox;
+    QTableView*               m_PropertiesTable;
+    ItemPropertiesTableModel* m_PropertiesModel;
 
-    ItemProperties*         m_CurrentProperties;
-    bool                    m_PopulatingWindow;
-    DialogParametersConfig* m_ConfigureDynamicParameter;
+    DialogParametersConfig*   m_ConfigureDynamicParameter;
 };
 
 #endif // WINDOWITEMPROPERTIES_H
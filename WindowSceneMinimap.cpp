@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#include "WindowSceneMinimap.h"
+
+////////////////////////////////////////////////////////////
+
+WindowSceneMinimap::WindowSceneMinimap(WiringScene* Scene, QGraphicsView* View, QWidget* parent /*=0*/)
+    : QFrame(parent)
+{
+    m_WiringScene = Scene;
+    m_WiringView = View;
+
+    m_ThumbnailScale = 1.0;
+    m_ThumbnailRebuildNeeded = true;
+
+    setMinimumSize(MINIMAP_MINIMUM_WIDTH, MINIMAP_MINIMUM_HEIGHT);
+    setCursor(Qt::PointingHandCursor);
+    setToolTip(tr("Click or Drag to Move the View"));
+
+    // Edits to the Scene re-render the Thumbnail at most once per update interval
+    m_ThumbnailUpdateTimer = new QTimer(this);
+    m_ThumbnailUpdateTimer->setSingleShot(true);
+    m_ThumbnailUpdateTimer->setInterval(MINIMAP_UPDATE_INTERVAL);
+    connect(m_ThumbnailUpdateTimer, SIGNAL(timeout()), this, SLOT(HandleThumbnailUpdateTimeout()));
+
+    // The Scene tells us which parts of it changed (Items added, removed, moved or redrawn)
+    connect(m_WiringScene, SIGNAL(changed(QList<QRectF>)), this, SLOT(HandleSceneChanged(QList<QRectF>)));
+    connect(m_WiringScene, SIGNAL(sceneRectChanged(QRectF)), this, SLOT(HandleSceneRectChanged(QRectF)));
+
+    // Scrolling and Zooming the View moves the Viewport Rectangle
+    connect(m_WiringView->horizontalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(HandleViewportMoved()));
+    connect(m_WiringView->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(HandleViewportMoved()));
+    connect(m_WiringView->horizontalScrollBar(), SIGNAL(rangeChanged(int, int)), this, SLOT(HandleViewportMoved()));
+    connect(m_WiringView->verticalScrollBar(), SIGNAL(rangeChanged(int, int)), this, SLOT(HandleViewportMoved()));
+}
+
+WindowSceneMinimap::~WindowSceneMinimap()
+{
+}
+
+QSize WindowSceneMinimap::sizeHint() const
+{
+    return QSize(MINIMAP_DEFAULT_WIDTH, MINIMAP_DEFAULT_HEIGHT);
+}
+
+void WindowSceneMinimap::UpdateThumbnailMapping()
+{
+    qreal ScaleX;
+    qreal ScaleY;
+
+    // The Thumbnail shows the whole Scene Rect (which holds all the items), keeping its aspect ratio
+    m_ThumbnailSceneRect = m_WiringScene->sceneRect();
+    if ((m_ThumbnailSceneRect.width() <= 0) || (m_ThumbnailSceneRect.height() <= 0)) {
+        m_ThumbnailScale = 1.0;
+        m_ThumbnailOffset = QPointF(0, 0);
+        return;
+    }
+
+    ScaleX = width() / m_ThumbnailSceneRect.width();
+    ScaleY = height() / m_ThumbnailSceneRect.height();
+    m_ThumbnailScale = qMin(ScaleX, ScaleY);
+
+    // Center the Scene inside the Thumbnail
+    m_ThumbnailOffset = QPointF((width() - (m_ThumbnailSceneRect.width() * m_ThumbnailScale)) / 2,
+                                (height() - (m_ThumbnailSceneRect.height() * m_ThumbnailScale)) / 2);
+}
+
+QRectF WindowSceneMinimap::MapSceneToThumbnail(const QRectF& SceneRect)
+{
+    return QRectF(m_ThumbnailOffset + ((SceneRect.topLeft() - m_ThumbnailSceneRect.topLeft()) * m_ThumbnailScale),
+                  SceneRect.size() * m_ThumbnailScale);
+}
+
+QPointF WindowSceneMinimap::MapThumbnailToScene(const QPointF& ThumbnailPoint)
+{
+    return m_ThumbnailSceneRect.topLeft() + ((ThumbnailPoint - m_ThumbnailOffset) / m_ThumbnailScale);
+}
+
+void WindowSceneMinimap::RenderThumbnailRegion(const QRectF& SceneRect)
+{
+    QRectF   TargetRect;
+    QRectF   SourceRect;
+
+    // Round out to whole Thumbnail pixels (so neighboring regions do not leave seams)
+    // and then work out exactly what part of the Scene lands in those pixels
+    TargetRect = QRectF(MapSceneToThumbnail(SceneRect).toAlignedRect()) & MapSceneToThumbnail(m_ThumbnailSceneRect);
+    TargetRect &= QRectF(m_Thumbnail.rect());
+    if (TargetRect.isEmpty() == true) {
+        return;
+    }
+    SourceRect = QRectF(MapThumbnailToScene(TargetRect.topLeft()), MapThumbnailToScene(TargetRect.bottomRight()));
+
+    // Repaint just that part of the cached Thumbnail
+    QPainter ThumbnailPainter(&m_Thumbnail);
+    ThumbnailPainter.setClipRect(TargetRect);
+    ThumbnailPainter.fillRect(TargetRect, MINIMAP_BACKGROUND_COLOR);
+    m_WiringScene->render(&ThumbnailPainter, TargetRect, SourceRect, Qt::IgnoreAspectRatio);
+}
+
+void WindowSceneMinimap::RebuildThumbnail()
+{
+    // Start over with a Thumbnail the size of the window (The only full render of the Scene)
+    UpdateThumbnailMapping();
+    m_Thumbnail = QPixmap(size());
+    m_Thumbnail.fill(MINIMAP_OUTSIDE_COLOR);
+    RenderThumbnailRegion(m_ThumbnailSceneRect);
+
+    m_ThumbnailRebuildNeeded = false;
+    m_DirtyThumbnailRegion = QRegion();
+}
+
+void WindowSceneMinimap::RenderDirtyThumbnailRegions()
+{
+    QVector<QRect> DirtyRectList;
+
+    // Too many small pieces cost more to render one by one than their bounding rect
+    if (m_DirtyThumbnailRegion.rectCount() > MINIMAP_MAX_DIRTY_REGIONS) {
+        DirtyRectList.append(m_DirtyThumbnailRegion.boundingRect());
+    } else {
+        DirtyRectList = m_DirtyThumbnailRegion.rects();
+    }
+    m_DirtyThumbnailRegion = QRegion();
+
+    // Re-render just the changed parts of the Scene into the Thumbnail
+    foreach (const QRect& DirtyRect, DirtyRectList) {
+        RenderThumbnailRegion(QRectF(MapThumbnailToScene(DirtyRect.topLeft()), MapThumbnailToScene(QPointF(DirtyRect.x() + DirtyRect.width(), DirtyRect.y() + DirtyRect.height()))));
+    }
+}
+
+void WindowSceneMinimap::CenterViewOnThumbnailPoint(const QPointF& ThumbnailPoint)
+{
+    m_WiringView->centerOn(MapThumbnailToScene(ThumbnailPoint));
+}
+
+void WindowSceneMinimap::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event)
+
+    QRectF ViewportSceneRect;
+
+    // Only rebuild the whole Thumbnail when the mapping has changed
+    if (m_ThumbnailRebuildNeeded == true) {
+        RebuildThumbnail();
+    } else if ((m_DirtyThumbnailRegion.isEmpty() == false) && (m_ThumbnailUpdateTimer->isActive() == false)) {
+        RenderDirtyThumbnailRegions();
+    }
+
+    QPainter WindowPainter(this);
+    WindowPainter.drawPixmap(0, 0, m_Thumbnail);
+
+    // Draw the part of the Scene the View is showing
+    ViewportSceneRect = m_WiringView->mapToScene(m_WiringView->viewport()->rect()).boundingRect();
+    WindowPainter.setPen(QPen(MINIMAP_VIEWPORT_COLOR, 2));
+    WindowPainter.setBrush(Qt::NoBrush);
+    WindowPainter.drawRect(MapSceneToThumbnail(ViewportSceneRect));
+}
+
+void WindowSceneMinimap::resizeEvent(QResizeEvent* event)
+{
+    QFrame::resizeEvent(event);
+
+    // The Thumbnail no longer fits
+    m_ThumbnailRebuildNeeded = true;
+}
+
+void WindowSceneMinimap::showEvent(QShowEvent* event)
+{
+    QFrame::showEvent(event);
+
+    // Changes were ignored while hidden
+    m_ThumbnailRebuildNeeded = true;
+}
+
+void WindowSceneMinimap::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton) {
+        CenterViewOnThumbnailPoint(event->pos());
+    }
+}
+
+void WindowSceneMinimap::mouseMoveEvent(QMouseEvent* event)
+{
+    if ((event->buttons() & Qt::LeftButton) != 0) {
+        CenterViewOnThumbnailPoint(event->pos());
+    }
+}
+
+void WindowSceneMinimap::HandleSceneChanged(const QList<QRectF>& ChangedSceneRectList)
+{
+    // While hidden or waiting on a full rebuild, the rebuild covers the changes
+    if ((isVisible() == false) || (m_ThumbnailRebuildNeeded == true)) {
+        return;
+    }
+
+    // Collect the changed parts (QRegion merges the ones that overlap)
+    foreach (const QRectF& ChangedSceneRect, ChangedSceneRectList) {
+        m_DirtyThumbnailRegion += MapSceneToThumbnail(ChangedSceneRect).toAlignedRect() & m_Thumbnail.rect();
+    }
+
+    // Only one re-render is queued at a time, further changes just ride along with it
+    if ((m_DirtyThumbnailRegion.isEmpty() == false) && (m_ThumbnailUpdateTimer->isActive() == false)) {
+        m_ThumbnailUpdateTimer->start();
+    }
+}
+
+void WindowSceneMinimap::HandleThumbnailUpdateTimeout()
+{
+    // The dirty parts are re-rendered on the next paint
+    if (isVisible() == true) {
+        update();
+    }
+}
+
+void WindowSceneMinimap::HandleSceneRectChanged(const QRectF& NewSceneRect)
+{
+    Q_UNUSED(NewSceneRect)
+
+    // The Scene to Thumbnail mapping changed, everything has moved
+    m_ThumbnailRebuildNeeded = true;
+    update();
+}
+
+void WindowSceneMinimap::HandleViewportMoved()
+{
+    // Just the Viewport Rectangle moves, the Thumbnail is unchanged
+    update();
+}
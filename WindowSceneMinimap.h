@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef WINDOWSCENEMINIMAP_H
+#define WINDOWSCENEMINIMAP_H
+
+#include "GlobalIncludes.h"
+
+#include "WiringScene.h"
+
+////////////////////////////////////////////////////////////
+
+class WindowSceneMinimap : public QFrame
+{
+    Q_OBJECT
+
+public:
+    // Constructor / Destructor
+    explicit WindowSceneMinimap(WiringScene* Scene, QGraphicsView* View, QWidget* parent = 0);
+    ~WindowSceneMinimap();
+
+    QSize sizeHint() const;
+
+private:
+    // Mapping between the Scene and the Thumbnail
+    void    UpdateThumbnailMapping();
+    QRectF  MapSceneToThumbnail(const QRectF& SceneRect);
+    QPointF MapThumbnailToScene(const QPointF& ThumbnailPoint);
+
+    // Rendering of the Thumbnail
+    void RenderThumbnailRegion(const QRectF& SceneRect);
+    void RebuildThumbnail();
+    void RenderDirtyThumbnailRegions();
+    void CenterViewOnThumbnailPoint(const QPointF& ThumbnailPoint);
+
+    // Overridden virtual functions
+    void paintEvent(QPaintEvent* event);
+    void resizeEvent(QResizeEvent* event);
+    void showEvent(QShowEvent* event);
+    void mousePressEvent(QMouseEvent* event);
+    void mouseMoveEvent(QMouseEvent* event);
+
+private slots:
+    void HandleSceneChanged(const QList<QRectF>& ChangedSceneRectList);
+    void HandleThumbnailUpdateTimeout();
+    void HandleSceneRectChanged(const QRectF& NewSceneRect);
+    void HandleViewportMoved();
+
+private:
+    WiringScene*   m_WiringScene;
+    QGraphicsView* m_WiringView;
+
+    QPixmap        m_Thumbnail;                 // Cached downscaled image of the whole Scene
+    QRectF         m_ThumbnailSceneRect;        // The Scene Rect shown in the Thumbnail
+    QPointF        m_ThumbnailOffset;           // Offset of the Scene Rect inside the Thumbnail (Keeps the aspect ratio)
+    qreal          m_ThumbnailScale;            // Thumbnail pixels per Scene unit
+    bool           m_ThumbnailRebuildNeeded;    // Set when the whole Thumbnail must be re-rendered before the next paint
+    QRegion        m_DirtyThumbnailRegion;      // Thumbnail pixels of the changed parts of the Scene (Merged as they come in)
+    QTimer*        m_ThumbnailUpdateTimer;      // Throttles re-renders while the Scene is being edited
+};
+
+#endif // WINDOWSCENEMINIMAP_H
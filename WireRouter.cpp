@@ -0,0 +1,338 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+#include "WireRouter.h"
+
+////////////////////////////////////////////////////////////
+
+// The Directions a Route moves in from one Node of the grid to the next
+// (Right, Left, Down, Up; Each Direction XOR 1 is its reverse)
+static const int RouteMoveX[4] = {1, -1, 0, 0};
+static const int RouteMoveY[4] = {0, 0, 1, -1};
+
+WireRouter::WireRouter()
+{
+}
+
+WireRouter::~WireRouter()
+{
+}
+
+void WireRouter::SetObstacle(QGraphicsItem* Item, const QRectF& SceneRect)
+{
+    QRectF ObstacleRect;
+    int    CellX;
+    int    CellY;
+
+    // Routes keep a Clearance from the Obstacle
+    ObstacleRect = SceneRect.adjusted(-WIRE_ROUTER_CLEARANCE, -WIRE_ROUTER_CLEARANCE, WIRE_ROUTER_CLEARANCE, WIRE_ROUTER_CLEARANCE);
+
+    // Nothing to do if the Obstacle has not changed
+    if ((m_ObstacleRectMap.contains(Item) == true) && (m_ObstacleRectMap.value(Item) == ObstacleRect)) {
+        return;
+    }
+
+    // Move the Obstacle to its new cells
+    RemoveObstacle(Item);
+    m_ObstacleRectMap.insert(Item, ObstacleRect);
+    for (CellX = qFloor(ObstacleRect.left() / WIRE_ROUTER_INDEX_CELL_SIZE); CellX <= qFloor(ObstacleRect.right() / WIRE_ROUTER_INDEX_CELL_SIZE); CellX++) {
+        for (CellY = qFloor(ObstacleRect.top() / WIRE_ROUTER_INDEX_CELL_SIZE); CellY <= qFloor(ObstacleRect.bottom() / WIRE_ROUTER_INDEX_CELL_SIZE); CellY++) {
+            m_ObstacleCellHash.insert(GetCellKey(CellX, CellY), Item);
+        }
+    }
+}
+
+void WireRouter::RemoveObstacle(QGraphicsItem* Item)
+{
+    QRectF ObstacleRect;
+    int    CellX;
+    int    CellY;
+
+    if (m_ObstacleRectMap.contains(Item) == false) {
+        return;
+    }
+
+    // Remove the Obstacle from the cells it was inserted into
+    ObstacleRect = m_ObstacleRectMap.take(Item);
+    for (CellX = qFloor(ObstacleRect.left() / WIRE_ROUTER_INDEX_CELL_SIZE); CellX <= qFloor(ObstacleRect.right() / WIRE_ROUTER_INDEX_CELL_SIZE); CellX++) {
+        for (CellY = qFloor(ObstacleRect.top() / WIRE_ROUTER_INDEX_CELL_SIZE); CellY <= qFloor(ObstacleRect.bottom() / WIRE_ROUTER_INDEX_CELL_SIZE); CellY++) {
+            m_ObstacleCellHash.remove(GetCellKey(CellX, CellY), Item);
+        }
+    }
+}
+
+void WireRouter::ClearObstacles()
+{
+    m_ObstacleRectMap.clear();
+    m_ObstacleCellHash.clear();
+}
+
+QVector<QPointF> WireRouter::RouteWire(const QPointF& StartPoint, ExitDirection StartExit, const QPointF& EndPoint, ExitDirection EndExit) const
+{
+    QRectF           SearchRect;
+    QVector<QPointF> RoutePointList;
+
+    // First search close to the End Points, then allow a wider detour around large Obstacles
+    SearchRect = QRectF(StartPoint, EndPoint).normalized();
+    SearchRect.adjust(-WIRE_ROUTER_SEARCH_MARGIN, -WIRE_ROUTER_SEARCH_MARGIN, WIRE_ROUTER_SEARCH_MARGIN, WIRE_ROUTER_SEARCH_MARGIN);
+    RoutePointList = RouteWireInRect(StartPoint, StartExit, EndPoint, EndExit, SearchRect);
+
+    if (RoutePointList.isEmpty() == true) {
+        SearchRect.adjust(-3 * WIRE_ROUTER_SEARCH_MARGIN, -3 * WIRE_ROUTER_SEARCH_MARGIN, 3 * WIRE_ROUTER_SEARCH_MARGIN, 3 * WIRE_ROUTER_SEARCH_MARGIN);
+        RoutePointList = RouteWireInRect(StartPoint, StartExit, EndPoint, EndExit, SearchRect);
+    }
+    return RoutePointList;
+}
+
+void WireRouter::RunRouteJob(RouteJob& Job)
+{
+    Job.RoutePointList = Job.Router->RouteWire(Job.StartPoint, Job.StartExit, Job.EndPoint, Job.EndExit);
+}
+
+QVector<QPointF> WireRouter::RouteWireInRect(const QPointF& StartPoint, ExitDirection StartExit, const QPointF& EndPoint, ExitDirection EndExit, const QRectF& SearchRect) const
+{
+    QList<QRectF>         ObstacleList;
+    QVector<qreal>        XLineList;
+    QVector<qreal>        YLineList;
+    QVector<bool>         HorzBlockedList;     // Edge from Node (x, y) to Node (x + 1, y)
+    QVector<bool>         VertBlockedList;     // Edge from Node (x, y) to Node (x, y + 1)
+    QVector<qreal>        CostList;            // Cost to reach each State (A State is Node * 4 + Move Direction)
+    QVector<int>          ParentList;
+    QVector<bool>         ClosedList;
+    QMultiMap<qreal, int> OpenMap;             // States still to visit by their estimated total cost
+    QVector<QPointF>      PathPointList;
+    QVector<QPointF>      RoutePointList;
+    int                   NumX;
+    int                   NumY;
+    int                   StartNode;
+    int                   EndNode;
+    int                   EndMoveDirection;
+    int                   FoundState = -1;
+    int                   Expansions = 0;
+    int                   State;
+    int                   Node;
+    int                   Dir;
+    int                   NewDir;
+    int                   NewX;
+    int                   NewY;
+    int                   NewState;
+    int                   x;
+    int                   y;
+    qreal                 NewCost;
+
+    // Obstacles holding an End Point cannot be avoided (The Wire was dropped onto them)
+    foreach (const QRectF& ObstacleRect, GetObstaclesInRect(SearchRect)) {
+        if ((ObstacleRect.contains(StartPoint) == false) && (ObstacleRect.contains(EndPoint) == false)) {
+            ObstacleList.append(ObstacleRect);
+        }
+    }
+
+    // The grid lines run through the End Points, a short stub out of each Port, half way
+    // between the End Points, along the edges of the Obstacles and the edges of the Search Rect
+    AddGridLine(XLineList, SearchRect.left(), SearchRect.left(), SearchRect.right());
+    AddGridLine(XLineList, SearchRect.right(), SearchRect.left(), SearchRect.right());
+    AddGridLine(XLineList, StartPoint.x(), SearchRect.left(), SearchRect.right());
+    AddGridLine(XLineList, EndPoint.x(), SearchRect.left(), SearchRect.right());
+    AddGridLine(XLineList, (StartPoint.x() + EndPoint.x()) / 2, SearchRect.left(), SearchRect.right());
+    AddGridLine(XLineList, StartPoint.x() + RouteMoveX[GetExitMoveDirection(StartExit)] * WIRE_ROUTER_CLEARANCE, SearchRect.left(), SearchRect.right());
+    AddGridLine(XLineList, EndPoint.x() + RouteMoveX[GetExitMoveDirection(EndExit)] * WIRE_ROUTER_CLEARANCE, SearchRect.left(), SearchRect.right());
+    AddGridLine(YLineList, SearchRect.top(), SearchRect.top(), SearchRect.bottom());
+    AddGridLine(YLineList, SearchRect.bottom(), SearchRect.top(), SearchRect.bottom());
+    AddGridLine(YLineList, StartPoint.y(), SearchRect.top(), SearchRect.bottom());
+    AddGridLine(YLineList, EndPoint.y(), SearchRect.top(), SearchRect.bottom());
+    AddGridLine(YLineList, (StartPoint.y() + EndPoint.y()) / 2, SearchRect.top(), SearchRect.bottom());
+    foreach (const QRectF& ObstacleRect, ObstacleList) {
+        AddGridLine(XLineList, ObstacleRect.left(), SearchRect.left(), SearchRect.right());
+        AddGridLine(XLineList, ObstacleRect.right(), SearchRect.left(), SearchRect.right());
+        AddGridLine(YLineList, ObstacleRect.top(), SearchRect.top(), SearchRect.bottom());
+        AddGridLine(YLineList, ObstacleRect.bottom(), SearchRect.top(), SearchRect.bottom());
+    }
+    SortGridLines(XLineList);
+    SortGridLines(YLineList);
+    NumX = XLineList.count();
+    NumY = YLineList.count();
+
+    StartNode = YLineList.indexOf(StartPoint.y()) * NumX + XLineList.indexOf(StartPoint.x());
+    EndNode = YLineList.indexOf(EndPoint.y()) * NumX + XLineList.indexOf(EndPoint.x());
+    if (StartNode == EndNode) {
+        return RoutePointList;
+    }
+
+    // Block the Edges that run through the inside of an Obstacle (Every Obstacle edge
+    // is a grid line, so an Edge is either all inside or all outside of an Obstacle)
+    HorzBlockedList.fill(false, (NumX - 1) * NumY);
+    VertBlockedList.fill(false, NumX * (NumY - 1));
+    foreach (const QRectF& ObstacleRect, ObstacleList) {
+        for (y = qUpperBound(YLineList.begin(), YLineList.end(), ObstacleRect.top()) - YLineList.begin(); (y < NumY) && (YLineList[y] < ObstacleRect.bottom()); y++) {
+            for (x = qLowerBound(XLineList.begin(), XLineList.end(), ObstacleRect.left()) - XLineList.begin(); (x < NumX - 1) && (XLineList[x + 1] <= ObstacleRect.right()); x++) {
+                HorzBlockedList[y * (NumX - 1) + x] = true;
+            }
+        }
+        for (x = qUpperBound(XLineList.begin(), XLineList.end(), ObstacleRect.left()) - XLineList.begin(); (x < NumX) && (XLineList[x] < ObstacleRect.right()); x++) {
+            for (y = qLowerBound(YLineList.begin(), YLineList.end(), ObstacleRect.top()) - YLineList.begin(); (y < NumY - 1) && (YLineList[y + 1] <= ObstacleRect.bottom()); y++) {
+                VertBlockedList[y * NumX + x] = true;
+            }
+        }
+    }
+
+    // A* Search; Each bend costs extra so the Routes stay simple, and a Route
+    // leaves and arrives at a Port in the direction the Port faces
+    CostList.fill(-1, NumX * NumY * 4);
+    ParentList.fill(-1, NumX * NumY * 4);
+    ClosedList.fill(false, NumX * NumY * 4);
+    for (Dir = 0; Dir < 4; Dir++) {
+        if ((StartExit == EXIT_ANY) || (Dir == GetExitMoveDirection(StartExit))) {
+            State = StartNode * 4 + Dir;
+            CostList[State] = 0;
+            OpenMap.insert(qAbs(EndPoint.x() - StartPoint.x()) + qAbs(EndPoint.y() - StartPoint.y()), State);
+        }
+    }
+    EndMoveDirection = (EndExit == EXIT_ANY) ? -1 : (GetExitMoveDirection(EndExit) ^ 1);
+
+    while ((OpenMap.isEmpty() == false) && (Expansions < WIRE_ROUTER_MAX_EXPANSIONS)) {
+        State = OpenMap.begin().value();
+        OpenMap.erase(OpenMap.begin());
+        if (ClosedList[State] == true) {
+            continue;
+        }
+        ClosedList[State] = true;
+        Expansions++;
+
+        Node = State / 4;
+        if (Node == EndNode) {
+            FoundState = State;
+            break;
+        }
+
+        Dir = State % 4;
+        x = Node % NumX;
+        y = Node / NumX;
+        for (NewDir = 0; NewDir < 4; NewDir++) {
+            // Routes never double back on themselves
+            if (NewDir == (Dir ^ 1)) {
+                continue;
+            }
+
+            NewX = x + RouteMoveX[NewDir];
+            NewY = y + RouteMoveY[NewDir];
+            if ((NewX < 0) || (NewX >= NumX) || (NewY < 0) || (NewY >= NumY)) {
+                continue;
+            }
+            if ((NewY == y) && (HorzBlockedList[y * (NumX - 1) + qMin(x, NewX)] == true)) {
+                continue;
+            }
+            if ((NewX == x) && (VertBlockedList[qMin(y, NewY) * NumX + x] == true)) {
+                continue;
+            }
+
+            NewCost = CostList[State] + qAbs(XLineList[NewX] - XLineList[x]) + qAbs(YLineList[NewY] - YLineList[y]);
+            if (NewDir != Dir) {
+                NewCost += WIRE_ROUTER_BEND_COST;
+            }
+            if ((NewY * NumX + NewX == EndNode) && (EndMoveDirection >= 0) && (NewDir != EndMoveDirection)) {
+                NewCost += WIRE_ROUTER_BEND_COST;
+            }
+
+            NewState = (NewY * NumX + NewX) * 4 + NewDir;
+            if ((CostList[NewState] < 0) || (NewCost < CostList[NewState])) {
+                CostList[NewState] = NewCost;
+                ParentList[NewState] = State;
+                OpenMap.insert(NewCost + qAbs(EndPoint.x() - XLineList[NewX]) + qAbs(EndPoint.y() - YLineList[NewY]), NewState);
+            }
+        }
+    }
+
+    // No Route (or the search ran too long)
+    if (FoundState < 0) {
+        return RoutePointList;
+    }
+
+    // Walk back from the End Point, then keep only the points where the Route bends
+    for (State = FoundState; State >= 0; State = ParentList[State]) {
+        Node = State / 4;
+        PathPointList.prepend(QPointF(XLineList[Node % NumX], YLineList[Node / NumX]));
+    }
+    for (x = 0; x < PathPointList.count(); x++) {
+        if ((x > 0) && (x < PathPointList.count() - 1) &&
+            (((PathPointList[x - 1].x() == PathPointList[x].x()) && (PathPointList[x].x() == PathPointList[x + 1].x())) ||
+             ((PathPointList[x - 1].y() == PathPointList[x].y()) && (PathPointList[x].y() == PathPointList[x + 1].y())))) {
+            continue;
+        }
+        RoutePointList.append(PathPointList[x]);
+    }
+    return RoutePointList;
+}
+
+QList<QRectF> WireRouter::GetObstaclesInRect(const QRectF& SearchRect) const
+{
+    QSet<QGraphicsItem*> FoundItemSet;
+    QList<QRectF>        ObstacleList;
+    QRectF               ObstacleRect;
+    int                  CellX;
+    int                  CellY;
+
+    // Collect the Obstacles in the cells under the Search Rect (An Obstacle can be in many cells)
+    for (CellX = qFloor(SearchRect.left() / WIRE_ROUTER_INDEX_CELL_SIZE); CellX <= qFloor(SearchRect.right() / WIRE_ROUTER_INDEX_CELL_SIZE); CellX++) {
+        for (CellY = qFloor(SearchRect.top() / WIRE_ROUTER_INDEX_CELL_SIZE); CellY <= qFloor(SearchRect.bottom() / WIRE_ROUTER_INDEX_CELL_SIZE); CellY++) {
+            foreach (QGraphicsItem* Item, m_ObstacleCellHash.values(GetCellKey(CellX, CellY))) {
+                FoundItemSet.insert(Item);
+            }
+        }
+    }
+
+    foreach (QGraphicsItem* Item, FoundItemSet) {
+        ObstacleRect = m_ObstacleRectMap.value(Item);
+        if (ObstacleRect.intersects(SearchRect) == true) {
+            ObstacleList.append(ObstacleRect);
+        }
+    }
+    return ObstacleList;
+}
+
+void WireRouter::AddGridLine(QVector<qreal>& LineList, qreal Line, qreal Min, qreal Max)
+{
+    // Lines outside of the Search Rect are not part of the grid
+    if ((Line >= Min) && (Line <= Max)) {
+        LineList.append(Line);
+    }
+}
+
+void WireRouter::SortGridLines(QVector<qreal>& LineList)
+{
+    int x;
+    int Count = 0;
+
+    // Sort the Lines and remove the duplicates
+    qSort(LineList);
+    for (x = 0; x < LineList.count(); x++) {
+        if ((Count == 0) || (LineList[x] != LineList[Count - 1])) {
+            LineList[Count++] = LineList[x];
+        }
+    }
+    LineList.resize(Count);
+}
+
+int WireRouter::GetExitMoveDirection(ExitDirection Exit)
+{
+    // Wires without a Port (EXIT_ANY) use the Right Direction for their stub
+    return (Exit == EXIT_LEFT) ? 1 : 0;
+}
+
+quint64 WireRouter::GetCellKey(int CellX, int CellY)
+{
+    return ((quint64)(quint32)CellX << 32) | (quint32)CellY;
+}
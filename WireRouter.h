@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef WIREROUTER_H
+#define WIREROUTER_H
+
+#include "GlobalIncludes.h"
+
+////////////////////////////////////////////////////////////
+
+// The Wire Router finds Orthogonal (Horizontal / Vertical) routes for Wires that go
+// around the Components and Groups of the Scene.  The Obstacles are kept in a Spatial
+// Hash, so a route only looks at the Obstacles near its End Points.  The route is
+// an A* search over the grid of lines through the End Points and the Obstacle edges.
+class WireRouter
+{
+public:
+    // Direction a Wire leaves its End Point (Ports leave away from their Component Side)
+    enum ExitDirection { EXIT_ANY, EXIT_LEFT, EXIT_RIGHT };
+
+    // A Route to be found by RunRouteJob() (Many Jobs can be run in parallel)
+    struct RouteJob
+    {
+        const WireRouter* Router;
+        QPointF           StartPoint;
+        ExitDirection     StartExit;
+        QPointF           EndPoint;
+        ExitDirection     EndExit;
+        QVector<QPointF>  RoutePointList;   // The Result
+    };
+
+    // Constructor / Destructor
+    WireRouter();
+    ~WireRouter();
+
+    // Obstacle Index (Keyed by the Scene Item that is the Obstacle)
+    void SetObstacle(QGraphicsItem* Item, const QRectF& SceneRect);
+    void RemoveObstacle(QGraphicsItem* Item);
+    void ClearObstacles();
+
+    // Find a Route from the Start to the End Point (in Scene coordinates); Returns all the points
+    // of the route including the Start and End Points, or an empty list if no route was found.
+    // NOTE: Routing only reads the Obstacle Index, so Routes can be found on several threads at once
+    QVector<QPointF> RouteWire(const QPointF& StartPoint, ExitDirection StartExit, const QPointF& EndPoint, ExitDirection EndExit) const;
+    static void RunRouteJob(RouteJob& Job);
+
+private:
+    QVector<QPointF> RouteWireInRect(const QPointF& StartPoint, ExitDirection StartExit, const QPointF& EndPoint, ExitDirection EndExit, const QRectF& SearchRect) const;
+    QList<QRectF> GetObstaclesInRect(const QRectF& SearchRect) const;
+    static void AddGridLine(QVector<qreal>& LineList, qreal Line, qreal Min, qreal Max);
+    static void SortGridLines(QVector<qreal>& LineList);
+    static int  GetExitMoveDirection(ExitDirection Exit);
+    static quint64 GetCellKey(int CellX, int CellY);
+
+private:
+    QHash<QGraphicsItem*, QRectF>         m_ObstacleRectMap;       // Obstacle Rects grown by the Clearance
+    QMultiHash<quint64, QGraphicsItem*>   m_ObstacleCellHash;      // Obstacles that touch each Cell
+};
+
+#endif // WIREROUTER_H
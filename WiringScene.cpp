@@ -17,14 +17,18 @@
 
 #include "WiringScene.h"
 
+#include <QtConcurrent>
+
 ////////////////////////////////////////////////////////////
 
-WiringScene::WiringScene(QMenu* ItemMenu, QUndoStack* UndoStack, QObject* parent /*=0*/) :
+WiringScene::WiringScene(QMenu* ItemMenu, UndoRedoStack* UndoStack, QObject* parent /*=0*/) :
     QGraphicsScene(parent)
 {
     // Get a copy of the ItemMenu and the UndoStack
     m_ItemMenu = ItemMenu;
     m_UndoStack = UndoStack;
+    m_UndoGestureSerial = 0;
+    m_LastUndoItemId = 0;
 
     // Set the Default Operation Mode
     SetOperationMode(MODE_SELECTMOVEITEM);
@@ -41,17 +45,45 @@ WiringScene::WiringScene(QMenu* ItemMenu, QUndoStack* UndoStack, QObject* parent
     m_ptrNewItemWire = NULL;
     m_ptrMovingItemWire = NULL;
     m_ptrMovingItemWireHandle = NULL;
+    m_ComponentRenderCacheMode = QGraphicsItem::NoCache;
+    m_TopLevelItemsBoundsValid = true;
+    m_AutoRouteNewWires = WIRE_ROUTER_DEFAULT_AUTOROUTE;
+    m_BatchOperationInProgress = false;
+    m_NotificationDispatchScheduled = false;
+    m_PendingProjectDirty = false;
+    m_PendingRefreshPropertiesWindow = false;
+    m_WireReroutesThisPeriod = 0;
     m_GraphicItemWireList.clear();
     m_GraphicItemComponentList.clear();
     for (int x = 0; x < NUMCOMPONENTTYPES; x++) {
         m_GraphicItemComponentByTypeList[x].clear();
     }
+    m_GraphicItemGroupList.clear();
+    m_SubCircuitDefinitionMap.clear();
     m_CurrentWireIndex = 0;
     m_CurrentComponentByKeyIndex.clear();
+
+    // The Wire Reroute Timer fires once per frame while Wires are waiting to be rerouted
+    m_WireRerouteTimer = new QTimer(this);
+    m_WireRerouteTimer->setSingleShot(true);
+    m_WireRerouteTimer->setInterval(WIRE_REROUTE_FRAME_INTERVAL);
+    connect(m_WireRerouteTimer, SIGNAL(timeout()), this, SLOT(ProcessWireRerouteQueue()));
+
+    // The Wire Bundle Timer redraws the Bundles that changed (Collapsing a Bundle waits a little)
+    m_WireBundleUpdateTimer = new QTimer(this);
+    m_WireBundleUpdateTimer->setSingleShot(true);
+    connect(m_WireBundleUpdateTimer, SIGNAL(timeout()), this, SLOT(UpdatePendingWireBundles()));
 }
 
 WiringScene::~WiringScene()
 {
+    // Delete the Sub-Circuit Definitions
+    qDeleteAll(m_SubCircuitDefinitionMap);
+    m_SubCircuitDefinitionMap.clear();
+
+    // Delete the Parameter Sets
+    qDeleteAll(m_ParameterSetMap);
+    m_ParameterSetMap.clear();
 }
 
 void WiringScene::SetOperationMode(OperationMode NewMode)
@@ -138,19 +170,399 @@ QString WiringScene::BuildComponentKey(QString ElementName, QString ComponentNam
     return IndexKey;
 }
 
-void WiringScene::SetNothingSelected()
+void WiringScene::SetComponentRenderCaching(bool Enable)
 {
-    // Get the List of all graphic Items, and set none of them selected
-    QList<QGraphicsItem*> GraphicItems = items();
-    foreach (QGraphicsItem* item, GraphicItems) {
-        item->setSelected(false);
+    // Device Coordinate Caching keeps the rasterized image of each Component until it
+    // changes or the view is zoomed, so panning and scrolling just blit the images
+    m_ComponentRenderCacheMode = (Enable == true) ? QGraphicsItem::DeviceCoordinateCache : QGraphicsItem::NoCache;
+
+    foreach (GraphicItemComponent* Component, m_GraphicItemComponentList) {
+        Component->SetRenderCacheMode(m_ComponentRenderCacheMode);
+    }
+}
+
+QRectF WiringScene::GetItemsBoundingRect()
+{
+    // Rebuild the Bounds from the saved Top Level Item Rects only if an item
+    // on the edge of the Bounds has moved inward or been removed
+    if (m_TopLevelItemsBoundsValid == false) {
+        m_TopLevelItemsBounds = QRectF();
+        foreach (const QRectF& ItemRect, m_TopLevelItemRectMap) {
+            m_TopLevelItemsBounds |= ItemRect;
+        }
+        m_TopLevelItemsBoundsValid = true;
+    }
+    return m_TopLevelItemsBounds;
+}
+
+QList<QGraphicsItem*> WiringScene::GetSelectedTopLevelItems()
+{
+    QList<QGraphicsItem*> SelectedTopLevelItems;
+    QSet<QGraphicsItem*>  FoundTopLevelItemSet;
+    QGraphicsItem*        TopLevelItem;
+
+    // Only Top Level Items are tracked, so walk up from any selected child item
+    // (The Set keeps this linear when many items are selected)
+    foreach (QGraphicsItem* Item, selectedItems()) {
+        TopLevelItem = Item->topLevelItem();
+        if ((m_TopLevelItemRectMap.contains(TopLevelItem) == true) && (FoundTopLevelItemSet.contains(TopLevelItem) == false)) {
+            FoundTopLevelItemSet.insert(TopLevelItem);
+            SelectedTopLevelItems.append(TopLevelItem);
+        }
+    }
+    return SelectedTopLevelItems;
+}
+
+QRectF WiringScene::GetSelectedItemsBoundingRect()
+{
+    QRectF SelectedBounds;
+
+    foreach (QGraphicsItem* Item, GetSelectedTopLevelItems()) {
+        SelectedBounds |= m_TopLevelItemRectMap.value(Item);
+    }
+    return SelectedBounds;
+}
+
+void WiringScene::TrackTopLevelItemBounds(QGraphicsItem* Item)
+{
+    QRectF                NewItemRect;
+    QRectF                OldItemRect;
+    GraphicItemComponent* Component;
+    GraphicItemGroup*     Group;
+
+    // Items that have been removed from the Scene are not tracked
+    if (Item->scene() != this) {
+        return;
+    }
+
+    // The Rect of the Item and its children (Names, Ports, Wire Segments, etc) in Scene coordinates
+    NewItemRect = Item->mapRectToScene(Item->boundingRect() | Item->childrenBoundingRect());
+
+    // If the Item used to sit on the edge of the Bounds, the Bounds may need to shrink
+    if (m_TopLevelItemRectMap.contains(Item) == true) {
+        OldItemRect = m_TopLevelItemRectMap.value(Item);
+        if ((IsRectOnItemsBoundsEdge(OldItemRect) == true) && (NewItemRect.contains(OldItemRect) == false)) {
+            m_TopLevelItemsBoundsValid = false;
+        }
+    }
+    m_TopLevelItemRectMap.insert(Item, NewItemRect);
+
+    // Growing the Bounds is just a union
+    if (m_TopLevelItemsBoundsValid == true) {
+        m_TopLevelItemsBounds |= NewItemRect;
+    }
+
+    // Grow the Scene Rect (which sets the scroll range of the view) to hold the Item
+    if (sceneRect().contains(NewItemRect) == false) {
+        setSceneRect(sceneRect() | NewItemRect.adjusted(-SCENE_GROW_MARGIN, -SCENE_GROW_MARGIN, SCENE_GROW_MARGIN, SCENE_GROW_MARGIN));
+    }
+
+    // The Ports of the Item may have moved
+    TrackPortOwnerCells(Item);
+
+    // The Body of a Component or Group is an Obstacle for the Routed Wires
+    Component = qgraphicsitem_cast<GraphicItemComponent*>(Item);
+    Group = qgraphicsitem_cast<GraphicItemGroup*>(Item);
+    if (Component != NULL) {
+        m_WireRouter.SetObstacle(Item, Component->mapRectToScene(Component->rect()));
+    } else if (Group != NULL) {
+        m_WireRouter.SetObstacle(Item, Group->mapRectToScene(Group->rect()));
+    }
+}
+
+void WiringScene::UntrackTopLevelItemBounds(QGraphicsItem* Item)
+{
+    QRectF OldItemRect;
+
+    // The Ports of the Item can no longer be found, and Wires no longer route around it
+    UntrackPortOwnerCells(Item);
+    m_WireRouter.RemoveObstacle(Item);
+
+    // A removed Wire leaves its Bundle
+    if (qgraphicsitem_cast<GraphicItemWire*>(Item) != NULL) {
+        RemoveWireFromBundle((GraphicItemWire*)Item);
+    }
+
+    if (m_TopLevelItemRectMap.contains(Item) == false) {
+        return;
+    }
+
+    // If the Item sat on the edge of the Bounds, the Bounds may need to shrink
+    OldItemRect = m_TopLevelItemRectMap.take(Item);
+    if (IsRectOnItemsBoundsEdge(OldItemRect) == true) {
+        m_TopLevelItemsBoundsValid = false;
+    }
+}
+
+bool WiringScene::IsRectOnItemsBoundsEdge(const QRectF& ItemRect)
+{
+    // An invalid Bounds will be rebuilt anyway
+    if (m_TopLevelItemsBoundsValid == false) {
+        return false;
+    }
+
+    return (ItemRect.left() <= m_TopLevelItemsBounds.left()) || (ItemRect.top() <= m_TopLevelItemsBounds.top()) ||
+           (ItemRect.right() >= m_TopLevelItemsBounds.right()) || (ItemRect.bottom() >= m_TopLevelItemsBounds.bottom());
+}
+
+void WiringScene::TrackPortOwnerCells(QGraphicsItem* Item)
+{
+    QList<GraphicItemPort*>       PortList;
+    QList<QPair<quint64, int> >   NewCellKeyList;
+    QPair<quint64, int>           CellKey;
+    QRectF                        ConnectionRect;
+    int                           CellX;
+    int                           CellY;
+    int                           x;
+
+    // Only Components and Groups own Ports
+    if ((qgraphicsitem_cast<GraphicItemComponent*>(Item) == NULL) && (qgraphicsitem_cast<GraphicItemGroup*>(Item) == NULL)) {
+        return;
+    }
+    PortList = GetPortOwnerPortArray(Item);
+
+    // Find every cell touched by the Connection Rect of each Port
+    for (x = 0; x < PortList.count(); x++) {
+        ConnectionRect = Item->mapRectToScene(PortList.at(x)->GetConnectionRect());
+        for (CellX = qFloor(ConnectionRect.left() / SCENE_PORT_HASH_CELL_SIZE); CellX <= qFloor(ConnectionRect.right() / SCENE_PORT_HASH_CELL_SIZE); CellX++) {
+            for (CellY = qFloor(ConnectionRect.top() / SCENE_PORT_HASH_CELL_SIZE); CellY <= qFloor(ConnectionRect.bottom() / SCENE_PORT_HASH_CELL_SIZE); CellY++) {
+                NewCellKeyList.append(qMakePair(GetPortHashCellKey(CellX, CellY), x));
+            }
+        }
+    }
+
+    // Nothing to do if the Ports are still in the same cells (Ports not moved or reconfigured)
+    if (m_PortOwnerCellKeyMap.value(Item) == NewCellKeyList) {
+        return;
+    }
+
+    // Move the Ports of the Item to their new cells
+    UntrackPortOwnerCells(Item);
+    foreach (CellKey, NewCellKeyList) {
+        m_PortCellHash.insert(CellKey.first, PortCellEntry(Item, CellKey.second));
+    }
+    m_PortOwnerCellKeyMap.insert(Item, NewCellKeyList);
+}
+
+void WiringScene::UntrackPortOwnerCells(QGraphicsItem* Item)
+{
+    QList<QPair<quint64, int> > OldCellKeyList;
+    QPair<quint64, int>         CellKey;
+
+    OldCellKeyList = m_PortOwnerCellKeyMap.take(Item);
+    foreach (CellKey, OldCellKeyList) {
+        m_PortCellHash.remove(CellKey.first, PortCellEntry(Item, CellKey.second));
+    }
+}
+
+QList<GraphicItemPort*> WiringScene::GetPortOwnerPortArray(QGraphicsItem* Item)
+{
+    GraphicItemComponent* Component = qgraphicsitem_cast<GraphicItemComponent*>(Item);
+    GraphicItemGroup*     Group = qgraphicsitem_cast<GraphicItemGroup*>(Item);
+
+    if (Component != NULL) {
+        return Component->GetGraphicalPortArray();
+    }
+    if (Group != NULL) {
+        return Group->GetGraphicalPortArray();
+    }
+    return QList<GraphicItemPort*>();
+}
+
+quint64 WiringScene::GetPortHashCellKey(int CellX, int CellY)
+{
+    return ((quint64)(quint32)CellX << 32) | (quint32)CellY;
+}
+
+QList<GraphicItemPort*> WiringScene::GetPortsAtScenePoint(const QPointF& ScenePoint)
+{
+    quint64                         CellKey;
+    QList<GraphicItemPort*>         FoundPorts;
+    QHash<QGraphicsItem*, int>      FoundPortIndexMap;     // Top most Port found on each Owner
+    QList<GraphicItemPort*>         PortList;
+    GraphicItemPort*                ptrPort;
+
+    // Only the Ports in the cell of the point can be there, each is checked on its own
+    CellKey = GetPortHashCellKey(qFloor(ScenePoint.x() / SCENE_PORT_HASH_CELL_SIZE), qFloor(ScenePoint.y() / SCENE_PORT_HASH_CELL_SIZE));
+    QMultiHash<quint64, PortCellEntry>::const_iterator it = m_PortCellHash.constFind(CellKey);
+    while ((it != m_PortCellHash.constEnd()) && (it.key() == CellKey)) {
+        PortList = GetPortOwnerPortArray(it.value().first);
+        if ((it.value().second < PortList.count()) && (it.value().second > FoundPortIndexMap.value(it.value().first, -1))) {
+            ptrPort = PortList.at(it.value().second);
+            if (ptrPort->ContainsConnectionPoint(it.value().first->mapFromScene(ScenePoint)) == true) {
+                FoundPortIndexMap.insert(it.value().first, it.value().second);
+            }
+        }
+        ++it;
+    }
+
+    // One Port per Owner (The last drawn one wins, as when the Owner is searched)
+    foreach (QGraphicsItem* Owner, FoundPortIndexMap.keys()) {
+        FoundPorts.append(GetPortOwnerPortArray(Owner).at(FoundPortIndexMap.value(Owner)));
+    }
+    return FoundPorts;
+}
+
+void WiringScene::HandleComponentGeometryChanged(GraphicItemComponent* Component)
+{
+    TrackTopLevelItemBounds(Component);
+}
+
+void WiringScene::HandleGroupGeometryChanged(GraphicItemGroup* Group)
+{
+    TrackTopLevelItemBounds(Group);
+}
+
+void WiringScene::HandleTextGeometryChanged(GraphicItemText* Text)
+{
+    TrackTopLevelItemBounds(Text);
+}
+
+void WiringScene::HandleWireGeometryChanged(GraphicItemWire* Wire)
+{
+    TrackTopLevelItemBounds(Wire);
+}
+
+void WiringScene::HandleWireConnectionChanged(GraphicItemWire* Wire)
+{
+    UpdateWireBundleMembership(Wire);
+}
+
+void WiringScene::HandleWireBundleStateChanged(GraphicItemWire* Wire)
+{
+    // Only Wires in a Bundle expand or collapse
+    if (m_WireBundleKeyMap.contains(Wire) == false) {
+        return;
+    }
+
+    // Expand right away, but give the mouse time to move between the Wires before collapsing
+    if ((Wire->isSelected() == true) || (Wire->IsWireHovered() == true)) {
+        ScheduleWireBundleUpdate(m_WireBundleKeyMap.value(Wire), 0);
+    } else {
+        ScheduleWireBundleUpdate(m_WireBundleKeyMap.value(Wire), WIRE_BUNDLE_COLLAPSE_DELAY);
+    }
+}
+
+void WiringScene::UpdateWireBundleMembership(GraphicItemWire* Wire)
+{
+    QGraphicsItem* StartOwner;
+    QGraphicsItem* EndOwner;
+    WireBundleKey  NewKey;
+
+    // Only Fully Connected Wires on this Scene are Bundled
+    if ((Wire->scene() != this) || (Wire->GetWireConnectedState() != GraphicItemWire::FULL_CONNECTION)) {
+        RemoveWireFromBundle(Wire);
+        return;
+    }
+
+    // The Key is the same whichever way round the Wire was drawn
+    StartOwner = Wire->GetStartPointConnectedPort()->GetOwnerItem();
+    EndOwner = Wire->GetEndPointConnectedPort()->GetOwnerItem();
+    if (StartOwner > EndOwner) {
+        qSwap(StartOwner, EndOwner);
+    }
+    NewKey = WireBundleKey(StartOwner, EndOwner);
+
+    // Nothing to do if the Wire is still in the same Bundle
+    if ((m_WireBundleKeyMap.contains(Wire) == true) && (m_WireBundleKeyMap.value(Wire) == NewKey)) {
+        return;
+    }
+
+    RemoveWireFromBundle(Wire);
+    m_WireBundleMap[NewKey].append(Wire);
+    m_WireBundleKeyMap.insert(Wire, NewKey);
+    ScheduleWireBundleUpdate(NewKey, 0);
+}
+
+void WiringScene::RemoveWireFromBundle(GraphicItemWire* Wire)
+{
+    WireBundleKey OldKey;
+
+    if (m_WireBundleKeyMap.contains(Wire) == false) {
+        return;
+    }
+
+    OldKey = m_WireBundleKeyMap.take(Wire);
+    m_WireBundleMap[OldKey].removeOne(Wire);
+    if (m_WireBundleMap.value(OldKey).isEmpty() == true) {
+        m_WireBundleMap.remove(OldKey);
+    }
+
+    // The Wire is drawn on its own again, and the rest of the Bundle is redrawn
+    Wire->SetWireBundleState(GraphicItemWire::BUNDLE_NONE, 0);
+    ScheduleWireBundleUpdate(OldKey, 0);
+}
+
+void WiringScene::ScheduleWireBundleUpdate(const WireBundleKey& Key, int Delay)
+{
+    m_PendingWireBundleKeySet.insert(Key);
+
+    // An earlier update takes over a later one
+    if ((m_WireBundleUpdateTimer->isActive() == false) || (m_WireBundleUpdateTimer->remainingTime() > Delay)) {
+        m_WireBundleUpdateTimer->start(Delay);
     }
+}
+
+void WiringScene::UpdatePendingWireBundles()
+{
+    QSet<WireBundleKey>     PendingKeySet;
+    QList<GraphicItemWire*> WireList;
+    bool                    Expanded;
+    int                     x;
+
+    // Take the pending Bundles (Bundles that changed since the last update)
+    PendingKeySet = m_PendingWireBundleKeySet;
+    m_PendingWireBundleKeySet.clear();
+
+    foreach (const WireBundleKey& Key, PendingKeySet) {
+        WireList = m_WireBundleMap.value(Key);
+
+        // A Bundle is expanded while any of its Wires is Hovered or Selected
+        Expanded = (WireList.count() < WIRE_BUNDLE_MIN_WIRES);
+        foreach (GraphicItemWire* Wire, WireList) {
+            if ((Wire->isSelected() == true) || (Wire->IsWireHovered() == true)) {
+                Expanded = true;
+            }
+        }
+
+        // A collapsed Bundle is drawn by its Lead (The First Wire)
+        for (x = 0; x < WireList.count(); x++) {
+            if (Expanded == true) {
+                WireList.at(x)->SetWireBundleState(GraphicItemWire::BUNDLE_NONE, 0);
+            } else if (x == 0) {
+                WireList.at(x)->SetWireBundleState(GraphicItemWire::BUNDLE_LEAD, WireList.count());
+            } else {
+                WireList.at(x)->SetWireBundleState(GraphicItemWire::BUNDLE_MEMBER, WireList.count());
+            }
+        }
+    }
+}
+
+void WiringScene::SetNothingSelected()
+{
+    // Clear the Selection in one shot; The scene only visits the items that are
+    // actually selected and emits a single selectionChanged() when done
+    clearSelection();
 
     // Turn off the properties
     emit SceneEventGraphicItemSelected(NULL);
     emit SceneEventGraphicItemSelectedProperties(NULL);
 }
 
+void WiringScene::SetAllSelected()
+{
+    QPainterPath SelectionPath;
+
+    // Select everything inside the bounds of all the items as one Selection Area
+    // (this emits a single selectionChanged() instead of one per item)
+    SelectionPath.addRect(GetItemsBoundingRect());
+    setSelectionArea(SelectionPath, Qt::IntersectsItemBoundingRect);
+
+    // Multiple items are selected, so no properties are displayed
+    emit SceneEventGraphicItemSelected(NULL);
+    emit SceneEventGraphicItemSelectedProperties(NULL);
+}
+
 void WiringScene::RefreshAllCurrentWirePositions()
 {
     GraphicItemWire* Wire;
@@ -171,6 +583,31 @@ void WiringScene::RefreshAllCurrentWirePositions()
     }
 }
 
+void WiringScene::RerouteAllWires()
+{
+    QList<GraphicItemWire*>       WireList;
+    QVector<WireRouter::RouteJob> RouteJobList;
+    WireRouter::RouteJob          Job;
+    int                           x;
+
+    // Collect the End Points of every Wire on the Scene
+    Job.Router = &m_WireRouter;
+    foreach (GraphicItemWire* Wire, m_GraphicItemWireList) {
+        if (Wire->scene() == this) {
+            Wire->GetRouteEndPoints(Job.StartPoint, Job.StartExit, Job.EndPoint, Job.EndExit);
+            WireList.append(Wire);
+            RouteJobList.append(Job);
+        }
+    }
+
+    // Find all the Routes in parallel (The Router is only read while routing),
+    // then give each Wire its Route back on this thread
+    QtConcurrent::blockingMap(RouteJobList, WireRouter::RunRouteJob);
+    for (x = 0; x < WireList.count(); x++) {
+        WireList.at(x)->SetRoutePoints(RouteJobList.at(x).RoutePointList);
+    }
+}
+
 QString WiringScene::CheckComponentReqsAndBuildKey(int AllowedInstances, SSTInfoDataComponent::ComponentType CompType, QString ParentElementName, QString ComponentName)
 {
     QString Key;
@@ -221,8 +658,8 @@ void WiringScene::CreateNewComponentItem(QPointF ScenePos)
         // Add this ADD Command to the Undo/Redo Queue
         // NOTE: QUndoCommand::redo() is called when pushing the command
         //       onto the stack, which will call AddNewComponentItemToScene();
-        QUndoCommand* AddComponentCommand = new ComandAddGraphicItemComponent(NewComponent, this);
-        m_UndoStack->push(AddComponentCommand);
+        ComandBase* AddComponentCommand = new ComandAddGraphicItemComponent(NewComponent, this);
+        m_UndoStack->Push(AddComponentCommand);
     }
 }
 
@@ -266,8 +703,8 @@ void WiringScene::PasteNewComponentItem(QDataStream& DataStreamIn, int PasteOffs
         // Add this PASTE Command to the Undo/Redo Queue
         // NOTE: QUndoCommand::redo() is called when pushing the command
         //       onto the stack, which will call AddNewComponentItemToScene();
-        QUndoCommand* AddComponentCommand = new ComandAddGraphicItemComponent(NewComponent, this, true);
-        m_UndoStack->push(AddComponentCommand);
+        ComandBase* AddComponentCommand = new ComandAddGraphicItemComponent(NewComponent, this, true);
+        m_UndoStack->Push(AddComponentCommand);
 
         // Offset the new Component's Position so it shows up near its original
         QPointF pos = NewComponent->pos();
@@ -283,8 +720,11 @@ void WiringScene::AddNewComponentItemToScene(GraphicItemComponent* NewComponentI
 {
     SSTInfoDataComponent::ComponentType CompType = NewComponentItem->GetComponentType();
 
-    // Add the item to the scene
+    // Add the item to the scene (using the current Render Caching)
+    NewComponentItem->SetRenderCacheMode(m_ComponentRenderCacheMode);
     addItem(NewComponentItem);
+    TrackTopLevelItemBounds(NewComponentItem);
+    connect(NewComponentItem, SIGNAL(ItemComponentGeometryChanged(GraphicItemComponent*)), this, SLOT(HandleComponentGeometryChanged(GraphicItemComponent*)), Qt::UniqueConnection);
 
     // Increment the count of all components and count of components by type
     m_GraphicItemComponentList.append(NewComponentItem);
@@ -295,13 +735,16 @@ void WiringScene::AddNewComponentItemToScene(GraphicItemComponent* NewComponentI
         SetSingleGraphicItemAsSelected(NewComponentItem);
     }
 
-    // Display the properties for this Wire
-    emit SceneEventGraphicItemSelected(NewComponentItem);
-    emit SceneEventGraphicItemSelectedProperties(NewComponentItem->GetItemProperties());
+    // Display the properties for this Wire (Batches only notify once when done)
+    if (m_BatchOperationInProgress == false) {
+        emit SceneEventGraphicItemSelected(NewComponentItem);
+        emit SceneEventGraphicItemSelectedProperties(NewComponentItem->GetItemProperties());
+    }
 
-    connect(NewComponentItem, SIGNAL(ItemComponentSetProjectDirty()), this, SIGNAL(SceneEventSetProjectDirty()));
-    connect(NewComponentItem, SIGNAL(ItemComponentRefreshPropertiesWindowProperty(QString, QString)), this, SIGNAL(SceneEventRefreshPropertiesWindowProperty(QString, QString)));
+    connect(NewComponentItem, SIGNAL(ItemComponentSetProjectDirty()), this, SLOT(HandleItemSetProjectDirty()));
+    connect(NewComponentItem, SIGNAL(ItemComponentRefreshPropertiesWindowProperty(QString, QString)), this, SLOT(HandleItemRefreshPropertiesWindowProperty(QString, QString)));
     connect(NewComponentItem, SIGNAL(ItemComponentRefreshPropertiesWindow(ItemProperties*)), this, SIGNAL(SceneEventRefreshPropertiesWindow(ItemProperties*)));
+    connect(NewComponentItem, SIGNAL(ItemComponentPortsReordered(GraphicItemComponent*, QList<int>)), this, SLOT(HandleComponentPortsReordered(GraphicItemComponent*, QList<int>)), Qt::UniqueConnection);
 
     // Tell the Main Window we added this Component
     emit SceneEventComponentAdded(NewComponentItem);
@@ -316,8 +759,8 @@ void WiringScene::CreateNewTextItem(QPointF ScenePos)
     // Add this ADD Command to the Undo/Redo Queue
     // NOTE: QUndoCommand::redo() is called when pushing the command
     //       onto the stack, which will call AddNewTextItemToScene();
-    QUndoCommand* AddTextCommand = new ComandAddGraphicItemText(NewTextItem, this);
-    m_UndoStack->push(AddTextCommand);
+    ComandBase* AddTextCommand = new ComandAddGraphicItemText(NewTextItem, this);
+    m_UndoStack->Push(AddTextCommand);
 }
 
 void WiringScene::CreateNewTextItem(QDataStream& DataStreamIn)
@@ -339,8 +782,8 @@ void WiringScene::PasteNewTextItem(QDataStream& DataStreamIn, int PasteOffset)
     // Add this Paste Command to the Undo/Redo Queue
     // NOTE: QUndoCommand::redo() is called when pushing the command
     //       onto the stack, which will call AddNewTextItemToScene();
-    QUndoCommand* AddTextCommand = new ComandAddGraphicItemText(NewTextItem, this, true);
-    m_UndoStack->push(AddTextCommand);
+    ComandBase* AddTextCommand = new ComandAddGraphicItemText(NewTextItem, this, true);
+    m_UndoStack->Push(AddTextCommand);
 
     // Offset the new Text's Position so it shows up near its original
     QPointF pos = NewTextItem->pos();
@@ -355,19 +798,23 @@ void WiringScene::AddNewTextItemToScene(GraphicItemText* NewTextItem, bool Selec
 {
     // Add the item to the scene
     addItem(NewTextItem);
+    TrackTopLevelItemBounds(NewTextItem);
+    connect(NewTextItem, SIGNAL(ItemTextGeometryChanged(GraphicItemText*)), this, SLOT(HandleTextGeometryChanged(GraphicItemText*)), Qt::UniqueConnection);
 
     if (SelectSingle == true) {
         // Set the Text to as the only selected item
         SetSingleGraphicItemAsSelected(NewTextItem);
     }
 
-    // Turn off the properties display (for text)
-    emit SceneEventGraphicItemSelected(NULL);
-    emit SceneEventGraphicItemSelectedProperties(NULL);
+    // Turn off the properties display (for text) (Batches only notify once when done)
+    if (m_BatchOperationInProgress == false) {
+        emit SceneEventGraphicItemSelected(NULL);
+        emit SceneEventGraphicItemSelectedProperties(NULL);
+    }
 
     // Signal a handler when Text Editor Looses Focus
     connect(NewTextItem, SIGNAL(ItemTextLostFocus(GraphicItemText*)), this, SLOT(HandleTextEditorLostFocus(GraphicItemText*)));
-    connect(NewTextItem, SIGNAL(ItemTextSetProjectDirty()), this, SIGNAL(SceneEventSetProjectDirty()));
+    connect(NewTextItem, SIGNAL(ItemTextSetProjectDirty()), this, SLOT(HandleItemSetProjectDirty()));
 
     // Tell the Main Window we added this Text
     emit SceneEventTextAdded(NewTextItem);
@@ -378,6 +825,7 @@ void WiringScene::CreateNewWireItem(QPointF ScenePos)
     // Create a New ItemWire graphic object to show the user how they are wiring,
     // both points initially start at the mouse position.
     m_ptrNewItemWire = new GraphicItemWire(++m_CurrentWireIndex, ScenePos, ScenePos);
+    m_ptrNewItemWire->SetAutoRouted(m_AutoRouteNewWires);
 
     // Set the Wire to as the only selected item
     // Also set the Wire to selected so it shows its colors correctly
@@ -391,8 +839,8 @@ void WiringScene::CreateNewWireItem(QPointF ScenePos)
     // Add this ADD Command to the Undo/Redo Queue
     // NOTE: QUndoCommand::redo() is called when pushing the command
     //       onto the stack, which will call AddNewWireItemToScene();
-    QUndoCommand* AddWireCommand = new ComandAddGraphicItemWire(m_ptrNewItemWire, this);
-    m_UndoStack->push(AddWireCommand);
+    ComandBase* AddWireCommand = new ComandAddGraphicItemWire(m_ptrNewItemWire, this);
+    m_UndoStack->Push(AddWireCommand);
 }
 
 void WiringScene::CreateNewWireItem(QDataStream& DataStreamIn)
@@ -417,8 +865,8 @@ void WiringScene::PasteNewWireItem(QDataStream& DataStreamIn, int PasteOffset)
     // Add this ADD Command to the Undo/Redo Queue
     // NOTE: QUndoCommand::redo() is called when pushing the command
     //       onto the stack, which will call AddNewWireItemToScene();
-    QUndoCommand* AddWireCommand = new ComandAddGraphicItemWire(m_ptrNewItemWire, this, true);
-    m_UndoStack->push(AddWireCommand);
+    ComandBase* AddWireCommand = new ComandAddGraphicItemWire(m_ptrNewItemWire, this, true);
+    m_UndoStack->Push(AddWireCommand);
 
     // Move the Objects Position
     m_ptrNewItemWire->SetPastePosition(PasteOffset);
@@ -435,11 +883,16 @@ void WiringScene::AddNewWireItemToScene(GraphicItemWire* NewWireItem, bool Updat
     // Add the item to the scene, and to the list
     addItem(NewWireItem);
     m_GraphicItemWireList.append(NewWireItem);
+    TrackTopLevelItemBounds(NewWireItem);
+    connect(NewWireItem, SIGNAL(ItemWireGeometryChanged(GraphicItemWire*)), this, SLOT(HandleWireGeometryChanged(GraphicItemWire*)), Qt::UniqueConnection);
+    connect(NewWireItem, SIGNAL(ItemWireConnectionChanged(GraphicItemWire*)), this, SLOT(HandleWireConnectionChanged(GraphicItemWire*)), Qt::UniqueConnection);
+    connect(NewWireItem, SIGNAL(ItemWireBundleStateChanged(GraphicItemWire*)), this, SLOT(HandleWireBundleStateChanged(GraphicItemWire*)), Qt::UniqueConnection);
 
     // Tell the Main Window we Initially added this Wire (The wire has been created and start point set)
     emit SceneEventWireAddedInitialPlacement(NewWireItem);
 
-    connect(NewWireItem, SIGNAL(ItemWireSetProjectDirty()), this, SIGNAL(SceneEventSetProjectDirty()));
+    connect(NewWireItem, SIGNAL(ItemWireSetProjectDirty()), this, SLOT(HandleItemSetProjectDirty()));
+    connect(NewWireItem, SIGNAL(ItemWireRerouteQueued(GraphicItemWire*)), this, SLOT(HandleWireRerouteQueued(GraphicItemWire*)), Qt::UniqueConnection);
 
     // Now Update the positions of the wires (always the Start Point and sometimes the End Point)
     NewWireItem->UpdateStartPointPosition(NewWireItem->GetStartPoint());
@@ -448,15 +901,728 @@ void WiringScene::AddNewWireItemToScene(GraphicItemWire* NewWireItem, bool Updat
     }
 }
 
+bool WiringScene::CreateSubCircuitFromSelection(QString DefinitionName)
+{
+    QList<GraphicItemComponent*>    CapturedComponentList;
+    QList<GraphicItemWire*>         CapturedWireList;
+    QList<GraphicItemWire*>         CrossingWireList;
+    QList<bool>                     CrossingWireStartFlagList;
+    QList<int>                      CrossingBoundaryPortIndexList;
+    QList<GraphicItemPort*>         BoundaryGraphicalPortList;
+    QList<SubCircuitBoundaryPort*>  BoundaryPortList;
+    GraphicItemComponent*           Component;
+    GraphicItemPort*                StartPort;
+    GraphicItemPort*                EndPort;
+    GraphicItemPort*                InsidePort;
+    QPointF                         OutsidePoint;
+    bool                            StartInside;
+    bool                            EndInside;
+    int                             BoundaryIndex;
+    QRectF                          CapturedRect;
+    QByteArray                      ContentsData;
+    PortInfoData::ComponentSide     BoundarySide;
+    SubCircuitDefinition*           NewDefinition;
+    GraphicItemGroup*               NewGroup;
+    QString                         Key;
+    int                             IndexValue;
+
+    // Definition Names must be unique
+    if (IsSubCircuitDefinitionNameUsed(DefinitionName) == true) {
+        return false;
+    }
+
+    // Get all the selected Components (The SST Startup Configuration cannot be part of a Sub-Circuit)
+    foreach (QGraphicsItem* Item, selectedItems()) {
+        Component = qgraphicsitem_cast<GraphicItemComponent*>(Item);
+        if ((Component != NULL) && (Component->GetComponentType() != SSTInfoDataComponent::COMP_SSTSTARTUPCONFIGURATION)) {
+            CapturedComponentList.append(Component);
+            CapturedRect |= Component->sceneBoundingRect();
+        }
+    }
+    if (CapturedComponentList.count() == 0) {
+        return false;
+    }
+
+    // Sort the Wires: Wires with both ends on captured Components go inside of the Sub-Circuit,
+    // Wires with only one end on a captured Component cross the boundary of the Sub-Circuit
+    foreach (GraphicItemWire* Wire, m_GraphicItemWireList) {
+        StartPort = Wire->GetStartPointConnectedPort();
+        EndPort = Wire->GetEndPointConnectedPort();
+        StartInside = (StartPort != NULL) && CapturedComponentList.contains(qgraphicsitem_cast<GraphicItemComponent*>(StartPort->GetOwnerItem()));
+        EndInside = (EndPort != NULL) && CapturedComponentList.contains(qgraphicsitem_cast<GraphicItemComponent*>(EndPort->GetOwnerItem()));
+
+        if ((StartInside == true) && (EndInside == true)) {
+            CapturedWireList.append(Wire);
+        } else if (StartInside != EndInside) {
+            // Each internal port is exported as a Boundary Port only once
+            InsidePort = (StartInside == true) ? StartPort : EndPort;
+            BoundaryIndex = BoundaryGraphicalPortList.indexOf(InsidePort);
+            if (BoundaryIndex < 0) {
+                Component = (GraphicItemComponent*)InsidePort->GetOwnerItem();
+
+                // Put the Boundary Port on the side facing the outside end of the wire
+                OutsidePoint = (StartInside == true) ? Wire->GetEndPoint() : Wire->GetStartPoint();
+                BoundarySide = (OutsidePoint.x() < CapturedRect.center().x()) ? PortInfoData::SIDE_LEFT : PortInfoData::SIDE_RIGHT;
+
+                BoundaryPortList.append(new SubCircuitBoundaryPort(Component->GetItemProperties()->GetPropertyValue(PROPKEY_COMPONENT_UNIQUENAME),
+                                                                   InsidePort->GetConfiguredPortName(),
+                                                                   InsidePort->GetItemProperties()->GetPropertyValue(PROPKEY_PORT_LATENCY),
+                                                                   BoundarySide));
+                BoundaryGraphicalPortList.append(InsidePort);
+                BoundaryIndex = BoundaryGraphicalPortList.count() - 1;
+            }
+
+            CrossingWireList.append(Wire);
+            CrossingWireStartFlagList.append(StartInside);
+            CrossingBoundaryPortIndexList.append(BoundaryIndex);
+        }
+    }
+
+    // Serialize the Captured Components and Wires into the Definition Contents
+    QDataStream DataStreamOut(&ContentsData, QIODevice::WriteOnly);
+    DataStreamOut.setVersion(QDataStream::Qt_5_2);
+    DataStreamOut << (qint32)CapturedComponentList.count();
+    DataStreamOut << (qint32)CapturedWireList.count();
+    foreach (GraphicItemComponent* CapturedComponent, CapturedComponentList) {
+        CapturedComponent->SaveData(DataStreamOut);
+    }
+    foreach (GraphicItemWire* CapturedWire, CapturedWireList) {
+        CapturedWire->SaveData(DataStreamOut);
+    }
+
+    // Create and Register the Definition
+    // NOTE: The Definition stays registered (even if the creation is undone) as
+    //       Group Instances on the Undo Stack or in the Copy Buffer may refer to it.
+    NewDefinition = new SubCircuitDefinition(DefinitionName, ContentsData, BoundaryPortList);
+    m_SubCircuitDefinitionMap.insert(DefinitionName, NewDefinition);
+
+    // Get the Index Value based on key SubCircuit.<DefinitionName> and increment it.
+    Key = BuildComponentKey(GROUP_KEY_ELEMENTNAME, DefinitionName);
+    IndexValue = m_CurrentComponentByKeyIndex.value(Key);  // If not in map, default will be 0
+    m_CurrentComponentByKeyIndex.insert(Key, ++IndexValue); // Increment value and put back into map
+
+    // Create the first Group Instance where the captured Components were
+    NewGroup = new GraphicItemGroup(IndexValue, NewDefinition, m_ItemMenu, QPointF(CapturedRect.center().x(), CapturedRect.top()));
+
+    // Add this CREATE Command to the Undo/Redo Queue
+    // NOTE: QUndoCommand::redo() is called when pushing the command
+    //       onto the stack, which will replace the captured items with the Group
+    ComandBase* CreateSubCircuitCommand = new ComandCreateSubCircuit(NewGroup, CapturedComponentList, CapturedWireList, CrossingWireList,
+                                                                       CrossingWireStartFlagList, CrossingBoundaryPortIndexList, this);
+    m_UndoStack->Push(CreateSubCircuitCommand);
+
+    return true;
+}
+
+void WiringScene::CreateNewGroupItem(QDataStream& DataStreamIn)
+{
+    QString               DefinitionName;
+    SubCircuitDefinition* Definition;
+
+    // Find the Definition of this Group (Definitions are always loaded before Groups)
+    DataStreamIn >> DefinitionName;
+    Definition = m_SubCircuitDefinitionMap.value(DefinitionName, NULL);
+    if (Definition == NULL) {
+        QMessageBox::critical(NULL, "CODING ERROR", QString("SCENE LOAD - SUB-CIRCUIT DEFINITION %1 NOT FOUND").arg(DefinitionName));
+        return;
+    }
+
+    // Create a new Group Item from the Saved Data
+    GraphicItemGroup* NewGroup;
+    NewGroup = new GraphicItemGroup(DataStreamIn, Definition, m_ItemMenu);
+
+    // Add the item to the scene
+    AddNewGroupItemToScene(NewGroup);
+}
+
+void WiringScene::PasteNewGroupItem(QDataStream& DataStreamIn, int PasteOffset)
+{
+    QString               DefinitionName;
+    SubCircuitDefinition* Definition;
+    QString               Key;
+    int                   IndexValue;
+
+    // Find the Definition of this Group
+    DataStreamIn >> DefinitionName;
+    Definition = m_SubCircuitDefinitionMap.value(DefinitionName, NULL);
+    if (Definition == NULL) {
+        // The Definition is gone (new project loaded), nothing to paste
+        return;
+    }
+
+    // Create a new Group Item from the Paste Action
+    GraphicItemGroup* NewGroup;
+    NewGroup = new GraphicItemGroup(DataStreamIn, Definition, m_ItemMenu);
+
+    // Get the Index Value based on key SubCircuit.<DefinitionName> and increment it.
+    Key = BuildComponentKey(GROUP_KEY_ELEMENTNAME, DefinitionName);
+    IndexValue = m_CurrentComponentByKeyIndex.value(Key);  // If not in map, default will be 0
+    m_CurrentComponentByKeyIndex.insert(Key, ++IndexValue); // Increment value and put back into map
+
+    // Set the Index for the New Group
+    NewGroup->SetGroupIndex(IndexValue);
+
+    // Add this PASTE Command to the Undo/Redo Queue
+    // NOTE: QUndoCommand::redo() is called when pushing the command
+    //       onto the stack, which will call AddNewGroupItemToScene();
+    ComandBase* AddGroupCommand = new ComandAddGraphicItemGroup(NewGroup, this, true);
+    m_UndoStack->Push(AddGroupCommand);
+
+    // Offset the new Group's Position so it shows up near its original
+    QPointF pos = NewGroup->pos();
+    pos += QPointF(PasteOffset, PasteOffset);
+    NewGroup->setPos(pos);
+
+    // Set the Pasted object to selected so that its ready to move
+    NewGroup->setSelected(true);
+}
+
+void WiringScene::AddNewGroupItemToScene(GraphicItemGroup* NewGroupItem, bool SelectSingle /*=true*/)
+{
+    // Add the item to the scene, and to the list
+    addItem(NewGroupItem);
+    m_GraphicItemGroupList.append(NewGroupItem);
+    TrackTopLevelItemBounds(NewGroupItem);
+    connect(NewGroupItem, SIGNAL(ItemGroupGeometryChanged(GraphicItemGroup*)), this, SLOT(HandleGroupGeometryChanged(GraphicItemGroup*)), Qt::UniqueConnection);
+
+    if (SelectSingle == true) {
+        // Set the Group to as the only selected item
+        SetSingleGraphicItemAsSelected(NewGroupItem);
+    }
+
+    // Display the properties for this Group (Batches only notify once when done)
+    if (m_BatchOperationInProgress == false) {
+        emit SceneEventGraphicItemSelected(NewGroupItem);
+        emit SceneEventGraphicItemSelectedProperties(NewGroupItem->GetItemProperties());
+    }
+
+    connect(NewGroupItem, SIGNAL(ItemGroupSetProjectDirty()), this, SLOT(HandleItemSetProjectDirty()));
+    connect(NewGroupItem, SIGNAL(ItemGroupRefreshPropertiesWindowProperty(QString, QString)), this, SLOT(HandleItemRefreshPropertiesWindowProperty(QString, QString)));
+}
+
+bool WiringScene::GenerateTopology(TopologyGenerator* Generator, SSTInfoDataComponent* RouterInfo, QString RouterPortName,
+                                   SSTInfoDataComponent* EndpointInfo, QString EndpointPortName, QPointF StartPos)
+{
+    int                             x;
+    int                             e;
+    int                             NumRouters;
+    int                             NumEndpoints;
+    int                             NumNewRouterInfoComponents;
+    int                             EndpointPortIndex;
+    GraphicItemComponent*           NewComponent;
+    GraphicItemComponent*           Router;
+    GraphicItemComponent*           Endpoint;
+    GraphicItemPort*                StartPort;
+    GraphicItemPort*                EndPort;
+    GraphicItemWire*                NewWire;
+    QList<GraphicItemComponent*>    RouterList;
+    QList<GraphicItemComponent*>    EndpointList;
+    QList<QList<GraphicItemPort*> > RouterPortList;
+    QList<GraphicItemPort*>         EndpointPortList;
+    QList<GraphicItemPort*>         PortList;
+    QList<GraphicItemComponent*>    NewComponentList;
+    QList<GraphicItemWire*>         NewWireList;
+    QRectF                          ItemRect;
+    qreal                           RouterWidth = 0;
+    qreal                           RouterHeight = 0;
+    qreal                           EndpointWidth = 0;
+    qreal                           EndpointHeight = 0;
+    qreal                           EndpointPitch;
+    qreal                           ColumnPitch;
+    qreal                           RowPitch;
+    QPointF                         RouterPos;
+    QMap<QString, int>              SavedComponentByKeyIndex;
+    bool                            PortsOkFlag = true;
+
+    NumRouters = Generator->GetNumRouters();
+    NumEndpoints = (EndpointInfo != NULL) ? Generator->GetNumEndpoints() : 0;
+
+    // Make sure all of the Components are allowed to be created
+    NumNewRouterInfoComponents = NumRouters + ((EndpointInfo == RouterInfo) ? NumEndpoints : 0);
+    if (CheckComponentReqsForBatch(RouterInfo, NumNewRouterInfoComponents) == false) {
+        return false;
+    }
+    if ((EndpointInfo != NULL) && (EndpointInfo != RouterInfo) && (CheckComponentReqsForBatch(EndpointInfo, NumEndpoints) == false)) {
+        return false;
+    }
+
+    // Remember the Component Indexes, they are given back if the Topology cannot be built
+    SavedComponentByKeyIndex = m_CurrentComponentByKeyIndex;
+
+    // Create the Routers with enough Dynamic Port Instances for all of their links
+    for (x = 0; x < NumRouters; x++) {
+        NewComponent = CreateGeneratedComponent(RouterInfo, RouterPortName, Generator->GetRouterNumPorts(x), PortList);
+        PortsOkFlag &= (PortList.count() == Generator->GetRouterNumPorts(x));
+        RouterList.append(NewComponent);
+        RouterPortList.append(PortList);
+
+        ItemRect = NewComponent->boundingRect() | NewComponent->childrenBoundingRect();
+        RouterWidth = qMax(RouterWidth, ItemRect.width());
+        RouterHeight = qMax(RouterHeight, ItemRect.height());
+    }
+
+    // Create the Endpoints (Each has 1 port that goes to its Router)
+    for (x = 0; x < NumEndpoints; x++) {
+        NewComponent = CreateGeneratedComponent(EndpointInfo, EndpointPortName, 1, PortList);
+        PortsOkFlag &= (PortList.count() == 1);
+        EndpointList.append(NewComponent);
+        EndpointPortList.append(PortList.value(0, NULL));
+
+        ItemRect = NewComponent->boundingRect() | NewComponent->childrenBoundingRect();
+        EndpointWidth = qMax(EndpointWidth, ItemRect.width());
+        EndpointHeight = qMax(EndpointHeight, ItemRect.height());
+    }
+
+    NewComponentList = RouterList + EndpointList;
+
+    // Make sure that every Component got the Ports the Topology needs
+    if (PortsOkFlag == false) {
+        qDeleteAll(NewComponentList);
+        m_CurrentComponentByKeyIndex = SavedComponentByKeyIndex;
+        QMessageBox::warning(NULL, "Cannot Generate Topology", QString("The Router Port %1 cannot hold the %2 Links each Router needs").arg(RouterPortName).arg(Generator->GetTopologyDescription()));
+        return false;
+    }
+
+    // Figure out the spacing of the Grid; The Endpoints of a Router are stacked to its right
+    EndpointPitch = EndpointHeight + (TOPOLOGY_LAYOUT_SPACING / 2);
+    ColumnPitch = RouterWidth + TOPOLOGY_LAYOUT_SPACING;
+    RowPitch = RouterHeight + TOPOLOGY_LAYOUT_SPACING;
+    if (NumEndpoints > 0) {
+        ColumnPitch += EndpointWidth + TOPOLOGY_LAYOUT_SPACING;
+        for (x = 0; x < NumRouters; x++) {
+            RowPitch = qMax(RowPitch, (Generator->GetRouterNumEndpoints(x) * EndpointPitch) + TOPOLOGY_LAYOUT_SPACING);
+        }
+    }
+
+    // Position the Routers and their Endpoints
+    EndpointPortIndex = 0;
+    for (x = 0; x < NumRouters; x++) {
+        Router = RouterList.at(x);
+        RouterPos = StartPos + QPointF(Generator->GetRouterGridPos(x).x() * ColumnPitch, Generator->GetRouterGridPos(x).y() * RowPitch);
+        Router->setPos(RouterPos);
+
+        for (e = 0; (NumEndpoints > 0) && (e < Generator->GetRouterNumEndpoints(x)); e++) {
+            Endpoint = EndpointList.at(EndpointPortIndex);
+            Endpoint->setPos(RouterPos + QPointF((RouterWidth + EndpointWidth) / 2 + TOPOLOGY_LAYOUT_SPACING, e * EndpointPitch));
+
+            // The Endpoint Ports of a Router follow its Network Ports
+            StartPort = RouterPortList.at(x).at(Generator->GetRouterNumNetworkPorts(x) + e);
+            EndPort = EndpointPortList.at(EndpointPortIndex);
+            NewWire = new GraphicItemWire(++m_CurrentWireIndex, Router->mapToScene(StartPort->GetConnectionPoint()), Endpoint->mapToScene(EndPort->GetConnectionPoint()));
+            NewWire->SetAutoRouted(m_AutoRouteNewWires);
+            NewWireList.append(NewWire);
+
+            EndpointPortIndex++;
+        }
+    }
+
+    // Create the Router to Router Wires
+    foreach (const TopologyLink& Link, Generator->GetRouterLinkList()) {
+        StartPort = RouterPortList.at(Link.GetSrcRouter()).at(Link.GetSrcPort());
+        EndPort = RouterPortList.at(Link.GetDstRouter()).at(Link.GetDstPort());
+        NewWire = new GraphicItemWire(++m_CurrentWireIndex, RouterList.at(Link.GetSrcRouter())->mapToScene(StartPort->GetConnectionPoint()),
+                                      RouterList.at(Link.GetDstRouter())->mapToScene(EndPort->GetConnectionPoint()));
+        NewWire->SetAutoRouted(m_AutoRouteNewWires);
+        NewWireList.append(NewWire);
+    }
+
+    // Add this GENERATE Command to the Undo/Redo Queue
+    // NOTE: QUndoCommand::redo() is called when pushing the command
+    //       onto the stack, which will call AddItemBatchToScene();
+    ComandBase* GenerateTopologyCommand = new ComandAddGeneratedTopology(NewComponentList, NewWireList, Generator->GetTopologyDescription(), this);
+    m_UndoStack->Push(GenerateTopologyCommand);
+
+    return true;
+}
+
+void WiringScene::AddItemBatchToScene(QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                                      const QList<GraphicItemGroup*>& GroupList /*=QList<GraphicItemGroup*>()*/,
+                                      const QList<GraphicItemText*>& TextList /*=QList<GraphicItemText*>()*/)
+{
+    // Turn off the per item notifications while the batch is added
+    m_BatchOperationInProgress = true;
+
+    // Add all the Components and Groups first so the Wires can connect to their Ports
+    foreach (GraphicItemComponent* Component, ComponentList) {
+        AddNewComponentItemToScene(Component, false);
+    }
+    foreach (GraphicItemGroup* Group, GroupList) {
+        AddNewGroupItemToScene(Group, false);
+    }
+    foreach (GraphicItemText* Text, TextList) {
+        AddNewTextItemToScene(Text, false);
+    }
+    foreach (GraphicItemWire* Wire, WireList) {
+        AddNewWireItemToScene(Wire, true);
+
+        // Sync the Wire style to its (unselected) state without any selection changes
+        Wire->SyncWireSelectedState();
+    }
+
+    m_BatchOperationInProgress = false;
+
+    // Nothing is selected after a batch
+    emit SceneEventGraphicItemSelected(NULL);
+    emit SceneEventGraphicItemSelectedProperties(NULL);
+}
+
+void WiringScene::DeleteItemBatchFromScene(QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                                           const QList<GraphicItemGroup*>& GroupList /*=QList<GraphicItemGroup*>()*/,
+                                           const QList<GraphicItemText*>& TextList /*=QList<GraphicItemText*>()*/)
+{
+    QSet<GraphicItemComponent*>   ComponentSet = ComponentList.toSet();
+    QSet<GraphicItemWire*>        WireSet = WireList.toSet();
+    QSet<GraphicItemGroup*>       GroupSet = GroupList.toSet();
+    QList<GraphicItemComponent*>  RemainingComponentList;
+    QList<GraphicItemWire*>       RemainingWireList;
+    QList<GraphicItemGroup*>      RemainingGroupList;
+    int                           x;
+
+    // Deselect everything at once (Removing Selected Items one by one emits a selectionChanged() for each)
+    clearSelection();
+
+    // Remove the Wires, Components, Groups and Text from the Scene
+    foreach (GraphicItemWire* Wire, WireList) {
+        Wire->DisconnectAllAttachedPorts();
+        UntrackTopLevelItemBounds(Wire);
+        removeItem(Wire);
+    }
+    foreach (GraphicItemComponent* Component, ComponentList) {
+        Component->DisconnectPortsFromAllWires();
+        UntrackTopLevelItemBounds(Component);
+        removeItem(Component);
+    }
+    foreach (GraphicItemGroup* Group, GroupList) {
+        Group->DisconnectPortsFromAllWires();
+        UntrackTopLevelItemBounds(Group);
+        removeItem(Group);
+    }
+    foreach (GraphicItemText* Text, TextList) {
+        UntrackTopLevelItemBounds(Text);
+        removeItem(Text);
+    }
+
+    // Rebuild the tracking lists in one pass (instead of searching the lists for every deleted item)
+    foreach (GraphicItemWire* Wire, m_GraphicItemWireList) {
+        if (WireSet.contains(Wire) == false) {
+            RemainingWireList.append(Wire);
+        }
+    }
+    m_GraphicItemWireList = RemainingWireList;
+
+    foreach (GraphicItemComponent* Component, m_GraphicItemComponentList) {
+        if (ComponentSet.contains(Component) == false) {
+            RemainingComponentList.append(Component);
+        }
+    }
+    m_GraphicItemComponentList = RemainingComponentList;
+
+    for (x = 0; x < NUMCOMPONENTTYPES; x++) {
+        RemainingComponentList.clear();
+        foreach (GraphicItemComponent* Component, m_GraphicItemComponentByTypeList[x]) {
+            if (ComponentSet.contains(Component) == false) {
+                RemainingComponentList.append(Component);
+            }
+        }
+        m_GraphicItemComponentByTypeList[x] = RemainingComponentList;
+    }
+
+    if (GroupSet.isEmpty() == false) {
+        foreach (GraphicItemGroup* Group, m_GraphicItemGroupList) {
+            if (GroupSet.contains(Group) == false) {
+                RemainingGroupList.append(Group);
+            }
+        }
+        m_GraphicItemGroupList = RemainingGroupList;
+    }
+
+    // NOTE: OBJECTS ARE CONTAINED IN THE GENERATE / DELETE COMMAND and will be deleted there
+
+    // De-Select all Items & Turn off the properties display
+    emit SceneEventGraphicItemSelected(NULL);
+    emit SceneEventGraphicItemSelectedProperties(NULL);
+}
+
+void WiringScene::SaveItemBatch(QDataStream& DataStreamOut, QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                                QList<GraphicItemGroup*>& GroupList, QList<GraphicItemText*>& TextList)
+{
+    // Make sure no Wires are waiting to be moved to their Ports
+    ProcessWireRerouteQueue();
+
+    // Save the Counts
+    DataStreamOut << (qint32)TextList.count();
+    DataStreamOut << (qint32)ComponentList.count();
+    DataStreamOut << (qint32)WireList.count();
+    DataStreamOut << (qint32)GroupList.count();
+
+    // Save the Items
+    foreach (GraphicItemText* Text, TextList) {
+        Text->SaveData(DataStreamOut);
+    }
+    foreach (GraphicItemComponent* Component, ComponentList) {
+        Component->SaveData(DataStreamOut);
+    }
+    foreach (GraphicItemWire* Wire, WireList) {
+        Wire->SaveData(DataStreamOut);
+    }
+    foreach (GraphicItemGroup* Group, GroupList) {
+        Group->SaveData(DataStreamOut);
+    }
+}
+
+bool WiringScene::LoadItemBatch(QDataStream& DataStreamIn, QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                                QList<GraphicItemGroup*>& GroupList, QList<GraphicItemText*>& TextList)
+{
+    int                   x;
+    qint32                TextCount = 0;
+    qint32                ComponentCount = 0;
+    qint32                WireCount = 0;
+    qint32                GroupCount = 0;
+    QString               DefinitionName;
+    SubCircuitDefinition* Definition;
+    bool                  DefinitionMissing = false;
+
+    // Build the Items from the Saved Data (They are not added to the Scene)
+    ComponentList.clear();
+    WireList.clear();
+    GroupList.clear();
+    TextList.clear();
+
+    DataStreamIn >> TextCount;
+    DataStreamIn >> ComponentCount;
+    DataStreamIn >> WireCount;
+    DataStreamIn >> GroupCount;
+
+    for (x = 0; x < TextCount; x++) {
+        TextList.append(new GraphicItemText(DataStreamIn));
+    }
+    for (x = 0; x < ComponentCount; x++) {
+        ComponentList.append(new GraphicItemComponent(DataStreamIn, m_ItemMenu));
+    }
+    for (x = 0; x < WireCount; x++) {
+        WireList.append(new GraphicItemWire(DataStreamIn));
+    }
+    for (x = 0; x < GroupCount; x++) {
+        DataStreamIn >> DefinitionName;
+        Definition = m_SubCircuitDefinitionMap.value(DefinitionName, NULL);
+        if (Definition == NULL) {
+            DefinitionMissing = true;
+            break;
+        }
+        GroupList.append(new GraphicItemGroup(DataStreamIn, Definition, m_ItemMenu));
+    }
+
+    // The Batch is only rebuilt as a whole; If the Definition of a Group is gone (new project
+    // loaded) or the Data is bad, none of the Items are kept (The Wires go first, as in a delete)
+    if ((DefinitionMissing == true) || (DataStreamIn.status() != QDataStream::Ok)) {
+        qDeleteAll(WireList);
+        qDeleteAll(ComponentList);
+        qDeleteAll(GroupList);
+        qDeleteAll(TextList);
+        ComponentList.clear();
+        WireList.clear();
+        GroupList.clear();
+        TextList.clear();
+
+        if (DefinitionMissing == true) {
+            QMessageBox::warning(NULL, "Cannot Rebuild Deleted Items", QString("The Sub-Circuit Definition %1 no longer exists").arg(DefinitionName));
+        } else {
+            QMessageBox::warning(NULL, "Cannot Rebuild Deleted Items", "The Saved Data of the Deleted Items is not readable");
+        }
+        return false;
+    }
+    return true;
+}
+
+quint32 WiringScene::GetUndoItemId(QGraphicsItem* Item)
+{
+    quint32 ItemId = Item->data(UNDO_ITEMID_DATAKEY).toUInt();
+
+    // An Item is given its Id the first time a Command refers to it
+    if (ItemId == 0) {
+        ItemId = ++m_LastUndoItemId;
+        SetUndoItemId(Item, ItemId);
+    }
+    return ItemId;
+}
+
+void WiringScene::SetUndoItemId(QGraphicsItem* Item, quint32 ItemId)
+{
+    Item->setData(UNDO_ITEMID_DATAKEY, ItemId);
+    m_UndoItemMap.insert(ItemId, Item);
+}
+
+void WiringScene::ForgetUndoItem(QGraphicsItem* Item)
+{
+    quint32 ItemId;
+
+    // Must be called before an Item is destroyed (Its Id may already refer to a rebuilt Item)
+    if (Item == NULL) {
+        return;
+    }
+    ItemId = Item->data(UNDO_ITEMID_DATAKEY).toUInt();
+    if ((ItemId != 0) && (m_UndoItemMap.value(ItemId, NULL) == Item)) {
+        m_UndoItemMap.remove(ItemId);
+    }
+}
+
+bool WiringScene::CheckComponentReqsForBatch(SSTInfoDataComponent* ComponentInfo, int NumNewComponents)
+{
+    int AllowedInstances = ComponentInfo->GetAllowedNumberOfInstances();
+    SSTInfoDataComponent::ComponentType CompType = ComponentInfo->GetComponentType();
+    int NumItemsCreatedByType = m_GraphicItemComponentByTypeList[CompType].count();
+
+    // If the allowed number of instances is -1, then it is unlimited
+    if ((AllowedInstances >= 0) && (NumItemsCreatedByType + NumNewComponents > AllowedInstances)) {
+        QString MsgText = QString("Cannot Create %1 New Components Of Type:\n\n%2\n\nExceeded Creation Limit Of %3")
+                          .arg(NumNewComponents).arg(SSTInfoDataComponent::GetComponentTypeName(CompType)).arg(AllowedInstances);
+        QMessageBox::warning(NULL, "Cannot Create New Component", MsgText);
+        return false;
+    }
+    return true;
+}
+
+GraphicItemComponent* WiringScene::CreateGeneratedComponent(SSTInfoDataComponent* ComponentInfo, QString PortName, int NumPorts, QList<GraphicItemPort*>& PortList)
+{
+    QString               Key;
+    int                   IndexValue;
+    GraphicItemComponent* NewComponent;
+    PortInfoData*         PortInfo;
+    int                   x;
+
+    PortList.clear();
+
+    // Get the Index Value based on key <element>.<component> and increment it.
+    Key = BuildComponentKey(ComponentInfo->GetParentElementName(), ComponentInfo->GetComponentName());
+    IndexValue = m_CurrentComponentByKeyIndex.value(Key);  // If not in map, default will be 0
+    m_CurrentComponentByKeyIndex.insert(Key, ++IndexValue); // Increment value and put back into map
+
+    // Create the Component (It is positioned later)
+    NewComponent = new GraphicItemComponent(IndexValue, ComponentInfo, m_ItemMenu, m_ItemComponentFillColor, QPointF(0, 0));
+
+    // Set the number of Port Instances (Static Ports always have exactly 1)
+    PortInfo = NewComponent->FindPortInfoData(PortName);
+    if (PortInfo == NULL) {
+        return NewComponent;
+    }
+    if (PortInfo->IsPortDynamic() == true) {
+        NewComponent->SetDynamicPortNumInstances(PortInfo, NumPorts);
+
+        // Each Instance is wired on its own, so the Port cannot be shown as a Bus
+        if (PortInfo->IsPortBus() == true) {
+            PortInfo->SetPortBus(false);
+            NewComponent->UpdateVisualLayoutOfComponent();
+        }
+    }
+
+    // Collect the Graphical Ports of the Port in Instance order
+    for (x = 0; (x < PortInfo->GetNumGraphicalPorts()) && (x < NumPorts); x++) {
+        PortList.append(PortInfo->GetGraphicalPort(x));
+    }
+
+    return NewComponent;
+}
+
+void WiringScene::CreateParameterSetFromSelection(QString SetName, GraphicItemComponent* SourceComponent)
+{
+    ParameterSet*          NewParameterSet;
+    GraphicItemComponent*  Component;
+    QList<ItemProperties*> PropertiesList;
+
+    // Capture the Parameters of the Source Component
+    NewParameterSet = new ParameterSet(SetName, SourceComponent->GetItemProperties());
+    m_ParameterSetMap.insert(SetName, NewParameterSet);
+
+    // Every selected Component of the same type references the new Set
+    foreach (QGraphicsItem* Item, selectedItems()) {
+        Component = qgraphicsitem_cast<GraphicItemComponent*>(Item);
+        if ((Component != NULL) && (NewParameterSet->IsCompatibleWith(Component->GetItemProperties()) == true)) {
+            // Components from older projects do not have the Parameter Set property yet
+            if (Component->GetItemProperties()->GetProperty(PROPKEY_COMPONENT_PARAMSET) == NULL) {
+                Component->GetItemProperties()->AddProperty(COMPONENT_PROPERTY_PARAMSET, "", "Name of the Parameter Set used by the Component", ItemProperty::READWRITE, false);
+            }
+            PropertiesList.append(Component->GetItemProperties());
+        }
+    }
+
+    // Reference the Set as one Undo step (The Set itself stays with the project)
+    if (PropertiesList.isEmpty() == false) {
+        SetPropertyValueOnItems(PropertiesList, COMPONENT_PROPERTY_PARAMSET, SetName);
+    }
+}
+
+void WiringScene::SetPropertyValueOnItems(QList<ItemProperties*> PropertiesList, QString PropertyName, QString NewValue)
+{
+    // Add this SET PROPERTY Command to the Undo/Redo Queue
+    // NOTE: QUndoCommand::redo() is called when pushing the command
+    //       onto the stack Which will set the Value on all the Items
+    ComandBase* SetPropertyValuesCommand = new ComandSetPropertyValues(PropertiesList, PropertyName, NewValue, this);
+    m_UndoStack->Push(SetPropertyValuesCommand);
+}
+
+void WiringScene::RefreshPropertiesWindow()
+{
+    // The Properties Window may be in the middle of an edit, rebuild it after this turn
+    m_PendingRefreshPropertiesWindow = true;
+    ScheduleNotificationDispatch();
+}
+
+void WiringScene::MoveItemToPosition(QGraphicsItem* Item, const QPointF& NewPos)
+{
+    // The Items ignore small moves that are not mouse drags, place them exactly
+    switch (Item->type()) {
+        case GraphicItemComponent::Type:
+            ((GraphicItemComponent*)Item)->MoveToPosition(NewPos);
+        break;
+
+        case GraphicItemGroup::Type:
+            ((GraphicItemGroup*)Item)->MoveToPosition(NewPos);
+        break;
+
+        case GraphicItemText::Type:
+            ((GraphicItemText*)Item)->MoveToPosition(NewPos);
+        break;
+
+        default:
+            Item->setPos(NewPos);
+        break;
+    }
+}
+
+void WiringScene::CommitComponentDynamicPortsChange(GraphicItemComponent* Component, QList<int>& OldPortsState,
+                                                    QList<GraphicItemComponent::PortWireConnection>& OldConnectionList)
+{
+    QList<int> NewPortsState = Component->GetDynamicPortsState();
+
+    // Nothing to undo if the Ports did not change
+    if (NewPortsState == OldPortsState) {
+        return;
+    }
+
+    // Add this SET DYNAMIC PORTS Command to the Undo/Redo Queue
+    // NOTE: The Ports are already set, redo() sets them to the same state
+    ComandBase* SetDynamicPortsCommand = new ComandSetDynamicPorts(Component, OldPortsState, NewPortsState, OldConnectionList, this);
+    m_UndoStack->Push(SetDynamicPortsCommand);
+}
+
+void WiringScene::HandleComponentPortsReordered(GraphicItemComponent* Component, QList<int> OldPortLayout)
+{
+    QList<int> NewPortLayout = Component->GetPortLayout();
+
+    // Add this REORDER PORTS Command to the Undo/Redo Queue
+    // NOTE: The Ports are already in place, redo() lays them out the same way
+    ComandBase* ReorderPortsCommand = new ComandReorderPorts(Component, OldPortLayout, NewPortLayout, this);
+    m_UndoStack->Push(ReorderPortsCommand);
+}
+
 void WiringScene::DeleteAllSelectedItems()
 {
     // Add this DELETE Command to the Undo/Redo Queue
     // NOTE: QUndoCommand::redo() is called when pushing the command
-    //       onto the stack Which will call DeleteWireFromScene(),
-    //       DeleteComponentFromScene() & DeleteTextFromScene() as many
-    //       times as necessary.
-    QUndoCommand* DeleteGraphicItemsCommand = new ComandDeleteGraphicItems(this);
-    m_UndoStack->push(DeleteGraphicItemsCommand);
+    //       onto the stack Which will call DeleteItemBatchFromScene()
+    //       once for all the Selected Items.
+    ComandBase* DeleteGraphicItemsCommand = new ComandDeleteGraphicItems(this);
+    m_UndoStack->Push(DeleteGraphicItemsCommand);
 }
 
 void WiringScene::DeleteWireFromScene(GraphicItemWire* ptrParentWire)
@@ -465,6 +1631,7 @@ void WiringScene::DeleteWireFromScene(GraphicItemWire* ptrParentWire)
     ptrParentWire->DisconnectAllAttachedPorts();
 
     // Delete the Parent Wire
+    UntrackTopLevelItemBounds(ptrParentWire);
     removeItem(ptrParentWire);
 
     // Remove the Wire from the WireList
@@ -493,6 +1660,7 @@ void WiringScene::DeleteComponentFromScene(GraphicItemComponent* ptrComponent)
     ptrComponent->DisconnectPortsFromAllWires();
 
     // Delete Component
+    UntrackTopLevelItemBounds(ptrComponent);
     removeItem(ptrComponent);
 
     // Remove the Component from the ComponentList & ComponentTypeList
@@ -516,9 +1684,29 @@ void WiringScene::DeleteComponentFromScene(GraphicItemComponent* ptrComponent)
     emit SceneEventGraphicItemSelectedProperties(NULL);
 }
 
+void WiringScene::DeleteGroupFromScene(GraphicItemGroup* ptrGroup)
+{
+    // Disconnect any Wires from the Group
+    ptrGroup->DisconnectPortsFromAllWires();
+
+    // Delete Group
+    UntrackTopLevelItemBounds(ptrGroup);
+    removeItem(ptrGroup);
+
+    // Remove the Group from the GroupList
+    m_GraphicItemGroupList.removeOne(ptrGroup);
+
+    // NOTE: OBJECT IS CONTAINED IN THE ADD COMMAND and will be deleted there upon destruction
+
+    // De-Select all Items & Turn off the properties display
+    emit SceneEventGraphicItemSelected(NULL);
+    emit SceneEventGraphicItemSelectedProperties(NULL);
+}
+
 void WiringScene::DeleteTextFromScene(GraphicItemText* ptrText)
 {
     // Delete Text Item
+    UntrackTopLevelItemBounds(ptrText);
     removeItem(ptrText);
 
     // NOTE: OBJECT IS CONTAINED IN THE ADD COMMAND and will be deleted there upon destruction
@@ -530,12 +1718,18 @@ void WiringScene::DeleteTextFromScene(GraphicItemText* ptrText)
 
 void WiringScene::SaveData(QDataStream& DataStreamOut)
 {
-    GraphicItemText*       Text;
-    GraphicItemComponent*  Component;
-    GraphicItemWire*       Wire;
-    qint32                 TextCount = 0;
-    qint32                 ComponentCount = 0;
-    qint32                 WireCount = 0;
+    GraphicItemText*              Text;
+    GraphicItemComponent*         Component;
+    GraphicItemGroup*             Group;
+    GraphicItemWire*              Wire;
+    QList<SubCircuitDefinition*>  UsedDefinitionList;
+    qint32                        TextCount = 0;
+    qint32                        ComponentCount = 0;
+    qint32                        GroupCount = 0;
+    qint32                        WireCount = 0;
+
+    // Make sure no Wires are waiting to be moved to their Ports
+    ProcessWireRerouteQueue();
 
     // Get a list of all graphic Items
     QList<QGraphicsItem*> GraphicItems = items();
@@ -544,6 +1738,7 @@ void WiringScene::SaveData(QDataStream& DataStreamOut)
     foreach (QGraphicsItem* Item, GraphicItems) {
         // Cast to a pointer, if the cast is invalid, the pointer will be NULL
         Component = qgraphicsitem_cast<GraphicItemComponent*>(Item);
+        Group = qgraphicsitem_cast<GraphicItemGroup*>(Item);
         Text = qgraphicsitem_cast<GraphicItemText*>(Item);
         Wire = qgraphicsitem_cast<GraphicItemWire*>(Item);
 
@@ -553,20 +1748,35 @@ void WiringScene::SaveData(QDataStream& DataStreamOut)
         if (Component != NULL) {
             ComponentCount++;
         }
+        if (Group != NULL) {
+            GroupCount++;
+
+            // Only the Definitions that are used by Groups in the scene are saved
+            if (UsedDefinitionList.contains(Group->GetSubCircuitDefinition()) == false) {
+                UsedDefinitionList.append(Group->GetSubCircuitDefinition());
+            }
+        }
         if (Wire != NULL) {
             WireCount++;
         }
     }
 
     // Save the Counts
+    DataStreamOut << (qint32)UsedDefinitionList.count();
     DataStreamOut << TextCount;
     DataStreamOut << ComponentCount;
+    DataStreamOut << GroupCount;
     DataStreamOut << WireCount;
 
     // Save the Current Item Index's
     DataStreamOut << (qint32)m_CurrentWireIndex;
     DataStreamOut << m_CurrentComponentByKeyIndex;
 
+    // Save all the Sub-Circuit Definitions (Before any Groups that use them)
+    foreach (SubCircuitDefinition* Definition, UsedDefinitionList) {
+        Definition->SaveData(DataStreamOut);
+    }
+
     // Save all the Text Items
     foreach (QGraphicsItem* Item, GraphicItems) {
         // Cast to a pointer, if the cast is invalid, the pointer will be NULL
@@ -585,6 +1795,16 @@ void WiringScene::SaveData(QDataStream& DataStreamOut)
         }
     }
 
+    // Save all the Group Items (and sub items)
+    // NOTE: Groups are saved before the Wires so the Wires can connect to the Group Ports on load
+    foreach (QGraphicsItem* Item, GraphicItems) {
+        // Cast to a pointer, if the cast is invalid, the pointer will be NULL
+        Group = qgraphicsitem_cast<GraphicItemGroup*>(Item);
+        if (Group != NULL) {
+            Group->SaveData(DataStreamOut);
+        }
+    }
+
     // Save all the Wire Items (and sub items)
     foreach (QGraphicsItem* Item, GraphicItems) {
         // Cast to a pointer, if the cast is invalid, the pointer will be NULL
@@ -593,14 +1813,25 @@ void WiringScene::SaveData(QDataStream& DataStreamOut)
             Wire->SaveData(DataStreamOut);
         }
     }
+
+    // Save all the Parameter Sets
+    DataStreamOut << (qint32)m_ParameterSetMap.count();
+    foreach (ParameterSet* Set, m_ParameterSetMap) {
+        Set->SaveData(DataStreamOut);
+    }
 }
 
-void WiringScene::LoadData(QDataStream& DataStreamIn)
+void WiringScene::LoadData(QDataStream& DataStreamIn, qint32 FileVersion)
 {
     int                    x;
+    qint32                 DefinitionCount = 0;
     qint32                 TextCount = 0;
     qint32                 ComponentCount = 0;
+    qint32                 GroupCount = 0;
     qint32                 WireCount = 0;
+    qint32                 ParameterSetCount = 0;
+    SubCircuitDefinition*  NewDefinition;
+    ParameterSet*          NewParameterSet;
 
     // Reset the Scene
     SetOperationMode(MODE_SELECTMOVEITEM);
@@ -610,24 +1841,50 @@ void WiringScene::LoadData(QDataStream& DataStreamIn)
     for (x = 0; x < NUMCOMPONENTTYPES; x++) {
         m_GraphicItemComponentByTypeList[x].clear();
     }
+    m_GraphicItemGroupList.clear();
     m_CurrentWireIndex = 0;
     m_CurrentComponentByKeyIndex.clear();
 
+    // NOTE: Like the removed items below, the old Sub-Circuit Definitions are not
+    //       deleted as Commands on the Undo Stack may still refer to them.
+    m_SubCircuitDefinitionMap.clear();
+
+    // Parameter Sets are only referenced by name, so they can be deleted
+    qDeleteAll(m_ParameterSetMap);
+    m_ParameterSetMap.clear();
+
     // Remove all items from the scene
     QList<QGraphicsItem*> GraphicItems = items();
     foreach (QGraphicsItem* Item, GraphicItems) {
         removeItem(Item);
     }
+    m_TopLevelItemRectMap.clear();
+    m_PortCellHash.clear();
+    m_PortOwnerCellKeyMap.clear();
+    m_WireRouter.ClearObstacles();
+    m_WireBundleMap.clear();
+    m_WireBundleKeyMap.clear();
+    m_PendingWireBundleKeySet.clear();
+    m_TopLevelItemsBounds = QRectF();
+    m_TopLevelItemsBoundsValid = true;
 
     // Get the number of each type of Items
+    DataStreamIn >> DefinitionCount;
     DataStreamIn >> TextCount;
     DataStreamIn >> ComponentCount;
+    DataStreamIn >> GroupCount;
     DataStreamIn >> WireCount;
 
     // Load the Current Item Index's
     DataStreamIn >> m_CurrentWireIndex;
     DataStreamIn >> m_CurrentComponentByKeyIndex;
 
+    // Load all the Sub-Circuit Definitions
+    for (x = 0; x < DefinitionCount; x++) {
+        NewDefinition = new SubCircuitDefinition(DataStreamIn);
+        m_SubCircuitDefinitionMap.insert(NewDefinition->GetDefinitionName(), NewDefinition);
+    }
+
     // Build all the Text Items
     for (x = 0; x < TextCount; x++) {
         CreateNewTextItem(DataStreamIn);
@@ -638,10 +1895,24 @@ void WiringScene::LoadData(QDataStream& DataStreamIn)
         CreateNewComponentItem(DataStreamIn);
     }
 
+    // Build all the Group Items
+    for (x = 0; x < GroupCount; x++) {
+        CreateNewGroupItem(DataStreamIn);
+    }
+
     // Build all the Wire Items
     for (x = 0; x < WireCount; x++) {
         CreateNewWireItem(DataStreamIn);
     }
+
+    // Load all the Parameter Sets (Older projects do not have any)
+    if (FileVersion >= SSTWORKBENCHPROJECTFILEPARAMSETSVERSION) {
+        DataStreamIn >> ParameterSetCount;
+    }
+    for (x = 0; x < ParameterSetCount; x++) {
+        NewParameterSet = new ParameterSet(DataStreamIn);
+        m_ParameterSetMap.insert(NewParameterSet->GetSetName(), NewParameterSet);
+    }
 }
 
 void WiringScene::mousePressEvent(QGraphicsSceneMouseEvent* mouseEvent)
@@ -657,6 +1928,9 @@ void WiringScene::mousePressEvent(QGraphicsSceneMouseEvent* mouseEvent)
         return;
     }
 
+    // Each press starts a new drag, its Commands do not merge with the last drag's
+    BeginUndoGesture();
+
     // Get the Operation Mode
     CurrentOperationMode = GetOperationMode();
 
@@ -719,37 +1993,30 @@ void WiringScene::mousePressEvent(QGraphicsSceneMouseEvent* mouseEvent)
                 if (SelectedItem->type() >= QGraphicsItem::UserType) {
                     QGraphicsItem*         GraphicItem = NULL;
                     GraphicItemBase*       BaseItem = NULL;
-                    GraphicItemWireHandle* WireHandle = NULL;
 
-                    // See if we can cast the item to a wire handle, Note: the cast will return
+                    // See if we can cast the item to one of our items, Note: the cast will return
                     // NULL if SelectedItem is not of the correct type that we are casting to
-                    if (mouseEvent->button() == Qt::LeftButton) { // Select WireHandles with LEFT Button only
-                        WireHandle = qgraphicsitem_cast<GraphicItemWireHandle*>(SelectedItem);
-                        if (WireHandle != NULL) {
-                            // We got a wire handle, but we actually need the wire that the wire handle is connected to.
-                            // Get the actual Wire that is connected to this wire handle and return it as the base item
-                            BaseItem = WireHandle->GetConnectedWire();
-                            GraphicItem = WireHandle;
-                        }
-                    }
-                    // If Item is not a WireHandle, is it one of the other items
                     if (BaseItem == NULL) {  // Select Components with LEFT or RIGHT Button
                         BaseItem = qgraphicsitem_cast<GraphicItemComponent*>(SelectedItem);
                         GraphicItem = qgraphicsitem_cast<GraphicItemComponent*>(SelectedItem);
                     }
-                    if (mouseEvent->button() == Qt::LeftButton) {  // Select WireLineSegments, Wires, Ports and Text with LEFT Button only
-                        if (BaseItem == NULL) {
-                            BaseItem = qgraphicsitem_cast<GraphicItemWireLineSegment*>(SelectedItem);
-                            GraphicItem = qgraphicsitem_cast<GraphicItemWireLineSegment*>(SelectedItem);
+                    if (BaseItem == NULL) {  // Select Groups with LEFT or RIGHT Button
+                        BaseItem = qgraphicsitem_cast<GraphicItemGroup*>(SelectedItem);
+                        GraphicItem = qgraphicsitem_cast<GraphicItemGroup*>(SelectedItem);
+                    }
+                    if (mouseEvent->button() == Qt::LeftButton) {  // Select Ports with LEFT Button only
+                        // Ports are drawn by their Component or Group, see if the click landed on one
+                        GraphicItemPort* Port = GraphicItemPort::GetOwnersPortAtScenePoint(SelectedItem, mouseEvent->scenePos());
+                        if (Port != NULL) {
+                            BaseItem = Port;
+                            GraphicItem = NULL;
                         }
+                    }
+                    if (mouseEvent->button() == Qt::LeftButton) {  // Select Wires (and their Handles) and Text with LEFT Button only
                         if (BaseItem == NULL) {
                             BaseItem = qgraphicsitem_cast<GraphicItemWire*>(SelectedItem);
                             GraphicItem = qgraphicsitem_cast<GraphicItemWire*>(SelectedItem);
                         }
-                        if (BaseItem == NULL) {
-                            BaseItem = qgraphicsitem_cast<GraphicItemPort*>(SelectedItem);
-                            GraphicItem = qgraphicsitem_cast<GraphicItemPort*>(SelectedItem);
-                        }
                         if (BaseItem == NULL) {
                             BaseItem = qgraphicsitem_cast<GraphicItemText*>(SelectedItem);
                             GraphicItem = qgraphicsitem_cast<GraphicItemText*>(SelectedItem);
@@ -778,27 +2045,25 @@ void WiringScene::mousePressEvent(QGraphicsSceneMouseEvent* mouseEvent)
 
                 // See if we clicked on anything
                 if (PointItems.count() > 0) {
-                    // Check to see if the top Item is a Wire Handle
-                    // Cast the first item in the items list to a GraphicItemWireHandle (or NULL if this item is not a Wire Handle)
-                    m_ptrMovingItemWireHandle = qgraphicsitem_cast<GraphicItemWireHandle*>(PointItems.first());
+                    // Check to see if the top Item is a Wire, and the point is on one of its Handles
+                    // Cast the first item in the items list to a GraphicItemWire (or NULL if this item is not a Wire)
+                    m_ptrMovingItemWire = qgraphicsitem_cast<GraphicItemWire*>(PointItems.first());
+                    m_ptrMovingItemWireHandle = NULL;
+                    if (m_ptrMovingItemWire != NULL) {
+                        m_ptrMovingItemWireHandle = m_ptrMovingItemWire->GetWireHandleAtScenePoint(mouseEvent->scenePos());
+                    }
 
-                    // Now figure out the Actual Wire that the WireHandle is attached to
                     if (m_ptrMovingItemWireHandle != NULL) {
-                        m_ptrMovingItemWire = qgraphicsitem_cast<GraphicItemWire*>(m_ptrMovingItemWireHandle->parentItem());
-                        // Final Check
-                        if (m_ptrMovingItemWire != NULL) {
-                            // Deselect any other items that might be selected
-                            SetSingleGraphicItemAsSelected(NULL);
-                            // Force select of moving wire wire
-                            m_ptrMovingItemWire->SetWireSelected(true);
-                        } else {
-                            // Opps, we have a handle, but not a wire... Something is screwed up
-                            m_ptrMovingItemWireHandle = NULL;
-                            QMessageBox::critical(NULL, "CODING ERROR", "SCENE MOUSE PRESS - WIRE HANDLE CANNOT FIND WIRE");
-                        }
+                        // Deselect any other items that might be selected
+                        SetSingleGraphicItemAsSelected(NULL);
+                        // Force select of moving wire wire
+                        m_ptrMovingItemWire->SetWireSelected(true);
 
                         // Now change the operation move to Moving a Wire Handle
                         SetOperationMode(MODE_MOVEWIREHANDLE);
+                    } else {
+                        // Clicked on the Wire, but not on a Handle
+                        m_ptrMovingItemWire = NULL;
                     }
                 }
             }
@@ -822,6 +2087,18 @@ void WiringScene::mousePressEvent(QGraphicsSceneMouseEvent* mouseEvent)
     if ((GetOperationMode() != MODE_MOVEWIREHANDLE) && (GetOperationMode() != MODE_ADDWIRE)) {
         QGraphicsScene::mousePressEvent(mouseEvent);
     }
+
+    // Remember where the selected Items start, they may be dragged
+    m_MovingItemList.clear();
+    m_MovingItemStartPosList.clear();
+    if ((GetOperationMode() == MODE_SELECTMOVEITEM) && (mouseEvent->button() == Qt::LeftButton)) {
+        foreach (QGraphicsItem* Item, selectedItems()) {
+            if ((Item->type() == GraphicItemComponent::Type) || (Item->type() == GraphicItemGroup::Type) || (Item->type() == GraphicItemText::Type)) {
+                m_MovingItemList.append(Item);
+                m_MovingItemStartPosList.append(Item->pos());
+            }
+        }
+    }
 }
 
 void WiringScene::mouseMoveEvent(QGraphicsSceneMouseEvent* mouseEvent)
@@ -851,6 +2128,10 @@ void WiringScene::mouseMoveEvent(QGraphicsSceneMouseEvent* mouseEvent)
 
 void WiringScene::mouseReleaseEvent(QGraphicsSceneMouseEvent* mouseEvent)
 {
+    QList<QGraphicsItem*> MovedItemList;
+    QList<QPointF>        OldPosList;
+    QList<QPointF>        NewPosList;
+
     // Are we Currently Adding a Wire (correct mode and the m_ptrNewItemWire exists)
     if (GetOperationMode() == MODE_ADDWIRE && m_ptrNewItemWire != 0) {
 
@@ -876,6 +2157,24 @@ void WiringScene::mouseReleaseEvent(QGraphicsSceneMouseEvent* mouseEvent)
 
     // Call the default handler
     QGraphicsScene::mouseReleaseEvent(mouseEvent);
+
+    // The dragged Items have been dropped, make the Move undoable
+    for (int x = 0; x < m_MovingItemList.count(); x++) {
+        if (m_MovingItemList.at(x)->pos() != m_MovingItemStartPosList.at(x)) {
+            MovedItemList.append(m_MovingItemList.at(x));
+            OldPosList.append(m_MovingItemStartPosList.at(x));
+            NewPosList.append(m_MovingItemList.at(x)->pos());
+        }
+    }
+    m_MovingItemList.clear();
+    m_MovingItemStartPosList.clear();
+
+    if (MovedItemList.isEmpty() == false) {
+        // Add this MOVE Command to the Undo/Redo Queue
+        // NOTE: The Items are already in place, redo() moves them to the same positions
+        ComandBase* MoveGraphicItemsCommand = new ComandMoveGraphicItems(MovedItemList, OldPosList, NewPosList, this);
+        m_UndoStack->Push(MoveGraphicItemsCommand);
+    }
 }
 
 void WiringScene::dragEnterEvent(QGraphicsSceneDragDropEvent* event)
@@ -912,6 +2211,113 @@ void WiringScene::dropEvent(QGraphicsSceneDragDropEvent* event)
     emit SceneEventDragAndDropFinished();
 }
 
+void WiringScene::HandleItemSetProjectDirty()
+{
+    // Items can report dirty many times per mouse move (e.g. dragging a large selection),
+    // just remember it and tell the Main Window once when this event loop turn is done
+    m_PendingProjectDirty = true;
+    ScheduleNotificationDispatch();
+}
+
+void WiringScene::HandleItemRefreshPropertiesWindowProperty(QString PropertyName, QString NewPropertyValue)
+{
+    // Only the latest value of each Property needs to be refreshed
+    if (m_PendingRefreshPropertyValueMap.contains(PropertyName) == false) {
+        m_PendingRefreshPropertyNameList.append(PropertyName);
+    }
+    m_PendingRefreshPropertyValueMap.insert(PropertyName, NewPropertyValue);
+    ScheduleNotificationDispatch();
+}
+
+void WiringScene::ScheduleNotificationDispatch()
+{
+    // Only one dispatch is queued at a time
+    if (m_NotificationDispatchScheduled == false) {
+        m_NotificationDispatchScheduled = true;
+        QTimer::singleShot(0, this, SLOT(DispatchPendingNotifications()));
+    }
+}
+
+void WiringScene::DispatchPendingNotifications()
+{
+    QStringList            RefreshPropertyNameList;
+    QMap<QString, QString> RefreshPropertyValueMap;
+    bool                   ProjectDirty;
+    bool                   RefreshPropertiesWindow;
+
+    // Take the pending notifications first, the handlers may cause new ones
+    ProjectDirty = m_PendingProjectDirty;
+    RefreshPropertiesWindow = m_PendingRefreshPropertiesWindow;
+    RefreshPropertyNameList = m_PendingRefreshPropertyNameList;
+    RefreshPropertyValueMap = m_PendingRefreshPropertyValueMap;
+
+    m_NotificationDispatchScheduled = false;
+    m_PendingProjectDirty = false;
+    m_PendingRefreshPropertiesWindow = false;
+    m_PendingRefreshPropertyNameList.clear();
+    m_PendingRefreshPropertyValueMap.clear();
+
+    // A full refresh covers the single Property refreshes
+    if (RefreshPropertiesWindow == true) {
+        emit SceneEventRefreshAllPropertiesWindow();
+    } else {
+        foreach (QString PropertyName, RefreshPropertyNameList) {
+            emit SceneEventRefreshPropertiesWindowProperty(PropertyName, RefreshPropertyValueMap.value(PropertyName));
+        }
+    }
+
+    if (ProjectDirty == true) {
+        emit SceneEventSetProjectDirty();
+    }
+}
+
+void WiringScene::HandleWireRerouteQueued(GraphicItemWire* Wire)
+{
+    // Add the Wire to the queue (A Wire only asks once until it is rerouted)
+    m_WireRerouteQueue.append(QPointer<GraphicItemWire>(Wire));
+
+    // Start the frame timer if it is not already running
+    if (m_WireRerouteTimer->isActive() == false) {
+        m_WireRerouteTimer->start();
+    }
+}
+
+void WiringScene::ProcessWireRerouteQueue()
+{
+    QList<QPointer<GraphicItemWire> > RerouteQueue;
+    int                               RerouteRate;
+
+    m_WireRerouteTimer->stop();
+
+    // Take the Queue, Rerouting may cause other Wires to be queued for the next frame
+    RerouteQueue = m_WireRerouteQueue;
+    m_WireRerouteQueue.clear();
+    if (RerouteQueue.isEmpty() == true) {
+        return;
+    }
+
+    // Start a new measurement period if we have been idle
+    if ((m_WireRerouteRateTimer.isValid() == false) || (m_WireRerouteRateTimer.elapsed() > 2 * WIRE_REROUTE_RATE_PERIOD)) {
+        m_WireRerouteRateTimer.start();
+        m_WireReroutesThisPeriod = 0;
+    }
+
+    // Reroute each Wire once (Wires deleted since they were queued are NULL)
+    foreach (QPointer<GraphicItemWire> Wire, RerouteQueue) {
+        if ((Wire.isNull() == false) && (Wire->ProcessQueuedReroute() == true)) {
+            m_WireReroutesThisPeriod++;
+        }
+    }
+
+    // Report the Reroutes per second
+    if (m_WireRerouteRateTimer.elapsed() >= WIRE_REROUTE_RATE_PERIOD) {
+        RerouteRate = (int)((qint64)m_WireReroutesThisPeriod * 1000 / m_WireRerouteRateTimer.elapsed());
+        emit SceneEventWireReroutesPerSecond(RerouteRate);
+        m_WireRerouteRateTimer.start();
+        m_WireReroutesThisPeriod = 0;
+    }
+}
+
 void WiringScene::SetSingleGraphicItemAsSelected(QGraphicsItem* NewItem)
 {
     // Clear all selected item and then select only the NewItem
@@ -933,5 +2339,8 @@ void WiringScene::HandleTextEditorLostFocus(GraphicItemText* item)
     if (item->toPlainText().isEmpty()) {
         item->setPlainText(TEXT_EMPTYTEXTSTRING);
     }
+
+    // Editing may have changed the size of the Text
+    TrackTopLevelItemBounds(item);
 }
 
@@ -24,13 +24,27 @@
 #include "GraphicItemComponent.h"
 #include "GraphicItemWire.h"
 #include "GraphicItemText.h"
+#include "GraphicItemGroup.h"
+#include "SubCircuitDefinition.h"
+#include "ParameterSet.h"
+#include "TopologyGenerator.h"
 #include "SSTInfoData.h"
 #include "UndoRedoCommands.h"
+#include "UndoRedoStack.h"
 
 /////////////////////////////////////////////////////////////////////
-// In the WiringScene, An Item is either a Component, Wire or Text
+// In the WiringScene, An Item is either a Component, Group, Wire or Text
 /////////////////////////////////////////////////////////////////////
 
+// Forward declarations to allow compile
+class ComandBase;
+
+// The Wires between the same two Components or Groups are a Bundle (Keyed by the pair of Items)
+typedef QPair<QGraphicsItem*, QGraphicsItem*> WireBundleKey;
+
+// A Port in the Port Spatial Hash (Its Owner and its Index in the Graphical Port Array of the Owner)
+typedef QPair<QGraphicsItem*, int> PortCellEntry;
+
 class WiringScene : public QGraphicsScene
 {
     Q_OBJECT
@@ -39,7 +53,7 @@ public:
     enum OperationMode {MODE_DONOTHING, MODE_SELECTMOVEITEM, MODE_MOVEWIREHANDLE, MODE_ADDCOMPONENT, MODE_ADDWIRE, MODE_ADDTEXT};
 
     // Constructor / Destructor
-    explicit WiringScene(QMenu* ItemMenu, QUndoStack* UndoStack, QObject* parent = 0);
+    explicit WiringScene(QMenu* ItemMenu, UndoRedoStack* UndoStack, QObject* parent = 0);
     ~WiringScene();
 
     // Set / Get the Operation Mode and What Component user has currently choosen
@@ -60,12 +74,33 @@ public:
     void RemoveComponentFromComponentTypeList(GraphicItemComponent* Component);
     QString BuildComponentKey(QString ElementName, QString ComponentName);
 
+    // Rendering Cache for the Components
+    void SetComponentRenderCaching(bool Enable);
+
+    // Bounds of all the Top Level Items (Maintained as items are added, moved or removed)
+    QRectF GetItemsBoundingRect();
+    bool   IsSceneEmpty() {return m_TopLevelItemRectMap.isEmpty();}
+
+    // The Top Level Items (Components, Wires, Groups & Text) and the ones that are Selected
+    QList<QGraphicsItem*> GetTopLevelItems() {return m_TopLevelItemRectMap.keys();}
+    QList<QGraphicsItem*> GetSelectedTopLevelItems();
+    QRectF                GetSelectedItemsBoundingRect();
+
+    // Ports whose Connection Point is at a Scene Point (Found through the Spatial Hash of Port Owners)
+    QList<GraphicItemPort*> GetPortsAtScenePoint(const QPointF& ScenePoint);
+
     // Selections
     void SetNothingSelected();
+    void SetAllSelected();
 
     // Refresh Wires
     void RefreshAllCurrentWirePositions();
 
+    // Orthogonal Routing of the Wires around the Components and Groups
+    WireRouter* GetWireRouter() {return &m_WireRouter;}
+    void SetAutoRouteNewWires(bool Enable) {m_AutoRouteNewWires = Enable;}
+    void RerouteAllWires();
+
     // Create New Graphic Item Component
     QString CheckComponentReqsAndBuildKey(int AllowedInstances, SSTInfoDataComponent::ComponentType CompType, QString ParentElementName, QString ComponentName);
     void CreateNewComponentItem(QPointF ScenePos);
@@ -85,15 +120,76 @@ public:
     void PasteNewWireItem(QDataStream& DataStreamIn, int PasteOffset);   // From Copy/Paste
     void AddNewWireItemToScene(GraphicItemWire* NewWireItem, bool UpdateBothPoints);
 
+    // Sub-Circuits (Groups)
+    bool CreateSubCircuitFromSelection(QString DefinitionName);
+    bool IsSubCircuitDefinitionNameUsed(QString DefinitionName) {return m_SubCircuitDefinitionMap.contains(DefinitionName);}
+    void CreateNewGroupItem(QDataStream& DataStreamIn);  // From Serialization
+    void PasteNewGroupItem(QDataStream& DataStreamIn, int PasteOffset);   // From Copy/Paste
+    void AddNewGroupItemToScene(GraphicItemGroup* NewGroupItem, bool SelectSingle = true);
+
+    // Parameter Sets (Named Parameter Values shared by many Components)
+    bool IsParameterSetNameUsed(QString SetName) {return m_ParameterSetMap.contains(SetName);}
+    ParameterSet* GetParameterSet(QString SetName) {return m_ParameterSetMap.value(SetName, NULL);}
+    void CreateParameterSetFromSelection(QString SetName, GraphicItemComponent* SourceComponent);
+
+    // Generated Topologies (All Components and Wires are added / removed as one batch)
+    bool GenerateTopology(TopologyGenerator* Generator, SSTInfoDataComponent* RouterInfo, QString RouterPortName,
+                          SSTInfoDataComponent* EndpointInfo, QString EndpointPortName, QPointF StartPos);
+    void AddItemBatchToScene(QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                             const QList<GraphicItemGroup*>& GroupList = QList<GraphicItemGroup*>(),
+                             const QList<GraphicItemText*>& TextList = QList<GraphicItemText*>());
+    void DeleteItemBatchFromScene(QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                                  const QList<GraphicItemGroup*>& GroupList = QList<GraphicItemGroup*>(),
+                                  const QList<GraphicItemText*>& TextList = QList<GraphicItemText*>());
+
+    // Serialization of a batch of Items (Used to keep Deleted Items compact for Undo)
+    void SaveItemBatch(QDataStream& DataStreamOut, QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                       QList<GraphicItemGroup*>& GroupList, QList<GraphicItemText*>& TextList);
+    bool LoadItemBatch(QDataStream& DataStreamIn, QList<GraphicItemComponent*>& ComponentList, QList<GraphicItemWire*>& WireList,
+                       QList<GraphicItemGroup*>& GroupList, QList<GraphicItemText*>& TextList);
+
+    // Undo Item Ids; The Undo Commands refer to Items by Id, so an Item destroyed by a Delete Command
+    // and rebuilt on undo is found again once the rebuilt Item is given its old Id (0 is no Id)
+    quint32 GetUndoItemId(QGraphicsItem* Item);
+    QGraphicsItem* GetUndoItem(quint32 ItemId) {return m_UndoItemMap.value(ItemId, NULL);}
+    void SetUndoItemId(QGraphicsItem* Item, quint32 ItemId);
+    void ForgetUndoItem(QGraphicsItem* Item);
+
+    // Set a Property Value on many Items as one Undo step
+    void SetPropertyValueOnItems(QList<ItemProperties*> PropertiesList, QString PropertyName, QString NewValue);
+
+    // Rebuild the Properties Window once this event loop turn is done
+    void RefreshPropertiesWindow();
+
+    // Undoable Moves and Port changes
+    void MoveItemToPosition(QGraphicsItem* Item, const QPointF& NewPos);
+    void CommitComponentDynamicPortsChange(GraphicItemComponent* Component, QList<int>& OldPortsState,
+                                           QList<GraphicItemComponent::PortWireConnection>& OldConnectionList);
+
+    // Commands pushed during the same Gesture (One mouse drag, One dialog) may merge together
+    void BeginUndoGesture() {m_UndoGestureSerial++;}
+    int GetUndoGestureSerial() {return m_UndoGestureSerial;}
+
     // Delete Handling
     void DeleteAllSelectedItems();
     void DeleteWireFromScene(GraphicItemWire* ptrParentWire);
     void DeleteComponentFromScene(GraphicItemComponent* ptrComponent);
     void DeleteTextFromScene(GraphicItemText* ptrText);
+    void DeleteGroupFromScene(GraphicItemGroup* ptrGroup);
 
     // Serialization
     void SaveData(QDataStream& DataStreamOut);
-    void LoadData(QDataStream& DataStreamIn);
+    void LoadData(QDataStream& DataStreamIn, qint32 FileVersion);
+
+public slots:
+    // Send any Dirty / Refresh notifications that are waiting for the end of the event loop turn
+    void DispatchPendingNotifications();
+
+    // Reroute all the Wires whose Ports have moved since the last frame
+    void ProcessWireRerouteQueue();
+
+    // Redraw the Bundles whose Wires have changed
+    void UpdatePendingWireBundles();
 
 signals:
     // Signals to notify Main Window of Events that happen
@@ -107,7 +203,9 @@ signals:
     void SceneEventSetProjectDirty();
     void SceneEventRefreshPropertiesWindowProperty(QString, QString);
     void SceneEventRefreshPropertiesWindow(ItemProperties*);
+    void SceneEventRefreshAllPropertiesWindow();
     void SceneEventDragAndDropFinished();
+    void SceneEventWireReroutesPerSecond(int ReroutesPerSecond);
 
 private:
     // Mouse Handling Events
@@ -124,13 +222,49 @@ private:
     // Set a Graphic Item Selected
     void SetSingleGraphicItemAsSelected(QGraphicsItem* NewItem);
 
+    // Support for Generated Topologies
+    bool CheckComponentReqsForBatch(SSTInfoDataComponent* ComponentInfo, int NumNewComponents);
+    GraphicItemComponent* CreateGeneratedComponent(SSTInfoDataComponent* ComponentInfo, QString PortName, int NumPorts, QList<GraphicItemPort*>& PortList);
+
+    // Coalesced Notifications
+    void ScheduleNotificationDispatch();
+
+    // Top Level Item Bounds Tracking
+    void TrackTopLevelItemBounds(QGraphicsItem* Item);
+    void UntrackTopLevelItemBounds(QGraphicsItem* Item);
+    bool IsRectOnItemsBoundsEdge(const QRectF& ItemRect);
+
+    // Port Spatial Hash Tracking
+    void TrackPortOwnerCells(QGraphicsItem* Item);
+    void UntrackPortOwnerCells(QGraphicsItem* Item);
+    static quint64 GetPortHashCellKey(int CellX, int CellY);
+    static QList<GraphicItemPort*> GetPortOwnerPortArray(QGraphicsItem* Item);
+
+    // Wire Bundles
+    void UpdateWireBundleMembership(GraphicItemWire* Wire);
+    void RemoveWireFromBundle(GraphicItemWire* Wire);
+    void ScheduleWireBundleUpdate(const WireBundleKey& Key, int Delay);
+
 private slots:
     void HandleTextEditorLostFocus(GraphicItemText* item);
+    void HandleItemSetProjectDirty();
+    void HandleItemRefreshPropertiesWindowProperty(QString PropertyName, QString NewPropertyValue);
+    void HandleWireRerouteQueued(GraphicItemWire* Wire);
+    void HandleComponentGeometryChanged(GraphicItemComponent* Component);
+    void HandleGroupGeometryChanged(GraphicItemGroup* Group);
+    void HandleTextGeometryChanged(GraphicItemText* Text);
+    void HandleWireGeometryChanged(GraphicItemWire* Wire);
+    void HandleWireConnectionChanged(GraphicItemWire* Wire);
+    void HandleWireBundleStateChanged(GraphicItemWire* Wire);
+    void HandleComponentPortsReordered(GraphicItemComponent* Component, QList<int> OldPortLayout);
 
 private:
     // General vars
     QMenu*                                m_ItemMenu;
-    QUndoStack*                           m_UndoStack;
+    UndoRedoStack*                        m_UndoStack;
+    int                                   m_UndoGestureSerial;
+    QHash<quint32, QGraphicsItem*>        m_UndoItemMap;                     // Items the Undo Commands refer to, by Id
+    quint32                               m_LastUndoItemId;
     OperationMode                         m_CurrentOperationMode;            // Mode that the Scene is current in
     SSTInfoDataComponent*                 m_UserChosenSSTInfoDataComponent;  // What component the user is going to add
 
@@ -144,10 +278,58 @@ private:
     GraphicItemWire*                      m_ptrMovingItemWire;
     GraphicItemWireHandle*                m_ptrMovingItemWireHandle;
 
+    // Items being dragged and where they started (A Move Command is pushed when they are dropped)
+    QList<QGraphicsItem*>                 m_MovingItemList;
+    QList<QPointF>                        m_MovingItemStartPosList;
+
+    // Render Caching of the Components (DeviceCoordinateCache when enabled)
+    QGraphicsItem::CacheMode              m_ComponentRenderCacheMode;
+
+    // Scene Rect of each Top Level Item (with its children) and the union of them all
+    QHash<QGraphicsItem*, QRectF>         m_TopLevelItemRectMap;
+    QRectF                                m_TopLevelItemsBounds;
+    bool                                  m_TopLevelItemsBoundsValid;
+
+    // Spatial Hash of the Port Connection Points. Each cell holds the Ports (Owner, Port Index)
+    // in that cell, so a lookup only checks the Ports near the point
+    QMultiHash<quint64, PortCellEntry>    m_PortCellHash;
+    QHash<QGraphicsItem*, QList<QPair<quint64, int> > > m_PortOwnerCellKeyMap;  // Cell and Port Index of each Port of an Owner
+
+    // Wire Routing (The Components and Groups are the Obstacles of the Router)
+    WireRouter                            m_WireRouter;
+    bool                                  m_AutoRouteNewWires;
+
+    // Wire Bundles (Fully connected Wires grouped by the Items at their ends; The first Wire is the Lead)
+    QHash<WireBundleKey, QList<GraphicItemWire*> > m_WireBundleMap;
+    QHash<GraphicItemWire*, WireBundleKey>         m_WireBundleKeyMap;     // Bundle each Wire is in
+    QSet<WireBundleKey>                            m_PendingWireBundleKeySet;
+    QTimer*                                        m_WireBundleUpdateTimer;
+
+    // Batch Operations (Suppresses the selection notifications for each item)
+    bool                                  m_BatchOperationInProgress;
+
+    // Coalesced Notifications (Collected from the items and sent once per event loop turn)
+    bool                                  m_NotificationDispatchScheduled;
+    bool                                  m_PendingProjectDirty;
+    bool                                  m_PendingRefreshPropertiesWindow;
+    QStringList                           m_PendingRefreshPropertyNameList;   // In the order they were first refreshed
+    QMap<QString, QString>                m_PendingRefreshPropertyValueMap;   // Latest value of each refreshed Property
+
+    // Wire Rerouting (Wires moved by their Ports are rerouted once per frame)
+    QList<QPointer<GraphicItemWire> >     m_WireRerouteQueue;
+    QTimer*                               m_WireRerouteTimer;
+    QElapsedTimer                         m_WireRerouteRateTimer;
+    int                                   m_WireReroutesThisPeriod;
+
     // Lists to track Graphic items
     QList<GraphicItemWire*>               m_GraphicItemWireList;          // List of all GraphicItemWires
     QList<GraphicItemComponent*>          m_GraphicItemComponentList;     // List of all GraphicItemComponents
     QList<GraphicItemComponent*>          m_GraphicItemComponentByTypeList[NUMCOMPONENTTYPES]; // List of GraphicItemComponents by ComponentType
+    QList<GraphicItemGroup*>              m_GraphicItemGroupList;         // List of all GraphicItemGroups (Sub-Circuit Instances)
+
+    // Sub-Circuit Definitions by Name (Shared by all Group instances of the Sub-Circuit)
+    QMap<QString, SubCircuitDefinition*>  m_SubCircuitDefinitionMap;
+    QMap<QString, ParameterSet*>          m_ParameterSetMap;
 
     // Index of Wires and Components
     int                                   m_CurrentWireIndex;           // Current Index of Wires